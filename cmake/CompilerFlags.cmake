@@ -1,6 +1,8 @@
 set(PONG_DEBUG_FLAGS      "")
 set(PONG_DEBUG_LINK_FLAGS "")
 set(PONG_WARNING_FLAGS    "")
+set(PONG_AVX2_FLAGS       "")
+set(PONG_FLOAT_FLAGS      "")
 # List with the common flags for GCC and Clang
 set(PONG_COMMON_WARNING_FLAGS
     -Wall
@@ -30,7 +32,20 @@ if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang"
     if (M_HAVE_ERROR_RETURN_TYPE)
         list(APPEND PONG_WARNING_FLAGS -Werror=return-type)
     endif()
+    # Flags for the translation units with AVX2 code, they are selected at runtime so only these files use them.
+    check_cxx_compiler_flag(-mavx2 M_HAVE_AVX2)
+    if (M_HAVE_AVX2)
+        list(APPEND PONG_AVX2_FLAGS -mavx2)
+    endif()
+    # The AI decides with floating-point numbers even in the fixed-point builds, so its operations must not be fused
+    # into FMA instructions, which round differently depending on the target.
+    check_cxx_compiler_flag(-ffp-contract=off M_HAVE_FP_CONTRACT_OFF)
+    if (M_HAVE_FP_CONTRACT_OFF)
+        list(APPEND PONG_FLOAT_FLAGS -ffp-contract=off)
+    endif()
 elseif(CMAKE_CXX_COMPILER_ID STREQUAL "MSVC")
     list(APPEND PONG_DEBUG_FLAGS /RTC1)
     list(APPEND PONG_WARNING_FLAGS /W4 /wd4100 /permissive-)
+    list(APPEND PONG_AVX2_FLAGS /arch:AVX2)
+    list(APPEND PONG_FLOAT_FLAGS /fp:precise)
 endif()
@@ -0,0 +1,8 @@
+# Build the headless simulator (pong-sim). It only depends on the core library, so it does not require SDL or OpenGL.
+option(PONG_BUILD_SIM "Build the headless simulator" ON)
+# Use the SIMD collision kernels (SSE2/AVX2). The best instruction set is selected at runtime, AVX2 is only compiled if
+# the compiler supports it.
+option(PONG_ENABLE_SIMD "Enable the SIMD collision kernels" ON)
+# Use Q16.16 fixed-point numbers for the state of the table, the paddles and the ball, so the matches are bit-exact with
+# every compiler and optimization level (the decisions of the AI are still floating-point, see PONG_FLOAT_FLAGS).
+option(PONG_FIXED_POINT "Use fixed-point numbers for the gameplay state" OFF)
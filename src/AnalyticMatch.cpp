@@ -0,0 +1,200 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "AnalyticMatch.hpp"
+#include "ControllerAI.hpp"
+#include "Game.hpp"
+#include "Paddle.hpp"
+#include "Table.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace pong {
+
+namespace {
+
+/** @brief Number of ticks between two decisions of the AI. */
+constexpr std::uint64_t DecisionTicks = ControllerAI::targetUpdateTicks(ControllerAI::TargetUpdateInterval,
+                                                                       Game::TickTime);
+
+} // namespace
+
+AnalyticMatch::AnalyticMatch(const std::uint64_t seed)
+{
+    reset(seed);
+}
+
+void AnalyticMatch::reset(const std::uint64_t seed)
+{
+    // The limits are calculated by a table so they are bit-exact with the ones used by the entities.
+    const Table table(Game::TablePosition, Game::TableSize);
+    mTable = {toFloat(table.top()), toFloat(table.bottom()), toFloat(table.left()), toFloat(table.right())};
+
+    const glm::vec2 half   = Game::PaddleSize * 0.5f;
+    const float     center = toFloat(table.position().y);
+    mPaddleA = {{mTable.right - Game::PaddleMargin, center}, half, 0.0f, mTable.bottom + half.y, mTable.top - half.y, 0.0};
+    mPaddleB = {{mTable.left  + Game::PaddleMargin, center}, half, 0.0f, mTable.bottom + half.y, mTable.top - half.y, 0.0};
+    // On the very first update the AI sets its target to the table's center.
+    mAIA = {center, false};
+    mAIB = {center, false};
+    mRandom.seed(seed);
+    // The timer of the AI starts with the first tick, so the first decision happens at the start of the last tick of
+    // the interval.
+    mDecisionTick = DecisionTicks - 1;
+    mTime         = 0.0;
+    mEvents       = 0;
+    mScoreA       = 0;
+    mScoreB       = 0;
+
+    kickoff(Game::InitialSpeed, 0.0);
+}
+
+bool AnalyticMatch::advance(const TimeDuration limit)
+{
+    if (finished() || mTime >= limit.count())
+    {
+        return false;
+    }
+
+    const double tick     = Game::TickTime.count();
+    const double decision = static_cast<double>(mDecisionTick) * tick;
+    const double end      = std::min(decision, limit.count());
+    // Resolve all the collisions until the next decision, a point or the time limit.
+    const physics::SweepResult result = physics::sweep(mBall, mPaddleA, mPaddleB, mTable, end);
+    if (result.overflow)
+    {
+        physics::settle(mBall, mPaddleA, mPaddleB, mTable, result, end);
+    }
+    mEvents += static_cast<std::uint64_t>(result.walls + result.paddles);
+    // The match ends at the time limit, a point after it does not count.
+    if ((result.pointA || result.pointB) && result.time > limit.count())
+    {
+        mTime = limit.count();
+        return false;
+    }
+
+    if (result.pointA || result.pointB)
+    {
+        if (result.pointA) { ++mScoreA; }
+        if (result.pointB) { ++mScoreB; }
+
+        mTime = result.time;
+        ++mEvents;
+        // The next round starts on the tick after the point.
+        if (!finished())
+        {
+            kickoff(result.pointA ? Game::InitialSpeed : -Game::InitialSpeed, std::ceil(result.time / tick) * tick);
+        }
+
+        return !finished();
+    }
+    if (end < decision)
+    {
+        mTime = end;
+        return false;
+    }
+    // Both AIs decide on the same tick, in the order of the scene.
+    decide(mAIA, mPaddleA, decision);
+    decide(mAIB, mPaddleB, decision);
+
+    mTime          = decision;
+    mDecisionTick += DecisionTicks;
+    mEvents       += 2;
+
+    return true;
+}
+
+void AnalyticMatch::play(const TimeDuration limit)
+{
+    while (advance(limit)) {}
+}
+
+bool AnalyticMatch::finished() const noexcept
+{
+    return mScoreA >= Game::MaxPoints || mScoreB >= Game::MaxPoints;
+}
+
+std::uint64_t AnalyticMatch::ticks() const noexcept
+{
+    return static_cast<std::uint64_t>(std::ceil(mTime / Game::TickTime.count()));
+}
+
+void AnalyticMatch::kickoff(const float speed, const double time)
+{
+    mBall = {{Game::TablePosition.x, Game::TablePosition.y}, {speed, 0.0f}, Game::BallRadius, time};
+    // The paddles go back to the center, but the AIs keep their targets.
+    mPaddleA.position.y = Game::TablePosition.y;
+    mPaddleA.time       = time;
+    mPaddleB.position.y = Game::TablePosition.y;
+    mPaddleB.time       = time;
+
+    steer(mAIA, mPaddleA, time);
+    steer(mAIB, mPaddleB, time);
+}
+
+void AnalyticMatch::decide(AI& ai, physics::SweptPaddle& paddle, const double time)
+{
+    ControllerAI::updateTarget(ai.target, ai.back,
+                               physics::positionAt(paddle, time), paddle.half.y * 2.0f,
+                               Game::TablePosition,               Game::TableSize.y,
+                               physics::positionAt(mBall, time),  mBall.speed,
+                               ControllerAI::Settings{},
+                               [this](const float min, const float max) { return mRandom.uniform(min, max); });
+
+    steer(ai, paddle, time);
+}
+
+void AnalyticMatch::steer(const AI& ai, physics::SweptPaddle& paddle, const double time) const
+{
+    const float minY = mTable.bottom + paddle.half.y;
+    const float maxY = mTable.top    - paddle.half.y;
+    const float y    = physics::positionAt(paddle, time).y;
+    // Distance moved by the paddle in a tick.
+    const auto step = static_cast<float>(Paddle::MovementSpeed * Game::TickTime.count());
+    // `ControllerAI` checks the dead zone once per tick, so the paddle stops on the first tick it is inside the dead
+    // zone (or at the limits of the table if the target is beyond them), not on its edge.
+    if (y < ai.target - ControllerAI::TargetDeadZone)
+    {
+        paddle.speed = Paddle::MovementSpeed;
+        paddle.minY  = minY;
+        paddle.maxY  = glm::min(maxY, y + step * std::ceil((ai.target - ControllerAI::TargetDeadZone - y) / step));
+    }
+    else if (y > ai.target + ControllerAI::TargetDeadZone)
+    {
+        paddle.speed = -Paddle::MovementSpeed;
+        paddle.minY  = glm::max(minY, y - step * std::ceil((y - ai.target - ControllerAI::TargetDeadZone) / step));
+        paddle.maxY  = maxY;
+    }
+    else
+    {
+        paddle.speed = 0.0f;
+        paddle.minY  = minY;
+        paddle.maxY  = maxY;
+    }
+
+    paddle.position.y = y;
+    paddle.time       = time;
+}
+
+} // namespace pong
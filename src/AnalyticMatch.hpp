@@ -0,0 +1,191 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Random.hpp"
+#include "SweptCollision.hpp"
+#include "Time.hpp"
+#include <cstdint>
+
+namespace pong {
+
+/**
+ * @brief Simulates an AI vs AI match jumping from event to event instead of integrating every tick.
+ *
+ * Between events the ball moves in a straight line and the paddles move at `Paddle::MovementSpeed` towards the target
+ * of their AI (or stay still), so the whole state is known in closed form. The match only needs to be advanced to the
+ * next event:
+ * - The collisions of the ball with the walls and the paddles, the points and the paddles reaching their targets or
+ *   the limits of the table, all of them found by `physics::sweep`.
+ * - The decisions of the AI, which recalculates its target every `ControllerAI::TargetUpdateInterval`. The timer is
+ *   evaluated at the ticks of the game, as `ControllerAI` does, so the decisions happen at the same times.
+ *
+ * The decisions are the ones of `ControllerAI::updateTarget` with a seeded random generator, and the next round starts
+ * on the tick after a point, as it does when the kickoff prompt is accepted right away. The collisions are the ones of
+ * the swept mode, so a match is statistically equivalent to an AI vs AI match played by `Game`, not bit-exact.
+ */
+class AnalyticMatch
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * The match starts at the kickoff.
+     * @param seed Seed for the random generator of the AI.
+     */
+    explicit AnalyticMatch(std::uint64_t seed);
+
+    /**
+     * @brief Resets the match to the kickoff.
+     * @param seed Seed for the random generator of the AI.
+     */
+    void reset(std::uint64_t seed);
+
+    /**
+     * @brief Advances the match to the next decision of the AI, the next point or the time limit, whatever comes first.
+     *
+     * All the collisions before that event are resolved in closed form. A point after the time limit is not scored.
+     * @param limit Maximum duration of the match.
+     * @return True if the match is still running, false if it has finished or reached the time limit.
+     */
+    bool advance(TimeDuration limit = TimeDuration::max());
+
+    /**
+     * @brief Advances the match until a player wins or the time limit is reached.
+     * @param limit Maximum duration of the match.
+     */
+    void play(TimeDuration limit);
+
+    /**
+     * @brief Checks if the match has finished.
+     * @return True if a player has won, false otherwise.
+     */
+    [[nodiscard]] bool finished() const noexcept;
+
+    /**
+     * @return Score of player A (right paddle).
+     */
+    [[nodiscard]] int scoreA() const noexcept { return mScoreA; }
+
+    /**
+     * @return Score of player B (left paddle).
+     */
+    [[nodiscard]] int scoreB() const noexcept { return mScoreB; }
+
+    /**
+     * @brief Gets the time of the last event.
+     * @return Time since the start of the match.
+     */
+    [[nodiscard]] TimeDuration time() const noexcept { return TimeDuration{mTime}; }
+
+    /**
+     * @brief Gets the number of ticks of the game needed to reach the last event.
+     * @return Number of ticks.
+     */
+    [[nodiscard]] std::uint64_t ticks() const noexcept;
+
+    /**
+     * @brief Gets the number of events processed: collisions, points and decisions of the AI.
+     * @return Number of events.
+     */
+    [[nodiscard]] std::uint64_t events() const noexcept { return mEvents; }
+
+private:
+
+    /**
+     * @brief Defines the state of the AI of a paddle.
+     */
+    struct AI
+    {
+        float target = 0.0f;  //!< Target Y-coordinate.
+        bool  back   = false; //!< Flag indicating if the paddle is returning to the center.
+    };
+
+    /**
+     * @brief Resets the ball and the paddles after a point.
+     * @param speed Initial horizontal speed of the ball.
+     * @param time Time when the round starts.
+     */
+    void kickoff(float speed, double time);
+
+    /**
+     * @brief Recalculates the target of an AI and steers its paddle.
+     * @param ai AI.
+     * @param paddle Paddle controlled by the AI.
+     * @param time Time of the decision.
+     */
+    void decide(AI& ai, physics::SweptPaddle& paddle, double time);
+
+    /**
+     * @brief Sets the movement of a paddle towards the target of its AI.
+     *
+     * The paddle moves at full speed and stops on the first tick it is inside the dead zone around the target.
+     * @param ai AI.
+     * @param paddle Paddle controlled by the AI.
+     * @param time Time from which the paddle moves.
+     */
+    void steer(const AI& ai, physics::SweptPaddle& paddle, double time) const;
+
+private:
+
+    /** @brief Limits of the table. */
+    physics::SweptTable mTable = {};
+
+    /** @brief Ball. */
+    physics::SweptBall mBall = {};
+
+    /** @brief Paddle A (right). */
+    physics::SweptPaddle mPaddleA = {};
+
+    /** @brief Paddle B (left). */
+    physics::SweptPaddle mPaddleB = {};
+
+    /** @brief AI of the paddle A. */
+    AI mAIA;
+
+    /** @brief AI of the paddle B. */
+    AI mAIB;
+
+    /** @brief Random generator of the AI. */
+    Random mRandom;
+
+    /** @brief Tick of the next decision of the AI. */
+    std::uint64_t mDecisionTick = 0;
+
+    /** @brief Time of the last event, in seconds. */
+    double mTime = 0.0;
+
+    /** @brief Number of events processed. */
+    std::uint64_t mEvents = 0;
+
+    /** @brief Score of player A. */
+    int mScoreA = 0;
+
+    /** @brief Score of player B. */
+    int mScoreB = 0;
+};
+
+} // namespace pong
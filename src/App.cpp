@@ -25,13 +25,19 @@
 #include "App.hpp"
 #include "Game.hpp"
 #include "Event.hpp"
-#include "Audio.hpp"
+#include "AudioNull.hpp"
+#include "AudioSDL.hpp"
 #include "Project.hpp"
 #include "RealTimeClock.hpp"
 #include "RendererGL3.hpp"
 #include <glad/gl.h>
 #include <SDL.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
 #include <iostream>
+#include <random>
 #include <thread>
 
 namespace pong {
@@ -43,6 +49,19 @@ constexpr SDL_KeyCode PongAKeyDown = SDLK_DOWN;
 constexpr SDL_KeyCode PongBKeyUp   = SDLK_w;
 constexpr SDL_KeyCode PongBKeyDown = SDLK_s;
 
+/**
+ * @brief Parses a non-negative integer command line value.
+ * @param text Text to parse.
+ * @param value Variable where the value is stored.
+ * @return True on success, false otherwise.
+ */
+template<typename T>
+bool parseValue(const std::string_view text, T& value)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size() && value >= 0;
+}
+
 void SDLDeleter::operator()(SDL_Window* win) const
 {
     if (win)
@@ -74,6 +93,12 @@ App::App() = default;
 
 App::~App()
 {
+    // A session that did not end through the main loop still gets its end record and the index of the keyframes.
+    finishRecording();
+
+    mPlayer   = {};
+    mRollback = {};
+    mSocket   = {};
     mGame     = {};
     mAudio    = {};
     mRenderer = {};
@@ -125,21 +150,26 @@ bool App::init(const int argc, char** argv)
         return false;
     }
     // Try to initialize the renderer.
-    mRenderer = RendererGL3::create(vMode.w, vMode.h);
-    if (!mRenderer)
+    if (!initRenderer(argc, argv, vMode.w, vMode.h))
     {
-        std::cerr << "Unable to initialize the renderer" << std::endl;
         return false;
     }
     // Try to initialize the audio system. The audio system is not a critical component, so on failure the application can
     // run without it.
-    mAudio = Audio::create();
+    mAudio = AudioSDL::create();
     if (!mAudio)
     {
         std::cerr << "Unable to initialize the audio system" << std::endl;
+        mAudio = std::make_unique<AudioNull>();
+    }
+    // Initiate the game, every session has different matches against the AI.
+    mGame = std::make_unique<Game>();
+    mGame->setSeed(std::random_device{}());
+    // Initiate the network session, the replay and the multi-ball mode, if any.
+    if (!initNetplay(argc, argv) || !initReplay(argc, argv) || !initBalls(argc, argv))
+    {
+        return false;
     }
-    // Initiate the game.
-    mGame = std::make_unique<Game>(*mAudio);
     // Wait to ensure the window is ready.
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
     // Everything is fine, :-)
@@ -151,7 +181,7 @@ void App::exec()
           bool done  = false;
     const bool vsync = enableVSync();
 
-    const TimeDuration tickTime{1.0 / 60.0};
+    const TimeDuration tickTime = Game::TickTime;
     const TimeDuration drawTime{1.0 / 60.0};
     TimeDuration tickAccum{};
     TimeDuration drawAccum{};
@@ -169,33 +199,84 @@ void App::exec()
             elapsed = tickTime * 4;
         }
         // Increase the timers with the elapsed time.
-        tickAccum += elapsed;
+        tickAccum += elapsed * mSpeed;
         drawAccum += elapsed;
         // Update in fixed time steps.
         for (; tickAccum >= tickTime; tickAccum -= tickTime)
         {
+            // In a network session the events are the input of the local player, the session updates the game.
+            if (mRollback)
+            {
+                // The events are drained by the first tick, a quit must not be lost in the next ticks of the frame.
+                done = updateNetplay();
+                if (done)
+                {
+                    break;
+                }
+                continue;
+            }
+            // When a replay is played the events come from it.
+            if (mPlayer)
+            {
+                done = updateReplay();
+                if (done)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            if (mRecorder)
+            {
+                mRecorder->keyframe(mTick, *mGame);
+            }
+
             while (!mEvents.empty())
             {
+                if (mRecorder)
+                {
+                    mRecorder->record(mTick, mEvents.front().type());
+                }
+
                 mGame->handle(mEvents.front());
                 mEvents.pop();
             }
             // Update the game and check if it has finished.
                    mGame->update(tickTime);
             done = mGame->done();
+            ++mTick;
+            // Close the replay file with the ticks and the final scores, so the playback can verify it.
+            if (done)
+            {
+                finishRecording();
+            }
         }
-        // Draw.
+        // React to what happened in the ticks.
+        playSounds();
+        // Draw, unless the frame would be the same as the one on the screen.
         if (!done)
         {
-            mRenderer->beginFrame();
-            mGame->draw(*mRenderer, static_cast<float>(tickAccum / tickTime));
-            mRenderer->endFrame();
+            const bool present = mRedraw || mGame->changed();
+            if (present)
+            {
+                mRenderer->beginFrame();
+                mGame->draw(*mRenderer, static_cast<float>(tickAccum / tickTime));
+                mRenderer->endFrame();
+                // Swap the buffers.
+                SDL_GL_SwapWindow(mWin.get());
+                mRedraw = false;
+                ++mStats.frames;
+            }
+            else
+            {
+                ++mStats.skippedFrames;
+            }
             // Reset the time accumulator with the time elapsed between draw calls.
             drawAccum = {};
-            // Swap the buffers.
-            SDL_GL_SwapWindow(mWin.get());
             // When VSync is disabled, the main loop can run at thousands of frames per second, consuming 100% of a CPU
-            // core. This block acts as a fallback manual frame limiter to conserve system resources.
-            if (!vsync)
+            // core. This block acts as a fallback manual frame limiter to conserve system resources. It also paces the
+            // skipped frames, as there is no swap to wait for the VSync.
+            if (!vsync || !present)
             {
                 /*
                  * The logic calculates the "spare time" available before the next scheduled game event and puts the
@@ -250,6 +331,15 @@ void App::handleEvents()
                     case SDL_WINDOWEVENT_RESTORED:
                     {
                         mEvents.emplace(Event::Type::Maximize);
+                        mRedraw = true;
+                    }
+                    break;
+
+                    // The window system may have lost the contents of the window.
+                    case SDL_WINDOWEVENT_EXPOSED:
+                    case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    {
+                        mRedraw = true;
                     }
                     break;
 
@@ -273,6 +363,8 @@ void App::handleEvents()
                     case SDLK_y:      { mEvents.emplace(Event::Type::Yes);  } break;
                     case SDLK_n:      { mEvents.emplace(Event::Type::No);   } break;
                     case SDLK_h:      { mEvents.emplace(Event::Type::Help); } break;
+                    case SDLK_0:
+                    case SDLK_KP_0:   { mEvents.emplace(Event::Type::Zero); } break;
                     case SDLK_1:
                     case SDLK_KP_1:   { mEvents.emplace(Event::Type::One);  } break;
                     case SDLK_2:
@@ -307,6 +399,318 @@ void App::handleEvents()
     }
 }
 
+bool App::initNetplay(const int argc, char** argv)
+{
+    std::optional<std::uint16_t> port;
+    Rollback::Settings           settings;
+    // Parse the options of the network session.
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string_view arg   = argv[i];
+        const std::string_view value = argv[i + 1];
+        bool                   valid = true;
+
+        if      (arg == "--host")     { port.emplace(); valid = parseValue(value, *port) && *port != 0; }
+        else if (arg == "--join")     { mPeer = UdpAddress::parse(value); valid = mPeer.has_value(); }
+        else if (arg == "--delay")    { valid = parseValue(value, settings.inputDelay); }
+        else if (arg == "--rollback") { valid = parseValue(value, settings.rollbackTicks); }
+        else                          { continue; }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+        ++i;
+    }
+    // Without a port or a peer it is a local game.
+    if (!port && !mPeer)
+    {
+        return true;
+    }
+    // Try to open the socket, the peer that joins uses any port.
+    mSocket = UdpSocket::create(port.value_or(0));
+    if (!mSocket)
+    {
+        std::cerr << "Unable to open the UDP socket" << std::endl;
+        return false;
+    }
+    // The host plays with the right paddle (player A) and the peer that joins with the left one (player B).
+    mRollback = std::make_unique<Rollback>(*mGame, mPeer ? ControllerHuman::Player::B : ControllerHuman::Player::A, settings);
+
+    if (mPeer)
+    {
+        std::cout << "Joining " << mPeer->toString() << " from port " << mSocket->port() << std::endl;
+    }
+    else
+    {
+        std::cout << "Hosting on port " << mSocket->port() << std::endl;
+    }
+
+    return true;
+}
+
+bool App::initReplay(const int argc, char** argv)
+{
+    std::string_view record;
+    std::string_view play;
+    double           seek = 0.0;
+    // Parse the options of the replay.
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string_view arg   = argv[i];
+        const std::string_view value = argv[i + 1];
+        bool                   valid = true;
+
+        if      (arg == "--record") { record = value; }
+        else if (arg == "--play")   { play   = value; }
+        else if (arg == "--speed")  { const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), mSpeed); valid = ec == std::errc{} && mSpeed > 0.0; }
+        else if (arg == "--seek")   { const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), seek);   valid = ec == std::errc{} && seek   >= 0.0; }
+        else                        { continue; }
+
+        if (!valid)
+        {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+        ++i;
+    }
+    // A replay is a local session, it cannot be combined with a network session or with another replay.
+    if ((!record.empty() || !play.empty()) && mRollback)
+    {
+        std::cerr << "Replays are not supported in network sessions" << std::endl;
+        return false;
+    }
+
+    if (!record.empty() && !play.empty())
+    {
+        std::cerr << "A replay cannot be recorded while another one is played" << std::endl;
+        return false;
+    }
+    // Try to create the file to record.
+    if (!record.empty())
+    {
+        mRecorder = ReplayRecorder::create(std::filesystem::path(record), mGame->seed());
+        if (!mRecorder)
+        {
+            std::cerr << "Unable to create the replay file " << record << std::endl;
+            return false;
+        }
+    }
+    // Try to load the file to play.
+    if (!play.empty())
+    {
+        mReplay = Replay::load(std::filesystem::path(play));
+        if (!mReplay)
+        {
+            std::cerr << "Unable to load the replay file " << play << std::endl;
+            return false;
+        }
+
+        mPlayer = std::make_unique<ReplayPlayer>(*mReplay, *mGame);
+        // Jump to the requested time.
+        if (!mPlayer->seek(static_cast<std::uint64_t>(std::llround(seek / Game::TickTime.count()))))
+        {
+            std::cerr << "Unable to seek the replay file " << play << std::endl;
+            return false;
+        }
+    }
+    // The speed only applies to replays.
+    if (!mPlayer)
+    {
+        mSpeed = 1.0;
+    }
+
+    return true;
+}
+
+bool App::initRenderer(const int argc, char** argv, const int width, const int height)
+{
+    RendererGL3::Settings settings;
+    settings.load = reinterpret_cast<GLADloadfunc>(SDL_GL_GetProcAddress);
+    // Parse the layout of the quads and the upload strategy.
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string_view arg   = argv[i];
+        const std::string_view value = argv[i + 1];
+        if (arg == "--quads")
+        {
+            if      (value == "instances") { settings.layout = QuadBatch::Layout::Instances; }
+            else if (value == "packed")    { settings.layout = QuadBatch::Layout::Packed;    }
+            else if (value == "vertices")  { settings.layout = QuadBatch::Layout::Vertices;  }
+            else
+            {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+            ++i;
+        }
+        else if (arg == "--upload")
+        {
+            const auto kind = std::find_if(GL3Upload::Kinds.begin(), GL3Upload::Kinds.end(),
+                                           [value](const GL3Upload::Kind k) { return GL3Upload::name(k) == value; });
+            if (kind != GL3Upload::Kinds.end())
+            {
+                settings.upload = *kind;
+            }
+            else if (value != "auto")
+            {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+            ++i;
+        }
+    }
+
+    mRenderer = RendererGL3::create(width, height, settings);
+    if (!mRenderer)
+    {
+        std::cerr << "Unable to initialize the renderer" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool App::initBalls(const int argc, char** argv)
+{
+    int balls = 1;
+    // Parse the number of balls.
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        const std::string_view arg   = argv[i];
+        const std::string_view value = argv[i + 1];
+        if (arg != "--balls")
+        {
+            continue;
+        }
+
+        if (!parseValue(value, balls) || balls < 1 || balls > Game::MaxBalls)
+        {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            return false;
+        }
+        ++i;
+    }
+    // Snapshots only hold one ball, so the network sessions and the replays only support the classic mode.
+    if (balls > 1 && (mRollback || mRecorder || mPlayer))
+    {
+        std::cerr << "Multi-ball matches are not supported in network sessions or replays" << std::endl;
+        return false;
+    }
+
+    mGame->setBalls(balls);
+
+    return true;
+}
+
+bool App::updateNetplay()
+{
+    bool quit = false;
+    // Update the keys held down by the local player, both sets of keys move its paddle.
+    for (; !mEvents.empty(); mEvents.pop())
+    {
+        switch (mEvents.front().type())
+        {
+            case Event::Type::PlayerAMoveUp:
+            case Event::Type::PlayerBMoveUp:           { mInput |= Rollback::InputUp;   } break;
+            case Event::Type::PlayerAMoveUpReleased:
+            case Event::Type::PlayerBMoveUpReleased:   { mInput &= static_cast<Rollback::Input>(~Rollback::InputUp);   } break;
+            case Event::Type::PlayerAMoveDown:
+            case Event::Type::PlayerBMoveDown:         { mInput |= Rollback::InputDown; } break;
+            case Event::Type::PlayerAMoveDownReleased:
+            case Event::Type::PlayerBMoveDownReleased: { mInput &= static_cast<Rollback::Input>(~Rollback::InputDown); } break;
+            case Event::Type::Next:                    { mInput |= Rollback::InputNext; } break;
+            case Event::Type::Quit:                    { quit = true; } break;
+
+            default:break;
+        }
+    }
+    // Read the packets of the peer, the host learns its address from the first one.
+    std::array<std::uint8_t, Rollback::MaxPacketSize> buffer{};
+    UdpAddress from;
+    while (const std::size_t size = mSocket->receive(buffer, from))
+    {
+        if (!mPeer)
+        {
+            mPeer = from;
+            std::cout << "Peer " << from.toString() << " joined" << std::endl;
+        }
+
+        if (from == *mPeer)
+        {
+            mRollback->readPacket({buffer.data(), size});
+        }
+    }
+    // Advance the game, there is no release event for the next key so it is only held down for one tick.
+    if (mRollback->advance(mInput))
+    {
+        mInput &= static_cast<Rollback::Input>(~Rollback::InputNext);
+    }
+    // Send the local inputs the peer has not acknowledged yet.
+    if (mPeer)
+    {
+        const std::size_t size = mRollback->writePacket(buffer);
+        mSocket->send(*mPeer, {buffer.data(), size});
+    }
+
+    return quit;
+}
+
+bool App::updateReplay()
+{
+    // A replay played to the end is not stepped again, it would be reported twice and not verified.
+    if (mPlayer->done())
+    {
+        return true;
+    }
+
+    bool quit = false;
+    for (; !mEvents.empty(); mEvents.pop())
+    {
+        quit = quit || mEvents.front().is(Event::Type::Quit);
+    }
+
+    mPlayer->step();
+
+    if (mPlayer->done())
+    {
+        std::cout << "Replay finished after " << mPlayer->tick() << " ticks, "
+                  << (mPlayer->verify() ? "scores verified" : "scores NOT verified") << std::endl;
+        return true;
+    }
+
+    return quit || mGame->done();
+}
+
+void App::finishRecording()
+{
+    if (mRecorder && mGame)
+    {
+        mRecorder->finish(mTick, mGame->scoreA(), mGame->scoreB());
+        if (!mRecorder->good())
+        {
+            std::cerr << "Unable to write the replay file" << std::endl;
+        }
+    }
+
+    mRecorder = {};
+}
+
+void App::playSounds()
+{
+    bool hit = false;
+    mGame->events().drain([&hit](const GameplayEvent& event)
+    {
+        hit = hit || event.type == GameplayEvent::Type::WallHit || event.type == GameplayEvent::Type::PaddleHit;
+    });
+    // The sound is played once per frame, even if the ball bounced several times.
+    if (hit)
+    {
+        mAudio->play();
+    }
+}
+
 bool App::openWindow(const unsigned int flags, const int major, const int minor)
 {
     const Uint32 sdlFlags = flags | SDL_WINDOW_HIDDEN;
@@ -25,7 +25,11 @@
 #pragma once
 
 #include "Event.hpp"
+#include "Replay.hpp"
+#include "Rollback.hpp"
+#include "UdpSocket.hpp"
 #include <memory>
+#include <optional>
 #include <queue>
 
 /* Forward declare SDL types to not include SDL.h in the header */
@@ -50,6 +54,16 @@ struct SDLGLDeleter { void operator()(void* ctx) const;  };
  * that can fail.
  * The main loop is a fixed-timestep implementation for deterministic physics updates, with variable rendering for
  * smoothness.
+ *
+ * With `--host PORT` or `--join ADDRESS:PORT` the application plays a two-player match against a remote peer over UDP
+ * instead: the host controls the right paddle and the peer that joins the left one (with any of the two sets of keys),
+ * and the inputs go through a `Rollback` session (`--delay` and `--rollback` set its input delay and rollback window,
+ * in ticks, and must be the same on both peers).
+ *
+ * `--record FILE` records the events of a local session into a replay file, and `--play FILE` plays one back (at
+ * `--speed` times the normal speed, from `--seek` seconds) and checks that it ends with the recorded scores.
+ *
+ * `--stats` prints the frames presented and skipped (see `stats()`) when the application quits.
  */
 class App
 {
@@ -93,16 +107,70 @@ private:
      */
     bool init(int argc, char** argv);
 
+    /**
+     * @brief Opens the network session if the command line requests one.
+     * @param argc The command-line argument count.
+     * @param argv The command-line argument values.
+     * @return True on success (or if there is no network session), false otherwise.
+     */
+    bool initNetplay(int argc, char** argv);
+
+    /**
+     * @brief Opens the replay file to record or to play if the command line requests one.
+     * @param argc The command-line argument count.
+     * @param argv The command-line argument values.
+     * @return True on success (or if there is no replay), false otherwise.
+     */
+    bool initReplay(int argc, char** argv);
+
+    /**
+     * @brief Creates the renderer, with the layout of the quads (`--quads instances|packed|vertices`) and the upload strategy
+     * (`--upload auto|subdata|orphan|ring|persistent`) requested in the command line, if any.
+     * @param argc The command-line argument count.
+     * @param argv The command-line argument values.
+     * @param width The width of the rendering window, in pixels.
+     * @param height The height of the rendering window, in pixels.
+     * @return True on success, false otherwise.
+     */
+    bool initRenderer(int argc, char** argv, int width, int height);
+
+    /**
+     * @brief Sets the number of balls of the matches if the command line requests a multi-ball mode.
+     * @param argc The command-line argument count.
+     * @param argv The command-line argument values.
+     * @return True on success (or if there is no multi-ball mode), false otherwise.
+     */
+    bool initBalls(int argc, char** argv);
+
 public:
 
     /**
      * @brief Executes the main application loop.
      *
      * This method will block until the user quits or the game logic signals that it is done. It contains the
-     * fixed-timestep update logic and rendering calls.
+     * fixed-timestep update logic and rendering calls. The frames where nothing visible changed (see `Game::changed()`)
+     * are neither drawn nor presented, the last one stays on the screen.
      */
     void exec();
 
+    /**
+     * @brief Defines the statistics of the frames of the main loop.
+     */
+    struct Stats
+    {
+        /** @brief Number of frames drawn and presented. */
+        std::uint64_t frames = 0;
+
+        /** @brief Number of frames skipped because nothing visible changed. */
+        std::uint64_t skippedFrames = 0;
+    };
+
+    /**
+     * @brief Gets the statistics of the frames of the main loop.
+     * @return Statistics.
+     */
+    [[nodiscard]] const Stats& stats() const noexcept { return mStats; }
+
 private:
 
     /**
@@ -113,6 +181,35 @@ private:
      */
     void handleEvents();
 
+    /**
+     * @brief Advances the network session one tick.
+     *
+     * The events are turned into the input of the local player, the packets of the peer are read, the game advances
+     * (unless it has to wait for the peer) and the local inputs are sent.
+     * @return True if the user wants to quit, false otherwise.
+     */
+    bool updateNetplay();
+
+    /**
+     * @brief Plays a tick of the replay.
+     *
+     * The only event of the user that is handled is quit, the game receives the events of the replay.
+     * @return True if the replay has finished or the user wants to quit, false otherwise.
+     */
+    bool updateReplay();
+
+    /**
+     * @brief Records the end of the session, if it is recorded, and closes the replay file.
+     *
+     * Nothing else is recorded after it, so it only writes the end record once.
+     */
+    void finishRecording();
+
+    /**
+     * @brief Drains the gameplay events of the ticks of the frame and plays the collision sound if the ball bounced.
+     */
+    void playSounds();
+
     /**
      * @brief Creates the SDL window and the associated OpenGL context.
      *
@@ -148,6 +245,39 @@ private:
 
     /** @brief A queue for game-specific events. */
     std::queue<Event> mEvents;
+
+    /** @brief Socket of the network session, null in local games. */
+    std::unique_ptr<UdpSocket> mSocket;
+
+    /** @brief Rollback session, null in local games. */
+    std::unique_ptr<Rollback> mRollback;
+
+    /** @brief Address of the peer, unknown until its first packet arrives when hosting. */
+    std::optional<UdpAddress> mPeer;
+
+    /** @brief Keys held down by the local player in the network session. */
+    Rollback::Input mInput = 0;
+
+    /** @brief Recorder of the session, null if it is not recorded. */
+    std::unique_ptr<ReplayRecorder> mRecorder;
+
+    /** @brief Replay being played, if any. */
+    std::optional<Replay> mReplay;
+
+    /** @brief Player of the replay, null if no replay is played. */
+    std::unique_ptr<ReplayPlayer> mPlayer;
+
+    /** @brief Speed of the game time relative to the real time, it is only changed to play replays. */
+    double mSpeed = 1.0;
+
+    /** @brief Number of updates of the game. */
+    std::uint64_t mTick = 0;
+
+    /** @brief Statistics of the frames. */
+    Stats mStats;
+
+    /** @brief Indicates whether the next frame must be presented even if the game did not change. */
+    bool mRedraw = true;
 };
 
 } // namespace pong
@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Arena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+namespace pong {
+
+Arena::~Arena() = default;
+
+std::size_t Arena::used() const noexcept
+{
+    return mUsedBefore + mOffset;
+}
+
+std::size_t Arena::capacity() const noexcept
+{
+    std::size_t size = 0;
+    for (const auto& block : mBlocks)
+    {
+        size += block.size;
+    }
+
+    return size;
+}
+
+void Arena::reset()
+{
+    // Replace the blocks by a single one if the last use needed several, the next uses will fit in it.
+    if (mBlocks.size() > 1)
+    {
+        const std::size_t size = capacity();
+        mBlocks.clear();
+        mBlockSize = size;
+        grow(size);
+    }
+
+    mCurrent    = 0;
+    mOffset     = 0;
+    mUsedBefore = 0;
+}
+
+void* Arena::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    for (;;)
+    {
+        if (mCurrent < mBlocks.size())
+        {
+            // Align the address, not the offset, the blocks are only aligned for the fundamental types.
+            const Block&         block  = mBlocks[mCurrent];
+            const std::uintptr_t base   = reinterpret_cast<std::uintptr_t>(block.memory.get());
+            const std::uintptr_t start  = (base + mOffset + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+            const std::size_t    offset = static_cast<std::size_t>(start - base);
+            if (offset + bytes <= block.size)
+            {
+                mOffset = offset + bytes;
+                return block.memory.get() + offset;
+            }
+            // Move to the next block, if any.
+            if (mCurrent + 1 < mBlocks.size())
+            {
+                mUsedBefore += mOffset;
+                mOffset      = 0;
+                ++mCurrent;
+                continue;
+            }
+        }
+
+        grow(bytes + alignment);
+    }
+}
+
+void Arena::do_deallocate(void*, std::size_t, std::size_t)
+{
+    // The memory is released by `reset()`.
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void Arena::grow(const std::size_t bytes)
+{
+    if (!mBlocks.empty())
+    {
+        mUsedBefore += mOffset;
+        mCurrent     = mBlocks.size();
+    }
+
+    const std::size_t size = std::max(mBlockSize, bytes);
+    mBlocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+    mBlockSize = size * 2;
+    mOffset    = 0;
+}
+
+} // namespace pong
@@ -0,0 +1,179 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace pong {
+
+/**
+ * @brief Deletes an object owned by an `ArenaPtr`.
+ *
+ * The objects created by an arena are only destroyed, their memory is released when the arena is reset. The deleter
+ * can also be converted from `std::default_delete`, so the pointers returned by `std::make_unique` can be stored in an
+ * `ArenaPtr` too, and then the objects are deleted as usual.
+ * @tparam T Type of the object.
+ */
+template<typename T>
+struct ArenaDelete
+{
+    ArenaDelete() = default;
+
+    /**
+     * @brief Constructor.
+     * @param fromArena True if the object was created by an arena, false if it was allocated with `new`.
+     */
+    explicit ArenaDelete(const bool fromArena) noexcept : arena(fromArena) {}
+
+    template<typename U>
+    ArenaDelete(const std::default_delete<U>&) noexcept {}
+
+    template<typename U>
+    ArenaDelete(const ArenaDelete<U>& other) noexcept : arena(other.arena) {}
+
+    void operator()(T* object) const noexcept
+    {
+        if (arena) { std::destroy_at(object); }
+        else       { delete object; }
+    }
+
+    /** @brief Flag indicating whether the object was created by an arena or allocated with `new`. */
+    bool arena = false;
+};
+
+/**
+ * @brief Defines a pointer to an object created by an arena (or allocated with `new`).
+ */
+template<typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDelete<T>>;
+
+/**
+ * @brief Monotonic memory resource that releases all its allocations at once.
+ *
+ * The memory is taken from blocks allocated from the heap: every allocation just moves forward in the current block,
+ * deallocating does nothing, and `reset()` releases everything by moving back to the start of the first block without
+ * returning the blocks to the heap. When a reset finds that the allocations needed several blocks, they are replaced
+ * by a single block large enough for all of them, so once the arena has seen its largest use it allocates nothing
+ * from the heap anymore.
+ *
+ * Containers use it through `std::pmr` allocators. Objects created in the arena must be destroyed before it is reset.
+ */
+class Arena final : public std::pmr::memory_resource
+{
+public:
+
+    /** @brief Size of the first block, in bytes. */
+    static constexpr std::size_t DefaultBlockSize = 4096;
+
+    /**
+     * @brief Constructor, the first block is allocated with the first allocation.
+     * @param blockSize Size of the first block, in bytes.
+     */
+    explicit Arena(std::size_t blockSize = DefaultBlockSize) noexcept : mBlockSize(blockSize) {}
+
+    Arena(const Arena&) = delete;
+
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override;
+
+    /**
+     * @brief Gets the number of bytes in use, including the padding for the alignments.
+     * @return Number of bytes.
+     */
+    [[nodiscard]] std::size_t used() const noexcept;
+
+    /**
+     * @brief Gets the total size of the blocks.
+     * @return Number of bytes.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Creates an object in the arena.
+     * @tparam T Type of the object.
+     * @param args The arguments for the constructor.
+     * @return A pointer that destroys the object, without releasing its memory.
+     */
+    template<typename T, typename... Args>
+    ArenaPtr<T> make(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return ArenaPtr<T>(::new (memory) T(std::forward<Args>(args)...), ArenaDelete<T>(true));
+    }
+
+    /**
+     * @brief Releases all the allocations, keeping the memory of the blocks.
+     */
+    void reset();
+
+private:
+
+    /** @brief Defines a block of memory. */
+    struct Block
+    {
+        /** @brief Memory. */
+        std::unique_ptr<std::byte[]> memory;
+
+        /** @brief Size, in bytes. */
+        std::size_t size = 0;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /**
+     * @brief Allocates a new block and makes it the current one.
+     * @param bytes Minimum size of the block.
+     */
+    void grow(std::size_t bytes);
+
+private:
+
+    /** @brief Blocks, in the order they were allocated. */
+    std::vector<Block> mBlocks;
+
+    /** @brief Size of the next block, in bytes. */
+    std::size_t mBlockSize = DefaultBlockSize;
+
+    /** @brief Index of the current block. */
+    std::size_t mCurrent = 0;
+
+    /** @brief Offset of the next allocation in the current block. */
+    std::size_t mOffset = 0;
+
+    /** @brief Number of bytes used by the blocks before the current one. */
+    std::size_t mUsedBefore = 0;
+};
+
+} // namespace pong
@@ -24,30 +24,28 @@
 
 #pragma once
 
-#include <memory>
-
 namespace pong {
 
 /**
- * @brief Manages loading and playback of WAV audio using the SDL audio subsystem.
+ * @class Audio
+ * @brief Defines a pure abstract interface for the audio system.
+ *
+ * @details The game only needs to trigger the "pong" sound effect, so the contract is limited to that. Concrete
+ * implementations are `AudioSDL`, which plays the sound through an SDL audio device, and `AudioNull`, which discards
+ * every request and is used by headless simulations or when no audio device is available.
  *
- * This class is a self-contained audio engine designed for playing a single pre-loaded sound effect.
+ * This class is non-copyable and non-movable as it represents a unique system resource.
  */
 class Audio
 {
-    /** @brief Define a wrapper for a SDL audio device. */
-    struct Device;
-
-    /** @brief Define a wrapper for a SDL sound. */
-    struct Sound;
-
-public:
+protected:
 
     /**
-     * @brief Factory method to create and initialize the audio system.
-     * @return A unique pointer holding the new instance if initialization is successful, or null if it fails.
+     * @brief Protected default constructor to allow inheritance.
      */
-    [[nodiscard]] static std::unique_ptr<Audio> create();
+    Audio() = default;
+
+public:
 
     Audio(const Audio&) = delete;
 
@@ -57,54 +55,15 @@ public:
 
     Audio& operator=(Audio&&) = delete;
 
-    ~Audio();
-
-private:
-
-    /**
-     * @brief Constructor.
-     */
-    Audio();
-
     /**
-     * @brief Internal initialization method called by the factory.
-     * @return True on success, false otherwise.
+     * @brief Virtual destructor to ensure proper cleanup in derived classes.
      */
-    bool init();
-
-public:
+    virtual ~Audio() = default;
 
     /**
      * @brief Play the "pong" sound.
      */
-    void play();
-
-private:
-
-    /**
-     * @brief Loads and converts a WAV file from memory.
-     * @param size Size of the memory buffer, in bytes.
-     * @param data Read-only pointer to the memory buffer.
-     * @return True on success, false otherwise.
-     */
-    bool load(std::size_t size, const void* data);
-
-    /**
-     * @brief C-style callback function passed to SDL audio.
-     *
-     * @param data User data (pointer to the instance of the audio system).
-     * @param stream Audio buffer to fill.
-     * @param length Length of the buffer, in bytes.
-     */
-    static void callback(void* data, unsigned char* stream, int length);
-
-private:
-
-    /** @brief Audio device. */
-    std::unique_ptr<Device> mDevice;
-
-    /** @brief The "pong" sound. */
-    std::unique_ptr<Sound> mSound;
+    virtual void play() = 0;
 };
 
 } // namespace pong
@@ -22,7 +22,7 @@
 /// THE SOFTWARE.
 ////////////////////////////////////////////////////////////
 
-#include "Audio.hpp"
+#include "AudioSDL.hpp"
 #include "data/Sound.hpp"
 #include <algorithm>
 #include <cstring>
@@ -39,9 +39,9 @@ namespace pong {
  *
  * This structure holds the unique identifier for the opened audio device and a copy of the final `SDL_AudioSpec` that
  * the hardware is using, which may differ from the one requested.
- * Its lifetime is managed by the parent `Audio` class.
+ * Its lifetime is managed by the parent `AudioSDL` class.
  */
-struct Audio::Device
+struct AudioSDL::Device
 {
     /** @brief Unique ID for the opened SDL audio device. A value of 0 indicates an error or uninitialized state. */
     SDL_AudioDeviceID mId;
@@ -56,7 +56,7 @@ struct Audio::Device
  * This structure contains the audio sample data in a vector, converted to the format required by the audio device. It
  * also tracks the current playback position within that buffer.
  */
-struct Audio::Sound
+struct AudioSDL::Sound
 {
     /**
      * @brief Gets the total size of the audio buffer, in bytes.
@@ -119,9 +119,9 @@ private:
     Uint32 mPosition = 0;
 };
 
-std::unique_ptr<Audio> Audio::create()
+std::unique_ptr<Audio> AudioSDL::create()
 {
-    auto audio = std::unique_ptr<Audio>(new Audio{});
+    auto audio = std::unique_ptr<AudioSDL>(new AudioSDL{});
     if (audio->init())
     {
         return audio;
@@ -131,13 +131,13 @@ std::unique_ptr<Audio> Audio::create()
 }
 
 
-Audio::Audio()
+AudioSDL::AudioSDL()
 {
     mDevice = std::make_unique<Device>();
     mSound  = std::make_unique<Sound>();
 }
 
-Audio::~Audio()
+AudioSDL::~AudioSDL()
 {
     if (mDevice->mId != 0)
     {
@@ -146,7 +146,7 @@ Audio::~Audio()
     }
 }
 
-bool Audio::init()
+bool AudioSDL::init()
 {
     SDL_AudioSpec want;
     // Set the desired audio specification.
@@ -155,7 +155,7 @@ bool Audio::init()
     want.format   = AUDIO_F32;
     want.channels = 1;
     want.samples  = 4096;
-    want.callback = &Audio::callback;
+    want.callback = &AudioSDL::callback;
     want.userdata = this;
     // Try to open the audio device.
     if ((mDevice->mId = SDL_OpenAudioDevice(nullptr, 0, &want, &mDevice->mSpec, 0)) == 0)
@@ -171,7 +171,7 @@ bool Audio::init()
     return true;
 }
 
-void Audio::play()
+void AudioSDL::play()
 {
     if (!mDevice || mDevice->mId == 0)
     {
@@ -186,7 +186,7 @@ void Audio::play()
     SDL_PauseAudioDevice(mDevice->mId, PONG_AUDIO_RESUME);
 }
 
-bool Audio::load(const std::size_t size, const void* data)
+bool AudioSDL::load(const std::size_t size, const void* data)
 {
     // Audio specification for the WAV file.
     SDL_AudioSpec wavSpec;
@@ -225,10 +225,10 @@ bool Audio::load(const std::size_t size, const void* data)
     return true;
 }
 
-void Audio::callback(void* data, unsigned char* stream, int length)
+void AudioSDL::callback(void* data, unsigned char* stream, int length)
 {
-    Device* device = static_cast<Audio*>(data)->mDevice.get();
-    Sound*  sound  = static_cast<Audio*>(data)->mSound.get();
+    Device* device = static_cast<AudioSDL*>(data)->mDevice.get();
+    Sound*  sound  = static_cast<AudioSDL*>(data)->mSound.get();
     if (!device || !sound)
     {
         return;
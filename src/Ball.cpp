@@ -23,56 +23,70 @@
 ////////////////////////////////////////////////////////////
 
 #include "Ball.hpp"
-#include "Audio.hpp"
+#include "BallGrid.hpp"
 #include "Event.hpp"
 #include "Scene.hpp"
 #include "Table.hpp"
 #include "Paddle.hpp"
 #include "Game.hpp"
 #include "Renderer.hpp"
-#include <glm/gtx/rotate_vector.hpp>
-#include <glm/gtx/norm.hpp>
+#include "Physics.hpp"
+#include "PhysicsFixed.hpp"
+#include "Snapshot.hpp"
 
 namespace pong {
-namespace      {
-
-/**
- * @brief Calculates the intersection between a circle and a line.
- *
- * @param c Center of the circle.
- * @param r Radius of the circle.
- * @param a Start point of the line.
- * @param b End point of the line.
- * @param p Intersection.
- *
- * @return True if the circle and the line intersect, false otherwise.
- */
-bool collisionCircleLine(const glm::vec2& c, float r, const glm::vec2& a, const glm::vec2& b, glm::vec2& p);
-
-} // namespace
 
 Ball::Ball(const glm::vec2& position, const float radius)
     :
     Entity       (Type::Ball),
-    mPosition    (position),
-    mPositionPrev(position),
+    mPosition    (toVector(position)),
+    mPositionPrev(toVector(position)),
     mRadius      (radius),
-    mSpeed       (100.0f, 0.0f)
+    mSpeed       (Scalar(100), Scalar(0))
 {}
 
 void Ball::reset(const glm::vec2& position, const float speed)
 {
-    mPosition     = position;
-    mPositionPrev = position;
-    mSpeed        = glm::vec2(speed, 0.0f);
+    mPosition     = toVector(position);
+    mPositionPrev = toVector(position);
+    mSpeed        = Vector(Scalar(speed), Scalar(0));
     mPoint        = Point::None;
+    markChanged();
+}
+
+void Ball::reset(const glm::vec2& position, const glm::vec2& speed)
+{
+    mPosition     = toVector(position);
+    mPositionPrev = toVector(position);
+    mSpeed        = toVector(speed);
+    mPoint        = Point::None;
+    markChanged();
 }
 
 void Ball::setup(const Table& table, const Paddle& paddleA, const Paddle& paddleB)
 {
-    mTable   = &table;
-    mPaddleA = &paddleA;
-    mPaddleB = &paddleB;
+    mTable   = Handle<Table> (table.id());
+    mPaddleA = Handle<Paddle>(paddleA.id());
+    mPaddleB = Handle<Paddle>(paddleB.id());
+}
+
+void Ball::snapshot(BallSnapshot& snapshot) const
+{
+    snapshot.position          = mPosition;
+    snapshot.positionPrev      = mPositionPrev;
+    snapshot.speed             = mSpeed;
+    snapshot.point             = static_cast<std::uint8_t>(mPoint);
+    snapshot.collisionOccurred = mCollisionOccurred ? 1 : 0;
+}
+
+void Ball::restore(const BallSnapshot& snapshot)
+{
+    mPosition          = snapshot.position;
+    mPositionPrev      = snapshot.positionPrev;
+    mSpeed             = snapshot.speed;
+    mPoint             = static_cast<Point>(snapshot.point);
+    mCollisionOccurred = snapshot.collisionOccurred != 0;
+    markChanged();
 }
 
 void Ball::handle(const Event& event)
@@ -81,100 +95,180 @@ void Ball::handle(const Event& event)
     if (event.is(Event::Type::Pause))
     {
         mPositionPrev = mPosition;
+        markChanged();
     }
 }
 
 void Ball::update(const TimeDuration dt)
 {
-    if (!mTable || !mPaddleA || !mPaddleB)
+    // Find the table and the paddles, which may no longer exist.
+    const Scene*  scene   = this->scene();
+    const Table*  table   = scene ? scene->get(mTable)   : nullptr;
+    const Paddle* paddleA = scene ? scene->get(mPaddleA) : nullptr;
+    const Paddle* paddleB = scene ? scene->get(mPaddleB) : nullptr;
+    if (!table || !paddleA || !paddleB)
     {
         return;
     }
-    // Reset the collision state and update the position.
+    // Keep the drawn state, to know whether the frames change.
+    const Vector position = mPosition;
+    const Vector previous = mPositionPrev;
+    const Point  point    = mPoint;
+    // Reset the collision state.
     mCollisionOccurred = false;
     mPositionPrev = mPosition;
-    mPosition = mPosition + mSpeed * static_cast<float>(dt.count());
-    // Check for collisions with the top and bottom boundaries of the table.
-    checkWallCollisions();
-    // Check for collisions (scores) with the left and right boundaries of the table.
-    checkScore();
-    // Check for collisions with the paddles.
-    checkPaddleCollisions();
-    // Play the collision sound if there was a collision.
-    if (mCollisionOccurred)
+
+    if (mCollisionMode == physics::CollisionMode::Swept)
+    {
+        updateSwept(*table, *paddleA, *paddleB, static_cast<float>(dt.count()));
+    }
+    else
     {
-        scene()->game().audio().play();
+        // Update the position.
+        mPosition = mPosition + mSpeed * Scalar(dt.count());
+        // Check for collisions with the top and bottom boundaries of the table.
+        checkWallCollisions(*table);
+        // Check for collisions (scores) with the left and right boundaries of the table.
+        checkScore(*table);
+        // Check for collisions with the paddles.
+        checkPaddleCollisions(*paddleA, *paddleB);
+    }
+
+    if (mPosition != position || mPositionPrev != previous || mPoint != point)
+    {
+        markChanged();
     }
 }
 
-void Ball::checkWallCollisions()
+void Ball::emit(const GameplayEvent::Type type, const int player, const float offset) const
 {
-    if (top() > mTable->top())
+    if (Scene* scene = this->scene())
     {
-        mPosition.y = mTable->top() - mRadius;
-        mSpeed.y *= -1.0f;
+        GameplayEvent event;
+        event.type     = type;
+        event.player   = static_cast<std::uint8_t>(player);
+        event.offset   = offset;
+        event.position = toVec2(mPosition);
+        scene->game().events().push(event);
+    }
+}
+
+void Ball::checkWallCollisions(const Table& table)
+{
+    if (top() > table.top())
+    {
+        mPosition.y = table.top() - mRadius;
+        mSpeed.y = -mSpeed.y;
         mCollisionOccurred = true;
+        emit(GameplayEvent::Type::WallHit);
     }
 
-    if (bottom() < mTable->bottom())
+    if (bottom() < table.bottom())
     {
-        mPosition.y = mTable->bottom() + mRadius;
-        mSpeed.y *= -1.0f;
+        mPosition.y = table.bottom() + mRadius;
+        mSpeed.y = -mSpeed.y;
         mCollisionOccurred = true;
+        emit(GameplayEvent::Type::WallHit);
     }
 }
 
-void Ball::checkScore()
+void Ball::checkScore(const Table& table)
 {
-    if (right() > mTable->right())
+    if (right() > table.right())
     {
         mPoint = Point::B;
     }
 
-    if (left() < mTable->left ())
+    if (left() < table.left ())
     {
         mPoint = Point::A;
     }
 }
 
-void Ball::checkPaddleCollisions()
+void Ball::checkPaddleCollisions(const Paddle& paddleA, const Paddle& paddleB)
 {
-    // Check for collisions with the paddles.
-    glm::vec2 pos;
-    const bool ca = collision(*this, *mPaddleA, pos);
-    const bool cb = collision(*this, *mPaddleB, pos);
+    // Check for collisions with the paddles, only the ones near the ball if there is a grid.
+    const unsigned int near = mGrid ? mGrid->paddles(mPosition) : BallGrid::PaddleA | BallGrid::PaddleB;
+    Vector             pos;
+    const bool ca = (near & BallGrid::PaddleA) != 0 && collision(*this, paddleA, pos);
+    const bool cb = (near & BallGrid::PaddleB) != 0 && collision(*this, paddleB, pos);
     // If there was a collision with the paddles.
     if (!ca && !cb)
     {
         return;
     }
 
-    float       rDist = 0.0f; // Relative distance.
-    float       speed = glm::length(mSpeed);
-    const float sign  = glm::sign(mSpeed.x);
-    // There was a collision, so play the collision sound.
+    Scalar rDist = Scalar(0); // Relative distance.
+    // There was a collision.
     mCollisionOccurred = true;
     // Collision with paddle A.
     if (ca)
     {
-        mPosition.x = mPaddleA->position().x - mPaddleA->size().x * 0.5f - mRadius;
+        mPosition.x = paddleA.position().x - paddleA.size().x * Scalar(0.5f) - mRadius;
         // Calculate the position of the collision relative to the center of the paddle A.
-        rDist = (pos.y - mPaddleA->position().y) / (mPaddleA->size().y * 0.5f);
+        rDist = (pos.y - paddleA.position().y) / (paddleA.size().y * Scalar(0.5f));
     }
     // Collision with paddle B.
     if (cb)
     {
-        mPosition.x = mPaddleB->position().x + mPaddleB->size().x * 0.5f + mRadius;
+        mPosition.x = paddleB.position().x + paddleB.size().x * Scalar(0.5f) + mRadius;
         // Calculate the position of the collision relative to the center of the paddle B.
-        rDist = (pos.y - mPaddleB->position().y) / (mPaddleB->size().y * 0.5f);
+        rDist = (pos.y - paddleB.position().y) / (paddleB.size().y * Scalar(0.5f));
     }
-    // Increment the speed regarding the position of the collision (near the center, the speed is reduced; near the end
-    // of the paddle, the speed is increased).
-    speed += 25.0f * ((3.0f * glm::abs(rDist) - 1) * (2.0f - glm::abs(rDist)) * 0.5f);
-    // Clamp the speed between its minimum and maximum values.
-    speed = glm::min(MaxSpeed, glm::max(MinSpeed, speed));
     // Calculate the new speed vector.
-    mSpeed = -speed * glm::rotate(glm::vec2(sign, 0.0f), -sign * MaxBounceAngle * rDist);
+    mSpeed = physics::bounce(mSpeed, rDist);
+    // Record the hit, with the paddle B if the ball touched both.
+    emit(GameplayEvent::Type::PaddleHit, cb ? 1 : 0, toFloat(rDist));
+}
+
+void Ball::updateSwept(const Table& table, const Paddle& paddleA, const Paddle& paddleB, const float dt)
+{
+    // The sweep is calculated in floating point, also with `PONG_FIXED_POINT`.
+    const physics::SweptTable walls = {toFloat(table.top()), toFloat(table.bottom()), toFloat(table.left()), toFloat(table.right())};
+
+    physics::SweptBall   ball   = {toVec2(mPosition), toVec2(mSpeed), toFloat(mRadius), 0.0};
+    physics::SweptPaddle sweptA = sweptPaddle(paddleA, table, dt);
+    physics::SweptPaddle sweptB = sweptPaddle(paddleB, table, dt);
+    // Move the ball through the whole time step, with as many bounces as the sweep resolves.
+    const physics::SweepResult result = physics::sweep(ball, sweptA, sweptB, walls, dt);
+    if (result.overflow)
+    {
+        physics::settle(ball, sweptA, sweptB, walls, result, dt);
+    }
+
+    mPosition = toVector(physics::positionAt(ball, result.pointA || result.pointB ? result.time : dt));
+    mSpeed    = toVector(ball.speed);
+
+    if (result.pointA) { mPoint = Point::A; }
+    if (result.pointB) { mPoint = Point::B; }
+
+    mCollisionOccurred = result.walls > 0 || result.paddles > 0;
+    // Record the hits, all of them at the end position of the ball and with the contact of the last paddle hit.
+    for (int i = 0; i < result.walls; ++i)
+    {
+        emit(GameplayEvent::Type::WallHit);
+    }
+
+    for (int i = 0; i < result.paddles; ++i)
+    {
+        emit(GameplayEvent::Type::PaddleHit, result.paddle, result.offset);
+    }
+}
+
+physics::SweptPaddle Ball::sweptPaddle(const Paddle& paddle, const Table& table, const float dt)
+{
+    const glm::vec2 half     = toVec2(paddle.size()) * 0.5f;
+    const glm::vec2 previous = toVec2(paddle.previousPosition());
+    const float     dy       = toFloat(paddle.position().y) - previous.y;
+    const float     bottom   = toFloat(table.bottom());
+    const float     top      = toFloat(table.top());
+
+    return {previous, half, dt > 0.0f ? dy / dt : 0.0f, bottom + half.y, top - half.y, 0.0};
+}
+
+bool Ball::animated() const noexcept
+{
+    return mPoint == Point::None && mPosition != mPositionPrev;
 }
 
 void Ball::draw(Renderer& renderer, const float interp)
@@ -184,71 +278,41 @@ void Ball::draw(Renderer& renderer, const float interp)
         return;
     }
 
-    renderer.queueQuad(mPosition * interp + mPositionPrev * (1.0f - interp), glm::vec2(mRadius * 2.0f));
+    renderer.queueQuad(toVec2(mPosition) * interp + toVec2(mPositionPrev) * (1.0f - interp), glm::vec2(toFloat(mRadius) * 2.0f));
 }
 
-bool Ball::collision(const Ball& ball, const Paddle& paddle, glm::vec2& where)
+bool Ball::collision(const Ball& ball, const Paddle& paddle, Vector& where)
 {
-    // Add the ball radius to the paddle radius.
-    const float radii = glm::length(paddle.size() * 0.5f) + ball.radius();
-    // Check if the paddle is close enough to collide with the ball. This calculation is faster than circle/segment
-    // intersection and if there is a collision, it is limited to the segment of the paddle.
-    if (glm::length2(paddle.position() - ball.position()) > (radii * radii))
+    return physics::collisionBallPaddle(ball.position(), ball.radius(), paddle.position(), paddle.size(), where);
+}
+
+bool Ball::collide(Ball& a, Ball& b)
+{
+    if (a.mPoint != Point::None || b.mPoint != Point::None)
     {
         return false;
     }
-    // Calculate the intersection between the ball and the paddle front line.
-    if (collisionCircleLine(ball.position(), ball.radius(),
-            {paddle.position().x - paddle.size().x * 0.5f, paddle.position().y - paddle.size().y * 0.5f},
-            {paddle.position().x - paddle.size().x * 0.5f, paddle.position().y + paddle.size().y * 0.5f},
-            where))
+    // Check if the balls overlap.
+    const Vector d     = b.mPosition - a.mPosition;
+    const Scalar dist2 = d.x * d.x + d.y * d.y;
+    const Scalar radii = a.mRadius + b.mRadius;
+    if (dist2 >= radii * radii || dist2 == Scalar(0))
     {
-        return true;
+        return false;
     }
-    // Calculate the intersection between the ball and the paddle back line.
-    if (collisionCircleLine(ball.position(), ball.radius(),
-            {paddle.position().x + paddle.size().x * 0.5f, paddle.position().y - paddle.size().y * 0.5f},
-            {paddle.position().x + paddle.size().x * 0.5f, paddle.position().y + paddle.size().y * 0.5f},
-            where))
+    // Check if they approach each other, otherwise they are already separating after a previous collision.
+    const Vector v        = a.mSpeed - b.mSpeed;
+    const Scalar approach = v.x * d.x + v.y * d.y;
+    if (approach <= Scalar(0))
     {
-        return true;
+        return false;
     }
-    // No collision.
-    return false;
-}
-
-namespace {
+    // Exchange the components of the speeds along the line between the centers.
+    const Vector impulse = d * (approach / dist2);
+    a.mSpeed = a.mSpeed - impulse;
+    b.mSpeed = b.mSpeed + impulse;
 
-bool collisionCircleLine(const glm::vec2& c, const float r, const glm::vec2& a, const glm::vec2& b, glm::vec2& p)
-{
-    const glm::vec2 ac = c - a;
-    const glm::vec2 ab = b - a;
-    // Calculate the square length of the vectors and dot product.
-    const float dot    = glm::dot(ac, ab);
-    const float len2AC = glm::length2(ac);
-    const float len2AB = glm::length2(ab);
-    // Calculate the discriminant.
-    const float discriminant = dot * dot - len2AB * (len2AC - (r * r));
-    // If the discriminant is greater than or equal to zero, we have real solutions (there is an intersection).
-    if (discriminant >= 0)
-    {
-        const float sqrt = glm::sqrt(discriminant);
-        const float inv  = 1.0f / len2AB;
-        const float r0   = glm::pow(-dot + sqrt, 2.0f) * inv * inv;
-        const float r1   = glm::pow(-dot - sqrt, 2.0f) * inv * inv;
-        // Check if the solutions are onto the segment.
-        if ((r0 >= 0 && r0 <= 1) || (r1 >= 0 && r1 <= 1))
-        {
-            // For this case, the exact intersection points are not needed, so the nearest point to the center
-            // of the ball is calculated (projection of the vector ac onto ab).
-            p = a + ab * dot * inv;
-            // Done.
-            return true;
-        }
-    }
-    // No intersection.
-    return false;
+    return true;
 }
 
-} // namespace
 } // namespace pong
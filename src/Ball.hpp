@@ -25,12 +25,17 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "GameplayEvents.hpp"
+#include "Scalar.hpp"
+#include "SweptCollision.hpp"
 #include <glm/glm.hpp>
 
 namespace pong {
 
 class Table;
 class Paddle;
+class BallGrid;
+struct BallSnapshot;
 
 /**
  * @brief Represents the game ball, handling its physics, collisions, and scoring logic.
@@ -38,19 +43,11 @@ class Paddle;
  * The Ball is the central dynamic entity in the game. It moves autonomously and interacts with the paddles and table
  * boundaries. It requires being linked to the Table and Paddles via the `setup()` method after its construction to
  * function correctly. The class encapsulates all physics calculations, including complex angular bounces off the
- * paddles.
+ * paddles. With `PONG_FIXED_POINT` the state and the discrete collisions use fixed point, so a match is bit-exact on
+ * every compiler and optimization level.
  */
 class Ball final : public Entity
 {
-    /** @brief Maximum angle (in radians) for a bounce off a paddle. */
-    static constexpr float MaxBounceAngle = glm::radians(55.0f);
-
-    /** @brief Minimum speed of the ball. */
-    static constexpr float MinSpeed = 100.0f;
-
-    /** @brief Maximum speed of the ball. */
-    static constexpr float MaxSpeed = 180.0f;
-
     /** @brief Defines which player (if any) scored a point on the last update. */
     enum class Point
     {
@@ -72,39 +69,39 @@ public:
      * @brief Gets the current position of the ball.
      * @return Position.
      */
-    [[nodiscard]] const glm::vec2& position() const { return mPosition; }
+    [[nodiscard]] const Vector& position() const { return mPosition; }
 
     /**
      * @brief Gets the radius of the ball (size).
      * @return Radius.
      */
-    [[nodiscard]] float radius() const { return mRadius; }
+    [[nodiscard]] Scalar radius() const { return mRadius; }
 
     /**
      * @return X-coordinate of the left side of the ball.
      */
-    [[nodiscard]] float left() const { return mPosition.x - mRadius; }
+    [[nodiscard]] Scalar left() const { return mPosition.x - mRadius; }
 
     /**
      * @return X-coordinate of the right side of the ball.
      */
-    [[nodiscard]] float right() const { return mPosition.x + mRadius; }
+    [[nodiscard]] Scalar right() const { return mPosition.x + mRadius; }
 
     /**
      * @return Y-coordinate of the top of the ball.
      */
-    [[nodiscard]] float top() const { return mPosition.y + mRadius; }
+    [[nodiscard]] Scalar top() const { return mPosition.y + mRadius; }
 
     /**
      * @return Y-coordinate of the bottom of the ball.
      */
-    [[nodiscard]] float bottom() const { return mPosition.y - mRadius; }
+    [[nodiscard]] Scalar bottom() const { return mPosition.y - mRadius; }
 
     /**
      * @brief Gets current speed of the ball.
      * @return Speed.
      */
-    [[nodiscard]] const glm::vec2& speed() const { return mSpeed; }
+    [[nodiscard]] const Vector& speed() const { return mSpeed; }
 
     /**
      * @brief Checks if a point was scored in the last frame.
@@ -124,6 +121,21 @@ public:
      */
     [[nodiscard]] bool pointPaddleB() const { return mPoint == Point::B; }
 
+    /**
+     * @brief Gets the collision detection mode.
+     * @return Collision detection mode.
+     */
+    [[nodiscard]] physics::CollisionMode collisionMode() const { return mCollisionMode; }
+
+    /**
+     * @brief Sets the collision detection mode.
+     *
+     * The discrete mode is the classic one, it is only accurate with the fixed time step of the game. The swept mode
+     * finds the exact time of every collision, so the ball can be updated with much larger time steps.
+     * @param mode Collision detection mode.
+     */
+    void setCollisionMode(const physics::CollisionMode mode) { mCollisionMode = mode; }
+
     /**
      * @brief Resets the ball's state for a new round.
      *
@@ -133,30 +145,102 @@ public:
      */
     void reset(const glm::vec2& position, float speed);
 
+    /**
+     * @brief Resets the ball's state with any direction, for the extra balls of multi-ball matches.
+     * @param position The new starting position.
+     * @param speed The new starting speed.
+     */
+    void reset(const glm::vec2& position, const glm::vec2& speed);
+
     /**
      * @brief Links the ball to its external gameplay dependencies.
+     *
+     * The ball refers to them by their handles, so they must be in the scene of the ball. The ball stops if any of them
+     * is destroyed.
      * @param table A reference to the game table.
      * @param paddleA A reference to paddle A.
      * @param paddleB A reference to paddle B.
      */
     void setup(const Table& table, const Paddle& paddleA, const Paddle& paddleB);
 
+    /**
+     * @brief Sets the grid of a multi-ball match, the ball only tests the paddles near it according to the grid.
+     * @param grid Grid, null to test both paddles.
+     */
+    void setGrid(const BallGrid* grid) noexcept { mGrid = grid; }
+
+    /**
+     * @brief Saves the state of the ball (see `Game::snapshot()`).
+     * @param snapshot Snapshot to fill.
+     */
+    void snapshot(BallSnapshot& snapshot) const;
+
+    /**
+     * @brief Restores the state of the ball.
+     * @param snapshot Snapshot.
+     */
+    void restore(const BallSnapshot& snapshot);
+
     void handle(const Event& event) override;
 
     void update(TimeDuration dt) override;
 
     void draw(Renderer& renderer, float interp) override;
 
+    /**
+     * @brief Checks whether the ball moved in the last update, so its drawing depends on the interpolation.
+     * @return True if the ball is animated, false otherwise.
+     */
+    [[nodiscard]] bool animated() const noexcept override;
+
 private:
 
-    /** @brief Checks for and resolves collisions with the top and bottom walls. */
-    void checkWallCollisions();
+    /**
+     * @brief Checks for and resolves collisions with the top and bottom walls.
+     * @param table The table.
+     */
+    void checkWallCollisions(const Table& table);
 
-    /** @brief Checks if the ball has passed the left or right boundaries, triggering a score. */
-    void checkScore();
+    /**
+     * @brief Checks if the ball has passed the left or right boundaries, triggering a score.
+     * @param table The table.
+     */
+    void checkScore(const Table& table);
 
-    /** @brief Checks for and resolves collisions with both paddles, calculating new bounce physics. */
-    void checkPaddleCollisions();
+    /**
+     * @brief Checks for and resolves collisions with both paddles, calculating new bounce physics.
+     * @param paddleA Paddle A.
+     * @param paddleB Paddle B.
+     */
+    void checkPaddleCollisions(const Paddle& paddleA, const Paddle& paddleB);
+
+    /**
+     * @brief Moves the ball with continuous collision detection, resolving all the collisions in the time step.
+     * @param table The table.
+     * @param paddleA Paddle A.
+     * @param paddleB Paddle B.
+     * @param dt The time elapsed since the last update, in seconds.
+     */
+    void updateSwept(const Table& table, const Paddle& paddleA, const Paddle& paddleB, float dt);
+
+    /**
+     * @brief Gets the state of a paddle for a sweep.
+     *
+     * The paddles are updated before the ball, so they are swept from their previous position at constant speed.
+     * @param paddle Paddle.
+     * @param table The table.
+     * @param dt The time elapsed since the last update, in seconds.
+     * @return State of the paddle.
+     */
+    [[nodiscard]] static physics::SweptPaddle sweptPaddle(const Paddle& paddle, const Table& table, float dt);
+
+    /**
+     * @brief Records a gameplay event at the position of the ball in its game, if the ball is in a scene.
+     * @param type Type of event.
+     * @param player Paddle hit, paddle (0 for A, 1 for B).
+     * @param offset Paddle hit, position of the contact relative to the center of the paddle.
+     */
+    void emit(GameplayEvent::Type type, int player = 0, float offset = 0.0f) const;
 
 public:
 
@@ -169,33 +253,50 @@ public:
      *
      * @return True if the ball and the paddle collide, false otherwise.
      */
-    static bool collision(const Ball& ball, const Paddle& paddle, glm::vec2& where);
+    static bool collision(const Ball& ball, const Paddle& paddle, Vector& where);
+
+    /**
+     * @brief Resolves a collision between two balls.
+     *
+     * If the balls overlap and approach each other, they exchange the components of their speeds along the line
+     * between their centers (an elastic collision of equal masses). The balls that scored a point are ignored.
+     * @param a A ball.
+     * @param b Another ball.
+     * @return True if the balls collided, false otherwise.
+     */
+    static bool collide(Ball& a, Ball& b);
 
 private:
 
     /** @brief Current center position of the ball. */
-    glm::vec2 mPosition;
+    Vector mPosition;
 
     /** @brief Position in the previous frame, for interpolation. */
-    glm::vec2 mPositionPrev;
+    Vector mPositionPrev;
 
     /** @brief Radius (size). */
-    float mRadius = 1.0f;
+    Scalar mRadius = Scalar(1);
 
     /** @brief The current velocity vector of the ball. */
-    glm::vec2 mSpeed;
+    Vector mSpeed;
 
     /** @brief The scoring state from the last update. */
     Point mPoint = Point::None;
 
-    /** @brief Identifier of the table. */
-    const Table* mTable = nullptr;
+    /** @brief Collision detection mode. */
+    physics::CollisionMode mCollisionMode = physics::CollisionMode::Discrete;
+
+    /** @brief Handle of the table. */
+    Handle<Table> mTable;
+
+    /** @brief Handle of the paddle A. */
+    Handle<Paddle> mPaddleA;
 
-    /** @brief Identifier of the paddle A. */
-    const Paddle* mPaddleA = nullptr;
+    /** @brief Handle of the paddle B. */
+    Handle<Paddle> mPaddleB;
 
-    /** @brief Identifier of the paddle B. */
-    const Paddle* mPaddleB = nullptr;
+    /** @brief Grid of the multi-ball match, null in normal matches. */
+    const BallGrid* mGrid = nullptr;
 
     /** @brief Flag indicating if there was a collision or not. */
     bool mCollisionOccurred = false;
@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "BallGrid.hpp"
+#include "Ball.hpp"
+#include "Paddle.hpp"
+#include "Table.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace pong {
+
+BallGrid::BallGrid(const Table& table, const Paddle& paddleA, const Paddle& paddleB, const float cellSize)
+    : mPaddleA(paddleA)
+    , mPaddleB(paddleB)
+    , mOrigin(toFloat(table.left()), toFloat(table.bottom()))
+    , mCellSize(cellSize)
+    , mInvCellSize(1.0f / cellSize)
+{
+    const float width  = toFloat(table.right()) - mOrigin.x;
+    const float height = toFloat(table.top())   - mOrigin.y;
+
+    mColumns = std::max(1, static_cast<std::int32_t>(std::ceil(width  * mInvCellSize)));
+    mRows    = std::max(1, static_cast<std::int32_t>(std::ceil(height * mInvCellSize)));
+    mHead.assign(static_cast<std::size_t>(mColumns) * static_cast<std::size_t>(mRows), -1);
+
+    mReachA = reach(mPaddleA);
+    mReachB = reach(mPaddleB);
+}
+
+void BallGrid::insert(Ball& ball)
+{
+    const std::size_t i = mBalls.size();
+    mBalls.push_back(&ball);
+    mCell.push_back(0);
+    mNext.push_back(-1);
+    mPrev.push_back(-1);
+    link(i, cell(ball.position()));
+    // The reach of the paddles depends on the radius of the balls.
+    if (toFloat(ball.radius()) > mRadius)
+    {
+        mRadius = toFloat(ball.radius());
+        mReachA = reach(mPaddleA);
+        mReachB = reach(mPaddleB);
+    }
+}
+
+void BallGrid::clear() noexcept
+{
+    std::fill(mHead.begin(), mHead.end(), -1);
+    mBalls.clear();
+    mCell.clear();
+    mNext.clear();
+    mPrev.clear();
+    mRadius = 0.0f;
+}
+
+void BallGrid::update()
+{
+    for (std::size_t i = 0; i < mBalls.size(); ++i)
+    {
+        const std::int32_t next = cell(mBalls[i]->position());
+        if (next != mCell[i])
+        {
+            unlink(i);
+            link(i, next);
+        }
+    }
+
+    mReachA = reach(mPaddleA);
+    mReachB = reach(mPaddleB);
+}
+
+unsigned int BallGrid::paddles(const Vector& position) const noexcept
+{
+    const std::int32_t x = column(toFloat(position.x));
+    const std::int32_t y = row   (toFloat(position.y));
+
+    unsigned int mask = 0;
+    if (x >= mReachA.column0 && x <= mReachA.column1 && y >= mReachA.row0 && y <= mReachA.row1) { mask |= PaddleA; }
+    if (x >= mReachB.column0 && x <= mReachB.column1 && y >= mReachB.row0 && y <= mReachB.row1) { mask |= PaddleB; }
+
+    return mask;
+}
+
+std::size_t BallGrid::collide() const
+{
+    std::size_t collisions = 0;
+    forEachPair([&collisions](Ball& a, Ball& b) { collisions += Ball::collide(a, b) ? 1 : 0; });
+
+    return collisions;
+}
+
+std::int32_t BallGrid::column(const float x) const noexcept
+{
+    const float value = std::floor((x - mOrigin.x) * mInvCellSize);
+    return static_cast<std::int32_t>(std::clamp(value, 0.0f, static_cast<float>(mColumns - 1)));
+}
+
+std::int32_t BallGrid::row(const float y) const noexcept
+{
+    const float value = std::floor((y - mOrigin.y) * mInvCellSize);
+    return static_cast<std::int32_t>(std::clamp(value, 0.0f, static_cast<float>(mRows - 1)));
+}
+
+std::int32_t BallGrid::cell(const Vector& position) const noexcept
+{
+    return row(toFloat(position.y)) * mColumns + column(toFloat(position.x));
+}
+
+void BallGrid::link(const std::size_t i, const std::int32_t cell) noexcept
+{
+    auto& head = mHead[static_cast<std::size_t>(cell)];
+
+    mCell[i] = cell;
+    mPrev[i] = -1;
+    mNext[i] = head;
+    if (head >= 0)
+    {
+        mPrev[static_cast<std::size_t>(head)] = static_cast<std::int32_t>(i);
+    }
+    head = static_cast<std::int32_t>(i);
+}
+
+void BallGrid::unlink(const std::size_t i) noexcept
+{
+    const std::int32_t prev = mPrev[i];
+    const std::int32_t next = mNext[i];
+
+    if (prev >= 0) { mNext[static_cast<std::size_t>(prev)] = next; }
+    else           { mHead[static_cast<std::size_t>(mCell[i])] = next; }
+
+    if (next >= 0) { mPrev[static_cast<std::size_t>(next)] = prev; }
+}
+
+BallGrid::CellRange BallGrid::reach(const Paddle& paddle) const noexcept
+{
+    // A ball is only tested against a paddle when its center is within the bounding circle of the paddle plus its
+    // radius (see `physics::collisionBallPaddle()`). The paddle moves less than a cell per tick, so one more cell
+    // covers its movement until the next update.
+    const glm::vec2 center = toVec2(paddle.position());
+    const float     extent = glm::length(toVec2(paddle.size()) * 0.5f) + mRadius + mCellSize;
+
+    return {column(center.x - extent), column(center.x + extent), row(center.y - extent), row(center.y + extent)};
+}
+
+} // namespace pong
@@ -0,0 +1,253 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Scalar.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace pong {
+
+class Ball;
+class Paddle;
+class Table;
+
+/**
+ * @brief Uniform grid over the table that finds the balls and paddles that may collide in a multi-ball match.
+ *
+ * The table is divided in square cells at least as large as the diameter of the balls, so two balls can only collide
+ * if they are in the same cell or in neighbor cells; the balls out of the table are kept in the cells of its edges.
+ * Every cell has a linked list of its balls, stored in arrays indexed by ball, and `update()` only relinks the balls
+ * that moved to another cell since the previous tick, so rebuilding the grid costs a few operations per ball.
+ *
+ * The paddles are not linked: the grid keeps the range of cells that each one can reach within a tick (its bounding
+ * circle plus a cell), and the balls only test the paddles whose range contains their cell.
+ */
+class BallGrid
+{
+public:
+
+    /** @brief Bit of paddle A in the masks of candidate paddles. */
+    static constexpr unsigned int PaddleA = 1;
+
+    /** @brief Bit of paddle B in the masks of candidate paddles. */
+    static constexpr unsigned int PaddleB = 2;
+
+    /**
+     * @brief Constructor.
+     * @param table Table, the grid covers its bounds.
+     * @param paddleA Paddle of player A.
+     * @param paddleB Paddle of player B.
+     * @param cellSize Size of the cells, it must be at least the diameter of the largest ball.
+     */
+    BallGrid(const Table& table, const Paddle& paddleA, const Paddle& paddleB, float cellSize);
+
+    /**
+     * @brief Gets the number of balls in the grid.
+     * @return Number of balls.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mBalls.size(); }
+
+    /**
+     * @brief Gets a ball.
+     * @param i Index of the ball, in the order they were inserted.
+     * @return Ball.
+     */
+    [[nodiscard]] Ball& ball(const std::size_t i) const noexcept { return *mBalls[i]; }
+
+    /**
+     * @brief Adds a ball, it must outlive the grid (or be removed with `clear()`).
+     * @param ball Ball.
+     */
+    void insert(Ball& ball);
+
+    /**
+     * @brief Removes all the balls.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Moves the balls that changed of cell and the ranges of the paddles to their current positions.
+     *
+     * It must be called after the balls and the paddles are updated, before looking for collisions.
+     */
+    void update();
+
+    /**
+     * @brief Gets the paddles that may collide with a ball at a position during the next tick.
+     * @param position Position of the ball.
+     * @return Mask of candidate paddles (`PaddleA` and `PaddleB`).
+     */
+    [[nodiscard]] unsigned int paddles(const Vector& position) const noexcept;
+
+    /**
+     * @brief Calls a function for every pair of balls in the same cell or in neighbor cells.
+     *
+     * Every pair is visited once: each ball is paired with the next balls of its cell and with the balls of the four
+     * neighbor cells to its right and above.
+     * @param function Function, it receives the two balls.
+     */
+    template<typename F>
+    void forEachPair(F&& function) const
+    {
+        for (std::size_t i = 0; i < mBalls.size(); ++i)
+        {
+            const std::int32_t cell   = mCell[i];
+            const std::int32_t column = cell % mColumns;
+            const std::int32_t row    = cell / mColumns;
+            // The next balls of the same cell.
+            for (std::int32_t j = mNext[i]; j >= 0; j = mNext[static_cast<std::size_t>(j)])
+            {
+                function(*mBalls[i], *mBalls[static_cast<std::size_t>(j)]);
+            }
+            // The balls of the neighbor cells on the right and above.
+            for (const auto& [dx, dy] : ForwardNeighbors)
+            {
+                const std::int32_t x = column + dx;
+                const std::int32_t y = row    + dy;
+                if (x < 0 || x >= mColumns || y >= mRows)
+                {
+                    continue;
+                }
+
+                for (std::int32_t j = mHead[static_cast<std::size_t>(y * mColumns + x)]; j >= 0; j = mNext[static_cast<std::size_t>(j)])
+                {
+                    function(*mBalls[i], *mBalls[static_cast<std::size_t>(j)]);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Resolves the collisions between the balls (see `Ball::collide()`).
+     * @return Number of collisions.
+     */
+    std::size_t collide() const;
+
+private:
+
+    /** @brief Defines the range of cells a paddle can reach. */
+    struct CellRange
+    {
+        std::int32_t column0 = 0;
+        std::int32_t column1 = -1;
+        std::int32_t row0    = 0;
+        std::int32_t row1    = -1;
+    };
+
+    /** @brief Offsets of the neighbor cells paired with a cell, half of the eight neighbors. */
+    static constexpr std::int32_t ForwardNeighbors[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
+    /**
+     * @brief Gets the column of a coordinate, clamped to the grid.
+     * @param x Coordinate.
+     * @return Column.
+     */
+    [[nodiscard]] std::int32_t column(float x) const noexcept;
+
+    /**
+     * @brief Gets the row of a coordinate, clamped to the grid.
+     * @param y Coordinate.
+     * @return Row.
+     */
+    [[nodiscard]] std::int32_t row(float y) const noexcept;
+
+    /**
+     * @brief Gets the cell of a position, clamped to the grid.
+     * @param position Position.
+     * @return Index of the cell.
+     */
+    [[nodiscard]] std::int32_t cell(const Vector& position) const noexcept;
+
+    /**
+     * @brief Links a ball to the list of a cell.
+     * @param i Index of the ball.
+     * @param cell Index of the cell.
+     */
+    void link(std::size_t i, std::int32_t cell) noexcept;
+
+    /**
+     * @brief Unlinks a ball from the list of its cell.
+     * @param i Index of the ball.
+     */
+    void unlink(std::size_t i) noexcept;
+
+    /**
+     * @brief Calculates the range of cells a paddle can reach.
+     * @param paddle Paddle.
+     * @return Range.
+     */
+    [[nodiscard]] CellRange reach(const Paddle& paddle) const noexcept;
+
+private:
+
+    /** @brief Paddle of player A. */
+    const Paddle& mPaddleA;
+
+    /** @brief Paddle of player B. */
+    const Paddle& mPaddleB;
+
+    /** @brief Corner of the grid with the lowest coordinates. */
+    glm::vec2 mOrigin{0.0f};
+
+    /** @brief Size of the cells. */
+    float mCellSize = 1.0f;
+
+    /** @brief Inverse of the size of the cells. */
+    float mInvCellSize = 1.0f;
+
+    /** @brief Number of columns. */
+    std::int32_t mColumns = 1;
+
+    /** @brief Number of rows. */
+    std::int32_t mRows = 1;
+
+    /** @brief Radius of the largest ball. */
+    float mRadius = 0.0f;
+
+    /** @brief First ball of every cell, -1 if it is empty. */
+    std::vector<std::int32_t> mHead;
+
+    /** @brief Balls. */
+    std::vector<Ball*> mBalls;
+
+    /** @brief Cell of every ball. */
+    std::vector<std::int32_t> mCell;
+
+    /** @brief Next ball in the cell of every ball, -1 for none. */
+    std::vector<std::int32_t> mNext;
+
+    /** @brief Previous ball in the cell of every ball, -1 for none. */
+    std::vector<std::int32_t> mPrev;
+
+    /** @brief Range of cells paddle A can reach. */
+    CellRange mReachA;
+
+    /** @brief Range of cells paddle B can reach. */
+    CellRange mReachB;
+};
+
+} // namespace pong
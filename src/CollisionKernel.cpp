@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "CollisionKernel.hpp"
+#include "Physics.hpp"
+#include <algorithm>
+#include <bit>
+#if defined(PONG_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+#if defined(PONG_SIMD_AVX2) && defined(_MSC_VER)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace pong::physics {
+namespace               {
+
+/**
+ * @brief Checks if the running CPU supports AVX2 (and the operating system saves the AVX registers).
+ * @return True if AVX2 can be used, false otherwise.
+ */
+bool cpuSupportsAVX2() noexcept
+{
+#if defined(PONG_SIMD_AVX2)
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        // OSXSAVE and AVX, and the XMM and YMM state enabled by the operating system.
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 0x6) != 0x6)
+        {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+    #else
+        return __builtin_cpu_supports("avx2");
+    #endif
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+SimdLevel detectSimdLevel() noexcept
+{
+    static const SimdLevel level = []
+    {
+        if (cpuSupportsAVX2())
+        {
+            return SimdLevel::AVX2;
+        }
+#if defined(PONG_SIMD_SSE2)
+        return SimdLevel::SSE2;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+
+    return level;
+}
+
+const char* simdLevelName(const SimdLevel level) noexcept
+{
+    switch (level)
+    {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::SSE2:   return "sse2";
+        case SimdLevel::AVX2:   return "avx2";
+    }
+
+    return "unknown";
+}
+
+bool isSimdLevelSupported(const SimdLevel level) noexcept
+{
+    return static_cast<int>(level) <= static_cast<int>(detectSimdLevel());
+}
+
+std::uint32_t collisionCircleLineScalar(const CircleLineInput& in, const std::size_t count, float* px, float* py)
+{
+    std::uint32_t mask = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        glm::vec2 p;
+        if (collisionCircleLine({in.cx[i], in.cy[i]}, in.r[i], {in.ax[i], in.ay[i]}, {in.bx[i], in.by[i]}, p))
+        {
+            px[i] = p.x;
+            py[i] = p.y;
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+}
+
+#if defined(PONG_SIMD_SSE2)
+std::uint32_t collisionCircleLineSSE2(const CircleLineInput& in, float* px, float* py)
+{
+    const __m128 cx = _mm_loadu_ps(in.cx);
+    const __m128 cy = _mm_loadu_ps(in.cy);
+    const __m128 r  = _mm_loadu_ps(in.r);
+    const __m128 ax = _mm_loadu_ps(in.ax);
+    const __m128 ay = _mm_loadu_ps(in.ay);
+    const __m128 bx = _mm_loadu_ps(in.bx);
+    const __m128 by = _mm_loadu_ps(in.by);
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 tol  = _mm_set1_ps(CircleLineRootTolerance);
+    const __m128 abs  = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 neg  = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    // Same operations, in the same order, as `collisionCircleLine`.
+    const __m128 acx = _mm_sub_ps(cx, ax);
+    const __m128 acy = _mm_sub_ps(cy, ay);
+    const __m128 abx = _mm_sub_ps(bx, ax);
+    const __m128 aby = _mm_sub_ps(by, ay);
+
+    const __m128 dot    = _mm_add_ps(_mm_mul_ps(acx, abx), _mm_mul_ps(acy, aby));
+    const __m128 len2AC = _mm_add_ps(_mm_mul_ps(acx, acx), _mm_mul_ps(acy, acy));
+    const __m128 len2AB = _mm_add_ps(_mm_mul_ps(abx, abx), _mm_mul_ps(aby, aby));
+
+    const __m128 discriminant = _mm_sub_ps(_mm_mul_ps(dot, dot), _mm_mul_ps(len2AB, _mm_sub_ps(len2AC, _mm_mul_ps(r, r))));
+    const __m128 real         = _mm_cmpge_ps(discriminant, zero);
+
+    const __m128 sqrt = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+    const __m128 inv  = _mm_div_ps(one, len2AB);
+    const __m128 s0   = _mm_add_ps(_mm_xor_ps(dot, neg), sqrt);
+    const __m128 s1   = _mm_sub_ps(_mm_xor_ps(dot, neg), sqrt);
+    const __m128 r0   = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(s0, s0), inv), inv);
+    const __m128 r1   = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(s1, s1), inv), inv);
+
+    const __m128 in0 = _mm_and_ps(_mm_cmpge_ps(r0, zero), _mm_cmple_ps(r0, one));
+    const __m128 in1 = _mm_and_ps(_mm_cmpge_ps(r1, zero), _mm_cmple_ps(r1, one));
+    const __m128 hit = _mm_and_ps(real, _mm_or_ps(in0, in1));
+    // Pairs with a solution too close to the end of the segment.
+    const __m128 near0 = _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(r0, one), abs), tol);
+    const __m128 near1 = _mm_cmple_ps(_mm_and_ps(_mm_sub_ps(r1, one), abs), tol);
+    const __m128 doubt = _mm_and_ps(real, _mm_or_ps(near0, near1));
+    // Nearest point to the center of the circle.
+    _mm_storeu_ps(px, _mm_add_ps(ax, _mm_mul_ps(_mm_mul_ps(abx, dot), inv)));
+    _mm_storeu_ps(py, _mm_add_ps(ay, _mm_mul_ps(_mm_mul_ps(aby, dot), inv)));
+
+    auto mask = static_cast<std::uint32_t>(_mm_movemask_ps(hit));
+    // Resolve the doubtful pairs with the scalar function.
+    for (auto bits = static_cast<std::uint32_t>(_mm_movemask_ps(doubt)); bits != 0; bits &= bits - 1)
+    {
+        const auto i = static_cast<std::size_t>(std::countr_zero(bits));
+        mask = (mask & ~(1u << i)) | (collisionCircleLineScalar(in.offset(i), 1, px + i, py + i) << i);
+    }
+
+    return mask;
+}
+#endif
+
+void collisionCircleLines(const SimdLevel level, const std::size_t count, const CircleLineInput& in, float* px, float* py, std::uint32_t* masks)
+{
+    std::fill_n(masks, (count + 31) / 32, 0u);
+
+    std::size_t width = 32;
+#if defined(PONG_SIMD_AVX2)
+    if (level == SimdLevel::AVX2) { width = 8; }
+#endif
+#if defined(PONG_SIMD_SSE2)
+    if (level == SimdLevel::SSE2) { width = 4; }
+#endif
+
+    std::size_t i = 0;
+    // Full groups with the vector kernels. A group never crosses a mask boundary because the widths divide 32.
+    if (width < 32)
+    {
+        for (; i + width <= count; i += width)
+        {
+            std::uint32_t mask = 0;
+#if defined(PONG_SIMD_AVX2)
+            if (width == 8) { mask = collisionCircleLineAVX2(in.offset(i), px + i, py + i); }
+#endif
+#if defined(PONG_SIMD_SSE2)
+            if (width == 4) { mask = collisionCircleLineSSE2(in.offset(i), px + i, py + i); }
+#endif
+            masks[i / 32] |= mask << (i % 32);
+        }
+    }
+    // Remaining pairs with the scalar function.
+    for (; i < count; i += 32 - i % 32)
+    {
+        const std::size_t n = std::min(count - i, 32 - i % 32);
+        masks[i / 32] |= collisionCircleLineScalar(in.offset(i), n, px + i, py + i) << (i % 32);
+    }
+}
+
+} // namespace pong::physics
@@ -0,0 +1,149 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// SSE2 is part of the x86-64 baseline, so it does not need any special compiler flag. AVX2 is compiled in a separate
+// translation unit and enabled by the build system (PONG_SIMD_AVX2) only when the compiler supports it.
+#if !defined(PONG_SIMD_DISABLED) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define PONG_SIMD_SSE2
+#endif
+
+namespace pong::physics {
+
+/**
+ * @brief Defines an enumeration with the instruction sets the collision kernels can use.
+ */
+enum class SimdLevel
+{
+    Scalar, //!< Portable scalar code.
+    SSE2,   //!< 4 pairs per instruction.
+    AVX2    //!< 8 pairs per instruction.
+};
+
+/**
+ * @brief Distance to the end of the segment under which the solutions computed by the kernels are not trusted and the
+ * pair is resolved again with the scalar function.
+ */
+inline constexpr float CircleLineRootTolerance = 1e-5f;
+
+/**
+ * @brief Describes a group of circle/line pairs stored as a structure of arrays.
+ *
+ * Pair `i` is the circle with center (`cx[i]`, `cy[i]`) and radius `r[i]` against the line from (`ax[i]`, `ay[i]`) to
+ * (`bx[i]`, `by[i]`).
+ */
+struct CircleLineInput
+{
+    const float* cx; //!< X-coordinates of the centers of the circles.
+    const float* cy; //!< Y-coordinates of the centers of the circles.
+    const float* r;  //!< Radii of the circles.
+    const float* ax; //!< X-coordinates of the start points of the lines.
+    const float* ay; //!< Y-coordinates of the start points of the lines.
+    const float* bx; //!< X-coordinates of the end points of the lines.
+    const float* by; //!< Y-coordinates of the end points of the lines.
+
+    /**
+     * @brief Gets a view of the pairs starting at an offset.
+     * @param n Offset.
+     * @return Input that starts at pair `n`.
+     */
+    [[nodiscard]] CircleLineInput offset(const std::size_t n) const noexcept
+    {
+        return {cx + n, cy + n, r + n, ax + n, ay + n, bx + n, by + n};
+    }
+};
+
+/**
+ * @brief Gets the best instruction set supported by both the build and the running CPU.
+ * @return Instruction set.
+ */
+[[nodiscard]] SimdLevel detectSimdLevel() noexcept;
+
+/**
+ * @brief Gets the name of an instruction set.
+ * @param level Instruction set.
+ * @return Name.
+ */
+[[nodiscard]] const char* simdLevelName(SimdLevel level) noexcept;
+
+/**
+ * @brief Checks if the build and the running CPU support an instruction set.
+ * @param level Instruction set.
+ * @return True if it is supported, false otherwise.
+ */
+[[nodiscard]] bool isSimdLevelSupported(SimdLevel level) noexcept;
+
+/**
+ * @brief Tests up to 32 circle/line pairs with the scalar `collisionCircleLine`.
+ * @param in Pairs to test.
+ * @param count Number of pairs (32 at most).
+ * @param px X-coordinates of the contact points, only written for the pairs that collide.
+ * @param py Y-coordinates of the contact points, only written for the pairs that collide.
+ * @return Mask with the bit `i` set if the pair `i` collides.
+ */
+std::uint32_t collisionCircleLineScalar(const CircleLineInput& in, std::size_t count, float* px, float* py);
+
+#if defined(PONG_SIMD_SSE2)
+/**
+ * @brief Tests 4 circle/line pairs with SSE2.
+ * @param in Pairs to test.
+ * @param px X-coordinates of the contact points (4 values), undefined for the pairs that do not collide.
+ * @param py Y-coordinates of the contact points (4 values), undefined for the pairs that do not collide.
+ * @return Mask with the bit `i` set if the pair `i` collides.
+ */
+std::uint32_t collisionCircleLineSSE2(const CircleLineInput& in, float* px, float* py);
+#endif
+
+#if defined(PONG_SIMD_AVX2)
+/**
+ * @brief Tests 8 circle/line pairs with AVX2.
+ * @warning The running CPU must support AVX2, see `isSimdLevelSupported`.
+ * @param in Pairs to test.
+ * @param px X-coordinates of the contact points (8 values), undefined for the pairs that do not collide.
+ * @param py Y-coordinates of the contact points (8 values), undefined for the pairs that do not collide.
+ * @return Mask with the bit `i` set if the pair `i` collides.
+ */
+std::uint32_t collisionCircleLineAVX2(const CircleLineInput& in, float* px, float* py);
+#endif
+
+/**
+ * @brief Tests any number of circle/line pairs.
+ *
+ * The results are bit-exact with `collisionCircleLine` whatever instruction set is used: the kernels square with a
+ * multiplication instead of `glm::pow`, which may round differently by one ulp, so the few pairs whose solutions lie
+ * right at the end of the segment are resolved again with the scalar function.
+ * @param level Instruction set to use, it must be supported.
+ * @param count Number of pairs.
+ * @param in Pairs to test.
+ * @param px X-coordinates of the contact points (`count` values), undefined for the pairs that do not collide.
+ * @param py Y-coordinates of the contact points (`count` values), undefined for the pairs that do not collide.
+ * @param masks Hit masks (`(count + 31) / 32` values), bit `i % 32` of mask `i / 32` is set if the pair `i` collides.
+ */
+void collisionCircleLines(SimdLevel level, std::size_t count, const CircleLineInput& in, float* px, float* py, std::uint32_t* masks);
+
+} // namespace pong::physics
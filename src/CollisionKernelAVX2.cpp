@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+// This translation unit is compiled with AVX2 enabled, so it must only be called after checking the CPU supports it. It
+// does not use any inline function from other headers: the linker could pick the AVX2 copy for the rest of the program.
+
+#include "CollisionKernel.hpp"
+#include <immintrin.h>
+
+namespace pong::physics {
+
+std::uint32_t collisionCircleLineAVX2(const CircleLineInput& in, float* px, float* py)
+{
+    const __m256 cx = _mm256_loadu_ps(in.cx);
+    const __m256 cy = _mm256_loadu_ps(in.cy);
+    const __m256 r  = _mm256_loadu_ps(in.r);
+    const __m256 ax = _mm256_loadu_ps(in.ax);
+    const __m256 ay = _mm256_loadu_ps(in.ay);
+    const __m256 bx = _mm256_loadu_ps(in.bx);
+    const __m256 by = _mm256_loadu_ps(in.by);
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 tol  = _mm256_set1_ps(CircleLineRootTolerance);
+    const __m256 abs  = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 neg  = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+    // Same operations, in the same order, as `collisionCircleLine`. There are no fused multiply-adds on purpose, they
+    // would round differently.
+    const __m256 acx = _mm256_sub_ps(cx, ax);
+    const __m256 acy = _mm256_sub_ps(cy, ay);
+    const __m256 abx = _mm256_sub_ps(bx, ax);
+    const __m256 aby = _mm256_sub_ps(by, ay);
+
+    const __m256 dot    = _mm256_add_ps(_mm256_mul_ps(acx, abx), _mm256_mul_ps(acy, aby));
+    const __m256 len2AC = _mm256_add_ps(_mm256_mul_ps(acx, acx), _mm256_mul_ps(acy, acy));
+    const __m256 len2AB = _mm256_add_ps(_mm256_mul_ps(abx, abx), _mm256_mul_ps(aby, aby));
+
+    const __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(dot, dot), _mm256_mul_ps(len2AB, _mm256_sub_ps(len2AC, _mm256_mul_ps(r, r))));
+    const __m256 real         = _mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ);
+
+    const __m256 sqrt = _mm256_sqrt_ps(_mm256_max_ps(discriminant, zero));
+    const __m256 inv  = _mm256_div_ps(one, len2AB);
+    const __m256 s0   = _mm256_add_ps(_mm256_xor_ps(dot, neg), sqrt);
+    const __m256 s1   = _mm256_sub_ps(_mm256_xor_ps(dot, neg), sqrt);
+    const __m256 r0   = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(s0, s0), inv), inv);
+    const __m256 r1   = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(s1, s1), inv), inv);
+
+    const __m256 in0 = _mm256_and_ps(_mm256_cmp_ps(r0, zero, _CMP_GE_OQ), _mm256_cmp_ps(r0, one, _CMP_LE_OQ));
+    const __m256 in1 = _mm256_and_ps(_mm256_cmp_ps(r1, zero, _CMP_GE_OQ), _mm256_cmp_ps(r1, one, _CMP_LE_OQ));
+    const __m256 hit = _mm256_and_ps(real, _mm256_or_ps(in0, in1));
+    // Pairs with a solution too close to the end of the segment.
+    const __m256 near0 = _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(r0, one), abs), tol, _CMP_LE_OQ);
+    const __m256 near1 = _mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(r1, one), abs), tol, _CMP_LE_OQ);
+    const __m256 doubt = _mm256_and_ps(real, _mm256_or_ps(near0, near1));
+    // Nearest point to the center of the circle.
+    _mm256_storeu_ps(px, _mm256_add_ps(ax, _mm256_mul_ps(_mm256_mul_ps(abx, dot), inv)));
+    _mm256_storeu_ps(py, _mm256_add_ps(ay, _mm256_mul_ps(_mm256_mul_ps(aby, dot), inv)));
+
+    auto mask = static_cast<std::uint32_t>(_mm256_movemask_ps(hit));
+    // Resolve the doubtful pairs with the scalar function.
+    const auto bits = static_cast<std::uint32_t>(_mm256_movemask_ps(doubt));
+    for (std::size_t i = 0; bits != 0 && i < 8; ++i)
+    {
+        if ((bits & (1u << i)) != 0)
+        {
+            const CircleLineInput pair = {in.cx + i, in.cy + i, in.r + i, in.ax + i, in.ay + i, in.bx + i, in.by + i};
+            mask = (mask & ~(1u << i)) | (collisionCircleLineScalar(pair, 1, px + i, py + i) << i);
+        }
+    }
+
+    return mask;
+}
+
+} // namespace pong::physics
@@ -32,6 +32,7 @@ class Paddle;
 class Table;
 class Ball;
 class Event;
+struct ControllerSnapshot;
 
 /**
  * @brief Defines an interface for the behavior of a paddle.
@@ -75,6 +76,18 @@ public:
      * @param dt The time elapsed since the last update frame (delta time) in seconds.
      */
     virtual void update(Paddle& paddle, const Table& table, const Ball& ball, TimeDuration dt) = 0;
+
+    /**
+     * @brief Saves the internal state of the controller (see `Game::snapshot()`).
+     * @param snapshot Snapshot to fill, including the kind of controller.
+     */
+    virtual void snapshot(ControllerSnapshot& snapshot) const = 0;
+
+    /**
+     * @brief Restores the internal state of the controller.
+     * @param snapshot Snapshot of a controller of the same kind.
+     */
+    virtual void restore(const ControllerSnapshot& snapshot) = 0;
 };
 
 } // namespace pong
@@ -26,81 +26,126 @@
 #include "Table.hpp"
 #include "Paddle.hpp"
 #include "Ball.hpp"
-#include <glm/gtc/random.hpp>
+#include "Game.hpp"
+#include "Scene.hpp"
+#include "Snapshot.hpp"
 
 namespace pong {
 
-void ControllerAI::update(Paddle& paddle, const Table& table, const Ball& ball, const TimeDuration dt)
+ControllerAI::ControllerAI(const Settings& settings, const std::uint32_t seed)
+    :
+    mSettings(settings),
+    mRandom  (seed)
+{}
+
+ControllerAI::~ControllerAI()
 {
-    // On the very first update, set the initial target to the table's center.
-    if (mFirst)
+    if (mTimers)
     {
-        mTarget = table.position().y;
-        mFirst  = false;
+        mTimers->cancel(mTimer);
     }
-    // Accumulate time since the last major logic update.
-    mTimeSinceTargetUpdate += dt;
-    // If enough time has elapsed since the last update, the target is recalculated.
-    if (mTimeSinceTargetUpdate > TargetUpdateInterval)
+}
+
+void ControllerAI::update(Paddle& paddle, const Table& table, const Ball& ball, const TimeDuration dt)
+{
+    // On the first update, schedule the updates of the target.
+    if (!mTimers)
     {
-        mTimeSinceTargetUpdate = TimeDuration::zero();
-        updateTarget(paddle, table, ball);
+        attach(paddle, table, ball, dt);
     }
     // Move the paddle towards the current target in every frame.
     moveTowardsTarget(paddle);
 }
 
-void ControllerAI::updateTarget(Paddle& paddle, const Table& table, const Ball& ball)
+void ControllerAI::attach(Paddle& paddle, const Table& table, const Ball& ball, const TimeDuration dt)
 {
-    bool isBallIncoming = false;
-    if (paddle.position().x < 0)
+    mScene  = paddle.scene();
+    mPaddle = mScene->handle(paddle);
+    mTimers = &mScene->game().timers();
+    mPeriod = targetUpdateTicks(mSettings.targetUpdateInterval, dt);
+    // On the very first update, set the initial target to the table's center.
+    std::uint64_t ticksLeft = mTicksLeft;
+    if (mFirst)
     {
-        isBallIncoming = ball.speed().x < 0;
+        mTarget   = toFloat(table.position().y);
+        mFirst    = false;
+        ticksLeft = mPeriod;
     }
-    else
+    // The timers of the current tick already expired, so the target is updated now if it is due in this tick.
+    if (ticksLeft <= 1)
     {
-        isBallIncoming = ball.speed().x > 0;
+        updateTarget(paddle, table, ball);
+        ticksLeft = mPeriod + 1;
     }
+    mTimer = mTimers->schedule(mTimers->now() + ticksLeft - 1, expire, this);
+}
 
-    if (isBallIncoming) {
-        // The paddle is no longer in "return to center" mode.
-        mBack = false;
-        // Predict where the ball will be on the Y-axis when it reaches the paddle.
-        const float timeToImpact = (paddle.position().x - ball.position().x) / ball.speed().x;
-        const float predictedY = ball.position().y + ball.speed().y * timeToImpact;
-        // Only update the target if the new prediction is significantly different.
-        if (std::abs(predictedY - mTarget) > TargetDeadZone)
-        {
-            // Add some random error to make the AI feel more human.
-            const float error = paddle.size().y * (HitPositionBase + glm::linearRand(-HitPositionError, HitPositionError));
-
-            if (predictedY < paddle.position().y)
-            {
-                mTarget = predictedY + error;
-            }
-            else
-            {
-                mTarget = predictedY - error;
-            }
-        }
+void ControllerAI::expire(void* context)
+{
+    auto& controller = *static_cast<ControllerAI*>(context);
+    // The target stays put if the paddle, the table or the ball no longer exist, as the paddle does.
+    Paddle*      paddle = controller.mScene->get(controller.mPaddle);
+    const Table* table  = paddle ? paddle->table() : nullptr;
+    const Ball*  ball   = paddle ? paddle->ball()  : nullptr;
+    if (table && ball)
+    {
+        controller.updateTarget(*paddle, *table, *ball);
     }
-    else
+    controller.mTimer = controller.mTimers->schedule(controller.mTimers->now() + controller.mPeriod, expire, context);
+}
+
+void ControllerAI::updateTarget(Paddle& paddle, const Table& table, const Ball& ball)
+{
+    updateTarget(mTarget, mBack,
+                 toVec2(paddle.position()), toFloat(paddle.size().y),
+                 toVec2(table.position()),  toFloat(table.size().y),
+                 toVec2(ball.position()),   toVec2(ball.speed()),
+                 mSettings,
+                 [this](const float min, const float max) { return mRandom.uniform(min, max); });
+}
+
+void ControllerAI::snapshot(ControllerSnapshot& snapshot) const
+{
+    snapshot.kind                      = ControllerSnapshot::Kind::AI;
+    snapshot.first                     = mFirst ? 1 : 0;
+    snapshot.back                      = mBack  ? 1 : 0;
+    snapshot.target                    = mTarget;
+    snapshot.hitPositionBase           = mSettings.hitPositionBase;
+    snapshot.hitPositionError          = mSettings.hitPositionError;
+    snapshot.returnPositionErrorFactor = mSettings.returnPositionErrorFactor;
+    snapshot.targetUpdateInterval      = mSettings.targetUpdateInterval.count();
+    snapshot.targetUpdateTicks         = mTimers ? static_cast<std::uint32_t>(mTimers->deadline(mTimer) - mTimers->now())
+                                                   : mTicksLeft;
+    snapshot.random                    = mRandom.state();
+}
+
+void ControllerAI::restore(const ControllerSnapshot& snapshot)
+{
+    mFirst                              = snapshot.first != 0;
+    mBack                               = snapshot.back  != 0;
+    mTarget                             = snapshot.target;
+    mSettings.hitPositionBase           = snapshot.hitPositionBase;
+    mSettings.hitPositionError          = snapshot.hitPositionError;
+    mSettings.returnPositionErrorFactor = snapshot.returnPositionErrorFactor;
+    mSettings.targetUpdateInterval      = TimeDuration(snapshot.targetUpdateInterval);
+    mTicksLeft                          = snapshot.targetUpdateTicks;
+    mRandom.setState(snapshot.random);
+    // The updates of the target are scheduled again on the next update, from the ticks left.
+    if (mTimers)
     {
-        if (!mBack)
-        {
-            const float error = table.size().y * ReturnPositionErrorFactor;
-            mTarget = table.position().y + glm::linearRand(-error, error);
-            mBack   = true;
-        }
+        mTimers->cancel(mTimer);
+        mTimers = nullptr;
+        mTimer  = {};
     }
 }
 
 void ControllerAI::moveTowardsTarget(Paddle& paddle)
 {
+    const float y = toFloat(paddle.position().y);
     // Move towards the target, but stop if we are within the dead zone to prevent jitter.
-    if (std::abs(paddle.position().y - mTarget) > TargetDeadZone)
+    if (std::abs(y - mTarget) > TargetDeadZone)
     {
-        if (paddle.position().y < mTarget)
+        if (y < mTarget)
         {
             paddle.moveUp();
         }
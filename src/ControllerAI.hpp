@@ -25,17 +25,28 @@
 #pragma once
 
 #include "Controller.hpp"
+#include "Random.hpp"
+#include "TimerWheel.hpp"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstdint>
 
 namespace pong {
 
+class Scene;
+
 /**
  * @brief Implements a controller strategy for an AI-controlled paddle.
  *
  * This AI features several human-like behaviors:
  * - **Predictive Tracking:** It calculates the ball's future trajectory to intercept it.
  * - **Delayed Reaction:** It only updates its target periodically, not every frame, to avoid jittery, robotic movement.
+ *   The updates are timers of the match (see `Game::timers()`), so the controller does not check the time every tick.
  * - **Intentional Error:** It adds a slight random offset to its target position to make its hits less predictable and
  *   perfect.
+ *
+ * The parameters of these behaviors can be changed (e.g. to compare variants of the AI in a tournament) and every
+ * controller has its own seeded random generator, so the matches are reproducible and independent of each other.
  */
 class ControllerAI final : public Controller
 {
@@ -59,13 +70,50 @@ public:
     constexpr static float ReturnPositionErrorFactor = 0.1f;
 
     /**
-     * @brief Constructor.
+     * @brief Defines the parameters of the AI, the defaults are the ones of the game.
+     */
+    struct Settings
+    {
+        /** @brief How often the AI re-evaluates its target. */
+        TimeDuration targetUpdateInterval = TargetUpdateInterval;
+
+        /** @brief The base offset from the paddle's center to hit the ball, as a factor of the paddle height. */
+        float hitPositionBase = HitPositionBase;
+
+        /** @brief The random error range added to the hit position. */
+        float hitPositionError = HitPositionError;
+
+        /** @brief The random error range when returning to the center, as a factor of table height. */
+        float returnPositionErrorFactor = ReturnPositionErrorFactor;
+    };
+
+    /**
+     * @brief Constructor, with the default settings and seed.
      */
+    ControllerAI() = default;
+
     /**
      * @brief Constructor.
-     * should react to. Typically -1.0f for the left paddle, 1.0f for the right.
+     * @param settings Parameters of the AI.
+     * @param seed Seed of the random generator.
      */
-    ControllerAI() = default;
+    ControllerAI(const Settings& settings, std::uint32_t seed);
+
+    /**
+     * @brief Destructor, cancels the timer of the next update of the target.
+     */
+    ~ControllerAI() override;
+
+    /**
+     * @brief Calculates the number of ticks between two updates of the target.
+     *
+     * The target used to be updated on the first tick where the time accumulated since the last update exceeds the
+     * interval, the same accumulation gives the period of the timer.
+     * @param interval Interval between two updates.
+     * @param dt Duration of a tick, positive.
+     * @return Number of ticks.
+     */
+    [[nodiscard]] static constexpr std::uint64_t targetUpdateTicks(TimeDuration interval, TimeDuration dt);
 
     /**
      * @brief AI does not react to direct user events, so this is empty.
@@ -74,6 +122,32 @@ public:
 
     void update(Paddle& paddle, const Table& table, const Ball& ball, TimeDuration dt) override;
 
+    void snapshot(ControllerSnapshot& snapshot) const override;
+
+    void restore(const ControllerSnapshot& snapshot) override;
+
+    /**
+     * @brief Recalculates a target Y-coordinate based on the ball's trajectory.
+     *
+     * This is the decision logic of the AI without the entities, so it can also be used by the analytic simulation.
+     * @param target The target Y-coordinate, it is updated.
+     * @param back Flag indicating if the paddle is returning to the center, it is updated.
+     * @param paddlePosition Center of the paddle.
+     * @param paddleHeight Height of the paddle.
+     * @param tablePosition Center of the table.
+     * @param tableHeight Height of the table.
+     * @param ballPosition Center of the ball.
+     * @param ballSpeed Speed of the ball.
+     * @param settings Parameters of the AI.
+     * @param random Function returning a random number uniformly distributed in the range [min, max].
+     */
+    template<typename RandomFunction>
+    static void updateTarget(float& target, bool& back,
+                             const glm::vec2& paddlePosition, float paddleHeight,
+                             const glm::vec2& tablePosition,  float tableHeight,
+                             const glm::vec2& ballPosition,   const glm::vec2& ballSpeed,
+                             const Settings& settings, RandomFunction&& random);
+
 private:
     /**
      * @brief Recalculates the AI's target Y-coordinate based on the ball's trajectory.
@@ -83,6 +157,21 @@ private:
      */
     void updateTarget(Paddle& paddle, const Table& table, const Ball& ball);
 
+    /**
+     * @brief Schedules the updates of the target in the timers of the match of the paddle, on its first update.
+     * @param paddle Paddle being controlled.
+     * @param table Game table.
+     * @param ball Game ball.
+     * @param dt Duration of a tick.
+     */
+    void attach(Paddle& paddle, const Table& table, const Ball& ball, TimeDuration dt);
+
+    /**
+     * @brief Updates the target when its timer expires and schedules the next update.
+     * @param context Controller.
+     */
+    static void expire(void* context);
+
     /**
      * @brief Moves the paddle towards the current target Y-coordinate.
      * @param paddle Paddle being controlled.
@@ -91,6 +180,12 @@ private:
 
 private:
 
+    /** @brief Parameters of the AI. */
+    Settings mSettings;
+
+    /** @brief Random generator. */
+    Random mRandom;
+
     /** @brief Flag to handle the first update frame uniquely. */
     bool mFirst = true;
 
@@ -100,11 +195,91 @@ private:
     /** @brief The target Y-coordinate the paddle is currently trying to reach. */
     float mTarget = 0.0f;
 
-    /**
-     * @brief Time elapsed since the last update of the target, it is used to control how often the target is
-     * recalculated.
-     */
-    TimeDuration mTimeSinceTargetUpdate = {};
+    /** @brief Scene of the paddle, null until the first update. */
+    const Scene* mScene = nullptr;
+
+    /** @brief Handle of the paddle being controlled, known from the first update. */
+    Handle<Paddle> mPaddle;
+
+    /** @brief Timers of the match, null until the first update. */
+    TimerWheel* mTimers = nullptr;
+
+    /** @brief Timer of the next update of the target. */
+    TimerWheel::Timer mTimer;
+
+    /** @brief Number of ticks between two updates of the target. */
+    std::uint64_t mPeriod = 1;
+
+    /** @brief Ticks until the next update of the target, counting the next one, restored before the first update. */
+    std::uint32_t mTicksLeft = 0;
 };
 
+////////////////////////////////////////////////////////////
+
+constexpr std::uint64_t ControllerAI::targetUpdateTicks(const TimeDuration interval, const TimeDuration dt)
+{
+    TimeDuration  elapsed{};
+    std::uint64_t ticks = 0;
+
+    while (elapsed <= interval)
+    {
+        elapsed += dt;
+        ++ticks;
+    }
+
+    return ticks;
+}
+
+////////////////////////////////////////////////////////////
+
+template<typename RandomFunction>
+void ControllerAI::updateTarget(float& target, bool& back,
+                                const glm::vec2& paddlePosition, const float paddleHeight,
+                                const glm::vec2& tablePosition,  const float tableHeight,
+                                const glm::vec2& ballPosition,   const glm::vec2& ballSpeed,
+                                const Settings& settings, RandomFunction&& random)
+{
+    bool isBallIncoming = false;
+    if (paddlePosition.x < 0)
+    {
+        isBallIncoming = ballSpeed.x < 0;
+    }
+    else
+    {
+        isBallIncoming = ballSpeed.x > 0;
+    }
+
+    if (isBallIncoming) {
+        // The paddle is no longer in "return to center" mode.
+        back = false;
+        // Predict where the ball will be on the Y-axis when it reaches the paddle.
+        const float timeToImpact = (paddlePosition.x - ballPosition.x) / ballSpeed.x;
+        const float predictedY = ballPosition.y + ballSpeed.y * timeToImpact;
+        // Only update the target if the new prediction is significantly different.
+        if (std::abs(predictedY - target) > TargetDeadZone)
+        {
+            // Add some random error to make the AI feel more human.
+            const float error = paddleHeight * (settings.hitPositionBase + random(-settings.hitPositionError, settings.hitPositionError));
+
+            if (predictedY < paddlePosition.y)
+            {
+                target = predictedY + error;
+            }
+            else
+            {
+                target = predictedY - error;
+            }
+        }
+    }
+    else
+    {
+        if (!back)
+        {
+            const float error = tableHeight * settings.returnPositionErrorFactor;
+            target = tablePosition.y + random(-error, error);
+            back   = true;
+        }
+    }
+}
+
 } // namespace pong
@@ -25,6 +25,7 @@
 #include "ControllerHuman.hpp"
 #include "Event.hpp"
 #include "Paddle.hpp"
+#include "Snapshot.hpp"
 
 namespace pong {
 
@@ -89,4 +90,16 @@ void ControllerHuman::update
     }
 }
 
+void ControllerHuman::snapshot(ControllerSnapshot& snapshot) const
+{
+    snapshot.kind          = mPlayer == Player::A ? ControllerSnapshot::Kind::HumanA : ControllerSnapshot::Kind::HumanB;
+    snapshot.moveDirection = mMoveDirection;
+}
+
+void ControllerHuman::restore(const ControllerSnapshot& snapshot)
+{
+    mPlayer        = snapshot.kind == ControllerSnapshot::Kind::HumanA ? Player::A : Player::B;
+    mMoveDirection = snapshot.moveDirection;
+}
+
 } // namespace pong
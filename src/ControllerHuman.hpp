@@ -53,6 +53,10 @@ public:
 
     void update(Paddle& paddle, const Table& table, const Ball& ball, TimeDuration dt) override;
 
+    void snapshot(ControllerSnapshot& snapshot) const override;
+
+    void restore(const ControllerSnapshot& snapshot) override;
+
 private:
 
     /** @brief @brief The player this controller is responsible for. */
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include "Handle.hpp"
 #include "Time.hpp"
 
 namespace pong {
@@ -95,6 +96,20 @@ public:
      */
     void setScene(Scene* scene) noexcept { mScene = scene; }
 
+    /**
+     * @brief Gets the handle that identifies this entity in its scene.
+     * @details Use `Scene::handle()` to get a handle of the concrete type.
+     * @return The handle, or a null handle if the entity is not in a scene.
+     */
+    [[nodiscard]] Handle<Entity> id() const noexcept { return mId; }
+
+    /**
+     * @brief Sets the handle that identifies this entity.
+     * @details This method is called by the `Scene` class itself when the entity is added to it.
+     * @param id The handle.
+     */
+    void setId(const Handle<Entity> id) noexcept { mId = id; }
+
     /**
      * @brief Handles a game event.
      *
@@ -121,6 +136,24 @@ public:
      */
     virtual void draw(Renderer& renderer, const float interp) {}
 
+    /**
+     * @brief Checks whether the drawing of the entity depends on the interpolation value.
+     *
+     * An animated entity looks different in every frame between two updates, so the scene is never unchanged while it
+     * has one (see `Scene::changed()`). Derived classes that interpolate their state should override this method.
+     * @return True if the entity is animated, false otherwise.
+     */
+    [[nodiscard]] virtual bool animated() const noexcept { return false; }
+
+protected:
+
+    /**
+     * @brief Notifies the scene of the entity that something visible changed, so the next frame is presented.
+     *
+     * Derived classes must call it whenever they change the state they draw outside `update()`.
+     */
+    void markChanged() const noexcept;
+
 private:
 
     /** @brief The specific type of this entity. */
@@ -128,6 +161,9 @@ private:
 
     /** @brief A pointer to the scene that owns this entity or null is the entity is not attached to a scene. */
     Scene* mScene = nullptr;
+
+    /** @brief Handle of this entity in its scene. */
+    Handle<Entity> mId;
 };
 
 } // namespace pong
@@ -60,6 +60,8 @@ public:
         One,                     //!< The one-player mode was selected.
         Two,                     //!< The two-player mode was selected.
         Win,                     //!< A player has won the match, ending the game.
+        Zero,                    //!< The zero-player mode (AI versus AI) was selected.
+        // New types go at the end, the replays store the value of the types.
     };
 
     /**
@@ -0,0 +1,230 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace pong {
+
+/**
+ * @brief A signed Q16.16 fixed-point number.
+ *
+ * All the operations are done with integers, so the results are the same with every compiler, optimization level and
+ * floating-point flag. Products and quotients are calculated with 64-bit intermediates; the products are rounded to
+ * the nearest value and the quotients are truncated. The range is [-32768, 32768), there are no overflow checks.
+ */
+class Fixed
+{
+public:
+
+    /** @brief Number of fractional bits. */
+    static constexpr int FractionBits = 16;
+
+    /** @brief Raw value of one. */
+    static constexpr std::int32_t One = 1 << FractionBits;
+
+    /**
+     * @brief Constructs a zero.
+     */
+    constexpr Fixed() noexcept = default;
+
+    /**
+     * @brief Constructs from an integer.
+     * @param value Value.
+     */
+    constexpr explicit Fixed(const std::integral auto value) noexcept : mRaw(static_cast<std::int32_t>(value) * One) {}
+
+    /**
+     * @brief Constructs from a floating-point value, rounded to the nearest fixed-point value.
+     *
+     * The conversion is exact arithmetic (a product by a power of two and a rounding), so it is also deterministic.
+     * @param value Value.
+     */
+    constexpr explicit Fixed(const std::floating_point auto value) noexcept
+        :
+        mRaw(static_cast<std::int32_t>(static_cast<double>(value) * One + (value < 0 ? -0.5 : 0.5)))
+    {}
+
+    /**
+     * @brief Constructs from a raw value.
+     * @param raw Raw value (the value multiplied by `One`).
+     * @return Fixed-point value.
+     */
+    [[nodiscard]] static constexpr Fixed fromRaw(const std::int32_t raw) noexcept
+    {
+        Fixed value;
+        value.mRaw = raw;
+        return value;
+    }
+
+    /**
+     * @brief Gets the raw value.
+     * @return Raw value (the value multiplied by `One`).
+     */
+    [[nodiscard]] constexpr std::int32_t raw() const noexcept { return mRaw; }
+
+    /**
+     * @brief Converts to floating point, for rendering and for the code that is not deterministic anyway.
+     * @return Value.
+     */
+    [[nodiscard]] constexpr float toFloat() const noexcept { return static_cast<float>(mRaw) / static_cast<float>(One); }
+
+    constexpr auto operator<=>(const Fixed&) const noexcept = default;
+
+    constexpr Fixed operator-() const noexcept { return fromRaw(-mRaw); }
+
+    constexpr Fixed operator+(const Fixed other) const noexcept { return fromRaw(mRaw + other.mRaw); }
+
+    constexpr Fixed operator-(const Fixed other) const noexcept { return fromRaw(mRaw - other.mRaw); }
+
+    constexpr Fixed operator*(const Fixed other) const noexcept
+    {
+        const std::int64_t product = static_cast<std::int64_t>(mRaw) * other.mRaw;
+        return fromRaw(static_cast<std::int32_t>((product + (One >> 1)) >> FractionBits));
+    }
+
+    constexpr Fixed operator/(const Fixed other) const noexcept
+    {
+        return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(mRaw) << FractionBits) / other.mRaw));
+    }
+
+    constexpr Fixed& operator+=(const Fixed other) noexcept { return *this = *this + other; }
+
+    constexpr Fixed& operator-=(const Fixed other) noexcept { return *this = *this - other; }
+
+    constexpr Fixed& operator*=(const Fixed other) noexcept { return *this = *this * other; }
+
+    constexpr Fixed& operator/=(const Fixed other) noexcept { return *this = *this / other; }
+
+private:
+
+    /** @brief Raw value (the value multiplied by `One`). */
+    std::int32_t mRaw = 0;
+};
+
+/**
+ * @brief A 2D vector of fixed-point numbers, with the subset of the `glm::vec2` interface used by the gameplay.
+ */
+struct FixedVec2
+{
+    Fixed x; //!< X-coordinate.
+    Fixed y; //!< Y-coordinate.
+
+    constexpr FixedVec2() noexcept = default;
+
+    constexpr FixedVec2(const Fixed vx, const Fixed vy) noexcept : x(vx), y(vy) {}
+
+    constexpr explicit FixedVec2(const glm::vec2& v) noexcept : x(v.x), y(v.y) {}
+
+    constexpr bool operator==(const FixedVec2&) const noexcept = default;
+
+    constexpr FixedVec2 operator-() const noexcept { return {-x, -y}; }
+
+    constexpr FixedVec2 operator+(const FixedVec2& other) const noexcept { return {x + other.x, y + other.y}; }
+
+    constexpr FixedVec2 operator-(const FixedVec2& other) const noexcept { return {x - other.x, y - other.y}; }
+
+    constexpr FixedVec2 operator*(const Fixed s) const noexcept { return {x * s, y * s}; }
+};
+
+/**
+ * @brief Calculates the square root of a 64-bit integer, rounded down.
+ *
+ * At runtime the root is estimated with floating point and then corrected with integers, so the result is exact even
+ * if the estimate is not (e.g. with `-ffast-math`).
+ * @param value Value.
+ * @return Square root.
+ */
+[[nodiscard]] constexpr std::uint64_t isqrt(std::uint64_t value) noexcept
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+
+    if (!std::is_constant_evaluated())
+    {
+        auto root = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(value)));
+        // Correct the estimate.
+        while (root * root > value)             { --root; }
+        while ((root + 1) * (root + 1) <= value) { ++root; }
+        return root;
+    }
+    // Start with the highest power of four that is not greater than the value.
+    std::uint64_t root = 0;
+    std::uint64_t bit  = std::uint64_t{1} << ((63 - std::countl_zero(value)) & ~1);
+    // Calculate one bit of the root per iteration.
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root   = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * @brief Calculates the square root of a fixed-point value, rounded down.
+ * @param value Value (negative values return zero).
+ * @return Square root.
+ */
+[[nodiscard]] constexpr Fixed sqrt(const Fixed value) noexcept
+{
+    if (value.raw() <= 0)
+    {
+        return {};
+    }
+    return Fixed::fromRaw(static_cast<std::int32_t>(isqrt(static_cast<std::uint64_t>(value.raw()) << Fixed::FractionBits)));
+}
+
+/** @brief Gets the absolute value of a fixed point number. */
+[[nodiscard]] constexpr Fixed abs(const Fixed value) noexcept { return value.raw() < 0 ? -value : value; }
+
+/** @brief Gets the smaller of two fixed point numbers. */
+[[nodiscard]] constexpr Fixed min(const Fixed a, const Fixed b) noexcept { return b < a ? b : a; }
+
+/** @brief Gets the larger of two fixed point numbers. */
+[[nodiscard]] constexpr Fixed max(const Fixed a, const Fixed b) noexcept { return a < b ? b : a; }
+
+/** @brief Converts a fixed point number to floating point, for rendering. */
+[[nodiscard]] constexpr float toFloat(const Fixed value) noexcept { return value.toFloat(); }
+
+/** @brief Converts a fixed point vector to floating point, for rendering. */
+[[nodiscard]] inline glm::vec2 toVec2(const FixedVec2& v) noexcept { return {v.x.toFloat(), v.y.toFloat()}; }
+
+} // namespace pong
@@ -32,30 +32,242 @@
 #include "ControllerHuman.hpp"
 #include "ControllerAI.hpp"
 #include "Project.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
 
 namespace pong {
+namespace {
 
-Game::Game(Audio& audio)
+/** @brief Size of the cells of the grid of multi-ball matches, two ball diameters. */
+constexpr float BallGridCellSize = 4.0f * Game::BallRadius;
+
+/** @brief Maximum angle of the serves of multi-ball matches, in radians. */
+constexpr float MaxServeAngle = 0.5f;
+
+/**
+ * @brief Creates a controller of a given kind, with the default state.
+ * @param kind Kind of controller.
+ * @return Controller.
+ */
+std::unique_ptr<Controller> createController(const ControllerSnapshot::Kind kind)
+{
+    switch (kind)
+    {
+        case ControllerSnapshot::Kind::HumanA: return std::make_unique<ControllerHuman>(ControllerHuman::Player::A);
+        case ControllerSnapshot::Kind::HumanB: return std::make_unique<ControllerHuman>(ControllerHuman::Player::B);
+        default:                               return std::make_unique<ControllerAI>();
+    }
+}
+
+/**
+ * @brief Gets the score displayed by a score label.
+ * @param label Label.
+ * @return Score.
+ */
+std::int32_t labelScore(const Label& label)
+{
+    std::int32_t score = 0;
+    std::from_chars(label.text().data(), label.text().data() + label.text().size(), score);
+    return score;
+}
+
+/**
+ * @brief Sets the score displayed by a score label, the text is only changed if the score changes.
+ * @param label Label.
+ * @param score Score.
+ */
+void setLabelScore(Label& label, const std::int32_t score)
+{
+    if (labelScore(label) != score)
+    {
+        label.setText(std::to_string(score));
+    }
+}
+
+/**
+ * @brief Adds a label to the scene of a menu, laying out its text right away.
+ * @param scene Scene of the menu.
+ * @param width Width of the characters.
+ * @param position Position.
+ * @param color Color.
+ * @param text Text.
+ */
+void addMenuLabel(Scene& scene, const float width, const glm::vec2 position, const glm::vec4& color, const std::string_view text)
+{
+    if (Label* label = scene.emplace<Label>(width, position, color, text))
+    {
+        label->updateGeometry();
+    }
+}
+
+} // namespace
+
+Game::Game()
     :
-    mAudio      (audio),
-    mSceneMenus (*this),
-    mSceneMatch (*this)
+    mSceneMatch(*this)
 {}
 
+Game::MatchLayout Game::matchLayout(const Table& table) noexcept
+{
+    const glm::vec2 center = toVec2(table.position());
+    const float     top    = toFloat(table.top());
+    const float     left   = toFloat(table.left());
+    const float     right  = toFloat(table.right());
+
+    const float centerTop   = 100.0f - (100.0f - top) * 0.5f;
+    const float centerLeft  = left  - 0.5f * (left  - center.x);
+    const float centerRight = right - 0.5f * (right - center.x);
+
+    return {{centerRight, centerTop}, {centerLeft, centerTop}, {right - PaddleMargin, center.y}, {left + PaddleMargin, center.y}, center};
+}
+
+void Game::setCollisionMode(const physics::CollisionMode mode)
+{
+    mCollisionMode = mode;
+
+    if (Ball* ball = mSceneMatch.get(mBall))
+    {
+        ball->setCollisionMode(mode);
+    }
+
+    for (const Handle<Ball> handle : mBalls)
+    {
+        entity(handle).setCollisionMode(mode);
+    }
+}
+
+void Game::setBalls(const int count) noexcept
+{
+    mBallCount = std::clamp(count, 1, MaxBalls);
+}
+
+void Game::startMatch(std::unique_ptr<Controller> controllerA, std::unique_ptr<Controller> controllerB)
+{
+    setState(State::Match);
+
+    clear();
+    setupMatch(std::move(controllerA), std::move(controllerB), mBallCount);
+}
+
+GameSnapshot Game::snapshot() const
+{
+    GameSnapshot result;
+    result.state         = static_cast<std::uint8_t>(mState);
+    result.collisionMode = static_cast<std::uint8_t>(mCollisionMode);
+    result.scoreA        = mScoreA;
+    result.scoreB        = mScoreB;
+    result.seed          = mSeed;
+    // The entities only exist during a match.
+    if (const Ball* ball = mSceneMatch.get(mBall))
+    {
+        result.match       = 1;
+        result.multiBall   = mGrid ? 1 : 0;
+        result.labelScoreA = labelScore(entity(mLabelScoreA));
+        result.labelScoreB = labelScore(entity(mLabelScoreB));
+        ball->snapshot(result.ball);
+        entity(mPaddleA).snapshot(result.paddleA);
+        entity(mPaddleB).snapshot(result.paddleB);
+    }
+
+    return result;
+}
+
+bool Game::restore(const GameSnapshot& snapshot)
+{
+    // Check the snapshot before changing anything.
+    if (!snapshot.valid()
+        || snapshot.state         > static_cast<std::uint8_t>(State::Kickoff)
+        || snapshot.collisionMode > static_cast<std::uint8_t>(physics::CollisionMode::Swept)
+        || snapshot.multiBall     != 0)
+    {
+        return false;
+    }
+
+    const auto state = static_cast<State>(snapshot.state);
+    const bool match = snapshot.match != 0;
+    // The match scene exists from the start of a match until the return to the main menu.
+    if (match != (state == State::Match || state == State::Win || state == State::Abort || state == State::Kickoff))
+    {
+        return false;
+    }
+
+    if (match && (snapshot.paddleA.controller.kind > ControllerSnapshot::Kind::AI ||
+                  snapshot.paddleB.controller.kind > ControllerSnapshot::Kind::AI))
+    {
+        return false;
+    }
+    // Restore the match scene. It is updated in place if it has the same kinds of controllers, otherwise it is built
+    // again.
+    const bool inMatch = mSceneMatch.get(mBall) != nullptr;
+    if (!match)
+    {
+        if (inMatch)
+        {
+            clear();
+        }
+    }
+    else if (!inMatch || mGrid || !entity(mPaddleA).restore(snapshot.paddleA) || !entity(mPaddleB).restore(snapshot.paddleB))
+    {
+        clear();
+        setupMatch(createController(snapshot.paddleA.controller.kind), createController(snapshot.paddleB.controller.kind), 1);
+
+        static_cast<void>(entity(mPaddleA).restore(snapshot.paddleA));
+        static_cast<void>(entity(mPaddleB).restore(snapshot.paddleB));
+    }
+
+    mState  = state;
+    mScoreA = snapshot.scoreA;
+    mScoreB = snapshot.scoreB;
+    mSeed   = snapshot.seed;
+    setCollisionMode(static_cast<physics::CollisionMode>(snapshot.collisionMode));
+
+    if (match)
+    {
+        entity(mBall).restore(snapshot.ball);
+        setLabelScore(entity(mLabelScoreA), snapshot.labelScoreA);
+        setLabelScore(entity(mLabelScoreB), snapshot.labelScoreB);
+    }
+    // Show the menu of the state, the menus have no state of their own.
+    switch (mState)
+    {
+        case State::Main:    showMenu(Menu::Main);                                   break;
+        case State::Win:     showMenu(mScoreA > mScoreB ? Menu::WinA : Menu::WinB); break;
+        case State::Abort:   showMenu(Menu::Abort);                                  break;
+        case State::Kickoff: showMenu(Menu::Kickoff);                                break;
+        case State::Help:    showMenu(Menu::Help);                                   break;
+        default:             hideMenu();
+    }
+
+    return true;
+}
+
 void Game::handle(const Event& event)
 {
     // Movement events are send always to the paddles.
-    if (mPaddleA && event.isPlayerA()) { mPaddleA->handle(event); }
-    if (mPaddleB && event.isPlayerB()) { mPaddleB->handle(event); }
+    Paddle* paddleA = mSceneMatch.get(mPaddleA);
+    Paddle* paddleB = mSceneMatch.get(mPaddleB);
+    if (paddleA && event.isPlayerA()) { paddleA->handle(event); }
+    if (paddleB && event.isPlayerB()) { paddleB->handle(event); }
 
     switch (mState)
     {
         // Main menu.
         case State::Main:
         {
+            if (event.is(Event::Type::Zero))
+            {
+                setState(State::Match);
+
+                clear();
+                setupMatch(0);
+            }
+
             if (event.is(Event::Type::One))
             {
-                mState = State::Match;
+                setState(State::Match);
 
                 clear();
                 setupMatch(1);
@@ -63,7 +275,7 @@ void Game::handle(const Event& event)
 
             if (event.is(Event::Type::Two))
             {
-                mState = State::Match;
+                setState(State::Match);
 
                 clear();
                 setupMatch(2);
@@ -71,15 +283,15 @@ void Game::handle(const Event& event)
 
             if (event.is(Event::Type::Help))
             {
-                mState = State::Help;
+                setState(State::Help);
 
                 clear();
-                setupHelp();
+                showMenu(Menu::Help);
             }
 
             if (event.is(Event::Type::Quit))
             {
-                mState = State::Done;
+                setState(State::Done);
 
                 clear();
             }
@@ -90,20 +302,21 @@ void Game::handle(const Event& event)
         {
             if (event.is(Event::Type::Win))
             {
-                mState = State::Win;
+                setState(State::Win);
 
-                setupWin();
+                showMenu(mScoreA > mScoreB ? Menu::WinA : Menu::WinB);
             }
 
             if (event.is(Event::Type::Quit) || event.is(Event::Type::Minimize))
             {
-                if (mPaddleA) { mPaddleA->handle(Event{Event::Type::Pause}); }
-                if (mPaddleB) { mPaddleB->handle(Event{Event::Type::Pause}); }
-                if (mBall)    { mBall   ->handle(Event{Event::Type::Pause}); }
+                Ball* ball = mSceneMatch.get(mBall);
+                if (paddleA) { paddleA->handle(Event{Event::Type::Pause}); }
+                if (paddleB) { paddleB->handle(Event{Event::Type::Pause}); }
+                if (ball)    { ball   ->handle(Event{Event::Type::Pause}); }
 
-                mState = State::Abort;
+                setState(State::Abort);
 
-                setupAbort();
+                showMenu(Menu::Abort);
             }
         }
         break;
@@ -112,10 +325,10 @@ void Game::handle(const Event& event)
         {
             if (event.is(Event::Type::Quit) || event.is(Event::Type::Next))
             {
-                mState = State::Main;
+                setState(State::Main);
 
                 clear();
-                setupMain();
+                showMenu(Menu::Main);
             }
         }
         break;
@@ -124,17 +337,17 @@ void Game::handle(const Event& event)
         {
             if (event.is(Event::Type::No) || event.is(Event::Type::Quit))
             {
-                mState = State::Match;
+                setState(State::Match);
 
-                clearMenus();
+                hideMenu();
             }
 
             if (event.is(Event::Type::Yes))
             {
-                mState = State::Main;
+                setState(State::Main);
 
                 clear();
-                setupMain();
+                showMenu(Menu::Main);
             }
         }
         break;
@@ -143,9 +356,9 @@ void Game::handle(const Event& event)
         {
             if (event.is(Event::Type::Next) || event.is(Event::Type::Quit))
             {
-                mState = State::Match;
+                setState(State::Match);
 
-                clearMenus();
+                hideMenu();
             }
         }
         break;
@@ -154,10 +367,10 @@ void Game::handle(const Event& event)
         {
             if (event.is(Event::Type::Quit))
             {
-                mState = State::Main;
+                setState(State::Main);
 
                 clear();
-                setupMain();
+                showMenu(Menu::Main);
             }
         }
         break;
@@ -167,157 +380,413 @@ void Game::handle(const Event& event)
 }
 
 void Game::update(const TimeDuration dt)
+{
+    update(Stage::Control, dt);
+    update(Stage::Move,    dt);
+    update(Stage::Ball,    dt);
+    update(Stage::Score,   dt);
+}
+
+void Game::update(const Stage stage, const TimeDuration dt)
 {
     // The initial state changes automatically to main.
-    if (mState == State::Start)
+    if (mState == State::Start && stage == Stage::Control)
     {
-        mState = State::Main;
-        setupMain();
+        setState(State::Main);
+        showMenu(Menu::Main);
     }
     // Update the scene for the match if a match is up and running.
-    if (mState == State::Match)
+    if (mState != State::Match)
     {
-        mSceneMatch.update(dt);
+        return;
+    }
+
+    switch (stage)
+    {
+        case Stage::Control:
+        {
+            // The timers expire before the entities update, as if the entities checked them themselves.
+            mTimers.advance();
+            mSceneMatch.forEach<Paddle>([dt](Paddle& paddle) { paddle.control(dt); });
+        }
+        break;
 
-        if (mBall->point())
+        case Stage::Move:
         {
-            if (mBall->pointPaddleA()) { ++mScoreA; }
-            if (mBall->pointPaddleB()) { ++mScoreB; }
+            mSceneMatch.forEach<Paddle>([dt](Paddle& paddle) { paddle.move(dt); });
+        }
+        break;
+
+        case Stage::Ball:
+        {
+            // The table and the labels do not change in updates.
+            mSceneMatch.forEach<Ball>([dt](Ball& ball) { ball.update(dt); });
+        }
+        break;
 
-            if (mScoreA >= MaxPoints || mScoreB >= MaxPoints)
+        case Stage::Score:
+        {
+            if (mGrid)
             {
-                handle(Event{Event::Type::Win});
+                updateBalls();
             }
-            else
+            else if (const Ball& ball = entity(mBall); ball.point())
             {
-                scorePoints();
-
-                mState = State::Kickoff;
-                setupKickoff();
+                countPoint(ball);
+
+                if (mScoreA >= MaxPoints || mScoreB >= MaxPoints)
+                {
+                    handle(Event{Event::Type::Win});
+                }
+                else
+                {
+                    scorePoints();
+
+                    setState(State::Kickoff);
+                    showMenu(Menu::Kickoff);
+                }
             }
         }
+        break;
     }
-    // Menus are always updated.
-    mSceneMenus.update(dt);
 }
 
 void Game::draw(Renderer& renderer, const float interp)
 {
     mSceneMatch.draw(renderer, interp);
-    mSceneMenus.draw(renderer, interp);
+    // The menus are immutable, they are only drawn.
+    if (mMenu)
+    {
+        mMenu->draw(renderer, interp);
+    }
+    // The next frames are the same until something changes.
+    mChanged = false;
+    mSceneMatch.resetChanged();
+    if (mMenu)
+    {
+        mMenu->resetChanged();
+    }
 }
 
-void Game::setupMain()
+bool Game::changed() const
 {
-    mSceneMenus.emplace<Label>(20.0f, glm::vec2{0.0f,  60.0f}, ColorBlue,  "PROTO");
-    mSceneMenus.emplace<Label>(20.0f, glm::vec2{0.0f,  35.0f}, ColorBlue,  "PONG");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -20.0f}, ColorWhite, "Press (1) for single player");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -35.0f}, ColorWhite, "Press (2) for player vs player");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -50.0f}, ColorWhite, "Press (h) to view controls");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -65.0f}, ColorWhite, "Press (ESC) to exit");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -90.0f}, ColorGray,  PONG_VERSION);
+    return mChanged || mSceneMatch.changed() || (mMenu && mMenu->changed());
 }
 
-void Game::setupMatch(const int players)
+void Game::showMenu(const Menu menu)
 {
-    mScoreA = 0;
-    mScoreB = 0;
+    std::unique_ptr<Scene>& scene = mMenus[static_cast<std::size_t>(menu)];
+    if (!scene)
+    {
+        scene = std::make_unique<Scene>(*this);
 
-    mTable = mSceneMatch.emplace<Table>(glm::vec2(0.0f, -10.0f), glm::vec2(200.0f, 140.0f));
+        switch (menu)
+        {
+            case Menu::Main:    setupMain   (*scene);        break;
+            case Menu::Help:    setupHelp   (*scene);        break;
+            case Menu::Kickoff: setupKickoff(*scene);        break;
+            case Menu::Abort:   setupAbort  (*scene);        break;
+            case Menu::WinA:    setupWin    (*scene, true);  break;
+            case Menu::WinB:    setupWin    (*scene, false); break;
+            default:;
+        }
+    }
+
+    mChanged = mChanged || mMenu != scene.get();
+    mMenu    = scene.get();
+}
+
+void Game::hideMenu() noexcept
+{
+    mChanged = mChanged || mMenu != nullptr;
+    mMenu    = nullptr;
+}
 
-    const float centerTop   = 100.0f - (100.0f - mTable->top()) * 0.5f;
-    const float centerLeft  = mTable->left () - 0.5f * (mTable->left () - mTable->position().x);
-    const float centerRight = mTable->right() - 0.5f * (mTable->right() - mTable->position().x);
+void Game::setupMain(Scene& scene)
+{
+    addMenuLabel(scene, 20.0f, glm::vec2{0.0f,  60.0f}, ColorBlue,  "PROTO");
+    addMenuLabel(scene, 20.0f, glm::vec2{0.0f,  35.0f}, ColorBlue,  "PONG");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -10.0f}, ColorWhite, "Press (0) to watch AI vs AI");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -25.0f}, ColorWhite, "Press (1) for single player");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -40.0f}, ColorWhite, "Press (2) for player vs player");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -55.0f}, ColorWhite, "Press (h) to view controls");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -70.0f}, ColorWhite, "Press (ESC) to exit");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -90.0f}, ColorGray,  PONG_VERSION);
+}
 
-    mLabelScoreA = mSceneMatch.emplace<Label>(15.0f, glm::vec2{centerRight, centerTop}, ColorWhite, std::to_string(mScoreA));
-    mLabelScoreB = mSceneMatch.emplace<Label>(15.0f, glm::vec2{centerLeft,  centerTop}, ColorWhite, std::to_string(mScoreB));
+void Game::setupMatch(const int players)
+{
+    // Each AI has its own seed, derived from the seed of the match.
+    const std::uint32_t seedA = mSeed * 2;
+    const std::uint32_t seedB = mSeed * 2 + 1;
+    ++mSeed;
 
-    std::unique_ptr<Controller> ca, cb;
+    // The controllers live in the arena of the match, like the paddles that own them.
+    ArenaPtr<Controller> ca, cb;
     if (players >= 2)
     {
-        ca = std::make_unique<ControllerHuman>(ControllerHuman::Player::A);
-        cb = std::make_unique<ControllerHuman>(ControllerHuman::Player::B);
+        ca = mSceneMatch.make<ControllerHuman>(ControllerHuman::Player::A);
+        cb = mSceneMatch.make<ControllerHuman>(ControllerHuman::Player::B);
+    }
+    else if (players == 1)
+    {
+        ca = mSceneMatch.make<ControllerHuman>(ControllerHuman::Player::A);
+        cb = mSceneMatch.make<ControllerAI>(ControllerAI::Settings{}, seedB);
     }
     else
     {
-        ca = std::make_unique<ControllerHuman>(ControllerHuman::Player::A);
-        cb = std::make_unique<ControllerAI>();
+        ca = mSceneMatch.make<ControllerAI>(ControllerAI::Settings{}, seedA);
+        cb = mSceneMatch.make<ControllerAI>(ControllerAI::Settings{}, seedB);
     }
 
-    mPaddleA = mSceneMatch.emplace<Paddle>(std::move(ca), glm::vec2{mTable->right() - 10.0f, mTable->position().y}, glm::vec2{5.0f, 30.0f});
-    mPaddleB = mSceneMatch.emplace<Paddle>(std::move(cb), glm::vec2{mTable->left()  + 10.0f, mTable->position().y}, glm::vec2{5.0f, 30.0f});
-    mBall    = mSceneMatch.emplace<Ball>(mTable->position(), 2.5f);
-    mPaddleA->setup(*mTable, *mBall);
-    mPaddleB->setup(*mTable, *mBall);
-    mBall   ->setup(*mTable, *mPaddleA, *mPaddleB);
+    setupMatch(std::move(ca), std::move(cb), mBallCount);
 }
 
-void Game::setupWin()
+void Game::setupMatch(ArenaPtr<Controller> controllerA, ArenaPtr<Controller> controllerB, const int balls)
 {
-    if (mBall->pointPaddleA())
+    mScoreA = 0;
+    mScoreB = 0;
+
+    Table* table = mSceneMatch.emplace<Table>(TablePosition, TableSize);
+    if (!table)
+    {
+        missingEntity();
+    }
+
+    const MatchLayout layout = matchLayout(*table);
+    const glm::vec2   center = layout.ball;
+
+    Label*  labelScoreA = mSceneMatch.emplace<Label>(ScoreWidth, layout.scoreA, ColorWhite, std::to_string(mScoreA));
+    Label*  labelScoreB = mSceneMatch.emplace<Label>(ScoreWidth, layout.scoreB, ColorWhite, std::to_string(mScoreB));
+    Paddle* paddleA     = mSceneMatch.emplace<Paddle>(std::move(controllerA), layout.paddleA, PaddleSize);
+    Paddle* paddleB     = mSceneMatch.emplace<Paddle>(std::move(controllerB), layout.paddleB, PaddleSize);
+    Ball*   ball        = mSceneMatch.emplace<Ball>(center, BallRadius);
+    if (!labelScoreA || !labelScoreB || !paddleA || !paddleB || !ball)
     {
-        mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->position().y + 7.5f}, ColorRed, "Right player won!!!");
+        missingEntity();
+    }
+    // The scores change during the match, the rest of the geometry of the table is static.
+    labelScoreA->setRetained(false);
+    labelScoreB->setRetained(false);
+    paddleA->setup(*table, *ball);
+    paddleB->setup(*table, *ball);
+    ball   ->setup(*table, *paddleA, *paddleB);
+    ball   ->setCollisionMode(mCollisionMode);
+
+    mTable       = mSceneMatch.handle(*table);
+    mLabelScoreA = mSceneMatch.handle(*labelScoreA);
+    mLabelScoreB = mSceneMatch.handle(*labelScoreB);
+    mPaddleA     = mSceneMatch.handle(*paddleA);
+    mPaddleB     = mSceneMatch.handle(*paddleB);
+    mBall        = mSceneMatch.handle(*ball);
+    // The extra balls of a multi-ball match are served at once, in random directions.
+    if (balls > 1)
+    {
+        mGrid = std::make_unique<BallGrid>(*table, *paddleA, *paddleB, BallGridCellSize);
+        mRandom.seed(mSeed);
+
+        ball->setGrid(mGrid.get());
+        mGrid->insert(*ball);
+        mBalls.push_back(mBall);
+        for (int i = 1; i < balls; ++i)
+        {
+            Ball* extra = mSceneMatch.emplace<Ball>(center, BallRadius);
+            if (!extra)
+            {
+                missingEntity();
+            }
+            extra->setup(*table, *paddleA, *paddleB);
+            extra->setCollisionMode(mCollisionMode);
+            extra->setGrid(mGrid.get());
+            serve(*extra, mRandom.next() % 2 == 0);
+            mGrid->insert(*extra);
+            mBalls.push_back(mSceneMatch.handle(*extra));
+        }
+    }
+}
+
+void Game::setupWin(Scene& scene, const bool playerA)
+{
+    // The menus do not depend on the table of the match, which is always at the same place.
+    const float center = TablePosition.y;
+
+    if (playerA)
+    {
+        addMenuLabel(scene, 5.0f, glm::vec2{0.0f, center + 7.5f}, ColorRed, "Right player won!!!");
     }
     else
     {
-        mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->position().y + 7.5f}, ColorRed, "Left player won!!!");
+        addMenuLabel(scene, 5.0f, glm::vec2{0.0f, center + 7.5f}, ColorRed, "Left player won!!!");
     }
-    mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->position().y - 7.5f}, ColorRed, "Press (ESC) to exit");
+    addMenuLabel(scene, 5.0f, glm::vec2{0.0f, center - 7.5f}, ColorRed, "Press (ESC) to exit");
 }
 
-void Game::setupAbort()
+void Game::setupAbort(Scene& scene)
 {
-    mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->position().y + 7.5f}, ColorRed, "Are you sure you want to quit?");
-    mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->position().y - 7.5f}, ColorRed, "(Y)es  (N)o");
+    const float center = TablePosition.y;
+
+    addMenuLabel(scene, 5.0f, glm::vec2{0.0f, center + 7.5f}, ColorRed, "Are you sure you want to quit?");
+    addMenuLabel(scene, 5.0f, glm::vec2{0.0f, center - 7.5f}, ColorRed, "(Y)es  (N)o");
 }
 
-void Game::setupKickoff()
+void Game::setupKickoff(Scene& scene)
 {
-    mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->top()    - 20}, ColorBlue, "Press (space) to kickoff");
-    mSceneMenus.emplace<Label>(5.0f, glm::vec2{0.0f, mTable->bottom() + 20}, ColorBlue, "Press (space) to kickoff");
+    const float top    = TablePosition.y + TableSize.y * 0.5f;
+    const float bottom = TablePosition.y - TableSize.y * 0.5f;
+
+    addMenuLabel(scene, 5.0f, glm::vec2{0.0f, top    - 20}, ColorBlue, "Press (space) to kickoff");
+    addMenuLabel(scene, 5.0f, glm::vec2{0.0f, bottom + 20}, ColorBlue, "Press (space) to kickoff");
 }
 
-void Game::setupHelp()
+void Game::setupHelp(Scene& scene)
 {
-    mSceneMenus.emplace<Label>(10.0f, glm::vec2{0.0f,  60.0f}, ColorBlue,  "Controls");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f,  20.0f}, ColorGray,  "Right player:");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f,  10.0f}, ColorWhite, "(up arrow) move up, (down arrow) move down");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, - 5.0f}, ColorGray,  "Left player:");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -15.0f}, ColorWhite, "(w) move up, (s) move down");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -30.0f}, ColorGray,  "Both players:");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -40.0f}, ColorWhite, "(space) kickoff");
-    mSceneMenus.emplace<Label>( 5.0f, glm::vec2{0.0f, -80.0f}, ColorWhite, "Press (ESC) to return");
+    addMenuLabel(scene, 10.0f, glm::vec2{0.0f,  60.0f}, ColorBlue,  "Controls");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f,  20.0f}, ColorGray,  "Right player:");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f,  10.0f}, ColorWhite, "(up arrow) move up, (down arrow) move down");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, - 5.0f}, ColorGray,  "Left player:");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -15.0f}, ColorWhite, "(w) move up, (s) move down");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -30.0f}, ColorGray,  "Both players:");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -40.0f}, ColorWhite, "(space) kickoff");
+    addMenuLabel(scene,  5.0f, glm::vec2{0.0f, -80.0f}, ColorWhite, "Press (ESC) to return");
 }
 
 void Game::scorePoints()
 {
-    mLabelScoreA->setText(std::to_string(mScoreA));
-    mLabelScoreB->setText(std::to_string(mScoreB));
+    const Table& table   = entity(mTable);
+    Ball&        ball    = entity(mBall);
+    Paddle&      paddleA = entity(mPaddleA);
+    Paddle&      paddleB = entity(mPaddleB);
+
+    entity(mLabelScoreA).setText(std::to_string(mScoreA));
+    entity(mLabelScoreB).setText(std::to_string(mScoreB));
+
+    const glm::vec2 center = toVec2(table.position());
 
-    if (mBall->pointPaddleA()) { mBall->reset(mTable->position(),  InitialSpeed); }
-    if (mBall->pointPaddleB()) { mBall->reset(mTable->position(), -InitialSpeed); }
+    if (ball.pointPaddleA()) { ball.reset(center,  InitialSpeed); }
+    if (ball.pointPaddleB()) { ball.reset(center, -InitialSpeed); }
 
-    mPaddleA->setPosition({mTable->right() - 10.0f, mTable->position().y});
-    mPaddleA->stop();
-    mPaddleB->setPosition({mTable->left()  + 10.0f, mTable->position().y});
-    mPaddleB->stop();
+    paddleA.setPosition({toFloat(table.right()) - PaddleMargin, center.y});
+    paddleA.stop();
+    paddleB.setPosition({toFloat(table.left())  + PaddleMargin, center.y});
+    paddleB.stop();
 }
 
-void Game::clear()
+void Game::updateBalls()
 {
-    mPaddleA = nullptr;
-    mPaddleB = nullptr;
-    mBall = nullptr;
-    mTable = nullptr;
-    mLabelScoreA = nullptr;
-    mLabelScoreB = nullptr;
-    mSceneMenus.clear();
-    mSceneMatch.clear();
+    // Count the points of all the balls.
+    bool point = false;
+    for (const Handle<Ball> handle : mBalls)
+    {
+        const Ball& ball = entity(handle);
+        if (ball.point())
+        {
+            countPoint(ball);
+            point = true;
+        }
+    }
+
+    if (mScoreA >= MaxPoints || mScoreB >= MaxPoints)
+    {
+        handle(Event{Event::Type::Win});
+        return;
+    }
+    // Serve the balls that scored again, there is no kickoff.
+    if (point)
+    {
+        entity(mLabelScoreA).setText(std::to_string(mScoreA));
+        entity(mLabelScoreB).setText(std::to_string(mScoreB));
+
+        for (const Handle<Ball> handle : mBalls)
+        {
+            Ball& ball = entity(handle);
+            if (ball.point())
+            {
+                serve(ball, ball.pointPaddleA());
+            }
+        }
+    }
+    // Resolve the collisions between the balls.
+    mGrid->update();
+    mGrid->collide();
+    // Each paddle follows the ball that will reach it first.
+    Paddle& paddleA = entity(mPaddleA);
+    Paddle& paddleB = entity(mPaddleB);
+    paddleA.track(nextBall(paddleA, true));
+    paddleB.track(nextBall(paddleB, false));
+}
+
+void Game::serve(Ball& ball, const bool right)
+{
+    const Table&    table  = entity(mTable);
+    const glm::vec2 center = toVec2(table.position());
+    const float     height = toFloat(table.size().y) * 0.4f;
+    const float     angle  = mRandom.uniform(-MaxServeAngle, MaxServeAngle);
+    const float     speed  = right ? InitialSpeed : -InitialSpeed;
+
+    ball.reset(center + glm::vec2{0.0f, mRandom.uniform(-height, height)}, speed * glm::vec2{std::cos(angle), std::sin(angle)});
 }
 
-void Game::clearMenus()
+const Ball& Game::nextBall(const Paddle& paddle, const bool right) const
 {
-    mSceneMenus.clear();
+    const float x    = toFloat(paddle.position().x);
+    const Ball* next = nullptr;
+    float       best = 0.0f;
+    for (const Handle<Ball> handle : mBalls)
+    {
+        const Ball& ball  = entity(handle);
+        const float speed = toFloat(ball.speed().x);
+        if (right ? speed <= 0.0f : speed >= 0.0f)
+        {
+            continue;
+        }
+
+        const float time = (x - toFloat(ball.position().x)) / speed;
+        if (time >= 0.0f && (!next || time < best))
+        {
+            next = &ball;
+            best = time;
+        }
+    }
+
+    return next ? *next : entity(mBall);
+}
+
+void Game::missingEntity()
+{
+    std::cerr << "An entity of the match no longer exists" << std::endl;
+    std::abort();
+}
+
+void Game::setState(const State state) noexcept
+{
+    mState = state;
+
+    GameplayEvent event;
+    event.type  = GameplayEvent::Type::State;
+    event.state = static_cast<std::uint8_t>(state);
+    mEvents.push(event);
+}
+
+void Game::countPoint(const Ball& ball) noexcept
+{
+    if (ball.pointPaddleA()) { ++mScoreA; }
+    if (ball.pointPaddleB()) { ++mScoreB; }
+
+    GameplayEvent event;
+    event.type     = GameplayEvent::Type::Point;
+    event.player   = ball.pointPaddleA() ? 0 : 1;
+    event.position = toVec2(ball.position());
+    mEvents.push(event);
+}
+
+void Game::clear()
+{
+    mGrid.reset();
+    mBalls.clear();
+    hideMenu();
+    // Clearing the match scene invalidates the handles of its entities, their timers are cancelled first.
+    mTimers.clear();
+    mSceneMatch.clear();
 }
 
 } // namespace pong
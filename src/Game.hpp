@@ -24,37 +24,43 @@
 
 #pragma once
 
+#include "BallGrid.hpp"
+#include "GameplayEvents.hpp"
+#include "Random.hpp"
 #include "Scene.hpp"
+#include "Snapshot.hpp"
+#include "SweptCollision.hpp"
+#include "Time.hpp"
+#include "TimerWheel.hpp"
 #include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace pong {
 
-class Audio;
 class Event;
 class Table;
 class Paddle;
 class Ball;
 class Label;
+class Controller;
 
 /**
  * @brief Defines a game class that orchestrates the entire game flow, acting as the central state machine.
  *
  * This class is the core of the application logic. It is responsible for:
  * - Managing the overall game state (e.g., main menu, match, win screen).
- * - Owning and managing the game scenes (`mSceneMatch` and `mSceneMenus`).
+ * - Owning and managing the game scenes (`mSceneMatch` and a prebuilt scene for every menu).
  * - Creating all game entities and placing them in the appropriate scenes.
  * - Handling and dispatching events to drive state transitions and player actions.
  * - Storing game-wide state, such as player scores.
- * - Maintaining non-owning pointers to critical entities for fast, direct access.
+ * - Recording what happens in the ticks as gameplay events, for the systems that react to them (e.g. the audio).
+ * - Maintaining handles to critical entities for fast, validated access.
  */
 class Game
 {
-    /** @brief Maximum number of points per match. */
-    static constexpr int MaxPoints = 10;
-
-    /** @brief Ball initial speed. */
-    static constexpr float InitialSpeed = 100.0f;
-
     /** @brief White color for common elements. */
     static constexpr auto ColorWhite = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
 
@@ -67,6 +73,66 @@ class Game
     /** @brief Gray color for texts. */
     static constexpr auto ColorGray = glm::vec4(0.4f, 0.4f, 0.4f, 1.0f);
 
+public:
+
+    /** @brief Fixed time step of the game logic. */
+    static constexpr TimeDuration TickTime{1.0 / 60.0};
+
+    /** @brief Maximum number of points per match. */
+    static constexpr int MaxPoints = 10;
+
+    /** @brief Ball initial speed. */
+    static constexpr float InitialSpeed = 100.0f;
+
+    /** @brief Center position of the table. */
+    static constexpr auto TablePosition = glm::vec2(0.0f, -10.0f);
+
+    /** @brief Size of the table. */
+    static constexpr auto TableSize = glm::vec2(200.0f, 140.0f);
+
+    /** @brief Size of the paddles. */
+    static constexpr auto PaddleSize = glm::vec2(5.0f, 30.0f);
+
+    /** @brief Horizontal distance from the side limits of the table to the center of the paddles. */
+    static constexpr float PaddleMargin = 10.0f;
+
+    /** @brief Radius of the ball. */
+    static constexpr float BallRadius = 2.5f;
+
+    /** @brief Maximum number of balls of a multi-ball match. */
+    static constexpr int MaxBalls = 10'000;
+
+    /** @brief Width scale of the texts of the scores. */
+    static constexpr float ScoreWidth = 15.0f;
+
+    /**
+     * @brief Defines the initial positions of the elements of a match.
+     */
+    struct MatchLayout
+    {
+        /** @brief Position of the score of player A. */
+        glm::vec2 scoreA;
+
+        /** @brief Position of the score of player B. */
+        glm::vec2 scoreB;
+
+        /** @brief Position of the paddle of player A (right). */
+        glm::vec2 paddleA;
+
+        /** @brief Position of the paddle of player B (left). */
+        glm::vec2 paddleB;
+
+        /** @brief Position of the ball. */
+        glm::vec2 ball;
+    };
+
+    /**
+     * @brief Calculates the initial positions of the elements of a match on a table.
+     * @param table Table.
+     * @return Layout.
+     */
+    [[nodiscard]] static MatchLayout matchLayout(const Table& table) noexcept;
+
     /**
      * @brief Defines an enumeration with the game states.
      */
@@ -82,13 +148,27 @@ class Game
         Kickoff = 7  //!< The pre-round "kickoff" prompt is shown.
     };
 
-public:
+    /**
+     * @brief Defines an enumeration with the stages of an update, in the order `update()` runs them.
+     *
+     * The stages let a host of many matches run each stage for a group of matches before the next one (see
+     * `MatchHost`). Running them in order gives the same result as `update()`.
+     */
+    enum class Stage
+    {
+        Control = 0, //!< The timers of the match expire and the controllers decide the moves of the paddles.
+        Move    = 1, //!< The paddles move.
+        Ball    = 2, //!< The balls move and collide with the table and the paddles.
+        Score   = 3  //!< The points are counted, the balls of multi-ball matches collide with each other.
+    };
+
+    /** @brief Number of stages of an update. */
+    static constexpr std::size_t StageCount = 4;
 
     /**
      * @brief Constructor.
-     * @param audio A reference to the audio system for playing sounds.
      */
-    explicit Game(Audio& audio);
+    Game();
 
     Game(const Game&) = delete;
 
@@ -99,10 +179,43 @@ public:
     Game& operator=(Game&&) = delete;
 
     /**
-     * @brief Gets a reference to the audio system.
-     * @return A reference to the audio object.
+     * @brief Gets the gameplay events of the last ticks, to drain them after the ticks.
+     * @return A reference to the events.
+     */
+    [[nodiscard]] GameplayEvents& events() noexcept { return mEvents; }
+
+    /**
+     * @brief Gets the gameplay events of the last ticks.
+     * @return A reference to the events.
      */
-    [[nodiscard]] Audio& audio() const noexcept { return mAudio; }
+    [[nodiscard]] const GameplayEvents& events() const noexcept { return mEvents; }
+
+    /**
+     * @brief Gets the timers of the match, for the work its entities schedule.
+     *
+     * The wheel advances a tick before every update of the match scene and its timers are cancelled when the match
+     * ends, so they count updates of the match rather than time.
+     * @return A reference to the timers.
+     */
+    [[nodiscard]] TimerWheel& timers() noexcept { return mTimers; }
+
+    /**
+     * @brief Gets the current state of the game's state machine.
+     * @return State.
+     */
+    [[nodiscard]] State state() const noexcept { return mState; }
+
+    /**
+     * @brief Gets the score of player A (right paddle) in the current or last match.
+     * @return Score.
+     */
+    [[nodiscard]] int scoreA() const noexcept { return mScoreA; }
+
+    /**
+     * @brief Gets the score of player B (left paddle) in the current or last match.
+     * @return Score.
+     */
+    [[nodiscard]] int scoreB() const noexcept { return mScoreB; }
 
     /**
      * @brief Checks if the game has finished and the application should exit.
@@ -110,6 +223,83 @@ public:
      */
      [[nodiscard]] bool done() const noexcept { return mState == State::Done; }
 
+    /**
+     * @brief Gets the collision detection mode of the ball.
+     * @return Collision detection mode.
+     */
+    [[nodiscard]] physics::CollisionMode collisionMode() const noexcept { return mCollisionMode; }
+
+    /**
+     * @brief Sets the collision detection mode of the ball, for the current and the next matches.
+     *
+     * The swept mode allows updating the game with time steps several times larger than the usual ones.
+     * @param mode Collision detection mode.
+     */
+    void setCollisionMode(physics::CollisionMode mode);
+
+    /**
+     * @brief Gets the seed of the AI for the next match started from the menus.
+     * @return Seed.
+     */
+    [[nodiscard]] std::uint32_t seed() const noexcept { return mSeed; }
+
+    /**
+     * @brief Sets the seed of the AI for the next match started from the menus.
+     *
+     * Every match started from the menus seeds the random generators of its AI from this seed and then increments it,
+     * so the matches are different but reproducible.
+     * @param seed Seed.
+     */
+    void setSeed(std::uint32_t seed) noexcept { mSeed = seed; }
+
+    /**
+     * @brief Gets the number of balls of the next matches.
+     * @return Number of balls.
+     */
+    [[nodiscard]] int balls() const noexcept { return mBallCount; }
+
+    /**
+     * @brief Sets the number of balls of the next matches.
+     *
+     * With more than one ball (multi-ball mode) there is no kickoff: every ball that scores a point is served again
+     * from the center of the table, the balls bounce off each other, and the paddles of the AI follow the ball that
+     * will reach them first. The collisions are found with a `BallGrid`. The state of a multi-ball match is not saved
+     * in snapshots, so they cannot be used with replays or network sessions.
+     * @param count Number of balls, clamped to [1, MaxBalls].
+     */
+    void setBalls(int count) noexcept;
+
+    /**
+     * @brief Starts a match with the given controllers, whatever the current state is.
+     *
+     * This is how the tools play matches between custom controllers (e.g. variants of the AI); the menus only start
+     * matches with human players and the default AI.
+     * @param controllerA Controller of player A (right paddle).
+     * @param controllerB Controller of player B (left paddle).
+     */
+    void startMatch(std::unique_ptr<Controller> controllerA, std::unique_ptr<Controller> controllerB);
+
+    /**
+     * @brief Saves the complete state of the game.
+     *
+     * The snapshot is a flat block of plain data (see `GameSnapshot`), so saving the state costs about as much as
+     * copying it. Multi-ball matches are only flagged, they cannot be restored.
+     * @return Snapshot.
+     */
+    [[nodiscard]] GameSnapshot snapshot() const;
+
+    /**
+     * @brief Restores the complete state of the game.
+     *
+     * The game continues exactly as the one that took the snapshot. If the game already has a match with the same
+     * kinds of controllers (e.g. when restoring a snapshot of the same match) the entities are updated in place, which
+     * costs about as much as copying the state; otherwise the scenes are rebuilt.
+     * @param snapshot Snapshot, taken by this game or by another one.
+     * @return True if the state was restored, false if the snapshot is not valid for this build (in which case the
+     * game does not change).
+     */
+    [[nodiscard]] bool restore(const GameSnapshot& snapshot);
+
     /**
      * @brief Handles incoming game events, driving state transitions and player input.
      * @param event Event to handle.
@@ -124,6 +314,13 @@ public:
      */
     void update(TimeDuration dt);
 
+    /**
+     * @brief Runs a stage of the update of the game.
+     * @param stage Stage.
+     * @param dt The time elapsed since the last update (delta time).
+     */
+    void update(Stage stage, TimeDuration dt);
+
     /**
      * @brief Draws the current game state to the screen.
      *
@@ -132,75 +329,215 @@ public:
      */
     void draw(Renderer& renderer, float interp);
 
+    /**
+     * @brief Checks whether anything visible changed since the last call to `draw()`.
+     *
+     * The game changes when the menu shown changes or when the scene of the match or of the menu changes (see
+     * `Scene::changed()`). An unchanged game draws the same frame as the last one, so the application does not need to
+     * draw nor present it again.
+     * @return True if the game changed, false otherwise.
+     */
+    [[nodiscard]] bool changed() const;
+
 private:
 
-    /** @brief Sets up the scene for the main menu. */
-    void setupMain();
+    /**
+     * @brief Defines the menus shown over the game.
+     */
+    enum class Menu
+    {
+        Main,    //!< Main menu.
+        Help,    //!< Help screen.
+        Kickoff, //!< Kickoff prompt.
+        Abort,   //!< Abort confirmation.
+        WinA,    //!< Winning screen of player A (right).
+        WinB,    //!< Winning screen of player B (left).
+        Count    //!< Number of menus.
+    };
+
+    /**
+     * @brief Shows a menu, replacing the current one.
+     *
+     * The scene of every menu is built the first time it is shown, with the geometry of its labels already laid out,
+     * and is never modified afterwards, so showing a menu only changes the scene drawn over the game.
+     * @param menu Menu.
+     */
+    void showMenu(Menu menu);
+
+    /** @brief Hides the current menu, if any. */
+    void hideMenu() noexcept;
+
+    /**
+     * @brief Sets up the scene for the main menu.
+     * @param scene Scene of the menu.
+     */
+    static void setupMain(Scene& scene);
 
     /**
      * @brief Sets up the scene for a match.
-     * @param players Number of players (1 or 2).
+     * @param players Number of human players (0, 1 or 2). With zero players both paddles are driven by the AI.
      */
     void setupMatch(int players);
 
-    /** @brief Sets up the scene for the winning screen. */
-    void setupWin();
+    /**
+     * @brief Sets up the scene for a match.
+     * @param controllerA Controller of player A (right paddle).
+     * @param controllerB Controller of player B (left paddle).
+     * @param balls Number of balls.
+     */
+    void setupMatch(ArenaPtr<Controller> controllerA, ArenaPtr<Controller> controllerB, int balls);
 
-    /** @briefs Set up the scene for the abort screen. */
-    void setupAbort();
+    /**
+     * @brief Sets up the scene for the winning screen.
+     * @param scene Scene of the menu.
+     * @param playerA True if player A won, false if player B won.
+     */
+    static void setupWin(Scene& scene, bool playerA);
 
-    /** @brief Sets up the scene for the kickoff prompt. */
-    void setupKickoff();
+    /**
+     * @brief Sets up the scene for the abort screen.
+     * @param scene Scene of the menu.
+     */
+    static void setupAbort(Scene& scene);
 
-    /** @brief Set up the scene for the help screen. */
-    void setupHelp();
+    /**
+     * @brief Sets up the scene for the kickoff prompt.
+     * @param scene Scene of the menu.
+     */
+    static void setupKickoff(Scene& scene);
+
+    /**
+     * @brief Sets up the scene for the help screen.
+     * @param scene Scene of the menu.
+     */
+    static void setupHelp(Scene& scene);
 
     /** @brief Handles logic after a point is scored (updates scores, resets entities). */
     void scorePoints();
 
+    /** @brief Handles the points, the collisions between the balls and the balls followed by the AI of a multi-ball match. */
+    void updateBalls();
+
+    /**
+     * @brief Serves a ball of a multi-ball match from the center line, at a random height and angle.
+     * @param ball Ball.
+     * @param right True to serve it to the right (to player A), false to serve it to the left.
+     */
+    void serve(Ball& ball, bool right);
+
+    /**
+     * @brief Finds the ball that will reach a paddle first in a multi-ball match.
+     * @param paddle Paddle.
+     * @param right True for the paddle on the right, false for the one on the left.
+     * @return The ball, or the main one if no ball approaches the paddle.
+     */
+    [[nodiscard]] const Ball& nextBall(const Paddle& paddle, bool right) const;
+
     /** @brief Resets the game to a clean state for a new match or returning to the menu. */
     void clear();
 
-    /** @brief Clears only the menu scene. */
-    void clearMenus();
+    /**
+     * @brief Changes the state of the game, recording the change as a gameplay event.
+     * @param state State.
+     */
+    void setState(State state) noexcept;
 
-private:
+    /**
+     * @brief Counts a point, recording it as a gameplay event.
+     * @param ball Ball that scored.
+     */
+    void countPoint(const Ball& ball) noexcept;
+
+    /**
+     * @brief Gets an entity of the match that must exist, such as the table, the paddles, the balls and the labels of
+     * the scores during a match.
+     *
+     * A handle that does not resolve is a logic error of the game, which is reported before aborting.
+     * @tparam T Type of the entity.
+     * @param handle Handle of the entity in the match scene.
+     * @return The entity.
+     */
+    template<typename T>
+    [[nodiscard]] T& entity(const Handle<T> handle) const
+    {
+        T* entity = mSceneMatch.get(handle);
+        if (!entity)
+        {
+            missingEntity();
+        }
+
+        return *entity;
+    }
 
-    /** @brief A reference to the audio system. */
-    Audio& mAudio;
+    /**
+     * @brief Reports that an entity of the match no longer exists and aborts.
+     */
+    [[noreturn]] static void missingEntity();
+
+private:
 
     /** @brief  The current state of the game's state machine. */
     State mState = State::Start;
 
-    /** @brief Scene for the menus. */
-    Scene mSceneMenus;
+    /** @brief Scenes of the menus, built the first time they are shown. */
+    std::array<std::unique_ptr<Scene>, static_cast<std::size_t>(Menu::Count)> mMenus;
+
+    /** @brief Scene of the menu shown, null if there is none. */
+    Scene* mMenu = nullptr;
+
+    /** @brief Indicates whether the menu shown changed since the last call to `draw()`. */
+    bool mChanged = true;
+
+    /** @brief Gameplay events of the last ticks. */
+    GameplayEvents mEvents;
+
+    /** @brief Timers of the match, they outlive its scene so that its entities can cancel their timers. */
+    TimerWheel mTimers;
 
     /** @brief Scene for the match. */
     Scene mSceneMatch;
 
-    /** @brief  A non-owning pointer to the Player A paddle. Null if no match is active. */
-    Paddle* mPaddleA = nullptr;
+    /** @brief Handle of the Player A paddle in the match scene. Invalid if no match is active. */
+    Handle<Paddle> mPaddleA;
+
+    /** @brief Handle of the Player B paddle in the match scene. Invalid if no match is active. */
+    Handle<Paddle> mPaddleB;
+
+    /** @brief Handle of the ball in the match scene. Invalid if no match is active. */
+    Handle<Ball> mBall;
 
-    /** @brief A non-owning pointer to the Player B paddle. Null if no match is active. */
-    Paddle* mPaddleB = nullptr;
+    /** @brief Handles of all the balls of a multi-ball match, the first one is `mBall`. Empty otherwise. */
+    std::vector<Handle<Ball>> mBalls;
 
-    /** @brief A non-owning pointer to the ball. Null if no match is active. */
-    Ball* mBall = nullptr;
+    /** @brief Grid of the balls of a multi-ball match. Null otherwise. */
+    std::unique_ptr<BallGrid> mGrid;
 
-    /** @brief A non-owning pointer to the table. Null if no match is active. */
-    Table* mTable = nullptr;
+    /** @brief Random generator for the serves of a multi-ball match. */
+    Random mRandom;
 
-    /** @brief A non-owning pointer to the Player A score label. Null if no match is active. */
-    Label* mLabelScoreA = nullptr;
+    /** @brief Handle of the table in the match scene. Invalid if no match is active. */
+    Handle<Table> mTable;
 
-    /** @brief A non-owning pointer to the Player B score label. Null if no match is active. */
-    Label* mLabelScoreB = nullptr;
+    /** @brief Handle of the Player A score label in the match scene. Invalid if no match is active. */
+    Handle<Label> mLabelScoreA;
+
+    /** @brief Handle of the Player B score label in the match scene. Invalid if no match is active. */
+    Handle<Label> mLabelScoreB;
 
     /** @brief Score of player A. */
     int mScoreA = 0;
 
     /** @brief Score of player B. */
     int mScoreB = 0;
+
+    /** @brief Collision detection mode of the ball. */
+    physics::CollisionMode mCollisionMode = physics::CollisionMode::Discrete;
+
+    /** @brief Seed of the AI for the next match started from the menus. */
+    std::uint32_t mSeed = 1;
+
+    /** @brief Number of balls of the next matches. */
+    int mBallCount = 1;
 };
 
 } // namespace pong
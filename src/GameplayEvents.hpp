@@ -0,0 +1,168 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace pong {
+
+/**
+ * @brief Record of something that happened in a tick of the game, for the systems that react to it.
+ */
+struct GameplayEvent
+{
+    /** @brief Defines an enumeration with the types of gameplay events. */
+    enum class Type : std::uint8_t
+    {
+        WallHit   = 0, //!< The ball bounced off the top or the bottom of the table.
+        PaddleHit = 1, //!< The ball bounced off a paddle.
+        Point     = 2, //!< A player scored a point.
+        State     = 3  //!< The game changed of state.
+    };
+
+    /** @brief Type of event. */
+    Type type = Type::WallHit;
+
+    /** @brief Paddle hit, paddle hit (0 for A, 1 for B); point, player that scored (0 for A, 1 for B). */
+    std::uint8_t player = 0;
+
+    /** @brief State, new state of the game (`Game::State`). */
+    std::uint8_t state = 0;
+
+    /** @brief Padding, always zero. */
+    std::uint8_t reserved = 0;
+
+    /** @brief Paddle hit, position of the contact relative to the center of the paddle, in [-1, 1]. */
+    float offset = 0.0f;
+
+    /** @brief Position of the ball, except for state changes. */
+    glm::vec2 position = {};
+};
+
+static_assert(std::is_trivially_copyable_v<GameplayEvent>);
+
+/**
+ * @brief Defines a ring of the gameplay events of a game, written by the simulation and drained by the systems that
+ * react to them (audio, statistics...) after the ticks.
+ *
+ * The ring has a fixed capacity and lives in the game, so the simulation only copies records into it, without I/O,
+ * locks or allocations. If the events are not drained in time, the oldest ones are overwritten and counted as lost.
+ */
+class GameplayEvents
+{
+public:
+
+    /** @brief Maximum number of events kept, a power of two. */
+    static constexpr std::size_t Capacity = 256;
+
+    /**
+     * @brief Gets the number of events kept.
+     * @return Number of events.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+    /**
+     * @brief Checks if there are no events.
+     * @return True if there are no events, false otherwise.
+     */
+    [[nodiscard]] bool empty() const noexcept { return mSize == 0; }
+
+    /**
+     * @brief Gets the number of events overwritten before they were drained.
+     * @return Number of events.
+     */
+    [[nodiscard]] std::uint64_t lost() const noexcept { return mLost; }
+
+    /**
+     * @brief Gets an event, from the oldest.
+     * @param index Index of the event, less than `size()`.
+     * @return The event.
+     */
+    [[nodiscard]] const GameplayEvent& operator[](const std::size_t index) const noexcept
+    {
+        return mEvents[(mHead + index) & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Adds an event, overwriting the oldest one if the ring is full.
+     * @param event Event.
+     */
+    void push(const GameplayEvent& event) noexcept
+    {
+        if (mSize == Capacity)
+        {
+            mHead = (mHead + 1) & (Capacity - 1);
+            --mSize;
+            ++mLost;
+        }
+
+        mEvents[(mHead + mSize) & (Capacity - 1)] = event;
+        ++mSize;
+    }
+
+    /**
+     * @brief Calls a function for every event, from the oldest, and removes them.
+     * @param function Function taking the event.
+     */
+    template<typename F>
+    void drain(F&& function)
+    {
+        for (std::size_t i = 0; i < mSize; ++i)
+        {
+            function((*this)[i]);
+        }
+
+        clear();
+    }
+
+    /**
+     * @brief Removes all the events.
+     */
+    void clear() noexcept
+    {
+        mHead = 0;
+        mSize = 0;
+    }
+
+private:
+
+    /** @brief Events. */
+    std::array<GameplayEvent, Capacity> mEvents = {};
+
+    /** @brief Index of the oldest event. */
+    std::size_t mHead = 0;
+
+    /** @brief Number of events. */
+    std::size_t mSize = 0;
+
+    /** @brief Number of events overwritten. */
+    std::uint64_t mLost = 0;
+};
+
+} // namespace pong
@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace pong {
+
+/**
+ * @brief Defines a weak reference to an entity of a scene.
+ *
+ * A handle packs the index of the entity in the handle table of its scene and the generation of that entry in 32 bits.
+ * The scene increments the generation of an entry when its entity is destroyed, so the handles of destroyed entities
+ * are detected instead of pointing to freed memory, and the entities can be moved as long as the scene updates the
+ * entry. The null handle has the generation zero, which is never issued.
+ * @tparam T Type of the entity.
+ */
+template<typename T>
+class Handle
+{
+public:
+
+    /** @brief Number of bits of the index. */
+    static constexpr std::uint32_t IndexBits = 20;
+
+    /** @brief Number of bits of the generation. */
+    static constexpr std::uint32_t GenerationBits = 32 - IndexBits;
+
+    /** @brief Maximum number of entities of a scene. */
+    static constexpr std::uint32_t MaxIndex = (1u << IndexBits) - 1;
+
+    /** @brief Mask of the generation. */
+    static constexpr std::uint32_t GenerationMask = (1u << GenerationBits) - 1;
+
+    /**
+     * @brief Constructs a null handle.
+     */
+    constexpr Handle() noexcept = default;
+
+    /**
+     * @brief Constructor.
+     * @param index Index of the entity.
+     * @param generation Generation of the entry, not zero.
+     */
+    constexpr Handle(const std::uint32_t index, const std::uint32_t generation) noexcept
+        : mValue((generation << IndexBits) | (index & MaxIndex))
+    {}
+
+    /**
+     * @brief Converts a handle of a base or derived type.
+     *
+     * The conversion is explicit because the type of the entity is not checked, it must be `T` or derived from it.
+     * @param other Handle.
+     */
+    template<typename U> requires std::derived_from<T, U> || std::derived_from<U, T>
+    constexpr explicit Handle(const Handle<U>& other) noexcept
+        : mValue(other.value())
+    {}
+
+    /** @brief Gets the index of the entity. */
+    [[nodiscard]] constexpr std::uint32_t index() const noexcept { return mValue & MaxIndex; }
+
+    /** @brief Gets the generation of the entry. */
+    [[nodiscard]] constexpr std::uint32_t generation() const noexcept { return mValue >> IndexBits; }
+
+    /** @brief Gets the packed value of the handle. */
+    [[nodiscard]] constexpr std::uint32_t value() const noexcept { return mValue; }
+
+    /** @brief Checks if the handle is not null, it still may refer to an entity that no longer exists. */
+    [[nodiscard]] constexpr explicit operator bool() const noexcept { return generation() != 0; }
+
+    [[nodiscard]] constexpr bool operator==(const Handle&) const noexcept = default;
+
+private:
+
+    /** @brief Generation in the high bits and index in the low bits. */
+    std::uint32_t mValue = 0;
+};
+
+} // namespace pong
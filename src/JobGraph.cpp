@@ -0,0 +1,242 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "JobGraph.hpp"
+#include <algorithm>
+#include <span>
+
+namespace pong {
+
+JobGraph::JobGraph(int threads)
+{
+    if (threads <= 0)
+    {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    // The calling thread is one of them.
+    mWorkers.reserve(static_cast<std::size_t>(threads - 1));
+    for (int t = 1; t < threads; ++t)
+    {
+        mWorkers.emplace_back([this] { loop(); });
+    }
+}
+
+JobGraph::~JobGraph()
+{
+    {
+        const std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mStart.notify_all();
+    mWorkers.clear();
+}
+
+std::size_t JobGraph::addStage(const Function function, void* const context, const std::initializer_list<std::size_t> dependencies)
+{
+    // The dependencies on earlier stages only keep the graph acyclic.
+    if (std::ranges::any_of(dependencies, [this](const std::size_t stage) { return stage >= mStages.size(); }))
+    {
+        return SIZE_MAX;
+    }
+    // The threads of the pool that are still leaving the previous run read the stages and the jobs.
+    std::unique_lock lock(mMutex);
+    mIdle.wait(lock, [this] { return mActive == 0; });
+
+    mStages.push_back({function, context, mStageDependencies.size(), dependencies.size()});
+    mStageDependencies.insert(mStageDependencies.end(), dependencies);
+    mJobs.clear();
+
+    return mStages.size() - 1;
+}
+
+void JobGraph::build(const std::size_t lanes, std::size_t grain)
+{
+    // The threads of the pool that are still leaving the previous run read the jobs and the queue.
+    std::unique_lock lock(mMutex);
+    mIdle.wait(lock, [this] { return mActive == 0; });
+
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t groups = (lanes + grain - 1) / grain;
+    const std::size_t stages = mStages.size();
+    // The job of stage `s` of group `g` is `g * stages + s`, its successors are the stages of the same group that
+    // depend on `s`.
+    mJobs.assign(groups * stages, {});
+    mSuccessors.clear();
+    for (std::size_t g = 0; g < groups; ++g)
+    {
+        for (std::size_t s = 0; s < stages; ++s)
+        {
+            Job& job       = mJobs[g * stages + s];
+            job.stage      = static_cast<std::uint32_t>(s);
+            job.begin      = g * grain;
+            job.end        = std::min(lanes, job.begin + grain);
+            job.successors = static_cast<std::uint32_t>(mSuccessors.size());
+            for (std::size_t t = s + 1; t < stages; ++t)
+            {
+                const Stage& stage = mStages[t];
+                const std::span<const std::size_t> dependencies(mStageDependencies.data() + stage.dependencies, stage.dependencyCount);
+                if (std::ranges::find(dependencies, s) != dependencies.end())
+                {
+                    mSuccessors.push_back(static_cast<std::uint32_t>(g * stages + t));
+                    ++mJobs[g * stages + t].dependencies;
+                }
+            }
+            job.successorCount = static_cast<std::uint32_t>(mSuccessors.size()) - job.successors;
+        }
+    }
+
+    mPending = std::make_unique<std::atomic<std::uint32_t>[]>(mJobs.size());
+    mReady   = std::make_unique<std::atomic<std::uint32_t>[]>(mJobs.size());
+    // A thread of the pool that wakes up late for the previous run finds it complete, until the next run starts.
+    mCompleted.store(mJobs.size(), std::memory_order_relaxed);
+}
+
+void JobGraph::run()
+{
+    if (mJobs.empty())
+    {
+        return;
+    }
+    {
+        // A thread of the pool may still be leaving the previous run, the state is only reset once all have left.
+        std::unique_lock lock(mMutex);
+        mIdle.wait(lock, [this] { return mActive == 0; });
+
+        mHead.store(0, std::memory_order_relaxed);
+        mTail.store(0, std::memory_order_relaxed);
+        mCompleted.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < mJobs.size(); ++i)
+        {
+            mPending[i].store(mJobs[i].dependencies, std::memory_order_relaxed);
+            mReady[i].store(None, std::memory_order_relaxed);
+        }
+        // The jobs without dependencies are ready.
+        for (std::size_t i = 0; i < mJobs.size(); ++i)
+        {
+            if (mJobs[i].dependencies == 0)
+            {
+                push(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        ++mRun;
+    }
+    mStart.notify_all();
+
+    work();
+}
+
+void JobGraph::work() noexcept
+{
+    const std::size_t total = mJobs.size();
+    while (mCompleted.load(std::memory_order_acquire) < total)
+    {
+        std::uint32_t index = take();
+        if (index == None)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        // Run the job, and then the first successor it makes ready, on this thread.
+        while (index != None)
+        {
+            const Job&   job   = mJobs[index];
+            const Stage& stage = mStages[job.stage];
+            stage.function(stage.context, job.begin, job.end);
+
+            std::uint32_t next = None;
+            for (std::uint32_t i = job.successors; i < job.successors + job.successorCount; ++i)
+            {
+                const std::uint32_t successor = mSuccessors[i];
+                if (mPending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    if (next == None)
+                    {
+                        next = successor;
+                    }
+                    else
+                    {
+                        push(successor);
+                    }
+                }
+            }
+
+            mCompleted.fetch_add(1, std::memory_order_release);
+            index = next;
+        }
+    }
+}
+
+std::uint32_t JobGraph::take() noexcept
+{
+    std::uint32_t head = mHead.load(std::memory_order_relaxed);
+    while (head < mJobs.size())
+    {
+        // The slot is empty until the job is pushed.
+        const std::uint32_t job = mReady[head].load(std::memory_order_acquire);
+        if (job == None)
+        {
+            return None;
+        }
+        if (mHead.compare_exchange_weak(head, head + 1, std::memory_order_relaxed))
+        {
+            return job;
+        }
+    }
+
+    return None;
+}
+
+void JobGraph::push(const std::uint32_t job) noexcept
+{
+    mReady[mTail.fetch_add(1, std::memory_order_relaxed)].store(job, std::memory_order_release);
+}
+
+void JobGraph::loop() noexcept
+{
+    std::uint64_t run = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock(mMutex);
+            mStart.wait(lock, [this, run] { return mStop || mRun != run; });
+            if (mStop)
+            {
+                return;
+            }
+            run = mRun;
+            ++mActive;
+        }
+
+        work();
+
+        {
+            const std::lock_guard lock(mMutex);
+            --mActive;
+        }
+        mIdle.notify_one();
+    }
+}
+
+} // namespace pong
@@ -0,0 +1,237 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pong {
+
+/**
+ * @brief Runs a graph of stages over many independent lanes (e.g. matches) on a pool of threads.
+ *
+ * The stages are declared once, each one with the stages it depends on, and the lanes are split into groups of a fixed
+ * size. A job is a stage of a group: it depends on the jobs of the stages it depends on for the same group, so every
+ * group goes through the stages in order while the groups progress independently of each other, without barriers
+ * between the stages.
+ *
+ * The jobs, their dependencies and the queue of ready jobs are allocated when the graph is built, so running it does
+ * not allocate. A run counts down the pending dependencies of every job with atomics; a thread that completes a job
+ * runs the first successor it makes ready itself and publishes the others in the queue, a fixed array where every job
+ * is pushed once per run. The threads of the pool sleep between runs and the calling thread runs jobs too.
+ */
+class JobGraph
+{
+public:
+
+    /**
+     * @brief Defines the function of a stage.
+     * @param context Context of the stage.
+     * @param begin First lane of the group.
+     * @param end Lane after the last lane of the group.
+     */
+    using Function = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Constructor.
+     * @param threads Number of threads running the jobs, the calling thread included; zero for one per hardware thread.
+     */
+    explicit JobGraph(int threads);
+
+    JobGraph(const JobGraph&) = delete;
+
+    JobGraph(JobGraph&&) = delete;
+
+    JobGraph& operator=(const JobGraph&) = delete;
+
+    JobGraph& operator=(JobGraph&&) = delete;
+
+    /**
+     * @brief Destructor, stops the threads.
+     */
+    ~JobGraph();
+
+    /**
+     * @brief Gets the number of threads running the jobs, the calling thread included.
+     * @return Number of threads.
+     */
+    [[nodiscard]] int threads() const noexcept { return static_cast<int>(mWorkers.size()) + 1; }
+
+    /**
+     * @brief Gets the number of jobs of a run.
+     * @return Number of jobs.
+     */
+    [[nodiscard]] std::size_t jobs() const noexcept { return mJobs.size(); }
+
+    /**
+     * @brief Adds a stage, the jobs are built again by the next `build()`.
+     *
+     * It waits for the threads of the pool to leave the previous run, if any.
+     * @param function Function of the stage.
+     * @param context Context passed to the function.
+     * @param dependencies Indices of the stages that must complete for a group before this one runs for it, they must
+     * be stages added before.
+     * @return The index of the stage, or `SIZE_MAX` if a dependency is not a stage added before.
+     */
+    std::size_t addStage(Function function, void* context, std::initializer_list<std::size_t> dependencies = {});
+
+    /**
+     * @brief Builds the jobs of the stages for a number of lanes.
+     *
+     * It waits for the threads of the pool to leave the previous run, if any.
+     * @param lanes Number of lanes.
+     * @param grain Number of lanes of a group, the last group may have less.
+     */
+    void build(std::size_t lanes, std::size_t grain);
+
+    /**
+     * @brief Runs every job of the graph once and waits for all of them to complete.
+     */
+    void run();
+
+private:
+
+    /** @brief Defines a stage. */
+    struct Stage
+    {
+        /** @brief Function. */
+        Function function = nullptr;
+
+        /** @brief Context of the function. */
+        void* context = nullptr;
+
+        /** @brief First dependency in `mStageDependencies`. */
+        std::size_t dependencies = 0;
+
+        /** @brief Number of dependencies. */
+        std::size_t dependencyCount = 0;
+    };
+
+    /** @brief Defines a job, a stage of a group of lanes. */
+    struct Job
+    {
+        /** @brief Stage. */
+        std::uint32_t stage = 0;
+
+        /** @brief Number of jobs it depends on. */
+        std::uint32_t dependencies = 0;
+
+        /** @brief First successor in `mSuccessors`. */
+        std::uint32_t successors = 0;
+
+        /** @brief Number of successors. */
+        std::uint32_t successorCount = 0;
+
+        /** @brief First lane. */
+        std::size_t begin = 0;
+
+        /** @brief Lane after the last one. */
+        std::size_t end = 0;
+    };
+
+    /** @brief Index of no job. */
+    static constexpr std::uint32_t None = UINT32_MAX;
+
+    /**
+     * @brief Runs jobs until all the jobs of the run are complete.
+     */
+    void work() noexcept;
+
+    /**
+     * @brief Takes a job from the queue.
+     * @return The job, or `None` if the queue has no job ready.
+     */
+    std::uint32_t take() noexcept;
+
+    /**
+     * @brief Pushes a ready job into the queue.
+     * @param job Job.
+     */
+    void push(std::uint32_t job) noexcept;
+
+    /**
+     * @brief Waits for runs and takes part in them, the loop of the threads of the pool.
+     */
+    void loop() noexcept;
+
+private:
+
+    /** @brief Stages. */
+    std::vector<Stage> mStages;
+
+    /** @brief Dependencies of the stages. */
+    std::vector<std::size_t> mStageDependencies;
+
+    /** @brief Jobs. */
+    std::vector<Job> mJobs;
+
+    /** @brief Successors of the jobs. */
+    std::vector<std::uint32_t> mSuccessors;
+
+    /** @brief Pending dependencies of every job in the current run. */
+    std::unique_ptr<std::atomic<std::uint32_t>[]> mPending;
+
+    /** @brief Queue of ready jobs, `None` until pushed. */
+    std::unique_ptr<std::atomic<std::uint32_t>[]> mReady;
+
+    /** @brief Next job to take from the queue. */
+    std::atomic<std::uint32_t> mHead = 0;
+
+    /** @brief Next slot to push into the queue. */
+    std::atomic<std::uint32_t> mTail = 0;
+
+    /** @brief Number of completed jobs in the current run. */
+    std::atomic<std::size_t> mCompleted = 0;
+
+    /** @brief Mutex of the state of the threads. */
+    std::mutex mMutex;
+
+    /** @brief Condition to wake the threads of the pool when a run starts. */
+    std::condition_variable mStart;
+
+    /** @brief Condition to wake the caller when the last thread leaves a run. */
+    std::condition_variable mIdle;
+
+    /** @brief Number of the current run, the threads take part in a run when it changes. */
+    std::uint64_t mRun = 0;
+
+    /** @brief Number of threads of the pool in a run. */
+    int mActive = 0;
+
+    /** @brief Flag to stop the threads of the pool. */
+    bool mStop = false;
+
+    /** @brief Threads of the pool. */
+    std::vector<std::jthread> mWorkers;
+};
+
+} // namespace pong
@@ -29,21 +29,23 @@
 
 namespace pong {
 
-Label::Label(const float width, const glm::vec2 position, const glm::vec4& color, std::string text) noexcept
+Label::Label(const float width, const glm::vec2 position, const glm::vec4& color, const std::string_view text, const allocator_type& allocator)
     :
-    Entity(Type::Label), mWidth(width), mPosition(position), mColor(color), mText(std::move(text))
+    Entity(Type::Label), mWidth(width), mPosition(position), mColor(color), mText(text, allocator), mCharQuads(allocator)
 {}
 
 void Label::setHAlign(const HAlign h)
 {
     mHAlign = h;
     mDirty  = true;
+    markChanged();
 }
 
 void Label::setVAlign(const VAlign v)
 {
     mVAlign = v;
     mDirty  = true;
+    markChanged();
 }
 
 void Label::setAlign(const HAlign h, const VAlign v)
@@ -52,46 +54,72 @@ void Label::setAlign(const HAlign h, const VAlign v)
     setVAlign(v);
 }
 
-void Label::setText(std::string text)
+void Label::setText(const std::string_view text)
 {
-    mText  = std::move(text);
+    mText.assign(text);
     mDirty = true;
+    markChanged();
+}
+
+void Label::setRetained(const bool retained)
+{
+    mRetained = retained;
+    mMesh.reset();
 }
 
 void Label::draw(Renderer& renderer, const float interp)
 {
     if (mDirty)
     {
-        mDirty = false;
         updateGeometry();
     }
 
-    for (const auto& [position, size] : mCharQuads)
+    const auto queueQuads = [this](Renderer& r)
+    {
+        for (const auto& [position, size] : mCharQuads)
+        {
+            r.queueQuad(position, size, mColor);
+        }
+    };
+
+    if (mRetained)
+    {
+        mMesh.draw(renderer, queueQuads);
+    }
+    else
     {
-        renderer.queueQuad(position, size, mColor);
+        queueQuads(renderer);
     }
 }
 
 void Label::updateGeometry()
 {
-    mCharQuads.clear();
-    if (mText.empty())
+    layout(mText, mWidth, mPosition, mHAlign, mVAlign, mCharQuads);
+    mDirty = false;
+    // The mesh is recorded again with the new quads.
+    mMesh.reset();
+}
+
+void Label::layout(const std::string_view text, const float width, const glm::vec2 position, const HAlign hAlign, const VAlign vAlign, std::pmr::vector<CharQuad>& quads)
+{
+    quads.clear();
+    if (text.empty())
     {
         return;
     }
 
     float ox = 0;
     float oy = 0;
-    const float scale  = mWidth / data::font::Advance;
+    const float scale  = width / data::font::Advance;
     // Horizontal alignment.
-    switch (mHAlign)
+    switch (hAlign)
     {
         case HAlign::Left:   { ox = 0.0f; } break;
-        case HAlign::Center: { ox = static_cast<float>(mText.length()) * -mWidth * 0.5f; } break;
-        case HAlign::Right:  { ox = static_cast<float>(mText.length()) * -mWidth; } break;
+        case HAlign::Center: { ox = static_cast<float>(text.length()) * -width * 0.5f; } break;
+        case HAlign::Right:  { ox = static_cast<float>(text.length()) * -width; } break;
     }
     // Vertical alignment.
-    switch (mVAlign)
+    switch (vAlign)
     {
         case VAlign::Top:    { oy -= static_cast<float>(data::font::MaxHeight) * scale; } break;
         case VAlign::Middle: { oy -= static_cast<float>(data::font::MaxHeight) * scale * 0.5f; } break;
@@ -100,13 +128,13 @@ void Label::updateGeometry()
 
     int n = 0;
     // Decode the string and generate the quads to render.
-    for (uint32_t cpos = 0, state = 0, codepoint; cpos < mText.length(); ++cpos)
+    for (uint32_t cpos = 0, state = 0, codepoint; cpos < text.length(); ++cpos)
     {
-        if (utf8d::decode(static_cast<uint8_t>(mText[cpos]), state, codepoint) == utf8d::Accept)
+        if (utf8d::decode(static_cast<uint8_t>(text[cpos]), state, codepoint) == utf8d::Accept)
         {
             if (codepoint != 0x20) {
                 if (auto span = data::font::getGlyph(codepoint); !span.empty()) {
-                    const float advance = ox + mWidth * static_cast<float>(n);
+                    const float advance = ox + width * static_cast<float>(n);
 
                     for (std::size_t i = 2; i < span.size(); i += 4)
                     {
@@ -120,7 +148,7 @@ void Label::updateGeometry()
                         // Scale size.
                         sca *= scale;
 
-                        mCharQuads.emplace_back(pos + mPosition, sca);
+                        quads.emplace_back(pos + position, sca);
                     }
                 }
             }
@@ -25,8 +25,12 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "StaticMesh.hpp"
 #include <glm/glm.hpp>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace pong {
 
@@ -35,11 +39,16 @@ namespace pong {
  *
  * This class handles text rendering, including alignment and color. It uses a "dirty flag" optimization to only
  * recalculate text geometry when the text content or its properties (alignment, width) actually change, significantly
- * improving performance for static labels.
+ * improving performance for static labels. Unless it is marked as dynamic, the label records its quads as a static
+ * mesh of the renderer and draws the mesh, recording it again only after the geometry changes.
+ *
+ * The text and the quads are stored with a `std::pmr` allocator, so the labels of a scene keep them in its arena.
  * @see pong::data::font::getGlyph
  */
 class Label final : public Entity
 {
+public:
+
     /**
      * @brief Stores pre-calculated position and size for a single quad used to render a character segment.
      */
@@ -49,8 +58,6 @@ class Label final : public Entity
         glm::vec2 size;
     };
 
-public:
-
     /**
      * @brief Define an enumeration with the horizontal alignment modes.
      */
@@ -61,14 +68,20 @@ public:
      */
     enum class VAlign { Top, Middle, Bottom };
 
+    /**
+     * @brief Allocator for the text and the quads.
+     */
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     /**
      * @brief Constructor.
      * @param width Desired width scale of the text.
      * @param position Base position of the label.
      * @param color RGBA color of the text.
      * @param text Text to display.
+     * @param allocator Allocator for the text and the quads, the default memory resource if none is given.
      */
-    Label(float width, glm::vec2 position, const glm::vec4& color, std::string text) noexcept;
+    Label(float width, glm::vec2 position, const glm::vec4& color, std::string_view text, const allocator_type& allocator = {});
 
     /**
      * @brief Gets the horizontal alignment.
@@ -105,13 +118,28 @@ public:
      * @brief Gets the text.
      * @return Text.
      */
-    [[nodiscard]] const std::string& text() const noexcept { return mText; }
+    [[nodiscard]] std::string_view text() const noexcept { return mText; }
 
     /**
-     * @brief Sets the text.
+     * @brief Sets the text, reusing the memory of the current one when it is large enough.
      * @param text Text to set.
      */
-    void setText(std::string text);
+    void setText(std::string_view text);
+
+    /**
+     * @brief Checks if the quads are recorded as a static mesh of the renderer.
+     * @return True if they are, false if they are queued every frame.
+     */
+    [[nodiscard]] bool retained() const noexcept { return mRetained; }
+
+    /**
+     * @brief Sets if the quads are recorded as a static mesh of the renderer, which is the default.
+     *
+     * Labels whose text changes often (e.g. the scores) queue their quads every frame instead of recording a new mesh
+     * after every change.
+     * @param retained True to record the quads as a static mesh, false to queue them every frame.
+     */
+    void setRetained(bool retained);
 
     /**
      * @brief Draws the label on the screen.
@@ -120,13 +148,22 @@ public:
      */
     void draw(Renderer& renderer, float interp) override;
 
-private:
+    /**
+     * @brief Calculates the quads of the characters of a text.
+     * @param text Text.
+     * @param width Width scale of the text.
+     * @param position Base position of the text.
+     * @param hAlign Horizontal alignment.
+     * @param vAlign Vertical alignment.
+     * @param quads Vector where the quads are stored, it is cleared first.
+     */
+    static void layout(std::string_view text, float width, glm::vec2 position, HAlign hAlign, VAlign vAlign, std::pmr::vector<CharQuad>& quads);
 
     /**
      * @brief Recalculates the geometry of the characters quads.
      *
-     * This potentially costly method is called only when the text content or its rendering properties (alignment,
-     * width) have changed (i.e., `mDirty` is true).
+     * This potentially costly method is called by `draw()` only when the text content or its rendering properties
+     * (alignment, width) have changed (i.e., `mDirty` is true). Call it to lay out a label before its first draw.
      */
     void updateGeometry();
 
@@ -148,13 +185,19 @@ private:
     glm::vec4 mColor = glm::vec4(1.0f);
 
     /** @brief Text. */
-    std::string mText = "label";
+    std::pmr::string mText;
 
     /** @brief Flag indicating whether the geometry needs recalculation or not. */
     bool mDirty = true;
 
+    /** @brief Flag indicating whether the quads are recorded as a static mesh or queued every frame. */
+    bool mRetained = true;
+
     /** @brief List of characters quads to render. */
-    std::vector<CharQuad> mCharQuads;
+    std::pmr::vector<CharQuad> mCharQuads;
+
+    /** @brief Mesh of the characters quads, if the label is retained. */
+    StaticMesh mMesh;
 };
 
 } // namespace pong
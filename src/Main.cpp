@@ -23,7 +23,10 @@
 ////////////////////////////////////////////////////////////
 
 #include "App.hpp"
+#include <algorithm>
+#include <iostream>
 #include <memory>
+#include <string_view>
 #include <SDL.h>
 
 ////////////////////////////////////////////////////////////
@@ -34,6 +37,12 @@ int main(const int argc, char* argv[])
     if (app)
     {
         app->exec();
+        // Report the frames presented and skipped when requested.
+        if (std::find(argv + 1, argv + argc, std::string_view("--stats")) != argv + argc)
+        {
+            const pong::App::Stats& stats = app->stats();
+            std::cout << "Frames: " << stats.frames << " presented, " << stats.skippedFrames << " skipped" << std::endl;
+        }
     }
 
     return EXIT_SUCCESS;
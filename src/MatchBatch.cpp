@@ -0,0 +1,431 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "MatchBatch.hpp"
+#include "Game.hpp"
+#include "Paddle.hpp"
+#include "Physics.hpp"
+#include "PhysicsFixed.hpp"
+#include "Table.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace pong {
+
+MatchBatch::MatchBatch(const std::size_t size, const physics::CollisionMode mode)
+    :
+    mMode        (mode),
+    mBallX       (size),
+    mBallY       (size),
+    mBallSpeedX  (size),
+    mBallSpeedY  (size),
+    mPaddleAY    (size),
+    mPaddleBY    (size),
+    mInputA      (size),
+    mInputB      (size),
+    mScoreA      (size),
+    mScoreB      (size),
+    mFinished    (size),
+    mTicks       (size),
+    mActive      (size),
+    mBallTime    (size),
+    mPaddleASpeed(size),
+    mPaddleATime (size),
+    mPaddleBSpeed(size),
+    mPaddleBTime (size)
+{
+    // The limits are calculated by a table so they are bit-exact with the ones used by the entities.
+    const Table table(Game::TablePosition, Game::TableSize);
+    mTableTop    = table.top();
+    mTableBottom = table.bottom();
+    mTableLeft   = table.left();
+    mTableRight  = table.right();
+    // The paddles are placed as in `Game::scorePoints`.
+    mPaddleAX    = Scalar(toFloat(mTableRight) - Game::PaddleMargin);
+    mPaddleBX    = Scalar(toFloat(mTableLeft)  + Game::PaddleMargin);
+#if !defined(PONG_FIXED_POINT)
+    // Up to two paddles with two lines per match.
+    const std::size_t pairs = size * 4;
+    mSimdLevel = physics::detectSimdLevel();
+    mPaddleTests.cx    .resize(pairs);
+    mPaddleTests.cy    .resize(pairs);
+    mPaddleTests.r     .resize(pairs, Game::BallRadius);
+    mPaddleTests.ax    .resize(pairs);
+    mPaddleTests.ay    .resize(pairs);
+    mPaddleTests.bx    .resize(pairs);
+    mPaddleTests.by    .resize(pairs);
+    mPaddleTests.px    .resize(pairs);
+    mPaddleTests.py    .resize(pairs);
+    mPaddleTests.masks .resize((pairs + 31) / 32);
+    mPaddleTests.owners.resize(pairs);
+    mPaddleTests.hits  .resize(size);
+    mPaddleTests.whereY.resize(size);
+#endif
+
+    reset();
+}
+
+void MatchBatch::reset()
+{
+    mClock = 0;
+
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        mInputA  [i] = 0;
+        mInputB  [i] = 0;
+
+        kickoff(i, Game::InitialSpeed, 0.0);
+
+        mScoreA  [i] = 0;
+        mScoreB  [i] = 0;
+        mFinished[i] = 0;
+        mTicks   [i] = 0;
+        mActive  [i] = static_cast<std::uint32_t>(i);
+    }
+
+    mFinishedCount = 0;
+}
+
+void MatchBatch::setInput(const std::size_t match, const int directionA, const int directionB)
+{
+    const auto inputA = static_cast<std::int8_t>(glm::sign(directionA));
+    const auto inputB = static_cast<std::int8_t>(glm::sign(directionB));
+    // In the swept mode the paddles move from the position they have when the input changes.
+    if (mMode == physics::CollisionMode::Swept)
+    {
+        if (inputA != mInputA[match])
+        {
+            mPaddleAY    [match] = Scalar(paddlePositionA(match).y);
+            mPaddleASpeed[match] = Paddle::MovementSpeed * inputA;
+            mPaddleATime [match] = now();
+        }
+
+        if (inputB != mInputB[match])
+        {
+            mPaddleBY    [match] = Scalar(paddlePositionB(match).y);
+            mPaddleBSpeed[match] = Paddle::MovementSpeed * inputB;
+            mPaddleBTime [match] = now();
+        }
+    }
+
+    mInputA[match] = inputA;
+    mInputB[match] = inputB;
+}
+
+glm::vec2 MatchBatch::ballPosition(const std::size_t match) const
+{
+    if (mMode == physics::CollisionMode::Swept)
+    {
+        return physics::positionAt(sweptBall(match), now());
+    }
+
+    return {toFloat(mBallX[match]), toFloat(mBallY[match])};
+}
+
+glm::vec2 MatchBatch::paddlePositionA(const std::size_t match) const
+{
+    if (mMode == physics::CollisionMode::Swept)
+    {
+        return physics::positionAt(sweptPaddle(toFloat(mPaddleAX), toFloat(mPaddleAY[match]), mPaddleASpeed[match], mPaddleATime[match]), now());
+    }
+
+    return {toFloat(mPaddleAX), toFloat(mPaddleAY[match])};
+}
+
+glm::vec2 MatchBatch::paddlePositionB(const std::size_t match) const
+{
+    if (mMode == physics::CollisionMode::Swept)
+    {
+        return physics::positionAt(sweptPaddle(toFloat(mPaddleBX), toFloat(mPaddleBY[match]), mPaddleBSpeed[match], mPaddleBTime[match]), now());
+    }
+
+    return {toFloat(mPaddleBX), toFloat(mPaddleBY[match])};
+}
+
+void MatchBatch::step(const TimeDuration dt)
+{
+    const std::size_t finished = mFinishedCount;
+
+    if (mMode == physics::CollisionMode::Swept)
+    {
+        stepSwept(dt);
+    }
+    else
+    {
+        stepDiscrete(dt);
+    }
+    // Drop the matches that have finished in this step from the list of active matches, keeping the order to access
+    // the arrays sequentially.
+    if (mFinishedCount > finished)
+    {
+        std::erase_if(mActive, [this](const std::uint32_t i) { return mFinished[i] != 0; });
+    }
+}
+
+void MatchBatch::stepDiscrete(const TimeDuration dt)
+{
+    // The displacements are calculated as in `Paddle::move` and `Ball::update`.
+    const Scalar dyUp   = distance( Scalar(Paddle::MovementSpeed), dt);
+    const Scalar dyDown = distance(-Scalar(Paddle::MovementSpeed), dt);
+    const Scalar sdt    = Scalar(dt.count());
+    const Vector size   = toVector(Game::PaddleSize);
+    const Scalar halfW  = size.x * Scalar(0.5f);
+    const Scalar halfH  = size.y * Scalar(0.5f);
+    const Scalar radius = Scalar(Game::BallRadius);
+
+    for (const std::uint32_t i : mActive)
+    {
+        ++mTicks[i];
+        // Paddles, in the same order as they are stored in the scene.
+        mPaddleAY[i] = mPaddleAY[i] + (mInputA[i] > 0 ? dyUp : (mInputA[i] < 0 ? dyDown : Scalar(0)));
+        if (mPaddleAY[i] + halfH > mTableTop)    { mPaddleAY[i] = mTableTop    - halfH; }
+        if (mPaddleAY[i] - halfH < mTableBottom) { mPaddleAY[i] = mTableBottom + halfH; }
+
+        mPaddleBY[i] = mPaddleBY[i] + (mInputB[i] > 0 ? dyUp : (mInputB[i] < 0 ? dyDown : Scalar(0)));
+        if (mPaddleBY[i] + halfH > mTableTop)    { mPaddleBY[i] = mTableTop    - halfH; }
+        if (mPaddleBY[i] - halfH < mTableBottom) { mPaddleBY[i] = mTableBottom + halfH; }
+        // Ball movement.
+        Vector speed    = Vector(mBallSpeedX[i], mBallSpeedY[i]);
+        Vector position = Vector(mBallX[i], mBallY[i]) + speed * sdt;
+        // Walls.
+        if (position.y + radius > mTableTop)
+        {
+            position.y = mTableTop - radius;
+            speed.y    = -speed.y;
+        }
+
+        if (position.y - radius < mTableBottom)
+        {
+            position.y = mTableBottom + radius;
+            speed.y    = -speed.y;
+        }
+
+        mBallX     [i] = position.x;
+        mBallY     [i] = position.y;
+        mBallSpeedY[i] = speed.y;
+    }
+#if !defined(PONG_FIXED_POINT)
+    testPaddles();
+#endif
+    for (const std::uint32_t i : mActive)
+    {
+        Vector position = Vector(mBallX[i], mBallY[i]);
+        // Score, `pointA` has priority as it does in `Ball::checkScore`.
+        const bool pointB = position.x + radius > mTableRight;
+        const bool pointA = position.x - radius < mTableLeft;
+        // Paddles, the contact point of paddle B has priority as it does in `Ball::checkPaddleCollisions`.
+        const Vector paddleA = Vector(mPaddleAX, mPaddleAY[i]);
+        const Vector paddleB = Vector(mPaddleBX, mPaddleBY[i]);
+#if defined(PONG_FIXED_POINT)
+        Vector       where;
+        const bool   ca      = physics::collisionBallPaddle(position, radius, paddleA, size, where);
+        const bool   cb      = physics::collisionBallPaddle(position, radius, paddleB, size, where);
+#else
+        const Vector where   = Vector(0.0f, mPaddleTests.whereY[i]);
+        const bool   ca      = (mPaddleTests.hits[i] & 1u) != 0;
+        const bool   cb      = (mPaddleTests.hits[i] & 2u) != 0;
+#endif
+        if (ca || cb)
+        {
+            Scalar rDist = Scalar(0);
+
+            if (ca)
+            {
+                position.x = paddleA.x - halfW - radius;
+                rDist = (where.y - paddleA.y) / halfH;
+            }
+
+            if (cb)
+            {
+                position.x = paddleB.x + halfW + radius;
+                rDist = (where.y - paddleB.y) / halfH;
+            }
+
+            const Vector speed = physics::bounce(Vector(mBallSpeedX[i], mBallSpeedY[i]), rDist);
+
+            mBallX     [i] = position.x;
+            mBallSpeedX[i] = speed.x;
+            mBallSpeedY[i] = speed.y;
+        }
+
+        if (pointA || pointB)
+        {
+            scorePoint(i, pointA, 0.0);
+        }
+    }
+}
+
+#if !defined(PONG_FIXED_POINT)
+void MatchBatch::testPaddles()
+{
+    // Same broad phase and lines as `physics::collisionBallPaddle`.
+    const glm::vec2 size  = Game::PaddleSize;
+    const float     radii = glm::length(size * 0.5f) + Game::BallRadius;
+    PaddleTests&    tests = mPaddleTests;
+    std::size_t     count = 0;
+
+    for (const std::uint32_t i : mActive)
+    {
+        const glm::vec2 c = {mBallX[i], mBallY[i]};
+        tests.hits[i] = 0;
+
+        for (std::uint32_t paddle = 0; paddle < 2; ++paddle)
+        {
+            const glm::vec2 position = paddle == 0 ? glm::vec2(mPaddleAX, mPaddleAY[i]) : glm::vec2(mPaddleBX, mPaddleBY[i]);
+            if (glm::length2(position - c) > (radii * radii))
+            {
+                continue;
+            }
+            // The front line first and then the back line.
+            for (const float x : {position.x - size.x * 0.5f, position.x + size.x * 0.5f})
+            {
+                tests.cx    [count] = c.x;
+                tests.cy    [count] = c.y;
+                tests.ax    [count] = x;
+                tests.ay    [count] = position.y - size.y * 0.5f;
+                tests.bx    [count] = x;
+                tests.by    [count] = position.y + size.y * 0.5f;
+                tests.owners[count] = i * 2 + paddle;
+                ++count;
+            }
+        }
+    }
+
+    const physics::CircleLineInput input = {tests.cx.data(), tests.cy.data(), tests.r.data(), tests.ax.data(), tests.ay.data(), tests.bx.data(), tests.by.data()};
+    physics::collisionCircleLines(mSimdLevel, count, input, tests.px.data(), tests.py.data(), tests.masks.data());
+    // A paddle is hit if any of its lines is, the contact point is the one of the front line if it is hit.
+    for (std::size_t k = 0; k < count; k += 2)
+    {
+        const bool front = ((tests.masks[ k      / 32] >> ( k      % 32)) & 1u) != 0;
+        const bool back  = ((tests.masks[(k + 1) / 32] >> ((k + 1) % 32)) & 1u) != 0;
+        if (front || back)
+        {
+            const std::uint32_t match = tests.owners[k] / 2;
+            tests.hits  [match] |= static_cast<std::uint8_t>(1u << (tests.owners[k] % 2));
+            tests.whereY[match]  = front ? tests.py[k] : tests.py[k + 1];
+        }
+    }
+}
+#endif
+
+void MatchBatch::stepSwept(const TimeDuration dt)
+{
+    // The clock counts ticks of the game, so the times are the same whatever the size of the steps.
+    const double              tick  = Game::TickTime.count();
+    const physics::SweptTable table = {toFloat(mTableTop), toFloat(mTableBottom), toFloat(mTableLeft), toFloat(mTableRight)};
+
+    mClock += static_cast<std::uint64_t>(std::max(1.0, std::round(dt / Game::TickTime)));
+    const double end = now();
+
+    for (const std::uint32_t i : mActive)
+    {
+        ++mTicks[i];
+
+        while (true)
+        {
+            physics::SweptBall   ball    = sweptBall(i);
+            physics::SweptPaddle paddleA = sweptPaddle(toFloat(mPaddleAX), toFloat(mPaddleAY[i]), mPaddleASpeed[i], mPaddleATime[i]);
+            physics::SweptPaddle paddleB = sweptPaddle(toFloat(mPaddleBX), toFloat(mPaddleBY[i]), mPaddleBSpeed[i], mPaddleBTime[i]);
+            // Move everything to the end of the step, with as many bounces as the sweep resolves.
+            const physics::SweepResult result = physics::sweep(ball, paddleA, paddleB, table, end);
+            if (result.overflow)
+            {
+                physics::settle(ball, paddleA, paddleB, table, result, end);
+            }
+
+            mBallX       [i] = Scalar(ball.position.x);
+            mBallY       [i] = Scalar(ball.position.y);
+            mBallSpeedX  [i] = Scalar(ball.speed.x);
+            mBallSpeedY  [i] = Scalar(ball.speed.y);
+            mBallTime    [i] = ball.time;
+            mPaddleAY    [i] = Scalar(paddleA.position.y);
+            mPaddleASpeed[i] = paddleA.speed;
+            mPaddleATime [i] = paddleA.time;
+            mPaddleBY    [i] = Scalar(paddleB.position.y);
+            mPaddleBSpeed[i] = paddleB.speed;
+            mPaddleBTime [i] = paddleB.time;
+
+            if (!result.pointA && !result.pointB)
+            {
+                break;
+            }
+            // The next round starts on the tick after the point, as it does in the discrete mode.
+            scorePoint(i, result.pointA, std::ceil(result.time / tick) * tick);
+            if (mFinished[i] != 0)
+            {
+                break;
+            }
+        }
+    }
+}
+
+void MatchBatch::scorePoint(const std::size_t match, const bool pointA, const double time)
+{
+    // Points, as in `Game::update` and `Game::scorePoints`.
+    if (pointA) { ++mScoreA[match]; }
+    else        { ++mScoreB[match]; }
+
+    if (mScoreA[match] >= Game::MaxPoints || mScoreB[match] >= Game::MaxPoints)
+    {
+        mFinished[match] = 1;
+        ++mFinishedCount;
+    }
+    else
+    {
+        kickoff(match, pointA ? Game::InitialSpeed : -Game::InitialSpeed, time);
+    }
+}
+
+void MatchBatch::kickoff(const std::size_t match, const float speed, const double time)
+{
+    mBallX       [match] = Scalar(Game::TablePosition.x);
+    mBallY       [match] = Scalar(Game::TablePosition.y);
+    mBallSpeedX  [match] = Scalar(speed);
+    mBallSpeedY  [match] = Scalar(0);
+    mBallTime    [match] = time;
+    mPaddleAY    [match] = Scalar(Game::TablePosition.y);
+    mPaddleASpeed[match] = Paddle::MovementSpeed * mInputA[match];
+    mPaddleATime [match] = time;
+    mPaddleBY    [match] = Scalar(Game::TablePosition.y);
+    mPaddleBSpeed[match] = Paddle::MovementSpeed * mInputB[match];
+    mPaddleBTime [match] = time;
+}
+
+double MatchBatch::now() const noexcept
+{
+    return static_cast<double>(mClock) * Game::TickTime.count();
+}
+
+physics::SweptBall MatchBatch::sweptBall(const std::size_t match) const
+{
+    return {{toFloat(mBallX[match]), toFloat(mBallY[match])}, {toFloat(mBallSpeedX[match]), toFloat(mBallSpeedY[match])}, Game::BallRadius, mBallTime[match]};
+}
+
+physics::SweptPaddle MatchBatch::sweptPaddle(const float x, const float y, const float speed, const double time) const
+{
+    const glm::vec2 half = Game::PaddleSize * 0.5f;
+    return {{x, y}, half, speed, toFloat(mTableBottom) + half.y, toFloat(mTableTop) - half.y, time};
+}
+
+} // namespace pong
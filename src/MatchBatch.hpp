@@ -0,0 +1,352 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CollisionKernel.hpp"
+#include "Scalar.hpp"
+#include "SweptCollision.hpp"
+#include "Time.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace pong {
+
+/**
+ * @brief Simulates many independent matches at once using a structure-of-arrays layout.
+ *
+ * Every match (lane) has the same layout as the matches created by `Game::setupMatch`, but instead of a scene with
+ * heap-allocated entities, the state of all the lanes (ball, paddles and scores) is stored in contiguous arrays and
+ * stepped in a single pass without virtual calls.
+ *
+ * The physics are the ones of `Ball` and `Paddle`, with the same `Scalar` type and the same collision code in
+ * `physics`, so a lane produces exactly the same results as a match driven by `Game::update` with the same paddle
+ * inputs, with floating point and with fixed point. The paddles are driven like `ControllerHuman` does: each lane has
+ * an input direction per paddle that is set before every step. In floating point the paddle tests of all the lanes are
+ * gathered and run together by the collision kernels (see `physics::collisionCircleLines`).
+ *
+ * With `physics::CollisionMode::Swept` the lanes use continuous collision detection instead (see `physics::sweep`),
+ * so the steps can be several times larger than the ticks of the game without the ball going through the paddles. The
+ * bodies keep the state of their last collision and the clock counts ticks of the game, so the results do not depend
+ * on the size of the steps as long as the inputs change on the same ticks. The sweeps are calculated in floating
+ * point, as they are by `Ball`.
+ *
+ * The kickoff prompt is skipped: after a point the lane is reset and the next step continues the match. A lane stops
+ * being updated once a player reaches `Game::MaxPoints`.
+ */
+class MatchBatch
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * All the lanes start at the kickoff of a new match.
+     * @param size Number of matches (lanes).
+     * @param mode Collision detection mode.
+     */
+    explicit MatchBatch(std::size_t size, physics::CollisionMode mode = physics::CollisionMode::Discrete);
+
+    /**
+     * @brief Gets the number of matches.
+     * @return Number of matches.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mBallX.size(); }
+
+    /**
+     * @brief Gets the collision detection mode.
+     * @return Collision detection mode.
+     */
+    [[nodiscard]] physics::CollisionMode mode() const noexcept { return mMode; }
+
+    /**
+     * @brief Gets the number of matches that have finished.
+     * @return Number of finished matches.
+     */
+    [[nodiscard]] std::size_t finished() const noexcept { return mFinishedCount; }
+
+    /**
+     * @brief Checks if all the matches have finished.
+     * @return True if all the matches have finished, false otherwise.
+     */
+    [[nodiscard]] bool done() const noexcept { return mFinishedCount == size(); }
+
+    /**
+     * @brief Resets all the lanes to the kickoff of a new match.
+     */
+    void reset();
+
+    /**
+     * @brief Sets the input of the paddles of a match.
+     *
+     * The direction is positive to move up, negative to move down and zero to stop. It remains active until it is
+     * changed.
+     * @param match Index of the match.
+     * @param directionA Movement direction of paddle A.
+     * @param directionB Movement direction of paddle B.
+     */
+    void setInput(std::size_t match, int directionA, int directionB);
+
+    /**
+     * @brief Steps all the running matches.
+     *
+     * In the swept mode the time step is rounded to a whole number of ticks of the game (`Game::TickTime`).
+     * @param dt The time elapsed since the last update (delta time).
+     */
+    void step(TimeDuration dt);
+
+    /**
+     * @brief Checks if a match has finished.
+     * @param match Index of the match.
+     * @return True if the match has finished, false otherwise.
+     */
+    [[nodiscard]] bool isFinished(const std::size_t match) const { return mFinished[match] != 0; }
+
+    /**
+     * @brief Gets the number of steps simulated in a match.
+     * @param match Index of the match.
+     * @return Number of steps simulated in the match.
+     */
+    [[nodiscard]] std::uint32_t ticks(const std::size_t match) const { return mTicks[match]; }
+
+    /**
+     * @brief Gets the score of player A in a match.
+     * @param match Index of the match.
+     * @return Score of player A (right paddle).
+     */
+    [[nodiscard]] int scoreA(const std::size_t match) const { return mScoreA[match]; }
+
+    /**
+     * @brief Gets the score of player B in a match.
+     * @param match Index of the match.
+     * @return Score of player B (left paddle).
+     */
+    [[nodiscard]] int scoreB(const std::size_t match) const { return mScoreB[match]; }
+
+    /**
+     * @brief Gets the position of the ball of a match.
+     * @param match Index of the match.
+     * @return Position of the ball.
+     */
+    [[nodiscard]] glm::vec2 ballPosition(std::size_t match) const;
+
+    /**
+     * @brief Gets the speed of the ball of a match.
+     * @param match Index of the match.
+     * @return Speed of the ball.
+     */
+    [[nodiscard]] glm::vec2 ballSpeed(const std::size_t match) const { return {toFloat(mBallSpeedX[match]), toFloat(mBallSpeedY[match])}; }
+
+    /**
+     * @brief Gets the position of the paddle A of a match.
+     * @param match Index of the match.
+     * @return Position of the paddle A.
+     */
+    [[nodiscard]] glm::vec2 paddlePositionA(std::size_t match) const;
+
+    /**
+     * @brief Gets the position of the paddle B of a match.
+     * @param match Index of the match.
+     * @return Position of the paddle B.
+     */
+    [[nodiscard]] glm::vec2 paddlePositionB(std::size_t match) const;
+
+private:
+
+    /**
+     * @brief Steps all the running matches with discrete collision detection.
+     * @param dt The time elapsed since the last update (delta time).
+     */
+    void stepDiscrete(TimeDuration dt);
+
+    /**
+     * @brief Steps all the running matches with continuous collision detection.
+     * @param dt The time elapsed since the last update (delta time).
+     */
+    void stepSwept(TimeDuration dt);
+
+#if !defined(PONG_FIXED_POINT)
+    /**
+     * @brief Tests the balls of the running matches against their paddles with the collision kernels.
+     *
+     * The results are the ones of `physics::collisionBallPaddle` and are kept in `mPaddleTests`.
+     */
+    void testPaddles();
+#endif
+
+    /**
+     * @brief Scores a point in a match, finishing it or starting the next round.
+     * @param match Index of the match.
+     * @param pointA True if player A scored, false if player B scored.
+     * @param time Time when the next round starts (swept mode).
+     */
+    void scorePoint(std::size_t match, bool pointA, double time);
+
+    /**
+     * @brief Resets the ball and the paddles of a match after a point.
+     * @param match Index of the match.
+     * @param speed Initial horizontal speed of the ball.
+     * @param time Time when the round starts (swept mode).
+     */
+    void kickoff(std::size_t match, float speed, double time);
+
+    /**
+     * @brief Gets the current time of the swept mode.
+     * @return Time, in seconds.
+     */
+    [[nodiscard]] double now() const noexcept;
+
+    /**
+     * @brief Gets the state of the ball of a match for a sweep.
+     * @param match Index of the match.
+     * @return State of the ball.
+     */
+    [[nodiscard]] physics::SweptBall sweptBall(std::size_t match) const;
+
+    /**
+     * @brief Gets the state of a paddle for a sweep.
+     * @param x X-coordinate of the paddle.
+     * @param y Y-coordinate of the paddle at `time`.
+     * @param speed Vertical speed of the paddle.
+     * @param time Time of the position.
+     * @return State of the paddle.
+     */
+    [[nodiscard]] physics::SweptPaddle sweptPaddle(float x, float y, float speed, double time) const;
+
+private:
+
+    /** @brief Collision detection mode. */
+    physics::CollisionMode mMode = physics::CollisionMode::Discrete;
+
+    /** @brief Y-coordinate of the top limit of the table. */
+    Scalar mTableTop = Scalar(0);
+
+    /** @brief Y-coordinate of the bottom limit of the table. */
+    Scalar mTableBottom = Scalar(0);
+
+    /** @brief X-coordinate of the left limit of the table. */
+    Scalar mTableLeft = Scalar(0);
+
+    /** @brief X-coordinate of the right limit of the table. */
+    Scalar mTableRight = Scalar(0);
+
+    /** @brief X-coordinate of the paddle A, it never changes. */
+    Scalar mPaddleAX = Scalar(0);
+
+    /** @brief X-coordinate of the paddle B, it never changes. */
+    Scalar mPaddleBX = Scalar(0);
+
+    /** @brief X-coordinates of the balls. */
+    std::vector<Scalar> mBallX;
+
+    /** @brief Y-coordinates of the balls. */
+    std::vector<Scalar> mBallY;
+
+    /** @brief X-components of the speed of the balls. */
+    std::vector<Scalar> mBallSpeedX;
+
+    /** @brief Y-components of the speed of the balls. */
+    std::vector<Scalar> mBallSpeedY;
+
+    /** @brief Y-coordinates of the paddles A. */
+    std::vector<Scalar> mPaddleAY;
+
+    /** @brief Y-coordinates of the paddles B. */
+    std::vector<Scalar> mPaddleBY;
+
+    /** @brief Movement direction of the paddles A. */
+    std::vector<std::int8_t> mInputA;
+
+    /** @brief Movement direction of the paddles B. */
+    std::vector<std::int8_t> mInputB;
+
+    /** @brief Scores of the players A. */
+    std::vector<std::uint8_t> mScoreA;
+
+    /** @brief Scores of the players B. */
+    std::vector<std::uint8_t> mScoreB;
+
+    /** @brief Flags indicating which matches have finished. */
+    std::vector<std::uint8_t> mFinished;
+
+    /** @brief Number of ticks simulated in each match. */
+    std::vector<std::uint32_t> mTicks;
+
+    /** @brief Indices of the matches that are still running, in increasing order. */
+    std::vector<std::uint32_t> mActive;
+
+    /** @brief Times of the state of the balls (swept mode). */
+    std::vector<double> mBallTime;
+
+    /** @brief Vertical speed of the paddles A, zero once they reach the limits (swept mode). */
+    std::vector<float> mPaddleASpeed;
+
+    /** @brief Times of the positions of the paddles A (swept mode). */
+    std::vector<double> mPaddleATime;
+
+    /** @brief Vertical speed of the paddles B, zero once they reach the limits (swept mode). */
+    std::vector<float> mPaddleBSpeed;
+
+    /** @brief Times of the positions of the paddles B (swept mode). */
+    std::vector<double> mPaddleBTime;
+
+#if !defined(PONG_FIXED_POINT)
+    /**
+     * @brief Defines a structure with the paddle tests of the discrete mode.
+     *
+     * Every paddle close enough to its ball adds two circle/line pairs, its front and back lines.
+     */
+    struct PaddleTests
+    {
+        std::vector<float>         cx;      //!< X-coordinates of the balls.
+        std::vector<float>         cy;      //!< Y-coordinates of the balls.
+        std::vector<float>         r;       //!< Radii of the balls.
+        std::vector<float>         ax;      //!< X-coordinates of the start points of the lines.
+        std::vector<float>         ay;      //!< Y-coordinates of the start points of the lines.
+        std::vector<float>         bx;      //!< X-coordinates of the end points of the lines.
+        std::vector<float>         by;      //!< Y-coordinates of the end points of the lines.
+        std::vector<float>         px;      //!< X-coordinates of the contact points.
+        std::vector<float>         py;      //!< Y-coordinates of the contact points.
+        std::vector<std::uint32_t> masks;   //!< Hit masks of the pairs.
+        std::vector<std::uint32_t> owners;  //!< Match and paddle of the pairs (match * 2 + 0 for A, 1 for B).
+        std::vector<std::uint8_t>  hits;    //!< Paddles hit in each match (bit 0 for A, bit 1 for B).
+        std::vector<float>         whereY;  //!< Y-coordinates of the contact points of the matches.
+    };
+
+    /** @brief Instruction set used by the paddle tests. */
+    physics::SimdLevel mSimdLevel = physics::SimdLevel::Scalar;
+
+    /** @brief Paddle tests of the discrete mode, sized for all the lanes so a step does not allocate. */
+    PaddleTests mPaddleTests;
+#endif
+
+    /** @brief Number of ticks of the game simulated (swept mode). */
+    std::uint64_t mClock = 0;
+
+    /** @brief Number of matches that have finished. */
+    std::size_t mFinishedCount = 0;
+};
+
+} // namespace pong
@@ -0,0 +1,111 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "MatchHost.hpp"
+#include "Renderer.hpp"
+
+namespace pong {
+
+MatchHost::MatchHost(const std::size_t matches, const int threads, const std::size_t grain)
+    :
+    mMatches(matches),
+    mGraph  (threads)
+{
+    for (Match& match : mMatches)
+    {
+        match.game = std::make_unique<Game>();
+    }
+    // Every stage of a group waits for the previous one, the groups are independent.
+    const std::size_t events  = mGraph.addStage(input, this);
+    const std::size_t control = mGraph.addStage(update<Game::Stage::Control>, this, {events});
+    const std::size_t move    = mGraph.addStage(update<Game::Stage::Move>,    this, {control});
+    const std::size_t ball    = mGraph.addStage(update<Game::Stage::Ball>,    this, {move});
+    const std::size_t score   = mGraph.addStage(update<Game::Stage::Score>,   this, {ball});
+    mGraph.addStage(draw, this, {score});
+    mGraph.build(matches, grain);
+}
+
+void MatchHost::setRenderer(const std::size_t match, Renderer* renderer) noexcept
+{
+    mMatches[match].renderer = renderer;
+}
+
+bool MatchHost::post(const std::size_t match, const Event& event) noexcept
+{
+    Match& hosted = mMatches[match];
+    if (hosted.eventCount == MaxEvents)
+    {
+        return false;
+    }
+
+    hosted.events[hosted.eventCount++] = event.type();
+    return true;
+}
+
+void MatchHost::tick(const TimeDuration dt)
+{
+    mDt = dt;
+    mGraph.run();
+}
+
+void MatchHost::input(void* context, const std::size_t begin, const std::size_t end)
+{
+    auto& host = *static_cast<MatchHost*>(context);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        Match& match = host.mMatches[i];
+        for (std::size_t e = 0; e < match.eventCount; ++e)
+        {
+            match.game->handle(Event{match.events[e]});
+        }
+        match.eventCount = 0;
+    }
+}
+
+template<Game::Stage S>
+void MatchHost::update(void* context, const std::size_t begin, const std::size_t end)
+{
+    auto& host = *static_cast<MatchHost*>(context);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        host.mMatches[i].game->update(S, host.mDt);
+    }
+}
+
+void MatchHost::draw(void* context, const std::size_t begin, const std::size_t end)
+{
+    auto& host = *static_cast<MatchHost*>(context);
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const Match& match = host.mMatches[i];
+        if (match.renderer)
+        {
+            match.renderer->beginFrame();
+            match.game->draw(*match.renderer, 1.0f);
+            match.renderer->endFrame();
+        }
+    }
+}
+
+} // namespace pong
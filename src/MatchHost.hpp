@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Event.hpp"
+#include "Game.hpp"
+#include "JobGraph.hpp"
+#include "Time.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace pong {
+
+class Renderer;
+
+/**
+ * @brief Hosts many independent matches in one process and updates them through a job graph.
+ *
+ * A tick of the host is a graph of stages: the events queued for every match are applied, then the stages of
+ * `Game::update()` run one after the other (controllers, paddles, balls and scores) and the matches with a renderer
+ * queue their geometry. The matches are split into groups of `grain` matches and every group goes through the stages
+ * in order on the threads of the graph, while the groups progress in parallel. The result of every match is the same
+ * as updating it on its own, whatever the number of threads.
+ *
+ * The games, the queues of events and the jobs are allocated when the host is created, so a tick does not allocate
+ * beyond what the games themselves do. The gameplay events of every game (`Game::events()`) are left for the caller to
+ * drain between ticks.
+ */
+class MatchHost
+{
+public:
+
+    /** @brief Maximum number of events queued for a match between two ticks. */
+    static constexpr std::size_t MaxEvents = 16;
+
+    /** @brief Number of matches of a group by default. */
+    static constexpr std::size_t DefaultGrain = 16;
+
+    /**
+     * @brief Constructor.
+     * @param matches Number of matches.
+     * @param threads Number of threads, the calling thread included; zero for one per hardware thread.
+     * @param grain Number of matches of a group.
+     */
+    MatchHost(std::size_t matches, int threads, std::size_t grain = DefaultGrain);
+
+    /**
+     * @brief Gets the number of matches.
+     * @return Number of matches.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mMatches.size(); }
+
+    /**
+     * @brief Gets the game of a match, to set it up or read its state between ticks.
+     * @param match Index of the match.
+     * @return The game.
+     */
+    [[nodiscard]] Game& game(const std::size_t match) noexcept { return *mMatches[match].game; }
+
+    /**
+     * @brief Gets the job graph of the ticks.
+     * @return The graph.
+     */
+    [[nodiscard]] const JobGraph& graph() const noexcept { return mGraph; }
+
+    /**
+     * @brief Sets the renderer that receives the geometry of a match in every tick.
+     *
+     * The matches of a group are drawn one after the other by the same thread, so they can share a renderer; the
+     * matches of different groups cannot.
+     * @param match Index of the match.
+     * @param renderer Renderer, null to skip drawing the match.
+     */
+    void setRenderer(std::size_t match, Renderer* renderer) noexcept;
+
+    /**
+     * @brief Queues an event for a match, it is handled at the start of the next tick.
+     * @param match Index of the match.
+     * @param event Event.
+     * @return True if the event was queued, false if the queue of the match is full.
+     */
+    bool post(std::size_t match, const Event& event) noexcept;
+
+    /**
+     * @brief Runs a tick of every match and waits for all of them.
+     * @param dt Duration of the tick.
+     */
+    void tick(TimeDuration dt);
+
+private:
+
+    /** @brief Defines a hosted match. */
+    struct Match
+    {
+        /** @brief Game. */
+        std::unique_ptr<Game> game;
+
+        /** @brief Renderer, null if the match is not drawn. */
+        Renderer* renderer = nullptr;
+
+        /** @brief Events queued for the next tick. */
+        std::array<Event::Type, MaxEvents> events = {};
+
+        /** @brief Number of events queued. */
+        std::size_t eventCount = 0;
+    };
+
+    /**
+     * @brief Handles the events queued for a group of matches, the first stage of a tick.
+     * @param context Host.
+     * @param begin First match.
+     * @param end Match after the last one.
+     */
+    static void input(void* context, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Runs a stage of the update of a group of matches.
+     * @tparam S Stage.
+     * @param context Host.
+     * @param begin First match.
+     * @param end Match after the last one.
+     */
+    template<Game::Stage S>
+    static void update(void* context, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Draws a group of matches into their renderers, the last stage of a tick.
+     * @param context Host.
+     * @param begin First match.
+     * @param end Match after the last one.
+     */
+    static void draw(void* context, std::size_t begin, std::size_t end);
+
+private:
+
+    /** @brief Matches. */
+    std::vector<Match> mMatches;
+
+    /** @brief Duration of the current tick. */
+    TimeDuration mDt = {};
+
+    /** @brief Graph of the stages of a tick. */
+    JobGraph mGraph;
+};
+
+} // namespace pong
@@ -23,48 +23,94 @@
 ////////////////////////////////////////////////////////////
 
 #include "Paddle.hpp"
+#include "Ball.hpp"
 #include "Controller.hpp"
 #include "Renderer.hpp"
 #include "Event.hpp"
 #include "Scene.hpp"
 #include "Table.hpp"
+#include "Snapshot.hpp"
 
 namespace pong {
 
-Paddle::Paddle(std::unique_ptr<Controller> controller, const glm::vec2& position, const glm::vec2& size)
+Paddle::Paddle(ArenaPtr<Controller> controller, const glm::vec2& position, const glm::vec2& size)
     :
     Entity       (Type::Paddle),
     mController  (std::move(controller)),
-    mPosition    (position),
-    mPositionPrev(position),
-    mSize        (size)
+    mPosition    (toVector(position)),
+    mPositionPrev(toVector(position)),
+    mSize        (toVector(size))
 {}
 
 void Paddle::setPosition(const glm::vec2 &position)
 {
-    mPosition     = position;
-    mPositionPrev = position;
+    mPosition     = toVector(position);
+    mPositionPrev = toVector(position);
+    markChanged();
 }
 
 void Paddle::moveUp()
 {
-    mSpeed = MovementSpeed;
+    mSpeed = Scalar(MovementSpeed);
 }
 
 void Paddle::moveDown()
 {
-    mSpeed = -MovementSpeed;
+    mSpeed = -Scalar(MovementSpeed);
 }
 
 void Paddle::stop()
 {
-    mSpeed = 0.0f;
+    mSpeed = Scalar(0);
 }
 
 void Paddle::setup(const Table& table, const Ball& ball)
 {
-    mTable = &table;
-    mBall  = &ball;
+    mTable = Handle<Table>(table.id());
+    mBall  = Handle<Ball> (ball.id());
+}
+
+void Paddle::track(const Ball& ball) noexcept
+{
+    mBall = Handle<Ball>(ball.id());
+}
+
+const Table* Paddle::table() const noexcept
+{
+    const Scene* scene = this->scene();
+    return scene ? scene->get(mTable) : nullptr;
+}
+
+const Ball* Paddle::ball() const noexcept
+{
+    const Scene* scene = this->scene();
+    return scene ? scene->get(mBall) : nullptr;
+}
+
+void Paddle::snapshot(PaddleSnapshot& snapshot) const
+{
+    snapshot.position     = mPosition;
+    snapshot.positionPrev = mPositionPrev;
+    snapshot.speed        = mSpeed;
+    mController->snapshot(snapshot.controller);
+}
+
+bool Paddle::restore(const PaddleSnapshot& snapshot)
+{
+    // Only the kind of the current controller is needed, but the controllers only expose it through their snapshots.
+    ControllerSnapshot current;
+    mController->snapshot(current);
+    if (current.kind != snapshot.controller.kind)
+    {
+        return false;
+    }
+
+    mPosition     = snapshot.position;
+    mPositionPrev = snapshot.positionPrev;
+    mSpeed        = snapshot.speed;
+    mController->restore(snapshot.controller);
+    markChanged();
+    return true;
 }
 
 void Paddle::handle(const Event& event)
@@ -75,23 +121,61 @@ void Paddle::handle(const Event& event)
     {
         // If game is paused reset the position to avoid interpolation.
         mPositionPrev = mPosition;
+        markChanged();
     }
 }
 
 void Paddle::update(const TimeDuration dt)
 {
-    mController->update(*this, *mTable, *mBall, dt);
+    control(dt);
+    move(dt);
+}
+
+void Paddle::control(const TimeDuration dt)
+{
+    // Find the table and the ball, which may no longer exist.
+    const Table* table = this->table();
+    const Ball*  ball  = this->ball();
+    if (!table || !ball)
+    {
+        return;
+    }
+
+    mController->update(*this, *table, *ball, dt);
+}
+
+void Paddle::move(const TimeDuration dt)
+{
+    const Table* table = this->table();
+    if (!table || !ball())
+    {
+        return;
+    }
+
+    // Keep the drawn state, to know whether the frames change.
+    const Vector position = mPosition;
+    const Vector previous = mPositionPrev;
 
     mPositionPrev = mPosition;
-    mPosition     = mPosition + glm::vec2(0.0f, mSpeed * dt.count());
+    mPosition.y   = mPosition.y + distance(mSpeed, dt);
 
-    if (mPosition.y + mSize.y * 0.5f > mTable->top())    { mPosition.y = mTable->top()    - mSize.y * 0.5f; }
-    if (mPosition.y - mSize.y * 0.5f < mTable->bottom()) { mPosition.y = mTable->bottom() + mSize.y * 0.5f; }
+    if (mPosition.y + mSize.y * Scalar(0.5f) > table->top())    { mPosition.y = table->top()    - mSize.y * Scalar(0.5f); }
+    if (mPosition.y - mSize.y * Scalar(0.5f) < table->bottom()) { mPosition.y = table->bottom() + mSize.y * Scalar(0.5f); }
+
+    if (mPosition != position || mPositionPrev != previous)
+    {
+        markChanged();
+    }
+}
+
+bool Paddle::animated() const noexcept
+{
+    return mPosition != mPositionPrev;
 }
 
 void Paddle::draw(Renderer& renderer, const float interp)
 {
-    renderer.queueQuad(mPosition * interp + mPositionPrev * (1.0f - interp), mSize);
+    renderer.queueQuad(toVec2(mPosition) * interp + toVec2(mPositionPrev) * (1.0f - interp), toVec2(mSize));
 }
 
 } // namespace pong
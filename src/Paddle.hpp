@@ -24,7 +24,9 @@
 
 #pragma once
 
+#include "Arena.hpp"
 #include "Entity.hpp"
+#include "Scalar.hpp"
 #include <glm/glm.hpp>
 #include <memory>
 
@@ -33,6 +35,7 @@ namespace pong {
 class Controller;
 class Table;
 class Ball;
+struct PaddleSnapshot;
 
 /**
  * @brief Represents a player's paddle entity.
@@ -52,17 +55,24 @@ public:
      *
      * The paddle is created in a "disconnected" state. The `setup()` method must be called after creation to link it to
      * other game entities.
-     * @param controller The control strategy (e.g., player or AI). Ownership is transferred to the paddle.
+     * @param controller The control strategy (e.g., player or AI), from the heap or from the arena of the scene.
+     * Ownership is transferred to the paddle.
      * @param position Initial center position of the paddle.
      * @param size Width and height of the paddle.
      */
-    Paddle(std::unique_ptr<Controller> controller, const glm::vec2& position, const glm::vec2& size);
+    Paddle(ArenaPtr<Controller> controller, const glm::vec2& position, const glm::vec2& size);
 
     /**
      * @brief Gets the current center position of the paddle.
      * @return Position.
      */
-    [[nodiscard]] const glm::vec2& position() const noexcept { return mPosition; }
+    [[nodiscard]] const Vector& position() const noexcept { return mPosition; }
+
+    /**
+     * @brief Gets the center position of the paddle before the last update.
+     * @return Position.
+     */
+    [[nodiscard]] const Vector& previousPosition() const noexcept { return mPositionPrev; }
 
     /**
      * @brief Sets the position of the paddle.
@@ -74,7 +84,7 @@ public:
      * @brief Gets the size of the paddle.
      * @return Size.
      */
-    [[nodiscard]] const glm::vec2& size() const noexcept { return mSize; }
+    [[nodiscard]] const Vector& size() const noexcept { return mSize; }
 
     /**
      * @brief Sets the speed of the paddle to move upwards.
@@ -95,40 +105,99 @@ public:
      * @brief Links the paddle to its external gameplay dependencies.
      *
      * This method must be called after all game entities have been created to resolve the circular dependency between
-     * paddles and the ball.
+     * paddles and the ball. The paddle refers to them by their handles, so they must be in the scene of the paddle; the
+     * paddle stops if any of them is destroyed.
      * @param table A reference to the game table for boundary checks.
      * @param ball A reference to the ball.
      */
     void setup(const Table& table, const Ball& ball);
 
+    /**
+     * @brief Changes the ball followed by the controller, in multi-ball matches.
+     * @param ball A reference to the ball.
+     */
+    void track(const Ball& ball) noexcept;
+
+    /**
+     * @brief Gets the game table.
+     * @return The table, or null if it was destroyed or the paddle is not in a scene.
+     */
+    [[nodiscard]] const Table* table() const noexcept;
+
+    /**
+     * @brief Gets the ball followed by the controller.
+     * @return The ball, or null if it was destroyed or the paddle is not in a scene.
+     */
+    [[nodiscard]] const Ball* ball() const noexcept;
+
+    /**
+     * @brief Saves the state of the paddle and its controller (see `Game::snapshot()`).
+     * @param snapshot Snapshot to fill.
+     */
+    void snapshot(PaddleSnapshot& snapshot) const;
+
+    /**
+     * @brief Restores the state of the paddle and its controller.
+     *
+     * The controller itself is not replaced, so the snapshot must have a controller of the same kind.
+     * @param snapshot Snapshot.
+     * @return True if the state was restored, false if the controller of the snapshot is of another kind.
+     */
+    [[nodiscard]] bool restore(const PaddleSnapshot& snapshot);
+
     void handle(const Event& event) override;
 
+    /**
+     * @brief Updates the paddle: its controller decides the move and the paddle moves.
+     * @param dt Duration of the tick.
+     */
     void update(TimeDuration dt) override;
 
+    /**
+     * @brief Runs the controller, the first half of `update()`.
+     *
+     * The controller only looks at its own paddle, the table and the ball, so the controllers of all the paddles can
+     * run before any of them moves.
+     * @param dt Duration of the tick.
+     */
+    void control(TimeDuration dt);
+
+    /**
+     * @brief Moves the paddle with the speed set by its controller, the second half of `update()`.
+     * @param dt Duration of the tick.
+     */
+    void move(TimeDuration dt);
+
     void draw(Renderer& renderer, float interp) override;
 
+    /**
+     * @brief Checks whether the paddle moved in the last update, so its drawing depends on the interpolation.
+     * @return True if the paddle is animated, false otherwise.
+     */
+    [[nodiscard]] bool animated() const noexcept override;
+
 private:
 
     /** @brief Controller. */
-    std::unique_ptr<Controller> mController;
+    ArenaPtr<Controller> mController;
 
     /** @brief The current center position of the paddle. */
-    glm::vec2 mPosition;
+    Vector mPosition;
 
     /** @brief The position of the paddle in the previous frame, used for interpolation. */
-    glm::vec2 mPositionPrev;
+    Vector mPositionPrev;
 
     /** @brief The width and height of the paddle (x = width, y = height). */
-    glm::vec2 mSize = glm::vec2(1.0f);
+    Vector mSize;
 
     /** @brief The current vertical speed of the paddle. */
-    float mSpeed = 0.0f;
+    Scalar mSpeed = Scalar(0);
 
-    /** @brief Pointer to the game table. */
-    const Table* mTable = nullptr;
+    /** @brief Handle of the game table. */
+    Handle<Table> mTable;
 
-    /** @brief Pointer to the game ball. */
-    const Ball* mBall = nullptr;
+    /** @brief Handle of the game ball. */
+    Handle<Ball> mBall;
 };
 
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,148 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtx/rotate_vector.hpp>
+#include <glm/gtx/norm.hpp>
+
+namespace pong::physics {
+
+/** @brief Maximum angle (in radians) for a bounce off a paddle. */
+inline constexpr float MaxBounceAngle = glm::radians(55.0f);
+
+/** @brief Minimum speed of the ball. */
+inline constexpr float MinSpeed = 100.0f;
+
+/** @brief Maximum speed of the ball. */
+inline constexpr float MaxSpeed = 180.0f;
+
+/**
+ * @brief Calculates the intersection between a circle and a line.
+ *
+ * @param c Center of the circle.
+ * @param r Radius of the circle.
+ * @param a Start point of the line.
+ * @param b End point of the line.
+ * @param p Intersection.
+ *
+ * @return True if the circle and the line intersect, false otherwise.
+ */
+inline bool collisionCircleLine(const glm::vec2& c, const float r, const glm::vec2& a, const glm::vec2& b, glm::vec2& p)
+{
+    const glm::vec2 ac = c - a;
+    const glm::vec2 ab = b - a;
+    // Calculate the square length of the vectors and dot product.
+    const float dot    = glm::dot(ac, ab);
+    const float len2AC = glm::length2(ac);
+    const float len2AB = glm::length2(ab);
+    // Calculate the discriminant.
+    const float discriminant = dot * dot - len2AB * (len2AC - (r * r));
+    // If the discriminant is greater than or equal to zero, we have real solutions (there is an intersection).
+    if (discriminant >= 0)
+    {
+        const float sqrt = glm::sqrt(discriminant);
+        const float inv  = 1.0f / len2AB;
+        const float r0   = glm::pow(-dot + sqrt, 2.0f) * inv * inv;
+        const float r1   = glm::pow(-dot - sqrt, 2.0f) * inv * inv;
+        // Check if the solutions are onto the segment.
+        if ((r0 >= 0 && r0 <= 1) || (r1 >= 0 && r1 <= 1))
+        {
+            // For this case, the exact intersection points are not needed, so the nearest point to the center
+            // of the ball is calculated (projection of the vector ac onto ab).
+            p = a + ab * dot * inv;
+            // Done.
+            return true;
+        }
+    }
+    // No intersection.
+    return false;
+}
+
+/**
+ * @brief Checks if a ball collides with a paddle.
+ *
+ * Only the front and back lines of the paddle are tested, the ball can not hit the top or bottom sides.
+ * @param c Center of the ball.
+ * @param r Radius of the ball.
+ * @param position Center of the paddle.
+ * @param size Size of the paddle.
+ * @param where Point where the collision happens.
+ *
+ * @return True if the ball and the paddle collide, false otherwise.
+ */
+inline bool collisionBallPaddle(const glm::vec2& c, const float r, const glm::vec2& position, const glm::vec2& size, glm::vec2& where)
+{
+    // Add the ball radius to the paddle radius.
+    const float radii = glm::length(size * 0.5f) + r;
+    // Check if the paddle is close enough to collide with the ball. This calculation is faster than circle/segment
+    // intersection and if there is a collision, it is limited to the segment of the paddle.
+    if (glm::length2(position - c) > (radii * radii))
+    {
+        return false;
+    }
+    // Calculate the intersection between the ball and the paddle front line.
+    if (collisionCircleLine(c, r,
+            {position.x - size.x * 0.5f, position.y - size.y * 0.5f},
+            {position.x - size.x * 0.5f, position.y + size.y * 0.5f},
+            where))
+    {
+        return true;
+    }
+    // Calculate the intersection between the ball and the paddle back line.
+    if (collisionCircleLine(c, r,
+            {position.x + size.x * 0.5f, position.y - size.y * 0.5f},
+            {position.x + size.x * 0.5f, position.y + size.y * 0.5f},
+            where))
+    {
+        return true;
+    }
+    // No collision.
+    return false;
+}
+
+/**
+ * @brief Calculates the speed of the ball after bouncing off a paddle.
+ *
+ * Near the center of the paddle the ball slows down and leaves almost horizontally; near the ends it speeds up and
+ * leaves with an angle up to `MaxBounceAngle`.
+ * @param speed Speed of the ball before the bounce.
+ * @param rDist Position of the collision relative to the center of the paddle, in the range [-1, 1].
+ * @return The new speed of the ball.
+ */
+inline glm::vec2 bounce(const glm::vec2& speed, const float rDist)
+{
+    float       length = glm::length(speed);
+    const float sign   = glm::sign(speed.x);
+    // Increment the speed regarding the position of the collision (near the center, the speed is reduced; near the end
+    // of the paddle, the speed is increased).
+    length += 25.0f * ((3.0f * glm::abs(rDist) - 1) * (2.0f - glm::abs(rDist)) * 0.5f);
+    // Clamp the speed between its minimum and maximum values.
+    length = glm::min(MaxSpeed, glm::max(MinSpeed, length));
+    // Calculate the new speed vector.
+    return -length * glm::rotate(glm::vec2(sign, 0.0f), -sign * MaxBounceAngle * rDist);
+}
+
+} // namespace pong::physics
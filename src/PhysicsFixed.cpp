@@ -0,0 +1,295 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "PhysicsFixed.hpp"
+#include "Physics.hpp"
+#include <array>
+
+namespace pong::physics {
+namespace {
+
+/** @brief Wide integer for the intermediate products. */
+using Wide = std::int64_t;
+
+/** @brief Number of entries of the trigonometric tables per unit of relative distance. */
+constexpr int TableResolution = 256;
+
+/** @brief Number of entries of the trigonometric tables, relative distances up to 2 are covered (the collision point
+ * can be a bit past the end of the paddle). */
+constexpr int TableSize = 2 * TableResolution + 1;
+
+// The tables are generated for a maximum bounce angle of 55 degrees.
+static_assert(MaxBounceAngle == glm::radians(55.0f), "The trigonometric tables must be regenerated");
+
+/** @brief Cosine of `MaxBounceAngle * i / TableResolution`, as raw Q16.16 values. */
+constexpr std::array<std::int32_t, TableSize> CosTable = {
+     65536,  65536,  65534,  65532,  65529,  65524,  65519,  65513,
+     65507,  65499,  65490,  65480,  65470,  65458,  65446,  65432,
+     65418,  65403,  65387,  65370,  65352,  65333,  65313,  65292,
+     65271,  65248,  65225,  65200,  65175,  65149,  65122,  65094,
+     65065,  65035,  65004,  64972,  64940,  64906,  64872,  64836,
+     64800,  64763,  64725,  64686,  64646,  64605,  64564,  64521,
+     64477,  64433,  64388,  64341,  64294,  64246,  64197,  64147,
+     64096,  64045,  63992,  63939,  63884,  63829,  63773,  63716,
+     63658,  63599,  63539,  63479,  63417,  63355,  63291,  63227,
+     63162,  63096,  63029,  62961,  62893,  62823,  62753,  62682,
+     62609,  62536,  62462,  62388,  62312,  62235,  62158,  62080,
+     62000,  61920,  61839,  61758,  61675,  61591,  61507,  61422,
+     61336,  61249,  61161,  61072,  60982,  60892,  60801,  60709,
+     60616,  60522,  60427,  60331,  60235,  60138,  60040,  59941,
+     59841,  59740,  59639,  59537,  59433,  59330,  59225,  59119,
+     59013,  58905,  58797,  58688,  58578,  58468,  58356,  58244,
+     58131,  58017,  57903,  57787,  57671,  57554,  57436,  57317,
+     57197,  57077,  56956,  56834,  56711,  56588,  56463,  56338,
+     56212,  56085,  55958,  55830,  55700,  55571,  55440,  55308,
+     55176,  55043,  54910,  54775,  54640,  54504,  54367,  54229,
+     54091,  53952,  53812,  53671,  53530,  53388,  53245,  53101,
+     52957,  52811,  52666,  52519,  52372,  52224,  52075,  51925,
+     51775,  51624,  51472,  51320,  51166,  51012,  50858,  50703,
+     50546,  50390,  50232,  50074,  49915,  49756,  49595,  49434,
+     49273,  49110,  48947,  48783,  48619,  48454,  48288,  48122,
+     47954,  47787,  47618,  47449,  47279,  47108,  46937,  46765,
+     46593,  46420,  46246,  46072,  45897,  45721,  45544,  45367,
+     45190,  45011,  44833,  44653,  44473,  44292,  44111,  43928,
+     43746,  43562,  43379,  43194,  43009,  42823,  42637,  42450,
+     42262,  42074,  41886,  41696,  41506,  41316,  41125,  40933,
+     40741,  40548,  40355,  40161,  39967,  39772,  39576,  39380,
+     39183,  38986,  38788,  38590,  38391,  38191,  37991,  37791,
+     37590,  37388,  37186,  36984,  36781,  36577,  36373,  36168,
+     35963,  35757,  35551,  35344,  35137,  34929,  34721,  34513,
+     34303,  34094,  33884,  33673,  33462,  33250,  33038,  32826,
+     32613,  32400,  32186,  31972,  31757,  31542,  31326,  31110,
+     30893,  30677,  30459,  30241,  30023,  29804,  29585,  29366,
+     29146,  28926,  28705,  28484,  28262,  28040,  27818,  27595,
+     27372,  27149,  26925,  26701,  26476,  26251,  26026,  25800,
+     25574,  25348,  25121,  24894,  24666,  24438,  24210,  23982,
+     23753,  23524,  23294,  23064,  22834,  22603,  22373,  22142,
+     21910,  21678,  21446,  21214,  20981,  20748,  20515,  20281,
+     20048,  19814,  19579,  19345,  19110,  18874,  18639,  18403,
+     18167,  17931,  17694,  17458,  17221,  16984,  16746,  16508,
+     16270,  16032,  15794,  15555,  15316,  15077,  14838,  14599,
+     14359,  14119,  13879,  13639,  13398,  13158,  12917,  12676,
+     12435,  12193,  11952,  11710,  11468,  11226,  10984,  10742,
+     10499,  10257,  10014,   9771,   9528,   9285,   9041,   8798,
+      8554,   8310,   8067,   7823,   7579,   7335,   7090,   6846,
+      6601,   6357,   6112,   5868,   5623,   5378,   5133,   4888,
+      4643,   4398,   4152,   3907,   3662,   3417,   3171,   2926,
+      2680,   2435,   2189,   1943,   1698,   1452,   1206,    961,
+       715,    469,    223,    -22,   -268,   -514,   -760,  -1005,
+     -1251,  -1497,  -1742,  -1988,  -2234,  -2479,  -2725,  -2970,
+     -3216,  -3461,  -3706,  -3952,  -4197,  -4442,  -4687,  -4933,
+     -5178,  -5422,  -5667,  -5912,  -6157,  -6401,  -6646,  -6890,
+     -7135,  -7379,  -7623,  -7867,  -8111,  -8355,  -8598,  -8842,
+     -9085,  -9329,  -9572,  -9815, -10058, -10301, -10543, -10786,
+    -11028, -11270, -11512, -11754, -11996, -12237, -12479, -12720,
+    -12961, -13201, -13442, -13683, -13923, -14163, -14403, -14642,
+    -14882, -15121, -15360, -15599, -15837, -16076, -16314, -16552,
+    -16789, -17027, -17264, -17501, -17738, -17974, -18210, -18446,
+    -18682, -18917, -19152, -19387, -19622, -19856, -20090, -20324,
+    -20557, -20791, -21024, -21256, -21488, -21720, -21952, -22184,
+    -22415,};
+
+/** @brief Sine of `MaxBounceAngle * i / TableResolution`, as raw Q16.16 values. */
+constexpr std::array<std::int32_t, TableSize> SinTable = {
+         0,    246,    491,    737,    983,   1229,   1474,   1720,
+      1966,   2211,   2457,   2702,   2948,   3193,   3439,   3684,
+      3930,   4175,   4420,   4665,   4910,   5155,   5400,   5645,
+      5890,   6135,   6379,   6624,   6868,   7112,   7357,   7601,
+      7845,   8089,   8333,   8576,   8820,   9063,   9307,   9550,
+      9793,  10036,  10279,  10521,  10764,  11006,  11248,  11490,
+     11732,  11974,  12215,  12457,  12698,  12939,  13180,  13420,
+     13661,  13901,  14141,  14381,  14620,  14860,  15099,  15338,
+     15577,  15816,  16054,  16292,  16530,  16768,  17005,  17242,
+     17479,  17716,  17952,  18189,  18425,  18660,  18896,  19131,
+     19366,  19600,  19835,  20069,  20303,  20536,  20769,  21002,
+     21235,  21467,  21699,  21931,  22163,  22394,  22624,  22855,
+     23085,  23315,  23544,  23774,  24002,  24231,  24459,  24687,
+     24914,  25141,  25368,  25595,  25821,  26046,  26272,  26497,
+     26721,  26945,  27169,  27393,  27616,  27838,  28061,  28283,
+     28504,  28725,  28946,  29166,  29386,  29605,  29824,  30043,
+     30261,  30479,  30696,  30913,  31130,  31346,  31561,  31776,
+     31991,  32205,  32419,  32632,  32845,  33058,  33270,  33481,
+     33692,  33903,  34113,  34322,  34532,  34740,  34948,  35156,
+     35363,  35570,  35776,  35982,  36187,  36391,  36595,  36799,
+     37002,  37205,  37407,  37608,  37809,  38010,  38210,  38409,
+     38608,  38806,  39004,  39201,  39398,  39594,  39789,  39984,
+     40179,  40373,  40566,  40759,  40951,  41142,  41333,  41524,
+     41714,  41903,  42091,  42280,  42467,  42654,  42840,  43026,
+     43211,  43395,  43579,  43762,  43945,  44127,  44308,  44489,
+     44669,  44849,  45028,  45206,  45384,  45560,  45737,  45912,
+     46088,  46262,  46436,  46609,  46781,  46953,  47124,  47294,
+     47464,  47633,  47802,  47970,  48137,  48303,  48469,  48634,
+     48798,  48962,  49125,  49287,  49449,  49610,  49770,  49930,
+     50088,  50247,  50404,  50561,  50717,  50872,  51027,  51180,
+     51333,  51486,  51638,  51789,  51939,  52088,  52237,  52385,
+     52532,  52679,  52825,  52970,  53114,  53258,  53401,  53543,
+     53684,  53825,  53964,  54103,  54242,  54379,  54516,  54652,
+     54787,  54922,  55055,  55188,  55320,  55452,  55582,  55712,
+     55841,  55969,  56097,  56224,  56349,  56475,  56599,  56722,
+     56845,  56967,  57088,  57208,  57328,  57446,  57564,  57681,
+     57798,  57913,  58028,  58141,  58254,  58367,  58478,  58588,
+     58698,  58807,  58915,  59022,  59129,  59234,  59339,  59443,
+     59546,  59648,  59750,  59850,  59950,  60049,  60147,  60244,
+     60340,  60436,  60530,  60624,  60717,  60809,  60900,  60991,
+     61080,  61169,  61256,  61343,  61429,  61515,  61599,  61682,
+     61765,  61847,  61928,  62008,  62087,  62165,  62242,  62319,
+     62394,  62469,  62543,  62616,  62688,  62759,  62830,  62899,
+     62968,  63035,  63102,  63168,  63233,  63297,  63360,  63423,
+     63484,  63545,  63604,  63663,  63721,  63778,  63834,  63889,
+     63944,  63997,  64050,  64101,  64152,  64202,  64250,  64298,
+     64346,  64392,  64437,  64481,  64525,  64567,  64609,  64650,
+     64690,  64728,  64766,  64804,  64840,  64875,  64909,  64943,
+     64975,  65007,  65038,  65067,  65096,  65124,  65151,  65177,
+     65203,  65227,  65250,  65273,  65294,  65315,  65335,  65353,
+     65371,  65388,  65404,  65419,  65434,  65447,  65459,  65471,
+     65481,  65491,  65499,  65507,  65514,  65520,  65525,  65529,
+     65532,  65534,  65536,  65536,  65535,  65534,  65532,  65528,
+     65524,  65519,  65513,  65506,  65498,  65489,  65479,  65469,
+     65457,  65445,  65431,  65417,  65401,  65385,  65368,  65350,
+     65331,  65311,  65290,  65269,  65246,  65223,  65198,  65173,
+     65146,  65119,  65091,  65062,  65032,  65001,  64969,  64937,
+     64903,  64869,  64833,  64797,  64760,  64721,  64682,  64642,
+     64601,  64560,  64517,  64473,  64429,  64383,  64337,  64290,
+     64242,  64193,  64143,  64092,  64040,  63987,  63934,  63879,
+     63824,  63768,  63711,  63653,  63594,  63534,  63473,  63411,
+     63349,  63286,  63221,  63156,  63090,  63023,  62955,  62886,
+     62817,  62746,  62675,  62603,  62530,  62456,  62381,  62305,
+     62228,  62151,  62072,  61993,  61913,  61832,  61750,  61667,
+     61584,};
+
+/**
+ * @brief Looks up a table with linear interpolation.
+ * @param table Table.
+ * @param rDist Absolute relative distance.
+ * @return Interpolated value.
+ */
+Fixed lookup(const std::array<std::int32_t, TableSize>& table, const Fixed rDist)
+{
+    constexpr int FractionBits = Fixed::FractionBits - 8;
+    static_assert((1 << (Fixed::FractionBits - FractionBits)) == TableResolution);
+    // Split the distance into the index of the entry and the fraction to the next one.
+    const std::int32_t index    = rDist.raw() >> FractionBits;
+    const std::int32_t fraction = rDist.raw() & ((1 << FractionBits) - 1);
+
+    if (index >= TableSize - 1)
+    {
+        return Fixed::fromRaw(table[TableSize - 1]);
+    }
+
+    const Wide delta = Wide{table[index + 1]} - table[index];
+    return Fixed::fromRaw(table[index] + static_cast<std::int32_t>((delta * fraction + (1 << (FractionBits - 1))) >> FractionBits));
+}
+
+} // namespace
+
+bool collisionCircleLine(const FixedVec2& c, const Fixed r, const FixedVec2& a, const FixedVec2& b, FixedVec2& p)
+{
+    const Wide acx = Wide{c.x.raw()} - a.x.raw();
+    const Wide acy = Wide{c.y.raw()} - a.y.raw();
+    const Wide abx = Wide{b.x.raw()} - a.x.raw();
+    const Wide aby = Wide{b.y.raw()} - a.y.raw();
+    // Calculate the square length of the vectors and dot product. The products have 32 fractional bits, they are
+    // scaled back to 16 so their squares still fit in 64 bits.
+    const Wide dot    = (acx * abx + acy * aby) >> Fixed::FractionBits;
+    const Wide len2AC = (acx * acx + acy * acy) >> Fixed::FractionBits;
+    const Wide len2AB = (abx * abx + aby * aby) >> Fixed::FractionBits;
+    const Wide r2     = (Wide{r.raw()} * r.raw()) >> Fixed::FractionBits;
+    // Calculate the discriminant (32 fractional bits).
+    const Wide discriminant = dot * dot - len2AB * (len2AC - r2);
+    // If the discriminant is greater than or equal to zero, we have real solutions (there is an intersection).
+    if (discriminant >= 0 && len2AB > 0)
+    {
+        const auto sqrt = static_cast<Wide>(isqrt(static_cast<std::uint64_t>(discriminant)));
+        // The solutions are the squares of (-dot +- sqrt) / len2AB, so they are onto the segment when the absolute
+        // value of the numerator is not greater than the denominator.
+        const Wide n0 = -dot + sqrt;
+        const Wide n1 = -dot - sqrt;
+        if ((n0 < 0 ? -n0 : n0) <= len2AB || (n1 < 0 ? -n1 : n1) <= len2AB)
+        {
+            // The nearest point to the center of the ball (projection of the vector ac onto ab).
+            const Wide t = (dot << Fixed::FractionBits) / len2AB;
+            p = {a.x + Fixed::fromRaw(static_cast<std::int32_t>((abx * t) >> Fixed::FractionBits)),
+                 a.y + Fixed::fromRaw(static_cast<std::int32_t>((aby * t) >> Fixed::FractionBits))};
+            // Done.
+            return true;
+        }
+    }
+    // No intersection.
+    return false;
+}
+
+bool collisionBallPaddle(const FixedVec2& c, const Fixed r, const FixedVec2& position, const FixedVec2& size, FixedVec2& where)
+{
+    const FixedVec2 half = size * Fixed(0.5f);
+    // Add the ball radius to the paddle radius.
+    const Wide  hx    = half.x.raw();
+    const Wide  hy    = half.y.raw();
+    const Fixed radii = Fixed::fromRaw(static_cast<std::int32_t>(isqrt(static_cast<std::uint64_t>(hx * hx + hy * hy)))) + r;
+    // Check if the paddle is close enough to collide with the ball.
+    const Wide dx = Wide{position.x.raw()} - c.x.raw();
+    const Wide dy = Wide{position.y.raw()} - c.y.raw();
+    if (dx * dx + dy * dy > Wide{radii.raw()} * radii.raw())
+    {
+        return false;
+    }
+    // Calculate the intersection between the ball and the paddle front line.
+    if (collisionCircleLine(c, r, {position.x - half.x, position.y - half.y}, {position.x - half.x, position.y + half.y}, where))
+    {
+        return true;
+    }
+    // Calculate the intersection between the ball and the paddle back line.
+    if (collisionCircleLine(c, r, {position.x + half.x, position.y - half.y}, {position.x + half.x, position.y + half.y}, where))
+    {
+        return true;
+    }
+    // No collision.
+    return false;
+}
+
+FixedVec2 bounce(const FixedVec2& speed, const Fixed rDist)
+{
+    const Wide sx = speed.x.raw();
+    const Wide sy = speed.y.raw();
+
+    Fixed      length = Fixed::fromRaw(static_cast<std::int32_t>(isqrt(static_cast<std::uint64_t>(sx * sx + sy * sy))));
+    const int  sign   = sx > 0 ? 1 : (sx < 0 ? -1 : 0);
+    const auto dist   = abs(rDist);
+    // Increment the speed regarding the position of the collision (near the center, the speed is reduced; near the end
+    // of the paddle, the speed is increased).
+    length += Fixed(25) * ((Fixed(3) * dist - Fixed(1)) * (Fixed(2) - dist) * Fixed(0.5f));
+    // Clamp the speed between its minimum and maximum values.
+    length = min(Fixed(MaxSpeed), max(Fixed(MinSpeed), length));
+    // Calculate the new speed vector, the direction (sign, 0) rotated by -sign * MaxBounceAngle * rDist.
+    if (sign == 0)
+    {
+        return {};
+    }
+
+    const Fixed cos = lookup(CosTable, dist);
+    const Fixed sin = lookup(SinTable, dist);
+
+    return {sign > 0 ? -(length * cos) : length * cos, rDist.raw() < 0 ? -(length * sin) : length * sin};
+}
+
+} // namespace pong::physics
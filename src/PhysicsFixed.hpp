@@ -0,0 +1,68 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Fixed.hpp"
+
+namespace pong::physics {
+
+/**
+ * @brief Calculates the intersection between a circle and a line, with fixed-point numbers.
+ *
+ * Same test as the floating-point version, the squares are calculated with 64-bit integers.
+ * @param c Center of the circle.
+ * @param r Radius of the circle.
+ * @param a Start point of the line.
+ * @param b End point of the line.
+ * @param p Intersection.
+ *
+ * @return True if the circle and the line intersect, false otherwise.
+ */
+bool collisionCircleLine(const FixedVec2& c, Fixed r, const FixedVec2& a, const FixedVec2& b, FixedVec2& p);
+
+/**
+ * @brief Checks if a ball collides with a paddle, with fixed-point numbers.
+ *
+ * @param c Center of the ball.
+ * @param r Radius of the ball.
+ * @param position Center of the paddle.
+ * @param size Size of the paddle.
+ * @param where Point where the collision happens.
+ *
+ * @return True if the ball and the paddle collide, false otherwise.
+ */
+bool collisionBallPaddle(const FixedVec2& c, Fixed r, const FixedVec2& position, const FixedVec2& size, FixedVec2& where);
+
+/**
+ * @brief Calculates the speed of the ball after bouncing off a paddle, with fixed-point numbers.
+ *
+ * The rotation uses tables of the sine and cosine of the bounce angle instead of `glm::rotate`.
+ * @param speed Speed of the ball before the bounce.
+ * @param rDist Position of the collision relative to the center of the paddle, in the range [-1, 1].
+ * @return The new speed of the ball.
+ */
+FixedVec2 bounce(const FixedVec2& speed, Fixed rDist);
+
+} // namespace pong::physics
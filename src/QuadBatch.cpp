@@ -0,0 +1,140 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "QuadBatch.hpp"
+#include "data/Shader.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace pong {
+namespace      {
+
+/**
+ * @brief Packs a coordinate into a 16-bit signed normalized fraction of `QuadBatch::PackedExtent`.
+ *
+ * Adding a half away from zero before the truncation rounds to the nearest value. It is inlined in the loop over the
+ * corners of `QuadBatch::queue()`.
+ * @param p Coordinate, it is clamped to [-PackedExtent, PackedExtent].
+ * @return Packed coordinate.
+ */
+inline std::int16_t packCoordinate(const float p) noexcept
+{
+    const float scaled = std::clamp(p * (32767.0f / QuadBatch::PackedExtent), -32767.0f, 32767.0f);
+    return static_cast<std::int16_t>(scaled + std::copysign(0.5f, scaled));
+}
+
+} // namespace
+
+std::array<std::uint8_t, 4> packColor(const glm::vec4& color) noexcept
+{
+    // Adding a half before the truncation rounds to the nearest value, the components are not negative.
+    const auto pack = [](const float c)
+    {
+        return static_cast<std::uint8_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f);
+    };
+
+    return {pack(color.r), pack(color.g), pack(color.b), pack(color.a)};
+}
+
+std::array<std::int16_t, 2> packPosition(const glm::vec2& position) noexcept
+{
+    return {packCoordinate(position.x), packCoordinate(position.y)};
+}
+
+void QuadBatch::setLayout(const Layout layout) noexcept
+{
+    clear();
+    mLayout = layout;
+}
+
+std::size_t QuadBatch::size() const noexcept
+{
+    switch (mLayout)
+    {
+        case Layout::Vertices:  return mVertices.size() / VerticesPerQuad;
+        case Layout::Packed:    return mPacked.size()   / PackedVerticesPerQuad;
+        case Layout::Instances: return mInstances.size();
+    }
+
+    return 0;
+}
+
+std::size_t QuadBatch::bytes() const noexcept
+{
+    return size() * bytesPerQuad(mLayout);
+}
+
+const void* QuadBatch::data() const noexcept
+{
+    switch (mLayout)
+    {
+        case Layout::Vertices:  return mVertices.data();
+        case Layout::Packed:    return mPacked.data();
+        case Layout::Instances: return mInstances.data();
+    }
+
+    return nullptr;
+}
+
+void QuadBatch::queue(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+    if (mLayout == Layout::Instances)
+    {
+        mInstances.push_back({position.x, position.y, size.x, size.y, packColor(color)});
+        return;
+    }
+
+    if (mLayout == Layout::Packed)
+    {
+        const std::array<std::uint8_t, 4> packed = packColor(color);
+        for (std::size_t i = 0; i < data::QuadCorners.size(); i += 2)
+        {
+            const float x = data::QuadCorners[i]     * size.x + position.x;
+            const float y = data::QuadCorners[i + 1] * size.y + position.y;
+            mPacked.push_back({{packCoordinate(x), packCoordinate(y)}, packed});
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < data::QuadVertices.size(); i += 2)
+    {
+        mVertices.emplace_back(
+            data::QuadVertices[i]     * size.x + position.x,
+            data::QuadVertices[i + 1] * size.y + position.y,
+            color.r,
+            color.g,
+            color.b,
+            color.a
+        );
+    }
+}
+
+void QuadBatch::clear() noexcept
+{
+    mVertices.clear();
+    mInstances.clear();
+    mPacked.clear();
+}
+
+} // namespace pong
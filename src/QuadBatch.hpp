@@ -0,0 +1,247 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pong {
+
+/**
+ * @brief Vertex of a quad expanded on the CPU, six per quad (two triangles), each one with the color of the quad.
+ */
+struct QuadVertex
+{
+    float px; //!< X-coordinate of the position.
+    float py; //!< Y-coordinate of the position.
+    float cr; //!< Red component of the color.
+    float cg; //!< Green component of the color.
+    float cb; //!< Blue component of the color.
+    float ca; //!< Alpha component of the color.
+};
+
+/**
+ * @brief Instance of a quad, drawn by stretching a unit quad shared by all the instances.
+ */
+struct QuadInstance
+{
+    float cx; //!< X-coordinate of the center.
+    float cy; //!< Y-coordinate of the center.
+    float sx; //!< Width.
+    float sy; //!< Height.
+
+    /** @brief Color, RGBA with 8 bits per component in this order in memory. */
+    std::array<std::uint8_t, 4> color;
+};
+
+/**
+ * @brief Packed vertex of a quad expanded on the CPU, four per quad (the corners, indexed as two triangles).
+ *
+ * The position is a 16-bit signed normalized fraction of `QuadBatch::PackedExtent` and the color has 8 bits per
+ * component, both read as normalized values by the GPU.
+ */
+struct PackedVertex
+{
+    /** @brief Position, X and Y, in units of `QuadBatch::PackedExtent` / 32767. */
+    std::array<std::int16_t, 2> position;
+
+    /** @brief Color, RGBA with 8 bits per component in this order in memory. */
+    std::array<std::uint8_t, 4> color;
+};
+
+static_assert(sizeof(QuadVertex)   == 24);
+static_assert(sizeof(QuadInstance) == 20);
+static_assert(sizeof(PackedVertex) == 8);
+
+/**
+ * @brief Packs a color into 8 bits per component, rounding to the nearest value.
+ * @param color Color, every component is clamped to [0, 1].
+ * @return Packed color.
+ */
+[[nodiscard]] std::array<std::uint8_t, 4> packColor(const glm::vec4& color) noexcept;
+
+/**
+ * @brief Packs a position into 16-bit signed normalized fractions of `QuadBatch::PackedExtent`, rounding to the nearest
+ * value.
+ * @param position Position, every coordinate is clamped to [-PackedExtent, PackedExtent].
+ * @return Packed position.
+ */
+[[nodiscard]] std::array<std::int16_t, 2> packPosition(const glm::vec2& position) noexcept;
+
+/**
+ * @brief Collects the quads of a frame in the layout a renderer uploads to the GPU.
+ *
+ * The batch does not depend on any graphics API, so the CPU side of every layout can be measured without a renderer:
+ *
+ * - **Vertices:** Every quad is expanded into six `QuadVertex` (144 bytes), drawn as a list of triangles.
+ * - **Packed:** Every quad is expanded into its four corners as `PackedVertex` (32 bytes), drawn through a static
+ *   index buffer with `IndicesPerQuad` indices per quad.
+ * - **Instances:** Every quad is a single `QuadInstance` (20 bytes), drawn as instances of a unit quad.
+ *
+ * The buffers keep their capacity when the batch is cleared, so after the first frames queueing does not allocate.
+ */
+class QuadBatch
+{
+public:
+
+    /** @brief Defines the layouts of the quads. */
+    enum class Layout
+    {
+        Vertices, //!< Six vertices per quad.
+        Packed,   //!< Four packed vertices per quad, indexed.
+        Instances //!< An instance per quad.
+    };
+
+    /** @brief Number of vertices of a quad in the vertices layout, and of the unit quad of the instances. */
+    static constexpr std::size_t VerticesPerQuad = 6;
+
+    /** @brief Number of vertices of a quad in the packed layout. */
+    static constexpr std::size_t PackedVerticesPerQuad = 4;
+
+    /** @brief Number of indices of a quad in the packed layout, two triangles. */
+    static constexpr std::size_t IndicesPerQuad = 6;
+
+    /** @brief Largest coordinate of the packed positions, in game units; larger ones are clamped. */
+    static constexpr float PackedExtent = 512.0f;
+
+    /**
+     * @brief Constructor.
+     * @param layout Layout of the quads.
+     */
+    explicit QuadBatch(Layout layout = Layout::Instances) noexcept : mLayout(layout) {}
+
+    /**
+     * @brief Gets the layout of the quads.
+     * @return Layout.
+     */
+    [[nodiscard]] Layout layout() const noexcept { return mLayout; }
+
+    /**
+     * @brief Changes the layout of the quads, removing the quads queued.
+     * @param layout Layout.
+     */
+    void setLayout(Layout layout) noexcept;
+
+    /**
+     * @brief Gets the number of quads queued.
+     * @return Number of quads.
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Checks if there are no quads queued.
+     * @return True if there are no quads, false otherwise.
+     */
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Gets the number of bytes to upload for the quads queued.
+     * @return Number of bytes.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept;
+
+    /**
+     * @brief Gets the number of bytes to upload for a quad in a layout.
+     * @param layout Layout.
+     * @return Number of bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t bytesPerQuad(const Layout layout) noexcept
+    {
+        switch (layout)
+        {
+            case Layout::Vertices:  return VerticesPerQuad * sizeof(QuadVertex);
+            case Layout::Packed:    return PackedVerticesPerQuad * sizeof(PackedVertex);
+            case Layout::Instances: return sizeof(QuadInstance);
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Gets the number of vertices that are uploaded or drawn for a quad in a layout.
+     * @param layout Layout.
+     * @return Number of vertices, the ones of the unit quad for the instances.
+     */
+    [[nodiscard]] static constexpr std::size_t verticesPerQuad(const Layout layout) noexcept
+    {
+        return layout == Layout::Packed ? PackedVerticesPerQuad : VerticesPerQuad;
+    }
+
+    /**
+     * @brief Gets the vertices of the quads, in the vertices layout.
+     * @return Vertices.
+     */
+    [[nodiscard]] const std::vector<QuadVertex>& vertices() const noexcept { return mVertices; }
+
+    /**
+     * @brief Gets the instances of the quads, in the instances layout.
+     * @return Instances.
+     */
+    [[nodiscard]] const std::vector<QuadInstance>& instances() const noexcept { return mInstances; }
+
+    /**
+     * @brief Gets the packed vertices of the quads, in the packed layout.
+     * @return Packed vertices.
+     */
+    [[nodiscard]] const std::vector<PackedVertex>& packed() const noexcept { return mPacked; }
+
+    /**
+     * @brief Gets the data to upload for the quads queued: the vertices or the instances, depending on the layout.
+     * @return Data, `bytes()` long.
+     */
+    [[nodiscard]] const void* data() const noexcept;
+
+    /**
+     * @brief Adds a quad.
+     * @param position The center position of the quad, in game units.
+     * @param size The width and height of the quad, in game units.
+     * @param color The RGBA color of the quad.
+     */
+    void queue(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+
+    /**
+     * @brief Removes all the quads.
+     */
+    void clear() noexcept;
+
+private:
+
+    /** @brief Layout of the quads. */
+    Layout mLayout;
+
+    /** @brief Vertices of the quads, in the vertices layout. */
+    std::vector<QuadVertex> mVertices;
+
+    /** @brief Instances of the quads, in the instances layout. */
+    std::vector<QuadInstance> mInstances;
+
+    /** @brief Packed vertices of the quads, in the packed layout. */
+    std::vector<PackedVertex> mPacked;
+};
+
+} // namespace pong
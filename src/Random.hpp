@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+namespace pong {
+
+/**
+ * @brief A small random generator (PCG32) with an accessible state.
+ *
+ * The whole state is a 64-bit integer, so it can be saved in a snapshot, and the numbers are generated with integer
+ * arithmetic and exact conversions, so the sequences are the same with every compiler and standard library (the
+ * distributions of `<random>` are implementation-defined).
+ */
+class Random
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param value Seed.
+     */
+    explicit constexpr Random(const std::uint64_t value = 0) noexcept
+    {
+        seed(value);
+    }
+
+    /**
+     * @brief Restarts the sequence.
+     *
+     * Consecutive seeds give unrelated sequences.
+     * @param value Seed.
+     */
+    constexpr void seed(const std::uint64_t value) noexcept
+    {
+        mState = 0;
+        next();
+        mState += value;
+        next();
+    }
+
+    /**
+     * @brief Gets the state.
+     * @return State.
+     */
+    [[nodiscard]] constexpr std::uint64_t state() const noexcept { return mState; }
+
+    /**
+     * @brief Sets the state.
+     * @param value State, as returned by `state()`.
+     */
+    constexpr void setState(const std::uint64_t value) noexcept { mState = value; }
+
+    /**
+     * @brief Generates the next number of the sequence.
+     * @return Random number uniformly distributed in the full range of 32 bits.
+     */
+    constexpr std::uint32_t next() noexcept
+    {
+        const std::uint64_t previous = mState;
+        mState = previous * Multiplier + Increment;
+        // Output function (XSH RR): xorshift the high bits and rotate them.
+        const auto xorShifted = static_cast<std::uint32_t>(((previous >> 18u) ^ previous) >> 27u);
+        const auto rotation   = static_cast<std::uint32_t>(previous >> 59u);
+        return (xorShifted >> rotation) | (xorShifted << ((32u - rotation) & 31u));
+    }
+
+    /**
+     * @brief Generates a random number in a range.
+     * @param min Minimum value.
+     * @param max Maximum value.
+     * @return Random number uniformly distributed in the range [min, max).
+     */
+    constexpr float uniform(const float min, const float max) noexcept
+    {
+        // The 24 high bits fit exactly in the mantissa of a float.
+        return min + (max - min) * (static_cast<float>(next() >> 8u) * (1.0f / 16777216.0f));
+    }
+
+private:
+
+    /** @brief Multiplier of the linear congruential step. */
+    static constexpr std::uint64_t Multiplier = 6364136223846793005u;
+
+    /** @brief Increment of the linear congruential step (any odd number). */
+    static constexpr std::uint64_t Increment = 1442695040888963407u;
+
+    /** @brief State. */
+    std::uint64_t mState = 0;
+};
+
+} // namespace pong
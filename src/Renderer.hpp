@@ -25,6 +25,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 
 namespace pong {
 
@@ -38,9 +39,19 @@ namespace pong {
  * This class is non-copyable and non-movable as it represents a unique system resource.
  * The intended lifecycle is:
  *     construction -> `init()` -> frame loop (`beginFrame`/`endFrame`) -> `quit()` -> destruction.
+ *
+ * Besides the quads queued every frame, the renderer keeps static meshes: quads recorded once between `beginMesh()`
+ * and `endMesh()`, kept by the renderer (on the GPU when it has one) and drawn by their ID with `drawMesh()`, so the
+ * geometry that never changes (the table, the texts of the menus) is not uploaded every frame. `StaticMesh` manages
+ * their lifetime.
  */
 class Renderer
 {
+public:
+
+    /** @brief Identifier of a static mesh. */
+    using MeshId = std::uint32_t;
+
 protected:
 
     /**
@@ -93,6 +104,32 @@ public:
      * @param color The RGBA color of the quad.
      */
     virtual void queueQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) = 0;
+
+    /**
+     * @brief Starts recording a static mesh.
+     *
+     * The quads queued until `endMesh()` are stored in the mesh instead of drawn in the current frame. Meshes can be
+     * recorded at any time, also between `beginFrame()` and `endFrame()`, but not inside another mesh.
+     */
+    virtual void beginMesh() = 0;
+
+    /**
+     * @brief Finishes recording a static mesh.
+     * @return Identifier of the mesh, valid until `destroyMesh()`.
+     */
+    virtual MeshId endMesh() = 0;
+
+    /**
+     * @brief Adds a static mesh to the current frame, in the order of the quads queued.
+     * @param id Identifier of the mesh.
+     */
+    virtual void drawMesh(MeshId id) = 0;
+
+    /**
+     * @brief Destroys a static mesh and frees its memory.
+     * @param id Identifier of the mesh.
+     */
+    virtual void destroyMesh(MeshId id) = 0;
 };
 
 } // namespace pong
@@ -23,35 +23,79 @@
 ////////////////////////////////////////////////////////////
 
 #include "RendererGL3.hpp"
+#include "RealTimeClock.hpp"
 #include "data/Shader.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/gl.h>
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace pong {
 namespace      {
 
+static_assert(RendererGL3::verticesPerBatch(QuadBatch::Layout::Packed) <= 65536, "The packed vertices are indexed with 16 bits");
+
 /**
- * @brief Creates and initializes a vertex buffer object (VBO) for a standard quad.
+ * @brief Creates a vertex buffer object (VBO) with the unit quad drawn by the instances.
  *
- * Generates an OpenGL buffer, binds it, and uploads static vertex data suitable for rendering a quad composed of two
- * triangles.
+ * The quad is uploaded once, as two triangles covering the area from -0.5 to 0.5, and never changes.
  * @param id A pointer that will receive the handle of the newly created VBO.
  * @return True on success, false otherwise.
  */
-bool createQuadVBO(GLuint* id);
+bool createUnitQuadVBO(GLuint* id);
+
+/**
+ * @brief Creates an index buffer with the two triangles of every quad of a full batch of packed vertices.
+ * @param id A pointer that will receive the handle of the newly created buffer.
+ * @return True on success, false otherwise.
+ */
+bool createIndexVBO(GLuint* id);
 
 /**
  * @brief Creates and configures a vertex array object (VAO) for a quad.
  *
- * Generates a VAO and configures its vertex attribute pointers to match the layout of the data in the provided VBO.
- * This effectively links the vertex data to the shader pipeline's input.
+ * Generates a VAO and enables the vertex attributes of the position and the color. Their pointers are set for every
+ * batch (see `setVertexAttributes()`), since the upload strategy decides the buffer and the offset of the batch.
  * @param id A pointer that will receive the handle of the newly created VAO.
- * @param vbo The handle of an existing VBO that contains the vertex data for the quad.
+ * @param indexVbo The handle of the index buffer of the packed vertices, or 0 if the vertices are not indexed.
  * @return True on success, false otherwise.
  */
-bool createQuadVAO(GLuint* id, GLuint vbo);
+bool createQuadVAO(GLuint* id, GLuint indexVbo);
+
+/**
+ * @brief Creates and configures a vertex array object (VAO) for instances of the unit quad.
+ *
+ * The corners come from the unit quad and advance per vertex, the center, size and color come from the instances and
+ * advance per instance. The pointers of the instances are set for every batch (see `setInstanceAttributes()`).
+ * @param id A pointer that will receive the handle of the newly created VAO.
+ * @param quadVbo The handle of the VBO with the unit quad.
+ * @return True on success, false otherwise.
+ */
+bool createInstanceVAO(GLuint* id, GLuint quadVbo);
+
+/**
+ * @brief Points the attributes of the vertices to a batch in the buffer bound to `GL_ARRAY_BUFFER`.
+ * @param offset Offset of the batch in the buffer, in bytes.
+ */
+void setVertexAttributes(std::size_t offset);
+
+/**
+ * @brief Points the attributes of the packed vertices to a batch in the buffer bound to `GL_ARRAY_BUFFER`.
+ * @param offset Offset of the batch in the buffer, in bytes.
+ */
+void setPackedAttributes(std::size_t offset);
+
+/**
+ * @brief Points the attributes of the instances to a batch in the buffer bound to `GL_ARRAY_BUFFER`.
+ * @param offset Offset of the batch in the buffer, in bytes.
+ */
+void setInstanceAttributes(std::size_t offset);
 
 /**
  * @brief Compiles and links a complete GLSL shader program from predefined sources.
@@ -59,9 +103,10 @@ bool createQuadVAO(GLuint* id, GLuint vbo);
  * This function handles the entire shader pipeline: creating shader objects, compiling vertex and fragment shaders from
  * source, attaching them to a program object, and linking the final program. It performs error checking at each stage.
  * @param id A pointer that will receive the handle of the newly created program.
+ * @param vs Source of the vertex shader, the fragment shader is the same for all the programs.
  * @return True on success, false otherwise.
  */
-bool createProgram(GLuint* id);
+bool createProgram(GLuint* id, std::string_view vs);
 
 /**
  * @brief Prints the information log for a given GLSL shader object.
@@ -100,23 +145,13 @@ bool checkErrors();
 
 } // namespace
 
-struct RendererGL3::QuadVertex
-{
-    float px; //!< X-coordinate of the position.
-    float py; //!< Y-coordinate of the position.
-    float cr; //!< Red component of the color.
-    float cg; //!< Green component of the color.
-    float cb; //!< Blue component of the color.
-    float ca; //!< Alpha component fo the color.
-};
-
-std::unique_ptr<Renderer> RendererGL3::create(const int width, const int height)
+std::unique_ptr<Renderer> RendererGL3::create(const int width, const int height, const Settings& settings)
 {
     const int w = width  <= 0 ? 640 :width;
     const int h = height <= 0 ? 480 :height;
 
     auto renderer = std::unique_ptr<RendererGL3>(new RendererGL3{});
-    if (renderer->init(w, h)) {
+    if (renderer->init(w, h, settings)) {
         return renderer;
     }
 
@@ -124,12 +159,45 @@ std::unique_ptr<Renderer> RendererGL3::create(const int width, const int height)
 }
 
 
-bool RendererGL3::init(const int screenWidth, const int screenHeight)
+bool RendererGL3::init(const int screenWidth, const int screenHeight, const Settings& settings)
 {
     mScreenWidth  = screenWidth;
     mScreenHeight = screenHeight;
-    // Create the buffers and shader programs.
-    if (!createQuadVBO(mQuadVBO.idPtr()) || !createQuadVAO(mQuadVAO.idPtr(), mQuadVBO) || !createProgram(mProgram.idPtr()))
+    mQuads.setLayout(settings.layout);
+    // Create the buffers and shader programs of the layout.
+    if (settings.layout == QuadBatch::Layout::Instances)
+    {
+        if (!createUnitQuadVBO(mQuadVBO.idPtr()) || !createInstanceVAO(mQuadVAO.idPtr(), mQuadVBO) ||
+            !createProgram(mProgram.idPtr(), data::GL3InstancedVS))
+        {
+            return false;
+        }
+    }
+    else if (settings.layout == QuadBatch::Layout::Packed)
+    {
+        if (!createIndexVBO(mIndexVBO.idPtr()) || !createQuadVAO(mQuadVAO.idPtr(), mIndexVBO) || !createProgram(mProgram.idPtr(), data::GL3VS))
+        {
+            return false;
+        }
+    }
+    else if (!createQuadVAO(mQuadVAO.idPtr(), 0) || !createProgram(mProgram.idPtr(), data::GL3VS))
+    {
+        return false;
+    }
+    // The buffer of the static meshes gets its storage when the first mesh is recorded.
+    glGenBuffers(1, mMeshVBO.idPtr());
+    // Create the upload strategy requested, or the fastest one.
+    if (settings.upload)
+    {
+        mUpload = GL3Upload::create(*settings.upload, QuadsPerBatch * QuadBatch::bytesPerQuad(settings.layout), settings.load);
+        if (!mUpload)
+        {
+            std::cerr << "Upload strategy not available: " << GL3Upload::name(*settings.upload) << std::endl;
+            return false;
+        }
+        std::cout << "Upload: " << GL3Upload::name(mUpload->kind()) << std::endl;
+    }
+    else if (!pickUpload(settings.load))
     {
         return false;
     }
@@ -144,6 +212,11 @@ bool RendererGL3::init(const int screenWidth, const int screenHeight)
     const float aspect = screenHeight == 0 ? 1.0f : static_cast<float>(screenWidth) / static_cast<float>(screenHeight);
     // Calculate the projection matrix.
     mProjection = glm::ortho(-100.0f * aspect, 100.0f * aspect, -100.0f, 100.0f, -1.0f, 1.0f);
+    // The packed positions are normalized, scale them back to game units.
+    if (settings.layout == QuadBatch::Layout::Packed)
+    {
+        mProjection = glm::scale(mProjection, glm::vec3(QuadBatch::PackedExtent, QuadBatch::PackedExtent, 1.0f));
+    }
 
     return true;
 }
@@ -156,30 +229,168 @@ void RendererGL3::beginFrame()
 
 void RendererGL3::endFrame()
 {
-    glBindBuffer(GL_ARRAY_BUFFER, mQuadVBO);
+    if (mMeshesChanged)
+    {
+        uploadMeshes();
+    }
+
     glBindVertexArray(mQuadVAO);
     glUseProgram     (mProgram);
     // The transformation matrix is the same for all quads.
     glUniformMatrix4fv(mLocTransform, 1, GL_FALSE, glm::value_ptr(mProjection));
 
-    const std::size_t vertices = mQuads.size();
-          std::size_t offset   = 0;
-    // Upload and draw each batch of vertices.
-    while (offset < vertices)
+    // Draw the meshes in order with the quads queued, which are uploaded.
+    std::size_t queued = 0;
+    for (const MeshDraw& draw : mMeshDraws)
     {
-        // Calculate the number of vertices to upload in this batch.
-        const std::size_t count = std::min(vertices - offset, VerticesPerBatch);
-        // Update the buffer and draw.
-        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(QuadVertex), mQuads.data() + offset);
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(count));
-        // Move the offset.
-        offset += count;
+        drawQueued(queued, draw.queued);
+        queued = draw.queued;
+
+        const Mesh& mesh = mMeshes[draw.id];
+        if (mesh.live && !mesh.quads.empty())
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mMeshVBO);
+            drawQuads(mesh.first * QuadBatch::bytesPerQuad(mQuads.layout()), mesh.quads.size());
+        }
     }
+    drawQueued(queued, mQuads.size());
     // Unbind the buffer to avoid unwanted access.
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     // Clear the list of quads to be ready for the next iteration.
     mQuads.clear();
+    mMeshDraws.clear();
+}
+
+void RendererGL3::uploadMeshes()
+{
+    const std::size_t bytes = QuadBatch::bytesPerQuad(mQuads.layout());
+
+    std::size_t quads = 0;
+    for (Mesh& mesh : mMeshes)
+    {
+        mesh.first  = quads;
+        quads      += mesh.quads.size();
+    }
+    // Allocate the storage and copy the meshes, the destroyed ones are empty.
+    glBindBuffer(GL_ARRAY_BUFFER, mMeshVBO);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(quads * bytes), nullptr, GL_STATIC_DRAW);
+    for (const Mesh& mesh : mMeshes)
+    {
+        if (!mesh.quads.empty())
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(mesh.first * bytes), static_cast<GLsizeiptr>(mesh.quads.bytes()), mesh.quads.data());
+        }
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    mMeshesChanged = false;
+}
+
+void RendererGL3::drawQueued(const std::size_t first, const std::size_t last)
+{
+    const std::size_t bytes = QuadBatch::bytesPerQuad(mQuads.layout());
+    const auto*       data  = static_cast<const std::byte*>(mQuads.data());
+    // Upload and draw each batch of quads.
+    for (std::size_t offset = first; offset < last; offset += QuadsPerBatch)
+    {
+        drawBatch(data + offset * bytes, std::min(last - offset, QuadsPerBatch));
+    }
+}
+
+bool RendererGL3::pickUpload(const GLADloadfunc load)
+{
+    const std::size_t            bytes = QuadsPerBatch * QuadBatch::bytesPerQuad(mQuads.layout());
+    const std::vector<std::byte> zeros(bytes);
+    // Degenerate quads, nothing is drawn but the vertex shader runs as in a frame.
+    glBindVertexArray(mQuadVAO);
+    glUseProgram     (mProgram);
+
+    std::ostringstream report;
+    double             best = 0.0;
+    for (const GL3Upload::Kind kind : GL3Upload::Kinds)
+    {
+        report << (kind == GL3Upload::Kinds.front() ? "" : ", ") << GL3Upload::name(kind);
+
+        std::unique_ptr<GL3Upload> upload = GL3Upload::create(kind, bytes, load);
+        if (!upload)
+        {
+            report << " unavailable";
+            continue;
+        }
+        // Measure from an idle GPU to an idle GPU.
+        std::swap(mUpload, upload);
+        glFinish();
+        RealTimeClock clock;
+        for (std::size_t batch = 0; batch < UploadBenchmarkFrames * UploadBenchmarkBatches; ++batch)
+        {
+            drawBatch(zeros.data(), QuadsPerBatch);
+        }
+        glFinish();
+        const double seconds = clock.elapsed().count();
+        report << " " << std::fixed << std::setprecision(2) << seconds * 1000.0 << " ms";
+        // Keep the fastest.
+        if (upload && seconds >= best)
+        {
+            std::swap(mUpload, upload);
+        }
+        else
+        {
+            best = seconds;
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    if (!mUpload)
+    {
+        std::cerr << "No upload strategy available" << std::endl;
+        return false;
+    }
+    std::cout << "Upload: " << GL3Upload::name(mUpload->kind()) << " (" << report.str() << ")" << std::endl;
+
+    return true;
+}
+
+void RendererGL3::drawBatch(const void* data, const std::size_t quads)
+{
+    drawQuads(mUpload->upload(data, quads * QuadBatch::bytesPerQuad(mQuads.layout())), quads);
+    // Let the strategy know when the buffer of the batch is free.
+    mUpload->drawn();
+}
+
+void RendererGL3::drawQuads(const std::size_t offset, const std::size_t quads)
+{
+    switch (mQuads.layout())
+    {
+        case QuadBatch::Layout::Vertices:
+        {
+            setVertexAttributes(offset);
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(quads * QuadBatch::VerticesPerQuad));
+        }
+        break;
+
+        case QuadBatch::Layout::Packed:
+        {
+            // The index buffer covers a full batch, larger meshes are drawn in several.
+            const std::size_t bytes = QuadBatch::bytesPerQuad(QuadBatch::Layout::Packed);
+            for (std::size_t first = 0; first < quads; first += QuadsPerBatch)
+            {
+                const std::size_t count = std::min(quads - first, QuadsPerBatch);
+                setPackedAttributes(offset + first * bytes);
+                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count * QuadBatch::IndicesPerQuad), GL_UNSIGNED_SHORT, nullptr);
+            }
+        }
+        break;
+
+        case QuadBatch::Layout::Instances:
+        {
+            setInstanceAttributes(offset);
+            glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(QuadBatch::VerticesPerQuad), static_cast<GLsizei>(quads));
+        }
+        break;
+    }
 }
 
 void RendererGL3::queueQuad(const glm::vec2& position, const glm::vec2& size)
@@ -189,48 +400,132 @@ void RendererGL3::queueQuad(const glm::vec2& position, const glm::vec2& size)
 
 void RendererGL3::queueQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
 {
-    for (std::size_t i = 0; i < data::QuadVertices.size(); i += 2)
+    if (mRecording)
+    {
+        mMeshes[*mRecording].quads.queue(position, size, color);
+    }
+    else
     {
-        mQuads.emplace_back(
-            data::QuadVertices[i]     * size.x + position.x,
-            data::QuadVertices[i + 1] * size.y + position.y,
-            color.r,
-            color.g,
-            color.b,
-            color.a
-        );
+        mQuads.queue(position, size, color);
     }
 }
 
+void RendererGL3::beginMesh()
+{
+    // Reuse the identifier of a destroyed mesh, if any.
+    if (!mFreeMeshes.empty())
+    {
+        mRecording = mFreeMeshes.back();
+        mFreeMeshes.pop_back();
+    }
+    else
+    {
+        mRecording = static_cast<MeshId>(mMeshes.size());
+        mMeshes.push_back({QuadBatch(mQuads.layout())});
+    }
+}
+
+Renderer::MeshId RendererGL3::endMesh()
+{
+    const MeshId id = *mRecording;
+
+    mMeshes[id].live = true;
+    mMeshesChanged   = true;
+    mRecording.reset();
+
+    return id;
+}
+
+void RendererGL3::drawMesh(const MeshId id)
+{
+    mMeshDraws.push_back({id, mQuads.size()});
+}
+
+void RendererGL3::destroyMesh(const MeshId id)
+{
+    // The quads leave the buffer the next time the meshes are uploaded.
+    mMeshes[id].quads.clear();
+    mMeshes[id].live = false;
+    mMeshesChanged   = true;
+    mFreeMeshes.push_back(id);
+}
+
 namespace {
 
-bool createQuadVBO(GLuint* id)
+bool createUnitQuadVBO(GLuint* id)
 {
     clearErrors();
     // Generate the buffer and bind it.
     glGenBuffers(1, id);
     glBindBuffer(GL_ARRAY_BUFFER, *id);
-    // Update the data.
-    glBufferData(GL_ARRAY_BUFFER, RendererGL3::VerticesPerBatch * sizeof(RendererGL3::QuadVertex), nullptr, GL_DYNAMIC_DRAW);
+    // Upload the quad, it is never updated.
+    glBufferData(GL_ARRAY_BUFFER, sizeof(data::QuadVertices), data::QuadVertices.data(), GL_STATIC_DRAW);
     // Unbind.
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     return !checkErrors();
 }
 
-bool createQuadVAO(GLuint* id, const GLuint vbo)
+bool createIndexVBO(GLuint* id)
+{
+    std::vector<GLushort> indices;
+    indices.reserve(RendererGL3::QuadsPerBatch * QuadBatch::IndicesPerQuad);
+    for (std::size_t quad = 0; quad < RendererGL3::QuadsPerBatch; ++quad)
+    {
+        for (const unsigned short index : data::QuadIndices)
+        {
+            indices.push_back(static_cast<GLushort>(quad * QuadBatch::PackedVerticesPerQuad + index));
+        }
+    }
+
+    clearErrors();
+    // Generate the buffer and bind it.
+    glGenBuffers(1, id);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *id);
+    // Upload the indices, they are never updated.
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(GLushort)), indices.data(), GL_STATIC_DRAW);
+    // Unbind.
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return !checkErrors();
+}
+
+bool createQuadVAO(GLuint* id, const GLuint indexVbo)
+{
+    clearErrors();
+    // Generate the buffer and bind it.
+    glGenVertexArrays(1, id);
+    glBindVertexArray(*id);
+    // The position and the color, the pointers are set for every batch.
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    // The index buffer is part of the state of the VAO.
+    if (indexVbo != 0)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVbo);
+    }
+    // Unbind, the VAO first to keep its index buffer.
+    glBindVertexArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    return !checkErrors();
+}
+
+bool createInstanceVAO(GLuint* id, const GLuint quadVbo)
 {
     clearErrors();
     // Generate the buffer and bind it.
     glGenVertexArrays(1, id);
     glBindVertexArray(*id);
-    // Bind the quad VBO.
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    // Pointers.
+    // The corners of the unit quad, per vertex.
+    glBindBuffer(GL_ARRAY_BUFFER, quadVbo);
     glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    // The center and size, and the color, per instance; the pointers are set for every batch.
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), nullptr);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(2 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
     // Unbind.
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -238,16 +533,34 @@ bool createQuadVAO(GLuint* id, const GLuint vbo)
     return !checkErrors();
 }
 
-bool createProgram(GLuint* id)
+void setVertexAttributes(const std::size_t offset)
+{
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), reinterpret_cast<void*>(offset));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), reinterpret_cast<void*>(offset + offsetof(QuadVertex, cr)));
+}
+
+void setPackedAttributes(const std::size_t offset)
+{
+    glVertexAttribPointer(0, 2, GL_SHORT,         GL_TRUE, sizeof(PackedVertex), reinterpret_cast<void*>(offset));
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), reinterpret_cast<void*>(offset + offsetof(PackedVertex, color)));
+}
+
+void setInstanceAttributes(const std::size_t offset)
+{
+    glVertexAttribPointer(1, 4, GL_FLOAT,         GL_FALSE, sizeof(QuadInstance), reinterpret_cast<void*>(offset));
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(QuadInstance), reinterpret_cast<void*>(offset + offsetof(QuadInstance, color)));
+}
+
+bool createProgram(GLuint* id, const std::string_view vs)
 {
     clearErrors();
     // Sources.
-    const GLchar* vsSrc[1] = {data::GL3VS.data()};
+    const GLchar* vsSrc[1] = {vs.data()};
     const GLchar* fsSrc[1] = {data::GL3FS.data()};
     // Create the vertex and frame shader programs.
     const GLuint vsId = glCreateShader(GL_VERTEX_SHADER);
     const GLuint fsId = glCreateShader(GL_FRAGMENT_SHADER);
-    const auto vsLen = static_cast<GLint>(data::GL3VS.length());
+    const auto vsLen = static_cast<GLint>(vs.length());
     const auto fsLen = static_cast<GLint>(data::GL3FS.length());
     GLint status1 = 0;
     GLint status2 = 0;
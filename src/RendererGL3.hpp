@@ -24,9 +24,12 @@
 
 #pragma once
 
+#include "QuadBatch.hpp"
 #include "Renderer.hpp"
+#include "RendererGL3Upload.hpp"
 #include "RendererGL3Util.hpp"
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace pong {
@@ -40,6 +43,13 @@ namespace pong {
  * - **Factory Creation:** It must be instantiated via the static `create()` method.
  * - **RAII:** All OpenGL resources (VBO, VAO, shaders) are managed automatically by RAII handles, guaranteeing no
  *   resource leaks.
+ *
+ * The quads are uploaded in the layout chosen at creation (see `QuadBatch`): by default as instances of a unit quad
+ * stored once in a static buffer, drawn with `glDrawArraysInstanced`, expanded into four packed vertices each, drawn
+ * with `glDrawElements` through a static index buffer, or expanded into six vertices each. The batches
+ * are streamed through an upload strategy (see `GL3Upload`), by default the fastest one in a short benchmark run at
+ * creation. The static meshes are kept in the same layout in a `GL_STATIC_DRAW` buffer, uploaded again only when a
+ * mesh is recorded or destroyed, and drawn from it between the batches of the quads queued before and after them.
  */
 class RendererGL3 final : public Renderer
 {
@@ -47,12 +57,36 @@ public:
 
     static constexpr std::size_t QuadsPerBatch = 1024;
 
-    static constexpr std::size_t VerticesPerBatch = QuadsPerBatch * 6;
+    /**
+     * @brief Gets the number of vertices of a full batch in a layout, which sizes the index buffer of the packed one.
+     * @param layout Layout of the quads.
+     * @return Number of vertices.
+     */
+    static constexpr std::size_t verticesPerBatch(const QuadBatch::Layout layout) noexcept
+    {
+        return QuadsPerBatch * QuadBatch::verticesPerQuad(layout);
+    }
+
+    /** @brief Number of frames uploaded to measure each strategy in the benchmark at creation. */
+    static constexpr std::size_t UploadBenchmarkFrames = 60;
+
+    /** @brief Number of full batches of every frame of the benchmark. */
+    static constexpr std::size_t UploadBenchmarkBatches = 4;
 
     /**
-     * @brief A private struct representing a single quadrilateral to be rendered in a batch.
+     * @brief Defines the options of the renderer.
      */
-    struct QuadVertex;
+    struct Settings
+    {
+        /** @brief Layout of the quads uploaded. */
+        QuadBatch::Layout layout = QuadBatch::Layout::Instances;
+
+        /** @brief Upload strategy, if none the fastest one is picked by a benchmark. */
+        std::optional<GL3Upload::Kind> upload;
+
+        /** @brief Function to get the address of the OpenGL functions not loaded by default, it may be null. */
+        GLADloadfunc load = nullptr;
+    };
 
     /**
      * @brief Factory method to create and initialize a `RendererGL3` instance.
@@ -61,9 +95,10 @@ public:
      * allocation.
      * @param width The desired width of the rendering window, in pixels.
      * @param height The desired height of the rendering window, in pixels.
+     * @param settings Options of the renderer.
      * @return A unique pointer holding the new instance if initialization is successful, or null if it fails.
      */
-    static std::unique_ptr<Renderer> create(int width, int height);
+    static std::unique_ptr<Renderer> create(int width, int height, const Settings& settings);
 
     /**
      * @brief Default destructor.
@@ -87,9 +122,52 @@ private:
      * uniform locations.
      * @param screenWidth The width of the screen.
      * @param screenHeight The height of the screen.
+     * @param settings Options of the renderer.
      * @return True on success, false on failure.
      */
-    bool init(int screenWidth, int screenHeight);
+    bool init(int screenWidth, int screenHeight, const Settings& settings);
+
+    /**
+     * @brief Creates every available upload strategy, uploads and draws the same frames of degenerate quads with each
+     * one, and keeps the fastest.
+     *
+     * The choice and the time of every strategy are reported in the standard output.
+     * @param load Function to get the address of the OpenGL functions not loaded by default, it may be null.
+     * @return True on success, false if no strategy is available.
+     */
+    bool pickUpload(GLADloadfunc load);
+
+    /**
+     * @brief Uploads all the static meshes to their buffer, one after another.
+     */
+    void uploadMeshes();
+
+    /**
+     * @brief Uploads and draws a range of the quads queued in the current frame, in batches of `QuadsPerBatch` quads.
+     *
+     * The vertex array and the shader program must be bound.
+     * @param first Index of the first quad.
+     * @param last Index past the last quad.
+     */
+    void drawQueued(std::size_t first, std::size_t last);
+
+    /**
+     * @brief Uploads and draws a batch of quads.
+     *
+     * The vertex array and the shader program must be bound.
+     * @param data Vertices or instances of the batch, in the layout of the quads.
+     * @param quads Number of quads, at most `QuadsPerBatch`.
+     */
+    void drawBatch(const void* data, std::size_t quads);
+
+    /**
+     * @brief Draws quads from the buffer bound to `GL_ARRAY_BUFFER`.
+     *
+     * The vertex array and the shader program must be bound.
+     * @param offset Offset of the first quad in the buffer, in bytes.
+     * @param quads Number of quads.
+     */
+    void drawQuads(std::size_t offset, std::size_t quads);
 
 public:
 
@@ -101,17 +179,58 @@ public:
 
     void queueQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override;
 
+    void beginMesh() override;
+
+    MeshId endMesh() override;
+
+    void drawMesh(MeshId id) override;
+
+    void destroyMesh(MeshId id) override;
+
 private:
 
+    /**
+     * @brief Defines a static mesh.
+     */
+    struct Mesh
+    {
+        /** @brief Quads, in the layout of the renderer. */
+        QuadBatch quads;
+
+        /** @brief Index of the first quad in the buffer of the meshes. */
+        std::size_t first = 0;
+
+        /** @brief Flag indicating whether the mesh exists or its identifier is free. */
+        bool live = false;
+    };
+
+    /**
+     * @brief Defines a draw of a static mesh in the current frame.
+     */
+    struct MeshDraw
+    {
+        /** @brief Identifier of the mesh. */
+        MeshId id;
+
+        /** @brief Number of quads queued before the mesh. */
+        std::size_t queued;
+    };
+
     /** @brief The width of the rendering surface, in pixels. */
     int mScreenWidth = 0;
 
     /** @brief The height of the rendering surface, in pixels. */
     int mScreenHeight = 0;
 
-    /** @brief RAII handle for the quad Vertex Buffer Object. Stores vertex data. */
+    /** @brief RAII handle for the Vertex Buffer Object of the unit quad, only in the instances layout. */
     GL3VBOHandle mQuadVBO;
 
+    /** @brief RAII handle for the buffer of the indices of a full batch, only in the packed layout. */
+    GL3VBOHandle mIndexVBO;
+
+    /** @brief Strategy to upload the batches of vertices or instances. */
+    std::unique_ptr<GL3Upload> mUpload;
+
     /** @brief RAII handle for the quad Vertex Array Object. Stores vertex attribute state. */
     GL3VAOHandle mQuadVAO;
 
@@ -130,11 +249,29 @@ private:
     /** @brief Cached location of the 'color' uniform in the shader. */
     GLint mLocColor = -1;
 
-    /** @brief The orthographic projection matrix used to map world space to screen space. */
+    /** @brief The orthographic projection matrix used to map world space (or packed positions) to screen space. */
     glm::mat4 mProjection = glm::mat4(1.0f);
 
-    /** @brief A vector that batches all quads to be drawn in the current frame. */
-    std::vector<QuadVertex> mQuads;
+    /** @brief Batch of all the quads to be drawn in the current frame. */
+    QuadBatch mQuads;
+
+    /** @brief RAII handle for the `GL_STATIC_DRAW` Vertex Buffer Object of the static meshes. */
+    GL3VBOHandle mMeshVBO;
+
+    /** @brief Static meshes, indexed by their identifier. */
+    std::vector<Mesh> mMeshes;
+
+    /** @brief Identifiers of the destroyed meshes, reused first. */
+    std::vector<MeshId> mFreeMeshes;
+
+    /** @brief Static meshes drawn in the current frame, in order. */
+    std::vector<MeshDraw> mMeshDraws;
+
+    /** @brief Mesh being recorded, if any. */
+    std::optional<MeshId> mRecording;
+
+    /** @brief Flag indicating whether the meshes changed since they were uploaded. */
+    bool mMeshesChanged = false;
 };
 
 } // namespace pong
@@ -0,0 +1,378 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "RendererGL3Upload.hpp"
+#include <cstring>
+
+namespace pong {
+namespace      {
+
+/** @brief Flag of `glBufferStorage` and `glMapBufferRange` for persistent mappings (OpenGL 4.4, not in the loader). */
+constexpr GLbitfield MapPersistentBit = 0x0040;
+
+/** @brief Flag of `glBufferStorage` and `glMapBufferRange` for coherent mappings (OpenGL 4.4, not in the loader). */
+constexpr GLbitfield MapCoherentBit = 0x0080;
+
+/** @brief Signature of `glBufferStorage`. */
+using BufferStorageFunction = void (GLAD_API_PTR*)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+/** @brief Maximum time of a single wait for a fence, in nanoseconds. */
+constexpr GLuint64 FenceTimeout = 1'000'000'000;
+
+/**
+ * @brief Creates a buffer with uninitialized storage.
+ * @param id A pointer that will receive the handle of the newly created buffer.
+ * @param bytes Size of the storage, in bytes.
+ * @param usage Usage hint of the storage.
+ * @return True on success, false otherwise.
+ */
+bool createBuffer(GLuint* id, std::size_t bytes, GLenum usage);
+
+/**
+ * @brief Checks if buffers with immutable storage can be created (`glBufferStorage`).
+ * @return True if the context is OpenGL 4.4 or newer or has the `GL_ARB_buffer_storage` extension, false otherwise.
+ */
+bool hasBufferStorage();
+
+/**
+ * @brief Waits until a fence is signaled and deletes it.
+ * @param fence Fence, it is set to null; nothing is done if it is already null.
+ */
+void waitFence(GLsync& fence);
+
+/**
+ * @brief Puts a fence after the commands issued so far.
+ * @param fence Variable where the fence is stored, it must be null.
+ */
+void putFence(GLsync& fence);
+
+/**
+ * @brief Upload with `glBufferSubData` over a single buffer.
+ */
+class GL3UploadSubData final : public GL3Upload
+{
+public:
+
+    explicit GL3UploadSubData(const std::size_t capacity) noexcept : GL3Upload(Kind::SubData, capacity) {}
+
+    bool init() { return createBuffer(mBuffer.idPtr(), mCapacity, GL_DYNAMIC_DRAW); }
+
+    std::size_t upload(const void* data, const std::size_t bytes) override
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+
+        return 0;
+    }
+
+private:
+
+    /** @brief Buffer. */
+    GL3VBOHandle mBuffer;
+};
+
+/**
+ * @brief Upload orphaning the storage of a single buffer before writing it.
+ */
+class GL3UploadOrphan final : public GL3Upload
+{
+public:
+
+    explicit GL3UploadOrphan(const std::size_t capacity) noexcept : GL3Upload(Kind::Orphan, capacity) {}
+
+    bool init() { return createBuffer(mBuffer.idPtr(), mCapacity, GL_STREAM_DRAW); }
+
+    std::size_t upload(const void* data, const std::size_t bytes) override
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+        glBufferData   (GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(mCapacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+
+        return 0;
+    }
+
+private:
+
+    /** @brief Buffer. */
+    GL3VBOHandle mBuffer;
+};
+
+/**
+ * @brief Upload to a ring of buffers through unsynchronized mappings, reusing a buffer once its last draw is done.
+ */
+class GL3UploadRing final : public GL3Upload
+{
+public:
+
+    explicit GL3UploadRing(const std::size_t capacity) noexcept : GL3Upload(Kind::Ring, capacity) {}
+
+    ~GL3UploadRing() override
+    {
+        for (GLsync& fence : mFences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+            }
+        }
+    }
+
+    bool init()
+    {
+        for (GL3VBOHandle& buffer : mBuffers)
+        {
+            if (!createBuffer(buffer.idPtr(), mCapacity, GL_STREAM_DRAW))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::size_t upload(const void* data, const std::size_t bytes) override
+    {
+        mCurrent = (mCurrent + 1) % RingSize;
+        // Nobody reads the buffer after its fence, so the mapping does not need to be synchronized.
+        waitFence(mFences[mCurrent]);
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffers[mCurrent]);
+
+        void* mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (mapped)
+        {
+            std::memcpy(mapped, data, bytes);
+        }
+        // The data of a mapping can be lost (e.g. when the screen mode changes), then it is written again.
+        if (!mapped || glUnmapBuffer(GL_ARRAY_BUFFER) == GL_FALSE)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(bytes), data);
+        }
+
+        return 0;
+    }
+
+    void drawn() override { putFence(mFences[mCurrent]); }
+
+private:
+
+    /** @brief Buffers. */
+    std::array<GL3VBOHandle, RingSize> mBuffers;
+
+    /** @brief Fences after the last draw from every buffer, null if there is none. */
+    std::array<GLsync, RingSize> mFences = {};
+
+    /** @brief Index of the buffer of the last batch. */
+    std::size_t mCurrent = 0;
+};
+
+/**
+ * @brief Upload to the segments of a buffer mapped once, persistent and coherent, reusing a segment once its last draw
+ * is done.
+ */
+class GL3UploadPersistent final : public GL3Upload
+{
+public:
+
+    explicit GL3UploadPersistent(const std::size_t capacity) noexcept : GL3Upload(Kind::Persistent, capacity) {}
+
+    ~GL3UploadPersistent() override
+    {
+        for (GLsync& fence : mFences)
+        {
+            if (fence)
+            {
+                glDeleteSync(fence);
+            }
+        }
+
+        if (mMapped)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    bool init(const GLADloadfunc load)
+    {
+        const auto bufferStorage = load && hasBufferStorage() ? reinterpret_cast<BufferStorageFunction>(load("glBufferStorage")) : nullptr;
+        if (!bufferStorage)
+        {
+            return false;
+        }
+
+        const auto       bytes = static_cast<GLsizeiptr>(RingSize * mCapacity);
+        const GLbitfield flags = GL_MAP_WRITE_BIT | MapPersistentBit | MapCoherentBit;
+
+        while (glGetError() != GL_NO_ERROR) {}
+        // The storage is immutable, so the mapping stays valid while the buffer is used for drawing.
+        glGenBuffers(1, mBuffer.idPtr());
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+        bufferStorage(GL_ARRAY_BUFFER, bytes, nullptr, flags);
+        mMapped = static_cast<std::byte*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bytes, flags));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        return mMapped && glGetError() == GL_NO_ERROR;
+    }
+
+    std::size_t upload(const void* data, const std::size_t bytes) override
+    {
+        mCurrent = (mCurrent + 1) % RingSize;
+        // The mapping is coherent, the copy is visible to the draw calls issued after it.
+        waitFence(mFences[mCurrent]);
+        std::memcpy(mMapped + mCurrent * mCapacity, data, bytes);
+        glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+
+        return mCurrent * mCapacity;
+    }
+
+    void drawn() override { putFence(mFences[mCurrent]); }
+
+private:
+
+    /** @brief Buffer. */
+    GL3VBOHandle mBuffer;
+
+    /** @brief Mapping of the whole buffer, null if it is not mapped. */
+    std::byte* mMapped = nullptr;
+
+    /** @brief Fences after the last draw from every segment, null if there is none. */
+    std::array<GLsync, RingSize> mFences = {};
+
+    /** @brief Index of the segment of the last batch. */
+    std::size_t mCurrent = 0;
+};
+
+} // namespace
+
+std::unique_ptr<GL3Upload> GL3Upload::create(const Kind kind, const std::size_t capacity, const GLADloadfunc load)
+{
+    switch (kind)
+    {
+        case Kind::SubData:
+        {
+            auto upload = std::make_unique<GL3UploadSubData>(capacity);
+            return upload->init() ? std::move(upload) : nullptr;
+        }
+
+        case Kind::Orphan:
+        {
+            auto upload = std::make_unique<GL3UploadOrphan>(capacity);
+            return upload->init() ? std::move(upload) : nullptr;
+        }
+
+        case Kind::Ring:
+        {
+            auto upload = std::make_unique<GL3UploadRing>(capacity);
+            return upload->init() ? std::move(upload) : nullptr;
+        }
+
+        case Kind::Persistent:
+        {
+            auto upload = std::make_unique<GL3UploadPersistent>(capacity);
+            return upload->init(load) ? std::move(upload) : nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+std::string_view GL3Upload::name(const Kind kind) noexcept
+{
+    switch (kind)
+    {
+        case Kind::SubData:    return "subdata";
+        case Kind::Orphan:     return "orphan";
+        case Kind::Ring:       return "ring";
+        case Kind::Persistent: return "persistent";
+    }
+
+    return "unknown";
+}
+
+namespace {
+
+bool createBuffer(GLuint* id, const std::size_t bytes, const GLenum usage)
+{
+    while (glGetError() != GL_NO_ERROR) {}
+    // Generate the buffer and allocate its storage.
+    glGenBuffers(1, id);
+    glBindBuffer(GL_ARRAY_BUFFER, *id);
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, usage);
+    // Unbind.
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return glGetError() == GL_NO_ERROR;
+}
+
+bool hasBufferStorage()
+{
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major > 4 || (major == 4 && minor >= 4))
+    {
+        return true;
+    }
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; ++i)
+    {
+        const auto* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+        if (extension && std::string_view(extension) == "GL_ARB_buffer_storage")
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void waitFence(GLsync& fence)
+{
+    if (!fence)
+    {
+        return;
+    }
+    // The first wait flushes the commands, so the fence is signaled eventually.
+    GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+    while (result == GL_TIMEOUT_EXPIRED)
+    {
+        result = glClientWaitSync(fence, 0, FenceTimeout);
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+void putFence(GLsync& fence)
+{
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+} // namespace
+} // namespace pong
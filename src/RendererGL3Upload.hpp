@@ -0,0 +1,138 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RendererGL3Util.hpp"
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace pong {
+
+/**
+ * @brief Defines a strategy to stream the batches of a frame into buffers that the GPU reads.
+ *
+ * A renderer uploads a batch, draws it and calls `drawn()`, and then uploads the next one. When the same buffer is
+ * written while the GPU still reads the previous batch from it, the driver has to either stall or copy the data in the
+ * background, so the strategies differ in how they avoid it:
+ *
+ * - **SubData:** `glBufferSubData` over the same buffer, the driver takes care of the conflicts.
+ * - **Orphan:** The storage of the buffer is orphaned with `glBufferData(nullptr)` before writing, so the driver can
+ *   give a fresh one while the GPU keeps reading the old one.
+ * - **Ring:** `RingSize` buffers used in turn, each one written through an unsynchronized mapping once the fence put
+ *   after its last draw is signaled.
+ * - **Persistent:** A buffer with `RingSize` segments created with `glBufferStorage` (OpenGL 4.4 or
+ *   `GL_ARB_buffer_storage`) and mapped once, persistent and coherent, so writing is a plain copy; the segments are
+ *   reused through fences as in the ring.
+ *
+ * They must be created via the static `create()` factory function, which returns null if the strategy is not
+ * available.
+ */
+class GL3Upload
+{
+public:
+
+    /** @brief Defines the upload strategies. */
+    enum class Kind
+    {
+        SubData,   //!< `glBufferSubData` over a single buffer.
+        Orphan,    //!< Orphaning the storage of a single buffer before writing.
+        Ring,      //!< Ring of buffers written through unsynchronized mappings, with fences.
+        Persistent //!< Persistent and coherent mapping of a buffer with several segments, with fences.
+    };
+
+    /** @brief All the strategies, from the simplest. */
+    static constexpr std::array<Kind, 4> Kinds = {Kind::SubData, Kind::Orphan, Kind::Ring, Kind::Persistent};
+
+    /** @brief Number of buffers of the ring, or segments of the persistent buffer. */
+    static constexpr std::size_t RingSize = 3;
+
+    /**
+     * @brief Creates an upload strategy.
+     * @param kind Strategy.
+     * @param capacity Maximum number of bytes of a batch.
+     * @param load Function to get the address of the OpenGL functions that are not loaded by default (the persistent
+     * strategy needs `glBufferStorage`), it may be null.
+     * @return The strategy, or null if it is not available or its buffers cannot be created.
+     */
+    static std::unique_ptr<GL3Upload> create(Kind kind, std::size_t capacity, GLADloadfunc load);
+
+    /**
+     * @brief Gets the name of a strategy.
+     * @param kind Strategy.
+     * @return Name, in lower case.
+     */
+    [[nodiscard]] static std::string_view name(Kind kind) noexcept;
+
+    GL3Upload(const GL3Upload&) = delete;
+
+    GL3Upload(GL3Upload&&) = delete;
+
+    GL3Upload& operator=(const GL3Upload&) = delete;
+
+    GL3Upload& operator=(GL3Upload&&) = delete;
+
+    /**
+     * @brief Virtual destructor to ensure proper cleanup in derived classes.
+     */
+    virtual ~GL3Upload() = default;
+
+    /**
+     * @brief Gets the strategy.
+     * @return Strategy.
+     */
+    [[nodiscard]] Kind kind() const noexcept { return mKind; }
+
+    /**
+     * @brief Copies a batch into a buffer and binds that buffer to `GL_ARRAY_BUFFER`.
+     * @param data Data of the batch.
+     * @param bytes Number of bytes of the batch, at most the capacity.
+     * @return Offset of the batch in the buffer bound, in bytes.
+     */
+    virtual std::size_t upload(const void* data, std::size_t bytes) = 0;
+
+    /**
+     * @brief Notifies that the batch uploaded last has been drawn, so the strategy can know when its buffer is free.
+     */
+    virtual void drawn() {}
+
+protected:
+
+    /**
+     * @brief Constructor.
+     * @param kind Strategy.
+     * @param capacity Maximum number of bytes of a batch.
+     */
+    GL3Upload(const Kind kind, const std::size_t capacity) noexcept : mKind(kind), mCapacity(capacity) {}
+
+    /** @brief Strategy. */
+    Kind mKind;
+
+    /** @brief Maximum number of bytes of a batch. */
+    std::size_t mCapacity;
+};
+
+} // namespace pong
@@ -0,0 +1,434 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Replay.hpp"
+#include "Game.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <span>
+
+namespace pong {
+namespace {
+
+/** @brief Magic number at the start of the replay files ("PPRP"). */
+constexpr std::uint32_t ReplayMagic = 0x50525050;
+
+/** @brief Magic number at the end of the index of keyframes ("PPRI"). */
+constexpr std::uint32_t IndexMagic = 0x49525050;
+
+/** @brief Version of the format. */
+constexpr std::uint16_t ReplayVersion = 1;
+
+/** @brief Last type of event, the codes above it are not events. */
+constexpr Event::Type LastEventType = Event::Type::Zero;
+
+/** @brief Size of the header, in bytes. */
+constexpr std::size_t HeaderSize = 12;
+
+/** @brief Size of an entry of the index (tick, number of events and offset), in bytes. */
+constexpr std::size_t IndexEntrySize = 24;
+
+/** @brief Size of the end of the index (number of entries and magic number), in bytes. */
+constexpr std::size_t IndexTrailerSize = 8;
+
+/** @brief Number of bits of the code of a record. */
+constexpr unsigned int CodeBits = 5;
+
+/** @brief Code of the end record. */
+constexpr std::uint8_t EndCode = (1u << CodeBits) - 1;
+
+/** @brief Code of the keyframe records. */
+constexpr std::uint8_t KeyframeCode = EndCode - 1;
+
+static_assert(static_cast<std::uint8_t>(LastEventType) < KeyframeCode, "The event types must fit in the code of a record");
+
+/**
+ * @brief Reads a variable-length integer.
+ * @param data Data.
+ * @param offset Offset of the integer, it is moved past it.
+ * @param value Variable where the value is stored.
+ * @return True on success, false if the data ends before the integer.
+ */
+bool readVarint(const std::span<const std::uint8_t> data, std::size_t& offset, std::uint64_t& value)
+{
+    value = 0;
+    for (unsigned int shift = 0; offset < data.size() && shift < 64; shift += 7)
+    {
+        const std::uint8_t byte = data[offset++];
+        value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Reads an integer in little endian.
+ * @param data Data.
+ * @param offset Offset.
+ * @param size Size, in bytes.
+ * @return Value.
+ */
+std::uint64_t readLittleEndian(const std::span<const std::uint8_t> data, const std::size_t offset, const std::size_t size)
+{
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        value |= static_cast<std::uint64_t>(data[offset + i]) << (8 * i);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Checks if a snapshot fits in the data.
+ * @param data Data.
+ * @param offset Offset of the snapshot.
+ * @return True if the data does not end before the snapshot, false otherwise.
+ */
+bool hasSnapshot(const std::span<const std::uint8_t> data, const std::size_t offset) noexcept
+{
+    return offset <= data.size() && data.size() - offset >= sizeof(GameSnapshot);
+}
+
+/**
+ * @brief Reads a keyframe.
+ * @param data Data, with the whole snapshot.
+ * @param offset Offset of the snapshot.
+ * @param keyframe Keyframe where the snapshot is stored.
+ * @return True on success, false if the snapshot is not valid.
+ */
+bool readKeyframe(const std::span<const std::uint8_t> data, const std::size_t offset, Replay::Keyframe& keyframe)
+{
+    std::memcpy(&keyframe.snapshot, data.data() + offset, sizeof(GameSnapshot));
+    return keyframe.snapshot.valid();
+}
+
+/**
+ * @brief Reads the index of keyframes at the end of a file.
+ * @param data Data of the file.
+ * @param keyframes Vector where the keyframes are stored.
+ * @return Offset of the index (the end of the records), zero if the file has no index, or nothing if the index is
+ * corrupt.
+ */
+std::optional<std::size_t> readIndex(const std::span<const std::uint8_t> data, std::vector<Replay::Keyframe>& keyframes)
+{
+    if (data.size() < HeaderSize + IndexTrailerSize || readLittleEndian(data, data.size() - 4, 4) != IndexMagic)
+    {
+        return 0;
+    }
+
+    const auto count = readLittleEndian(data, data.size() - IndexTrailerSize, 4);
+    if (count > (data.size() - HeaderSize - IndexTrailerSize) / IndexEntrySize)
+    {
+        return std::nullopt;
+    }
+
+    const std::size_t index   = data.size() - IndexTrailerSize - static_cast<std::size_t>(count) * IndexEntrySize;
+    const auto        records = data.first(index);
+
+    keyframes.resize(static_cast<std::size_t>(count));
+    for (std::size_t i = 0; i < keyframes.size(); ++i)
+    {
+        const std::size_t entry    = index + i * IndexEntrySize;
+        const auto        snapshot = static_cast<std::size_t>(readLittleEndian(data, entry + 16, 8));
+        keyframes[i].tick  =                           readLittleEndian(data, entry,      8);
+        keyframes[i].event = static_cast<std::size_t>(readLittleEndian(data, entry + 8,  8));
+        // The keyframes must point to valid snapshots inside the records, in order.
+        if (!hasSnapshot(records, snapshot) || !readKeyframe(records, snapshot, keyframes[i]) ||
+            (i > 0 && keyframes[i].tick <= keyframes[i - 1].tick))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return index;
+}
+
+} // namespace
+
+std::optional<Replay> Replay::load(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return std::nullopt;
+    }
+
+    const std::vector<std::uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    // Check the header.
+    if (data.size() < HeaderSize                                      ||
+        readLittleEndian(data, 0, 4) != ReplayMagic                   ||
+        readLittleEndian(data, 4, 2) != ReplayVersion                 ||
+        data[6]                      != GameSnapshot::Format)
+    {
+        return std::nullopt;
+    }
+
+    Replay replay;
+    replay.seed = static_cast<std::uint32_t>(readLittleEndian(data, 8, 4));
+    // Read the index, if any, the records end where it starts.
+    const auto index = readIndex(data, replay.keyframes);
+    if (!index)
+    {
+        return std::nullopt;
+    }
+
+    const bool indexed = *index != 0;
+    const auto records = std::span<const std::uint8_t>(data).first(indexed ? *index : data.size());
+    // Read the records up to the end record, or up to the last complete one.
+    std::size_t   offset = HeaderSize;
+    std::uint64_t tick   = 0;
+    std::uint64_t record = 0;
+    while (readVarint(records, offset, record))
+    {
+        const auto code = static_cast<std::uint8_t>(record & EndCode);
+        tick += record >> CodeBits;
+
+        if (code == EndCode)
+        {
+            std::uint64_t scoreA = 0;
+            std::uint64_t scoreB = 0;
+            if (readVarint(records, offset, scoreA) && readVarint(records, offset, scoreB))
+            {
+                replay.finished = true;
+                replay.ticks    = tick;
+                replay.scoreA   = static_cast<int>(scoreA);
+                replay.scoreB   = static_cast<int>(scoreB);
+            }
+            break;
+        }
+        // The keyframes are taken from the index when there is one. A snapshot cut short is the end of a file that was
+        // not closed, but a whole snapshot that is not valid means that the file is corrupt.
+        if (code == KeyframeCode)
+        {
+            if (!hasSnapshot(records, offset))
+            {
+                break;
+            }
+
+            Keyframe keyframe{tick, replay.events.size(), {}};
+            if (!indexed && !readKeyframe(records, offset, keyframe))
+            {
+                return std::nullopt;
+            }
+
+            if (!indexed)
+            {
+                replay.keyframes.push_back(keyframe);
+            }
+
+            offset += sizeof(GameSnapshot);
+            continue;
+        }
+
+        if (code > static_cast<std::uint8_t>(LastEventType))
+        {
+            return std::nullopt;
+        }
+
+        replay.events.push_back({tick, static_cast<Event::Type>(code)});
+    }
+    // The playback starts from the event of a keyframe, so the index must point to the first event of its tick (or of a
+    // later one), otherwise a seek would skip events or play them twice.
+    for (const Keyframe& keyframe : replay.keyframes)
+    {
+        const std::size_t event = keyframe.event;
+        if (event > replay.events.size()                                                      ||
+            (event > 0                    && replay.events[event - 1].tick >= keyframe.tick) ||
+            (event < replay.events.size() && replay.events[event].tick     <  keyframe.tick))
+        {
+            return std::nullopt;
+        }
+    }
+
+    return replay;
+}
+
+std::unique_ptr<ReplayRecorder> ReplayRecorder::create(const std::filesystem::path& path,
+                                                       const std::uint32_t seed,
+                                                       const std::uint64_t keyframeInterval)
+{
+    auto recorder = std::unique_ptr<ReplayRecorder>(new ReplayRecorder{});
+    recorder->mFile.open(path, std::ios::binary | std::ios::trunc);
+    if (!recorder->mFile)
+    {
+        return nullptr;
+    }
+
+    recorder->mKeyframeInterval = keyframeInterval;
+    recorder->writeLittleEndian(ReplayMagic,          4);
+    recorder->writeLittleEndian(ReplayVersion,        2);
+    recorder->writeLittleEndian(GameSnapshot::Format, 1);
+    recorder->writeLittleEndian(0,                    1);
+    recorder->writeLittleEndian(seed,                 4);
+
+    return recorder->mFile ? std::move(recorder) : nullptr;
+}
+
+void ReplayRecorder::keyframe(const std::uint64_t tick, const Game& game)
+{
+    if (mKeyframeInterval == 0 || tick < mKeyframeTick + mKeyframeInterval)
+    {
+        return;
+    }
+
+    const GameSnapshot snapshot = game.snapshot();
+    writeRecord(tick, KeyframeCode);
+    mIndex.push_back({tick, mEvents, mSize});
+    write(&snapshot, sizeof(snapshot));
+
+    mKeyframeTick = tick;
+}
+
+void ReplayRecorder::record(const std::uint64_t tick, const Event::Type type)
+{
+    writeRecord(tick, static_cast<std::uint8_t>(type));
+    ++mEvents;
+}
+
+void ReplayRecorder::finish(const std::uint64_t ticks, const int scoreA, const int scoreB)
+{
+    writeRecord(ticks, EndCode);
+    writeVarint(static_cast<std::uint64_t>(scoreA));
+    writeVarint(static_cast<std::uint64_t>(scoreB));
+    // Write the index of the keyframes.
+    for (const IndexEntry& entry : mIndex)
+    {
+        writeLittleEndian(entry.tick,   8);
+        writeLittleEndian(entry.event,  8);
+        writeLittleEndian(entry.offset, 8);
+    }
+    writeLittleEndian(mIndex.size(), 4);
+    writeLittleEndian(IndexMagic,    4);
+
+    mFile.flush();
+}
+
+void ReplayRecorder::writeRecord(const std::uint64_t tick, const std::uint8_t code)
+{
+    writeVarint((tick - mTick) << CodeBits | code);
+    mTick = tick;
+}
+
+void ReplayRecorder::writeVarint(std::uint64_t value)
+{
+    std::uint8_t bytes[10];
+    std::size_t  count = 0;
+    for (; value >= 0x80; value >>= 7)
+    {
+        bytes[count++] = static_cast<std::uint8_t>((value & 0x7F) | 0x80);
+    }
+    bytes[count++] = static_cast<std::uint8_t>(value);
+
+    write(bytes, count);
+}
+
+void ReplayRecorder::writeLittleEndian(const std::uint64_t value, const std::size_t size)
+{
+    std::uint8_t bytes[8];
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        bytes[i] = static_cast<std::uint8_t>(value >> (8 * i));
+    }
+
+    write(bytes, size);
+}
+
+void ReplayRecorder::write(const void* data, const std::size_t size)
+{
+    mFile.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    mSize += size;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, Game& game) : mReplay(replay), mGame(game)
+{
+    mGame.setSeed(mReplay.seed);
+    mStart = mGame.snapshot();
+}
+
+bool ReplayPlayer::done() const noexcept
+{
+    return mReplay.finished ? mTick >= mReplay.ticks : mNext >= mReplay.events.size();
+}
+
+void ReplayPlayer::step()
+{
+    for (; mNext < mReplay.events.size() && mReplay.events[mNext].tick <= mTick; ++mNext)
+    {
+        mGame.handle(Event{mReplay.events[mNext].type});
+    }
+
+    mGame.update(Game::TickTime);
+    ++mTick;
+}
+
+bool ReplayPlayer::seek(std::uint64_t tick)
+{
+    // Clamp the tick to the end of the replay.
+    if (mReplay.finished)
+    {
+        tick = std::min(tick, mReplay.ticks);
+    }
+    else
+    {
+        tick = std::min(tick, mReplay.events.empty() ? 0 : mReplay.events.back().tick + 1);
+    }
+    // Find the last keyframe at or before the tick.
+    const auto next = std::upper_bound(mReplay.keyframes.begin(), mReplay.keyframes.end(), tick,
+                                       [](const std::uint64_t t, const Replay::Keyframe& keyframe) { return t < keyframe.tick; });
+    const Replay::Keyframe* keyframe = next == mReplay.keyframes.begin() ? nullptr : &*std::prev(next);
+    // Restore it, unless the game is already closer to the tick.
+    if (mTick > tick || (keyframe && mTick < keyframe->tick))
+    {
+        if (!mGame.restore(keyframe ? keyframe->snapshot : mStart))
+        {
+            return false;
+        }
+
+        mTick = keyframe ? keyframe->tick  : 0;
+        mNext = keyframe ? keyframe->event : 0;
+    }
+
+    while (mTick < tick)
+    {
+        step();
+    }
+    // The events of the ticks skipped are not reported.
+    mGame.events().clear();
+
+    return true;
+}
+
+bool ReplayPlayer::verify() const
+{
+    return mReplay.finished && mTick == mReplay.ticks && mNext == mReplay.events.size() &&
+           mGame.scoreA() == mReplay.scoreA && mGame.scoreB() == mReplay.scoreB;
+}
+
+} // namespace pong
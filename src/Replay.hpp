@@ -0,0 +1,314 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Event.hpp"
+#include "Snapshot.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace pong {
+
+class Game;
+
+/**
+ * @brief Defines a recorded session: the seed of the game and the events it handled, with the tick of each one.
+ *
+ * The game is deterministic, so playing the events on the same ticks of a new game with the same seed reproduces the
+ * session exactly (with floating-point numbers only on a build with the same compiler and flags, see
+ * `PONG_FIXED_POINT`).
+ *
+ * A replay file starts with a header (magic number, version, number format and seed) followed by one record per event:
+ * a variable-length integer (LEB128) with the ticks elapsed since the previous record and the type of the event in its
+ * five lowest bits, so most events take a single byte. The file is only appended to, and a file cut short (e.g. by a
+ * crash) is still valid up to its last complete record. A session that ends normally finishes with an end record
+ * holding the number of ticks and the final scores, which the playback verifies.
+ *
+ * Every few seconds of game time the file also holds a keyframe record with a complete `GameSnapshot`, and after the
+ * end record there is an index with the tick, the number of previous events and the offset of every keyframe, so a
+ * replay can be played from any tick by restoring the keyframe before it instead of playing all the previous ticks.
+ * The index is rebuilt from the records when a file has none (it was cut short).
+ */
+struct Replay
+{
+    /**
+     * @brief Defines an event of the session.
+     */
+    struct Entry
+    {
+        /** @brief Tick, the number of updates of the game before the event. */
+        std::uint64_t tick = 0;
+
+        /** @brief Type of the event. */
+        Event::Type type = Event::Type::Quit;
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    /**
+     * @brief Defines a keyframe: the state of the game at the start of a tick, before it handles the events.
+     */
+    struct Keyframe
+    {
+        /** @brief Tick. */
+        std::uint64_t tick = 0;
+
+        /** @brief Index of the first event of the tick (or of a later one). */
+        std::size_t event = 0;
+
+        /** @brief State of the game. */
+        GameSnapshot snapshot;
+    };
+
+    /** @brief Seed of the game. */
+    std::uint32_t seed = 0;
+
+    /** @brief Events, in the order they were handled. */
+    std::vector<Entry> events;
+
+    /** @brief Keyframes, sorted by tick. */
+    std::vector<Keyframe> keyframes;
+
+    /** @brief Flag indicating if the session has an end record. */
+    bool finished = false;
+
+    /** @brief Number of ticks of the session, if it is finished. */
+    std::uint64_t ticks = 0;
+
+    /** @brief Final score of player A, if it is finished. */
+    int scoreA = 0;
+
+    /** @brief Final score of player B, if it is finished. */
+    int scoreB = 0;
+
+    /**
+     * @brief Loads a replay file.
+     * @param path Path of the file.
+     * @return Replay, or nothing if the file cannot be read, is not a replay, is corrupt, or was recorded by a build
+     * with another version of the format or another number format.
+     */
+    [[nodiscard]] static std::optional<Replay> load(const std::filesystem::path& path);
+};
+
+/**
+ * @brief Records a session into a replay file as it happens.
+ *
+ * It must be created via the static `create()` factory function, which returns a null pointer if the file cannot be
+ * created.
+ */
+class ReplayRecorder
+{
+public:
+
+    /** @brief Default number of ticks between keyframes (ten seconds), the most ticks played by a seek. */
+    static constexpr std::uint64_t DefaultKeyframeInterval = 600;
+
+    /**
+     * @brief Creates a replay file and writes its header.
+     * @param path Path of the file, it is overwritten.
+     * @param seed Seed of the game, it must be set before its first update.
+     * @param keyframeInterval Number of ticks between keyframes, zero for none.
+     * @return A unique pointer on success, null on failure.
+     */
+    [[nodiscard]] static std::unique_ptr<ReplayRecorder> create(const std::filesystem::path& path,
+                                                                std::uint32_t seed,
+                                                                std::uint64_t keyframeInterval = DefaultKeyframeInterval);
+
+    /**
+     * @brief Records a keyframe of the game if the keyframe interval has elapsed since the previous one.
+     *
+     * It must be called at the start of every tick, before the events of the tick are recorded.
+     * @param tick Tick, the number of updates of the game.
+     * @param game Game.
+     */
+    void keyframe(std::uint64_t tick, const Game& game);
+
+    /**
+     * @brief Records an event.
+     * @param tick Tick, the number of updates of the game before the event. It never decreases.
+     * @param type Type of the event.
+     */
+    void record(std::uint64_t tick, Event::Type type);
+
+    /**
+     * @brief Records the end of the session and writes the index of the keyframes, nothing can be recorded after it.
+     * @param ticks Number of updates of the game.
+     * @param scoreA Final score of player A.
+     * @param scoreB Final score of player B.
+     */
+    void finish(std::uint64_t ticks, int scoreA, int scoreB);
+
+    /**
+     * @brief Checks if the file has been written without errors.
+     * @return True if there were no errors, false otherwise.
+     */
+    [[nodiscard]] bool good() const { return mFile.good(); }
+
+private:
+
+    /**
+     * @brief Defines an entry of the index of keyframes.
+     */
+    struct IndexEntry
+    {
+        /** @brief Tick. */
+        std::uint64_t tick = 0;
+
+        /** @brief Number of events before the keyframe. */
+        std::uint64_t event = 0;
+
+        /** @brief Offset of the snapshot in the file. */
+        std::uint64_t offset = 0;
+    };
+
+    ReplayRecorder() = default;
+
+    /**
+     * @brief Writes a record with the ticks since the previous one and a code.
+     * @param tick Tick.
+     * @param code Code (the type of an event, or a special record).
+     */
+    void writeRecord(std::uint64_t tick, std::uint8_t code);
+
+    /**
+     * @brief Writes a variable-length integer.
+     * @param value Value.
+     */
+    void writeVarint(std::uint64_t value);
+
+    /**
+     * @brief Writes an integer in little endian.
+     * @param value Value.
+     * @param size Size, in bytes.
+     */
+    void writeLittleEndian(std::uint64_t value, std::size_t size);
+
+    /**
+     * @brief Writes bytes.
+     * @param data Bytes.
+     * @param size Number of bytes.
+     */
+    void write(const void* data, std::size_t size);
+
+private:
+
+    /** @brief File. */
+    std::ofstream mFile;
+
+    /** @brief Tick of the last record. */
+    std::uint64_t mTick = 0;
+
+    /** @brief Number of bytes written. */
+    std::uint64_t mSize = 0;
+
+    /** @brief Number of events recorded. */
+    std::uint64_t mEvents = 0;
+
+    /** @brief Number of ticks between keyframes, zero for none. */
+    std::uint64_t mKeyframeInterval = 0;
+
+    /** @brief Tick of the last keyframe. */
+    std::uint64_t mKeyframeTick = 0;
+
+    /** @brief Index of the keyframes. */
+    std::vector<IndexEntry> mIndex;
+};
+
+/**
+ * @brief Plays a replay on a game.
+ *
+ * The player does not depend on time: each call to `step()` plays one tick, so the caller decides the speed (real time
+ * in the application, as fast as possible in the tools), and `seek()` jumps to any tick through the keyframes.
+ */
+class ReplayPlayer
+{
+public:
+
+    /**
+     * @brief Constructor, it seeds the game.
+     * @param replay Replay, it must outlive the player.
+     * @param game A game that has not been updated yet.
+     */
+    ReplayPlayer(const Replay& replay, Game& game);
+
+    /**
+     * @brief Gets the next tick to play.
+     * @return Tick.
+     */
+    [[nodiscard]] std::uint64_t tick() const noexcept { return mTick; }
+
+    /**
+     * @brief Checks if the whole replay has been played.
+     *
+     * A finished replay is played until its last tick, otherwise until its last event.
+     * @return True if it has been played, false otherwise.
+     */
+    [[nodiscard]] bool done() const noexcept;
+
+    /**
+     * @brief Plays a tick: the game handles the events of the tick and then it is updated.
+     */
+    void step();
+
+    /**
+     * @brief Moves the game to the start of a tick.
+     *
+     * The game is restored from the last keyframe before the tick (or to its initial state if there is none), unless
+     * it is already between that keyframe and the tick, and then the remaining ticks are played. So a seek plays fewer
+     * ticks than the keyframe interval of the replay. The gameplay events of the ticks played are cleared.
+     * @param tick Tick, it is clamped to the end of the replay.
+     * @return True on success, false if a keyframe cannot be restored.
+     */
+    [[nodiscard]] bool seek(std::uint64_t tick);
+
+    /**
+     * @brief Checks if the game ended as the recorded session.
+     * @return True if the replay is finished and the game has been played to the end with the same scores.
+     */
+    [[nodiscard]] bool verify() const;
+
+private:
+
+    /** @brief Replay. */
+    const Replay& mReplay;
+
+    /** @brief Game. */
+    Game& mGame;
+
+    /** @brief Initial state of the game. */
+    GameSnapshot mStart;
+
+    /** @brief Next tick to play. */
+    std::uint64_t mTick = 0;
+
+    /** @brief Index of the next event to play. */
+    std::size_t mNext = 0;
+};
+
+} // namespace pong
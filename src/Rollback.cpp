@@ -0,0 +1,317 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Rollback.hpp"
+#include "Event.hpp"
+#include "Game.hpp"
+#include "RealTimeClock.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+namespace pong {
+namespace {
+
+/** @brief Magic number at the start of the packets ("PRLB"). */
+constexpr std::uint32_t PacketMagic = 0x424C5250;
+
+/** @brief Value of the first tick to roll back when there is nothing to roll back. */
+constexpr long long NoRollback = std::numeric_limits<long long>::max();
+
+/**
+ * @brief Maximum number of ticks the inputs of a valid peer can be ahead of the current tick.
+ *
+ * The peer never simulates more than the rollback window past the local inputs it has, and its inputs are the ones of
+ * its current tick plus the input delay.
+ */
+constexpr long long MaxRemoteLead = 2 * Rollback::MaxInputDelay + Rollback::MaxRollbackTicks + 1;
+
+/** @brief Number of ticks of inputs no longer needed that are dropped at once, so the erases are rare. */
+constexpr long long TrimTicks = 256;
+
+/**
+ * @brief Writes a 32-bit integer in little endian.
+ * @param buffer Buffer.
+ * @param offset Offset.
+ * @param value Value.
+ */
+void writeU32(const std::span<std::uint8_t> buffer, const std::size_t offset, const std::uint32_t value)
+{
+    buffer[offset + 0] = static_cast<std::uint8_t>(value);
+    buffer[offset + 1] = static_cast<std::uint8_t>(value >>  8);
+    buffer[offset + 2] = static_cast<std::uint8_t>(value >> 16);
+    buffer[offset + 3] = static_cast<std::uint8_t>(value >> 24);
+}
+
+/**
+ * @brief Reads a 32-bit integer in little endian.
+ * @param buffer Buffer.
+ * @param offset Offset.
+ * @return Value.
+ */
+std::uint32_t readU32(const std::span<const std::uint8_t> buffer, const std::size_t offset)
+{
+    return static_cast<std::uint32_t>(buffer[offset + 0])
+         | static_cast<std::uint32_t>(buffer[offset + 1]) <<  8
+         | static_cast<std::uint32_t>(buffer[offset + 2]) << 16
+         | static_cast<std::uint32_t>(buffer[offset + 3]) << 24;
+}
+
+/**
+ * @brief Sends the events of the movement keys of a player that changed between two ticks.
+ * @param game Game.
+ * @param playerA True for player A, false for player B.
+ * @param previous Input on the previous tick.
+ * @param input Input.
+ */
+void sendMovement(Game& game, const bool playerA, const Rollback::Input previous, const Rollback::Input input)
+{
+    const auto released = static_cast<Rollback::Input>(previous & ~input);
+    const auto pressed  = static_cast<Rollback::Input>(input & ~previous);
+
+    if (released & Rollback::InputUp)   { game.handle(Event{playerA ? Event::Type::PlayerAMoveUpReleased   : Event::Type::PlayerBMoveUpReleased});   }
+    if (released & Rollback::InputDown) { game.handle(Event{playerA ? Event::Type::PlayerAMoveDownReleased : Event::Type::PlayerBMoveDownReleased}); }
+    if (pressed  & Rollback::InputUp)   { game.handle(Event{playerA ? Event::Type::PlayerAMoveUp           : Event::Type::PlayerBMoveUp});           }
+    if (pressed  & Rollback::InputDown) { game.handle(Event{playerA ? Event::Type::PlayerAMoveDown         : Event::Type::PlayerBMoveDown});         }
+}
+
+} // namespace
+
+Rollback::Rollback(Game& game, const ControllerHuman::Player local, const Settings& settings)
+    :
+    mGame        (game),
+    mLocal       (local),
+    mSettings    {std::clamp(settings.inputDelay, 0, MaxInputDelay), std::clamp(settings.rollbackTicks, 0, MaxRollbackTicks)},
+    mRollbackFrom(NoRollback)
+{
+    // Without input delay the remote input of a tick always arrives after it, so at least one tick must be predicted.
+    if (mSettings.inputDelay == 0)
+    {
+        mSettings.rollbackTicks = std::max(mSettings.rollbackTicks, 1);
+    }
+    // There are no local inputs for the first ticks, the ones sampled then are used after the input delay.
+    mLocalInputs.assign(static_cast<std::size_t>(mSettings.inputDelay), 0);
+    mSnapshots  .resize(static_cast<std::size_t>(mSettings.rollbackTicks) + 1);
+    // Both peers start from the same state.
+    mGame.startMatch(std::make_unique<ControllerHuman>(ControllerHuman::Player::A),
+                     std::make_unique<ControllerHuman>(ControllerHuman::Player::B));
+}
+
+bool Rollback::advance(const Input input)
+{
+    synchronize();
+    // Do not predict more ticks than the ones that can be rolled back.
+    if (mTick - mRemoteConfirmed >= mSettings.rollbackTicks)
+    {
+        ++mStats.stalls;
+        return false;
+    }
+
+    mLocalInputs.push_back(input);
+
+    const auto index = static_cast<std::size_t>(mTick - mInputBase);
+    if (index >= mRemoteReceived.size() || !mRemoteReceived[index])
+    {
+        ++mStats.predictions;
+    }
+
+    simulate(mTick);
+    ++mTick;
+    ++mStats.ticks;
+
+    trim();
+
+    return true;
+}
+
+void Rollback::synchronize()
+{
+    if (mRollbackFrom >= mTick)
+    {
+        return;
+    }
+
+    RealTimeClock clock;
+    // Go back to the state before the first wrong prediction and simulate the ticks again with the inputs received.
+    const long long from = mRollbackFrom;
+    mRollbackFrom = NoRollback;
+
+    static_cast<void>(mGame.restore(mSnapshots[static_cast<std::size_t>(from) % mSnapshots.size()]));
+    for (long long tick = from; tick < mTick; ++tick)
+    {
+        simulate(tick);
+    }
+    // The events of the ticks simulated again already happened for the players, they are not reported twice.
+    mGame.events().clear();
+
+    ++mStats.rollbacks;
+    mStats.resimulatedTicks    += mTick - from;
+    mStats.maxRollback          = std::max(mStats.maxRollback, mTick - from);
+    mStats.resimulationSeconds += clock.elapsed().count();
+}
+
+bool Rollback::readPacket(const std::span<const std::uint8_t> packet)
+{
+    // Check the header and the size.
+    if (packet.size() < PacketHeaderSize || readU32(packet, 0) != PacketMagic ||
+        packet[12] > MaxPacketInputs || packet.size() != PacketHeaderSize + packet[12])
+    {
+        ++mStats.invalidPackets;
+        return false;
+    }
+
+    ++mStats.packets;
+
+    const long long first        = readU32(packet, 4);
+    const long long acknowledged = readU32(packet, 8);
+    const std::size_t count      = packet[12];
+
+    mLocalAcknowledged = std::max(mLocalAcknowledged, std::min(acknowledged, mInputBase + static_cast<long long>(mLocalInputs.size())));
+    // Store the inputs not received yet.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const long long tick = first + static_cast<long long>(i);
+        if (tick < mRemoteConfirmed)
+        {
+            continue;
+        }
+
+        if (tick > mTick + MaxRemoteLead)
+        {
+            break;
+        }
+
+        const auto index = static_cast<std::size_t>(tick - mInputBase);
+        if (index >= mRemoteInputs.size())
+        {
+            mRemoteInputs  .resize(index + 1, 0);
+            mRemoteReceived.resize(index + 1, 0);
+        }
+
+        if (mRemoteReceived[index])
+        {
+            continue;
+        }
+
+        const Input input = packet[PacketHeaderSize + i];
+        // A tick already simulated with another input must be simulated again.
+        if (tick < mTick && mRemoteInputs[index] != input)
+        {
+            mRollbackFrom = std::min(mRollbackFrom, tick);
+        }
+
+        mRemoteInputs  [index] = input;
+        mRemoteReceived[index] = 1;
+    }
+
+    while (static_cast<std::size_t>(mRemoteConfirmed - mInputBase) < mRemoteReceived.size() &&
+           mRemoteReceived[static_cast<std::size_t>(mRemoteConfirmed - mInputBase)])
+    {
+        ++mRemoteConfirmed;
+    }
+
+    return true;
+}
+
+std::size_t Rollback::writePacket(const std::span<std::uint8_t> buffer) const
+{
+    // The acknowledged inputs are never trimmed past, so the first one to send is always kept.
+    const auto first = static_cast<std::size_t>(mLocalAcknowledged - mInputBase);
+    const auto count = std::min(mLocalInputs.size() - first, MaxPacketInputs);
+
+    writeU32(buffer, 0, PacketMagic);
+    writeU32(buffer, 4, static_cast<std::uint32_t>(mLocalAcknowledged));
+    writeU32(buffer, 8, static_cast<std::uint32_t>(mRemoteConfirmed));
+    buffer[12] = static_cast<std::uint8_t>(count);
+    std::copy_n(mLocalInputs.begin() + static_cast<std::ptrdiff_t>(first), count, buffer.begin() + PacketHeaderSize);
+
+    return PacketHeaderSize + count;
+}
+
+void Rollback::applyInputs(Game& game, const Input previousA, const Input inputA, const Input previousB, const Input inputB)
+{
+    sendMovement(game, true,  previousA, inputA);
+    sendMovement(game, false, previousB, inputB);
+    // The next key only acts when it is pressed.
+    if (((inputA & ~previousA) | (inputB & ~previousB)) & InputNext)
+    {
+        game.handle(Event{Event::Type::Next});
+    }
+}
+
+void Rollback::simulate(const long long tick)
+{
+    const auto index = static_cast<std::size_t>(tick - mInputBase);
+    if (index >= mRemoteInputs.size())
+    {
+        mRemoteInputs  .resize(index + 1, 0);
+        mRemoteReceived.resize(index + 1, 0);
+    }
+    // Predict the remote input if it has not been received: the player keeps the keys of the previous tick.
+    if (!mRemoteReceived[index])
+    {
+        mRemoteInputs[index] = tick > 0 ? mRemoteInputs[index - 1] : 0;
+    }
+
+    mSnapshots[static_cast<std::size_t>(tick) % mSnapshots.size()] = mGame.snapshot();
+
+    applyInputs(mGame, input(ControllerHuman::Player::A, tick - 1), input(ControllerHuman::Player::A, tick),
+                       input(ControllerHuman::Player::B, tick - 1), input(ControllerHuman::Player::B, tick));
+    mGame.update(Game::TickTime);
+}
+
+void Rollback::trim()
+{
+    // The ticks from the first input not acknowledged by the peer are sent, the ones from the first remote input not
+    // received may be simulated again, and every simulated tick reads the inputs of the previous one.
+    const long long first = std::max(std::min({mLocalAcknowledged, mRemoteConfirmed, mTick}) - 1, 0LL);
+    const long long count = first - mInputBase;
+    if (count >= TrimTicks)
+    {
+        const auto erase = [count](auto& inputs)
+        {
+            inputs.erase(inputs.begin(), inputs.begin() + static_cast<std::ptrdiff_t>(std::min(count, static_cast<long long>(inputs.size()))));
+        };
+
+        erase(mLocalInputs);
+        erase(mRemoteInputs);
+        erase(mRemoteReceived);
+        mInputBase = first;
+    }
+
+    mStats.maxInputs = std::max(mStats.maxInputs, static_cast<long long>(std::max(mLocalInputs.size(), mRemoteInputs.size())));
+}
+
+Rollback::Input Rollback::input(const ControllerHuman::Player player, const long long tick) const
+{
+    if (tick < 0)
+    {
+        return 0;
+    }
+
+    const auto index = static_cast<std::size_t>(tick - mInputBase);
+    return player == mLocal ? mLocalInputs[index] : mRemoteInputs[index];
+}
+
+} // namespace pong
@@ -0,0 +1,271 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ControllerHuman.hpp"
+#include "Snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pong {
+
+class Game;
+
+/**
+ * @brief Plays a two-player match against a remote peer with rollback (GGPO-style) netcode.
+ *
+ * Both peers run the whole match. The inputs of the players are the states of their keys on every tick; the local
+ * input is applied `inputDelay` ticks after it is sampled, which gives it time to reach the peer, and is sent to the
+ * peer in every packet until the peer acknowledges it. When the input of the remote player for a tick has not arrived
+ * yet, it is predicted (the player keeps the keys of the previous tick) and the game goes on. When the actual input
+ * arrives and differs from the prediction, the game is restored from the snapshot taken before that tick and the ticks
+ * since then are simulated again with the right input. The game never runs more than `rollbackTicks` ticks ahead of
+ * the last remote input received, it waits (stalls) instead.
+ *
+ * The class does no I/O: the packets are read and written as buffers, so any transport can carry them (`UdpSocket` in
+ * the application, a simulated link in the tests). The packets carry all the inputs not acknowledged yet, so a lost or
+ * reordered packet is repaired by the next one.
+ */
+class Rollback
+{
+public:
+
+    /** @brief Input of a player on a tick, the keys held down (a combination of the `Input*` flags). */
+    using Input = std::uint8_t;
+
+    /** @brief The move up key is held down. */
+    static constexpr Input InputUp = 1 << 0;
+
+    /** @brief The move down key is held down. */
+    static constexpr Input InputDown = 1 << 1;
+
+    /** @brief The next key (kickoff) is held down. */
+    static constexpr Input InputNext = 1 << 2;
+
+    /** @brief Maximum input delay, in ticks. */
+    static constexpr int MaxInputDelay = 15;
+
+    /** @brief Maximum rollback window, in ticks. */
+    static constexpr int MaxRollbackTicks = 30;
+
+    /** @brief Maximum number of inputs in a packet. */
+    static constexpr std::size_t MaxPacketInputs = 128;
+
+    /** @brief Size of the header of a packet, in bytes. */
+    static constexpr std::size_t PacketHeaderSize = 13;
+
+    /** @brief Maximum size of a packet, in bytes. */
+    static constexpr std::size_t MaxPacketSize = PacketHeaderSize + MaxPacketInputs;
+
+    /**
+     * @brief Defines the parameters of the netcode, both peers must use the same ones.
+     */
+    struct Settings
+    {
+        /** @brief Number of ticks between the sampling of a local input and its use. Hides that much latency. */
+        int inputDelay = 2;
+
+        /**
+         * @brief Maximum number of ticks that are predicted, and therefore rolled back, at once.
+         *
+         * Without input delay the remote inputs always arrive late, so it is at least one.
+         */
+        int rollbackTicks = 8;
+    };
+
+    /**
+     * @brief Defines the statistics of a session.
+     */
+    struct Stats
+    {
+        /** @brief Number of ticks advanced. */
+        long long ticks = 0;
+
+        /** @brief Number of times the session waited for the remote inputs instead of advancing a tick. */
+        long long stalls = 0;
+
+        /** @brief Number of remote inputs that were predicted before they arrived. */
+        long long predictions = 0;
+
+        /** @brief Number of rollbacks (mispredictions). */
+        long long rollbacks = 0;
+
+        /** @brief Number of ticks simulated again by the rollbacks. */
+        long long resimulatedTicks = 0;
+
+        /** @brief Longest rollback, in ticks. */
+        long long maxRollback = 0;
+
+        /** @brief Time spent restoring and simulating again, in seconds. */
+        double resimulationSeconds = 0.0;
+
+        /** @brief Number of packets read. */
+        long long packets = 0;
+
+        /** @brief Number of packets rejected because they are not valid. */
+        long long invalidPackets = 0;
+
+        /** @brief Most ticks of inputs kept at once. */
+        long long maxInputs = 0;
+    };
+
+    /**
+     * @brief Constructor, it starts a two-player match in the game.
+     * @param game Game, owned by the caller.
+     * @param local The player controlled on this peer, the peer controls the other one.
+     * @param settings Parameters of the netcode, they are clamped to the maximum values.
+     */
+    Rollback(Game& game, ControllerHuman::Player local, const Settings& settings);
+
+    /**
+     * @brief Gets the next tick to simulate, which is also the number of ticks simulated.
+     * @return Tick.
+     */
+    [[nodiscard]] long long tick() const noexcept { return mTick; }
+
+    /**
+     * @brief Gets the number of ticks, from the start, for which the remote input is known.
+     * @return Number of ticks.
+     */
+    [[nodiscard]] long long confirmedTicks() const noexcept { return mRemoteConfirmed; }
+
+    /**
+     * @brief Gets the statistics.
+     * @return Statistics.
+     */
+    [[nodiscard]] const Stats& stats() const noexcept { return mStats; }
+
+    /**
+     * @brief Advances the game one tick.
+     *
+     * Any pending rollback is done first (see `synchronize()`). Then, unless the game is already `rollbackTicks` ticks
+     * ahead of the remote inputs, the local input is queued and the next tick is simulated.
+     * @param input Current input of the local player.
+     * @return True if a tick was simulated, false if the session stalled (the input is discarded).
+     */
+    bool advance(Input input);
+
+    /**
+     * @brief Rolls back and simulates again the ticks whose remote input differs from the prediction, if any.
+     *
+     * After a rollback the gameplay events of the game are cleared, the ticks simulated again do not report them twice.
+     */
+    void synchronize();
+
+    /**
+     * @brief Reads a packet of the peer.
+     * @param packet Packet.
+     * @return True if it is a valid packet, false otherwise.
+     */
+    bool readPacket(std::span<const std::uint8_t> packet);
+
+    /**
+     * @brief Writes a packet for the peer, with the local inputs it has not acknowledged yet.
+     * @param buffer Buffer of at least `MaxPacketSize` bytes.
+     * @return Size of the packet.
+     */
+    [[nodiscard]] std::size_t writePacket(std::span<std::uint8_t> buffer) const;
+
+    /**
+     * @brief Applies the inputs of a tick to a game, as events.
+     *
+     * The paddles receive the press and release events of the keys that changed since the previous tick, and the game
+     * receives a next event when any player presses the next key.
+     * @param game Game.
+     * @param previousA Input of player A on the previous tick.
+     * @param inputA Input of player A.
+     * @param previousB Input of player B on the previous tick.
+     * @param inputB Input of player B.
+     */
+    static void applyInputs(Game& game, Input previousA, Input inputA, Input previousB, Input inputB);
+
+private:
+
+    /**
+     * @brief Simulates a tick.
+     * @param tick Tick.
+     */
+    void simulate(long long tick);
+
+    /**
+     * @brief Drops the inputs of the ticks before the first one that can still be sent, simulated again or used as the
+     * previous input of a tick.
+     */
+    void trim();
+
+    /**
+     * @brief Gets the input of a player on a tick.
+     * @param player Player.
+     * @param tick Tick, it may be negative (no keys are held down before the first tick), otherwise it must not have
+     * been trimmed.
+     * @return Input.
+     */
+    [[nodiscard]] Input input(ControllerHuman::Player player, long long tick) const;
+
+private:
+
+    /** @brief Game. */
+    Game& mGame;
+
+    /** @brief Player controlled on this peer. */
+    ControllerHuman::Player mLocal;
+
+    /** @brief Parameters of the netcode. */
+    Settings mSettings;
+
+    /** @brief Next tick to simulate. */
+    long long mTick = 0;
+
+    /** @brief First tick that must be simulated again because its prediction was wrong. */
+    long long mRollbackFrom = 0;
+
+    /** @brief First tick of the inputs kept, the ones before it are no longer needed. */
+    long long mInputBase = 0;
+
+    /** @brief Inputs of the local player, indexed by tick minus the base (the first `inputDelay` ticks are empty). */
+    std::vector<Input> mLocalInputs;
+
+    /** @brief Inputs of the remote player, indexed by tick minus the base; the ones not received are the predictions. */
+    std::vector<Input> mRemoteInputs;
+
+    /** @brief Flags indicating which remote inputs have been received, indexed by tick minus the base. */
+    std::vector<std::uint8_t> mRemoteReceived;
+
+    /** @brief Number of ticks, from the start, for which the remote input has been received. */
+    long long mRemoteConfirmed = 0;
+
+    /** @brief Number of local inputs acknowledged by the peer. */
+    long long mLocalAcknowledged = 0;
+
+    /** @brief Snapshots of the game before the last ticks, indexed by tick modulo the size. */
+    std::vector<GameSnapshot> mSnapshots;
+
+    /** @brief Statistics. */
+    Stats mStats;
+};
+
+} // namespace pong
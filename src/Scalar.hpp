@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Fixed.hpp"
+#include "Time.hpp"
+#include <glm/glm.hpp>
+
+namespace pong {
+
+#if defined(PONG_FIXED_POINT)
+
+/** @brief Scalar type of the state of the table, the paddles and the ball. */
+using Scalar = Fixed;
+
+/** @brief Vector type of the state of the table, the paddles and the ball. */
+using Vector = FixedVec2;
+
+#else
+
+/** @brief Scalar type of the state of the table, the paddles and the ball. */
+using Scalar = float;
+
+/** @brief Vector type of the state of the table, the paddles and the ball. */
+using Vector = glm::vec2;
+
+#endif
+
+/** @brief Converts a scalar to floating point, for rendering (identity in the floating point build). */
+[[nodiscard]] constexpr float toFloat(const float value) noexcept { return value; }
+
+/** @brief Converts a vector to the rendering type (identity in the floating point build). */
+[[nodiscard]] inline glm::vec2 toVec2(const glm::vec2& v) noexcept { return v; }
+
+/**
+ * @brief Converts a vector from the rendering and configuration type to the state type.
+ * @param v Vector.
+ * @return Vector in the state type.
+ */
+[[nodiscard]] inline Vector toVector(const glm::vec2& v) noexcept { return Vector(v); }
+
+/**
+ * @brief Calculates the distance travelled at a given speed during a time step.
+ *
+ * With floating point, the product is calculated in double precision (as the paddles always did) and then rounded;
+ * with fixed point, the time step is converted first, so only integers are involved.
+ * @param speed Speed.
+ * @param dt Time step.
+ * @return Distance.
+ */
+[[nodiscard]] inline float distance(const float speed, const TimeDuration dt) noexcept
+{
+    return static_cast<float>(speed * dt.count());
+}
+
+[[nodiscard]] inline Fixed distance(const Fixed speed, const TimeDuration dt) noexcept
+{
+    return speed * Fixed(dt.count());
+}
+
+} // namespace pong
@@ -23,7 +23,6 @@
 ////////////////////////////////////////////////////////////
 
 #include "Scene.hpp"
-#include "Entity.hpp"
 
 namespace pong {
 
@@ -31,38 +30,91 @@ Scene::Scene(Game& game) : mGame(game) {}
 
 Scene::~Scene() = default;
 
-Entity& Scene::at(const int i) const
+std::size_t Scene::size() const noexcept
 {
-    return *mEntities[static_cast<std::size_t>(i)];
+    std::size_t size = 0;
+    for (const auto& [key, pool] : mPools)
+    {
+        size += pool->size();
+    }
+
+    return size;
 }
 
-int Scene::append(std::unique_ptr<Entity> entity)
+void Entity::markChanged() const noexcept
 {
-    entity->setScene(this);
-    mEntities.emplace_back(std::move(entity));
+    if (mScene)
+    {
+        mScene->markChanged();
+    }
+}
+
+bool Scene::attach(Entity& entity)
+{
+    entity.setScene(this);
+    mChanged = true;
+
+    if (mHandleCount > Handle<Entity>::MaxIndex)
+    {
+        entity.setId({});
+        return false;
+    }
 
-    return static_cast<int>(mEntities.size() - 1);
+    if (mHandleCount == mHandles.size())
+    {
+        mHandles.emplace_back();
+    }
+
+    HandleEntry& entry = mHandles[mHandleCount];
+    entry.entity = &entity;
+    entity.setId({static_cast<std::uint32_t>(mHandleCount), entry.generation});
+    ++mHandleCount;
+
+    return true;
 }
 
 void Scene::clear()
 {
-    mEntities.clear();
+    for (const auto& [key, pool] : mPools)
+    {
+        pool->clear();
+    }
+    // Invalidate the handles of the entities, the generation zero is reserved for the null handle.
+    for (std::size_t i = 0; i < mHandleCount; ++i)
+    {
+        HandleEntry& entry = mHandles[i];
+        entry.entity     = nullptr;
+        entry.generation = (entry.generation + 1) & Handle<Entity>::GenerationMask;
+        if (entry.generation == 0)
+        {
+            entry.generation = 1;
+        }
+    }
+    mHandleCount = 0;
+    mChanged     = true;
+    // All the memory of the entities is released at once.
+    mArena.reset();
 }
 
 void Scene::update(const TimeDuration dt)
 {
-    for (auto& ptr : mEntities)
+    for (const auto& [key, pool] : mPools)
     {
-        ptr->update(dt);
+        pool->update(dt);
     }
 }
 
 void Scene::draw(Renderer& renderer, const float interp)
 {
-    for (const auto& ptr : mEntities)
+    for (const auto& [key, pool] : mPools)
     {
-        ptr->draw(renderer, interp);
+        pool->draw(renderer, interp);
     }
 }
 
+bool Scene::changed() const
+{
+    return mChanged || std::ranges::any_of(mPools, [](const auto& entry) { return entry.second->animated(); });
+}
+
 } // namespace pong
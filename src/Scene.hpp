@@ -24,14 +24,22 @@
 
 #pragma once
 
+#include "Arena.hpp"
+#include "Entity.hpp"
 #include "Time.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
 #include <vector>
 
 namespace pong {
 
 class Renderer;
-class Entity;
 class Game;
 
 /**
@@ -39,11 +47,25 @@ class Game;
  *
  * The Scene is the primary container for all active game objects (`Entity`).
  * It is responsible for:
- * - **Ownership:** Exclusively owns all entities using `std::unique_ptr`, ensuring automatic memory management and
- *   preventing leaks.
+ * - **Ownership:** Exclusively owns all entities, destroying them when the scene is cleared or destroyed.
  * - **Lifecycle:** Driving the main game loop for its entities by calling their `update()` and `draw()` methods each
  *   frame.
  * - **Access:** Providing a way to access entities for interaction.
+ *
+ * Entities are stored by concrete type: every type has its own pool, where the entities are constructed in place in
+ * contiguous chunks that never move, so the pointers returned by `emplace()` remain valid until the scene is cleared.
+ * The pools are updated and drawn in the order their types were first added to the scene, and the entities of a pool
+ * in the order they were added; each pool calls the functions of its concrete type directly instead of through the
+ * virtual functions of `Entity`.
+ *
+ * The chunks of the pools, and the buffers of the entities that take a `std::pmr` allocator (see `Label`), are
+ * allocated from the arena of the scene. Clearing the scene destroys the entities and then resets the arena in one
+ * step, keeping its memory for the next entities, so changing between the menus and the matches does not allocate
+ * memory from the heap once the arena is large enough.
+ *
+ * Every entity added to the scene receives a generational handle (see `Handle`), and the entities refer to each other,
+ * and the game to them, through handles instead of pointers. `get()` looks up the entity of a handle in constant time
+ * and returns null if the entity no longer exists; clearing the scene invalidates all its handles at once.
  */
 class Scene
 {
@@ -76,49 +98,98 @@ public:
     [[nodiscard]] Game& game() const noexcept { return mGame; }
 
     /**
-     * @brief Gets a reference to an entity by its index.
-     * @warning This method does not check if the entity exists.
-     * @note The method is `const` because it does not modify the Scene's container, but the returned entity itself can
-     * be modified.
-     * @param i The zero-based index of the entity to retrieve.
-     * @return A reference to the entity at the specified index.
+     * @brief Gets the number of entities in the scene.
+     * @return The number of entities.
      */
-    [[nodiscard]] Entity& at(int i) const;
+    [[nodiscard]] std::size_t size() const noexcept;
 
     /**
-     * @brief Adds a new entity to the scene, taking ownership of it.
-     *
-     * The provided `std::unique_ptr` is moved into the scene's internal storage. After this call, the original pointer
-     * will be null, and the scene becomes solely responsible for the entity's lifetime.
-     * @param entity Unique pointer to the entity being added.
-     * @return The index assigned to the newly added entity.
+     * @brief Gets the arena of the scene.
+     * @return The arena.
      */
-    int append(std::unique_ptr<Entity> entity);
+    [[nodiscard]] const Arena& arena() const noexcept { return mArena; }
 
     /**
      * @brief Emplaces a new entity into the scene, constructing it in-place.
-     * @details This is a convenience factory method that constructs a new entity of type `T` in-place and adds it to
-     * the scene. It simplifies object creation and addition into a single, safe operation, mirroring the behavior of
+     * @details This is a convenience factory method that constructs a new entity of type `T` in-place in the pool of
+     * its type. It simplifies object creation and addition into a single, safe operation, mirroring the behavior of
      * container methods like `emplace_back`.
      * @tparam T The concrete `Entity` type to create (e.g., `Label`, `Matrix`).
      * @tparam Args The types of the arguments to forward to the constructor.
      * @param args The arguments for the constructor.
-     * @return A non-owning raw pointer to the newly created entity on success, null on failure.
+     * @return A non-owning raw pointer to the newly created entity on success, null if the handle table is full (the
+     * entity is destroyed right away).
      */
     template<typename T, typename... Args> requires std::derived_from<T, Entity>
     T* emplace(Args&&... args)
     {
-        const int index = append(std::make_unique<T>(std::forward<Args>(args)...));
-        if (index < 0)
+        Pool<T>& entities = pool<T>();
+        T*       entity   = entities.emplace(mArena, std::forward<Args>(args)...);
+        if (!attach(*entity))
+        {
+            entities.pop();
+            return nullptr;
+        }
+
+        return entity;
+    }
+
+    /**
+     * @brief Attaches an entity owned outside the pools of the scene, giving it a handle.
+     *
+     * The scene does not update, draw nor destroy the entity, which must outlive the scene or the next `clear()`. If
+     * the handle table is full, the entity gets a null handle.
+     * @param entity The entity.
+     * @return True if the entity got a handle, false if the handle table is full.
+     */
+    bool attach(Entity& entity);
+
+    /**
+     * @brief Gets the handle of an entity of the scene.
+     * @tparam T The type of the entity.
+     * @param entity The entity.
+     * @return The handle.
+     */
+    template<typename T> requires std::derived_from<T, Entity>
+    [[nodiscard]] Handle<T> handle(const T& entity) const noexcept
+    {
+        return Handle<T>(entity.id());
+    }
+
+    /**
+     * @brief Gets the entity of a handle.
+     * @tparam T The type of the entity.
+     * @param handle The handle.
+     * @return A pointer to the entity, or null if the handle is null or the entity no longer exists.
+     */
+    template<typename T> requires std::derived_from<T, Entity>
+    [[nodiscard]] T* get(const Handle<T> handle) const noexcept
+    {
+        const std::uint32_t index = handle.index();
+        if (index >= mHandleCount || mHandles[index].generation != handle.generation())
         {
             return nullptr;
         }
 
-        return &static_cast<T&>(at(index));
+        return static_cast<T*>(mHandles[index].entity);
+    }
+
+    /**
+     * @brief Creates an object that is not an entity in the arena of the scene.
+     *
+     * The object must be destroyed before the scene is cleared, usually it is owned by an entity of the scene.
+     * @tparam T The type of the object.
+     * @param args The arguments for the constructor.
+     * @return A pointer that owns the object.
+     */
+    template<typename T, typename... Args>
+    ArenaPtr<T> make(Args&&... args)
+    {
+        return mArena.make<T>(std::forward<Args>(args)...);
     }
 
     /**
-     * @brief Removes all entities from the scene.
+     * @brief Removes all entities from the scene, invalidates their handles and releases the memory of its arena.
      */
     void clear();
 
@@ -128,6 +199,26 @@ public:
      */
     void update(TimeDuration dt);
 
+    /**
+     * @brief Calls a function for every entity of a type, in the order they were added.
+     *
+     * It lets the game run a step of the update of one type of entity for all of them (see `Game::Stage`).
+     * @tparam T The type of the entities.
+     * @param function Function taking a reference to the entity.
+     */
+    template<typename T, typename F> requires std::derived_from<T, Entity>
+    void forEach(F&& function)
+    {
+        for (const auto& [key, pool] : mPools)
+        {
+            if (key == poolKey<T>())
+            {
+                static_cast<Pool<T>&>(*pool).forEach(function);
+                return;
+            }
+        }
+    }
+
     /**
      * @brief Draws all entities in the scene.
      * @param renderer The renderer object to use for drawing operations.
@@ -135,13 +226,265 @@ public:
      */
     void draw(Renderer& renderer, float interp);
 
+    /**
+     * @brief Checks whether anything visible changed since the last call to `resetChanged()`.
+     *
+     * The entities notify their changes to the scene (see `Entity::markChanged()`), and a scene with an animated entity
+     * is always changed, as its drawing depends on the interpolation. Adding entities and clearing the scene change it
+     * too. An unchanged scene draws the same frame as the last one, so the frame does not need to be presented again.
+     * @return True if the scene changed, false otherwise.
+     */
+    [[nodiscard]] bool changed() const;
+
+    /**
+     * @brief Marks the scene as changed.
+     */
+    void markChanged() noexcept { mChanged = true; }
+
+    /**
+     * @brief Marks the scene as unchanged, usually after drawing it.
+     */
+    void resetChanged() noexcept { mChanged = false; }
+
+private:
+
+    /**
+     * @brief Defines the interface of the pools, used to update, draw and clear them without knowing their type.
+     */
+    class PoolBase
+    {
+    public:
+
+        PoolBase() = default;
+
+        PoolBase(const PoolBase&) = delete;
+
+        PoolBase& operator=(const PoolBase&) = delete;
+
+        virtual ~PoolBase() = default;
+
+        /** @brief Gets the number of entities in the pool. */
+        [[nodiscard]] virtual std::size_t size() const noexcept = 0;
+
+        /** @brief Destroys all entities of the pool, keeping its memory. */
+        virtual void clear() noexcept = 0;
+
+        /** @brief Updates all entities of the pool. */
+        virtual void update(TimeDuration dt) = 0;
+
+        /** @brief Draws all entities of the pool. */
+        virtual void draw(Renderer& renderer, float interp) = 0;
+
+        /** @brief Checks whether any entity of the pool is animated. */
+        [[nodiscard]] virtual bool animated() = 0;
+    };
+
+    /**
+     * @brief Defines a pool of entities of a concrete type.
+     *
+     * The entities are stored in chunks allocated from the arena of the scene, each one twice as large as the previous
+     * one, so the entities are contiguous within a chunk and never move. Clearing the pool forgets the chunks, the
+     * scene resets the arena right after.
+     * @tparam T Type of the entities.
+     */
+    template<typename T>
+    class Pool final : public PoolBase
+    {
+    public:
+
+        /** @brief Capacity of the first chunk. */
+        static constexpr std::size_t FirstChunkCapacity = 8;
+
+        Pool() = default;
+
+        ~Pool() override { clear(); }
+
+        [[nodiscard]] std::size_t size() const noexcept override { return mSize; }
+
+        /**
+         * @brief Constructs an entity at the end of the pool.
+         *
+         * If the entity takes a `std::pmr` allocator as its last argument, it receives an allocator of the arena.
+         * @param arena Arena of the scene.
+         * @param args The arguments for the constructor.
+         * @return A pointer to the entity.
+         */
+        template<typename... Args>
+        T* emplace(Arena& arena, Args&&... args)
+        {
+            // Find the chunk of the entity, allocating it if it is the first one there.
+            const auto [chunk, slot] = locate(mSize);
+            if (chunk == mChunks.size())
+            {
+                mChunks.push_back(static_cast<Slot*>(arena.allocate(capacity(chunk) * sizeof(Slot), alignof(Slot))));
+            }
+
+            T* entity = std::uninitialized_construct_using_allocator(reinterpret_cast<T*>(mChunks[chunk][slot].bytes), std::pmr::polymorphic_allocator<>(&arena), std::forward<Args>(args)...);
+            ++mSize;
+
+            return entity;
+        }
+
+        /**
+         * @brief Destroys the last entity of the pool, keeping its memory.
+         */
+        void pop() noexcept
+        {
+            --mSize;
+            const auto [chunk, slot] = locate(mSize);
+            std::launder(reinterpret_cast<T*>(mChunks[chunk][slot].bytes))->~T();
+        }
+
+        void clear() noexcept override
+        {
+            forEach([](T& entity) { entity.~T(); });
+            mChunks.clear();
+            mSize = 0;
+        }
+
+        void update(const TimeDuration dt) override
+        {
+            // The qualified call is not virtual.
+            forEach([dt](T& entity) { entity.T::update(dt); });
+        }
+
+        void draw(Renderer& renderer, const float interp) override
+        {
+            forEach([&renderer, interp](T& entity) { entity.T::draw(renderer, interp); });
+        }
+
+        [[nodiscard]] bool animated() override
+        {
+            bool animated = false;
+            forEach([&animated](const T& entity) { animated = animated || entity.T::animated(); });
+
+            return animated;
+        }
+
+        /**
+         * @brief Finds the chunk and the slot of an entity.
+         * @param index Index of the entity in the pool.
+         * @return The index of the chunk and the index of the slot in the chunk.
+         */
+        static constexpr std::pair<std::size_t, std::size_t> locate(const std::size_t index) noexcept
+        {
+            std::size_t chunk = 0;
+            std::size_t slot  = index;
+            for (; slot >= capacity(chunk); ++chunk)
+            {
+                slot -= capacity(chunk);
+            }
+
+            return {chunk, slot};
+        }
+
+        /**
+         * @brief Calls a function for every entity of the pool, in order.
+         * @param function Function.
+         */
+        template<typename F>
+        void forEach(F&& function)
+        {
+            std::size_t left = mSize;
+            for (std::size_t chunk = 0; left > 0; ++chunk)
+            {
+                const std::size_t count = std::min(left, capacity(chunk));
+                Slot*             slots = mChunks[chunk];
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    function(*std::launder(reinterpret_cast<T*>(slots[i].bytes)));
+                }
+                left -= count;
+            }
+        }
+
+    private:
+
+        /** @brief Defines the storage of an entity. */
+        struct Slot
+        {
+            alignas(T) std::byte bytes[sizeof(T)];
+        };
+
+        /**
+         * @brief Gets the capacity of a chunk.
+         * @param chunk Index of the chunk.
+         * @return The capacity.
+         */
+        static constexpr std::size_t capacity(const std::size_t chunk) noexcept { return FirstChunkCapacity << chunk; }
+
+    private:
+
+        /** @brief Chunks, allocated from the arena. */
+        std::vector<Slot*> mChunks;
+
+        /** @brief Number of entities. */
+        std::size_t mSize = 0;
+    };
+
+    /**
+     * @brief Gets the key that identifies the pool of a type.
+     * @tparam T Type.
+     * @return The key, unique for every type.
+     */
+    template<typename T>
+    static const void* poolKey() noexcept
+    {
+        static constexpr char key = 0;
+        return &key;
+    }
+
+    /**
+     * @brief Gets the pool of a type, creating it if the scene has none yet.
+     * @tparam T Type.
+     * @return The pool.
+     */
+    template<typename T>
+    Pool<T>& pool()
+    {
+        const void* key = poolKey<T>();
+        for (const auto& [poolKey, pool] : mPools)
+        {
+            if (poolKey == key)
+            {
+                return static_cast<Pool<T>&>(*pool);
+            }
+        }
+
+        return static_cast<Pool<T>&>(*mPools.emplace_back(key, std::make_unique<Pool<T>>()).second);
+    }
+
+    /**
+     * @brief Defines an entry of the handle table.
+     */
+    struct HandleEntry
+    {
+        /** @brief Entity, null if the entry is free. */
+        Entity* entity = nullptr;
+
+        /** @brief Generation of the entry, never zero. */
+        std::uint32_t generation = 1;
+    };
+
 private:
 
     /** @brief Parent Game object. */
     Game& mGame;
 
-    /** @brief Vector with all entities in the scene. */
-    std::vector<std::unique_ptr<Entity>> mEntities;
+    /** @brief Arena for the chunks of the pools and the buffers of the entities, destroyed after the pools. */
+    Arena mArena;
+
+    /** @brief Pools of entities with the key of their type, in the order they were created. */
+    std::vector<std::pair<const void*, std::unique_ptr<PoolBase>>> mPools;
+
+    /** @brief Handle table, the entries are kept when the scene is cleared to keep their generations. */
+    std::vector<HandleEntry> mHandles;
+
+    /** @brief Number of entries of the handle table in use. */
+    std::size_t mHandleCount = 0;
+
+    /** @brief Indicates whether something visible changed since the last call to `resetChanged()`. */
+    bool mChanged = true;
 };
 
 } // namespace pong
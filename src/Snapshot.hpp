@@ -0,0 +1,228 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Scalar.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace pong {
+
+/**
+ * @brief State of a paddle controller in a snapshot.
+ *
+ * The record is the same for every kind of controller, each one only uses its own fields and leaves the others zero.
+ */
+struct ControllerSnapshot
+{
+    /** @brief Defines an enumeration with the kinds of controllers. */
+    enum class Kind : std::uint8_t
+    {
+        HumanA = 0, //!< Human player A.
+        HumanB = 1, //!< Human player B.
+        AI     = 2  //!< AI.
+    };
+
+    /** @brief Kind of controller. */
+    Kind kind = Kind::HumanA;
+
+    /** @brief AI, flag to handle the first update frame uniquely. */
+    std::uint8_t first = 0;
+
+    /** @brief AI, flag indicating the paddle is returning to the center. */
+    std::uint8_t back = 0;
+
+    /** @brief Padding, always zero. */
+    std::uint8_t reserved = 0;
+
+    /** @brief Human, direction counter of the keys held down. */
+    std::int32_t moveDirection = 0;
+
+    /** @brief AI, target Y-coordinate. */
+    float target = 0.0f;
+
+    /** @brief AI, base offset from the paddle's center to hit the ball. */
+    float hitPositionBase = 0.0f;
+
+    /** @brief AI, random error range added to the hit position. */
+    float hitPositionError = 0.0f;
+
+    /** @brief AI, random error range when returning to the center. */
+    float returnPositionErrorFactor = 0.0f;
+
+    /** @brief AI, how often the target is re-evaluated, in seconds. */
+    double targetUpdateInterval = 0.0;
+
+    /** @brief AI, ticks until the next update of the target, counting the next one. */
+    std::uint32_t targetUpdateTicks = 0;
+
+    /** @brief Padding, always zero. */
+    std::uint32_t reserved2 = 0;
+
+    /** @brief AI, state of the random generator. */
+    std::uint64_t random = 0;
+
+    bool operator==(const ControllerSnapshot&) const = default;
+};
+
+/**
+ * @brief State of a paddle in a snapshot.
+ */
+struct PaddleSnapshot
+{
+    /** @brief Center position. */
+    Vector position;
+
+    /** @brief Position in the previous frame. */
+    Vector positionPrev;
+
+    /** @brief Vertical speed. */
+    Scalar speed = Scalar(0);
+
+    /** @brief Padding, always zero. */
+    std::uint32_t reserved = 0;
+
+    /** @brief Controller. */
+    ControllerSnapshot controller;
+
+    bool operator==(const PaddleSnapshot&) const = default;
+};
+
+/**
+ * @brief State of the ball in a snapshot.
+ */
+struct BallSnapshot
+{
+    /** @brief Center position. */
+    Vector position;
+
+    /** @brief Position in the previous frame. */
+    Vector positionPrev;
+
+    /** @brief Speed. */
+    Vector speed;
+
+    /** @brief Scoring state of the last update (0 none, 1 player A, 2 player B). */
+    std::uint8_t point = 0;
+
+    /** @brief Flag indicating if there was a collision in the last update. */
+    std::uint8_t collisionOccurred = 0;
+
+    /** @brief Padding, always zero. */
+    std::uint16_t reserved = 0;
+
+    bool operator==(const BallSnapshot&) const = default;
+};
+
+/**
+ * @brief Complete state of a game, as a flat, fixed-size block of plain data.
+ *
+ * A snapshot holds everything that changes while the game runs: the state machine, the scores and their labels, the
+ * entities of the match and the internals of the controllers, including the state of their random generators. The
+ * rest (the layout of the table, the menus) is rebuilt from it. It can be copied with `memcpy`, stored in arrays or
+ * written to a file as it is; the header identifies the format, and a snapshot is only restored by a build with the
+ * same version and the same number format (`PONG_FIXED_POINT`). It has no implicit padding, so two snapshots of the
+ * same state are also equal byte by byte.
+ */
+struct GameSnapshot
+{
+    /** @brief Magic number identifying a snapshot. */
+    static constexpr std::uint32_t Magic = 0x534E4750; // "PGNS"
+
+    /** @brief Version of the format, it changes with every change of the layout. */
+    static constexpr std::uint16_t Version = 1;
+
+    /** @brief Identifier of the number format of the build. */
+    static constexpr std::uint8_t Format = std::is_same_v<Scalar, float> ? 0 : 1;
+
+    /** @brief Magic number. */
+    std::uint32_t magic = Magic;
+
+    /** @brief Version of the format. */
+    std::uint16_t version = Version;
+
+    /** @brief Number format (0 float, 1 fixed point). */
+    std::uint8_t format = Format;
+
+    /** @brief Flag indicating if there is a match scene (paddles, ball and score labels). */
+    std::uint8_t match = 0;
+
+    /** @brief Size of the snapshot, in bytes. */
+    std::uint32_t size = sizeof(GameSnapshot);
+
+    /** @brief State of the state machine (`Game::State`). */
+    std::uint8_t state = 0;
+
+    /** @brief Collision detection mode of the ball (`physics::CollisionMode`). */
+    std::uint8_t collisionMode = 0;
+
+    /** @brief Flag indicating if the match has several balls, such a match is not saved and cannot be restored. */
+    std::uint8_t multiBall = 0;
+
+    /** @brief Padding, always zero. */
+    std::uint8_t reserved = 0;
+
+    /** @brief Score of player A. */
+    std::int32_t scoreA = 0;
+
+    /** @brief Score of player B. */
+    std::int32_t scoreB = 0;
+
+    /** @brief Seed of the AI for the next match started from the menus. */
+    std::uint32_t seed = 0;
+
+    /** @brief Score displayed by the label of player A, it is not updated with the last point of a match. */
+    std::int32_t labelScoreA = 0;
+
+    /** @brief Score displayed by the label of player B, it is not updated with the last point of a match. */
+    std::int32_t labelScoreB = 0;
+
+    /** @brief Ball. */
+    BallSnapshot ball;
+
+    /** @brief Paddle of player A. */
+    PaddleSnapshot paddleA;
+
+    /** @brief Paddle of player B. */
+    PaddleSnapshot paddleB;
+
+    /**
+     * @brief Checks if the header matches the one of this build.
+     * @return True if the snapshot can be restored, false otherwise.
+     */
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return magic == Magic && version == Version && format == Format && size == sizeof(GameSnapshot);
+    }
+
+    bool operator==(const GameSnapshot&) const = default;
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>);
+static_assert(std::is_standard_layout_v<GameSnapshot>);
+// Any change of the size is a change of the layout, which needs a new version.
+static_assert(sizeof(GameSnapshot) == 208);
+
+} // namespace pong
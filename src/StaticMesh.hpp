@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Renderer.hpp"
+#include <utility>
+
+namespace pong {
+
+/**
+ * @brief Owns a static mesh of a renderer (see `Renderer::beginMesh()`).
+ *
+ * Entities whose geometry never changes record it once, the first time they are drawn, and then only draw the mesh.
+ * The mesh belongs to the renderer that recorded it, so it is recorded again if the entity is drawn with another one,
+ * and it is destroyed with the handle; the renderer must outlive it.
+ */
+class StaticMesh
+{
+public:
+
+    StaticMesh() noexcept = default;
+
+    StaticMesh(const StaticMesh&) = delete;
+
+    /**
+     * @brief Move constructor. Transfers ownership of the mesh from another handle.
+     * @param other Handle to move.
+     */
+    StaticMesh(StaticMesh&& other) noexcept
+        :
+        mRenderer(std::exchange(other.mRenderer, nullptr)), mId(other.mId)
+    {}
+
+    StaticMesh& operator=(const StaticMesh&) = delete;
+
+    /**
+     * @brief Move assignment operator. Destroys the current mesh and takes ownership from another handle.
+     * @param other Handle to move.
+     * @return Reference to itself.
+     */
+    StaticMesh& operator=(StaticMesh&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            mRenderer = std::exchange(other.mRenderer, nullptr);
+            mId       = other.mId;
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the mesh, if any.
+     */
+    ~StaticMesh() { reset(); }
+
+    /**
+     * @brief Draws the mesh, recording it first if there is none for the renderer.
+     * @param renderer Renderer.
+     * @param record Function that queues the quads of the mesh to the renderer given as argument.
+     */
+    template<typename F>
+    void draw(Renderer& renderer, F&& record)
+    {
+        if (mRenderer != &renderer)
+        {
+            reset();
+            renderer.beginMesh();
+            record(renderer);
+            mId       = renderer.endMesh();
+            mRenderer = &renderer;
+        }
+
+        renderer.drawMesh(mId);
+    }
+
+    /**
+     * @brief Destroys the mesh, so it is recorded again the next time it is drawn.
+     */
+    void reset()
+    {
+        if (mRenderer)
+        {
+            mRenderer->destroyMesh(mId);
+            mRenderer = nullptr;
+        }
+    }
+
+private:
+
+    /** @brief Renderer of the mesh, null if there is none. */
+    Renderer* mRenderer = nullptr;
+
+    /** @brief Identifier of the mesh. */
+    Renderer::MeshId mId = 0;
+};
+
+} // namespace pong
@@ -0,0 +1,309 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "SweptCollision.hpp"
+#include "Physics.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace pong::physics {
+
+namespace {
+
+/** @brief Defines an enumeration with the collisions found by a sweep. */
+enum class Hit
+{
+    None,    //!< No collision.
+    Top,     //!< Top wall.
+    Bottom,  //!< Bottom wall.
+    GoalA,   //!< Left goal line, player A scores.
+    GoalB,   //!< Right goal line, player B scores.
+    StopA,   //!< Paddle A reaches its limits.
+    StopB,   //!< Paddle B reaches its limits.
+    PaddleA, //!< Ball against paddle A.
+    PaddleB  //!< Ball against paddle B.
+};
+
+/** @brief Time used for the events that never happen. */
+constexpr double Never = std::numeric_limits<double>::infinity();
+
+/**
+ * @brief Calculates the time when a paddle reaches its limits.
+ * @param paddle Paddle.
+ * @return Time when the paddle stops, `Never` if it is not moving.
+ */
+double timeToStop(const SweptPaddle& paddle)
+{
+    if (paddle.speed > 0.0f) { return paddle.time + static_cast<double>((paddle.maxY - paddle.position.y) / paddle.speed); }
+    if (paddle.speed < 0.0f) { return paddle.time + static_cast<double>((paddle.minY - paddle.position.y) / paddle.speed); }
+
+    return Never;
+}
+
+/**
+ * @brief Calculates the time of impact of a point against a circle.
+ * @param c Position of the point.
+ * @param w Velocity of the point relative to the circle.
+ * @param center Center of the circle.
+ * @param r Radius of the circle.
+ * @return Time of impact, `Never` if the point does not move into the circle.
+ */
+double timeOfImpactCircle(const glm::vec2& c, const glm::vec2& w, const glm::vec2& center, const float r)
+{
+    const glm::vec2 d = c - center;
+    const float     b = glm::dot(d, w);
+    // The point must be moving towards the center.
+    if (b >= 0.0f)
+    {
+        return Never;
+    }
+
+    const float k = glm::dot(d, d) - r * r;
+    // The point is already inside the circle.
+    if (k <= 0.0f)
+    {
+        return 0.0;
+    }
+
+    const float a            = glm::dot(w, w);
+    const float discriminant = b * b - a * k;
+    if (discriminant < 0.0f)
+    {
+        return Never;
+    }
+
+    return static_cast<double>((-b - glm::sqrt(discriminant)) / a);
+}
+
+/**
+ * @brief Calculates the time of impact of the ball against a line of a paddle.
+ *
+ * The line is vertical and the ball is reduced to its center, so the line becomes a capsule: a band of width twice the
+ * radius around the line capped by a circle at each end.
+ * @param c Center of the ball.
+ * @param w Velocity of the ball relative to the paddle.
+ * @param line Center of the line.
+ * @param halfH Half of the length of the line.
+ * @param r Radius of the ball.
+ * @return Time of impact, `Never` if the ball does not hit the line.
+ */
+double timeOfImpactLine(const glm::vec2& c, const glm::vec2& w, const glm::vec2& line, const float halfH, const float r)
+{
+    double t = Never;
+    // Sides of the band, only the one facing the ball can be hit.
+    float ts = -1.0f;
+    if      (w.x > 0.0f && c.x <= line.x - r) { ts = (line.x - r - c.x) / w.x; }
+    else if (w.x < 0.0f && c.x >= line.x + r) { ts = (line.x + r - c.x) / w.x; }
+    else if ((line.x - c.x) * w.x > 0.0f)     { ts = 0.0f; }
+
+    if (ts >= 0.0f && glm::abs(c.y + w.y * ts - line.y) <= halfH)
+    {
+        t = static_cast<double>(ts);
+    }
+    // Ends of the line.
+    t = std::min(t, timeOfImpactCircle(c, w, {line.x, line.y - halfH}, r));
+    t = std::min(t, timeOfImpactCircle(c, w, {line.x, line.y + halfH}, r));
+
+    return t;
+}
+
+/**
+ * @brief Calculates the time of impact of the ball against a paddle.
+ * @param ball Ball.
+ * @param paddle Paddle.
+ * @param now Time of the last collision, the positions of both bodies are known at this time.
+ * @return Time of impact, `Never` if the ball does not hit the paddle.
+ */
+double timeOfImpact(const SweptBall& ball, const SweptPaddle& paddle, const double now)
+{
+    const glm::vec2 c = positionAt(ball,   now);
+    const glm::vec2 p = positionAt(paddle, now);
+    // The ball only bounces off a paddle it is moving towards, after a bounce it always moves away.
+    if ((p.x - c.x) * ball.speed.x <= 0.0f)
+    {
+        return Never;
+    }
+    // The paddle moves vertically, so the ball is swept with its relative velocity.
+    const glm::vec2 w     = {ball.speed.x, ball.speed.y - paddle.speed};
+    const glm::vec2 front = {p.x - paddle.half.x, p.y};
+    const glm::vec2 back  = {p.x + paddle.half.x, p.y};
+
+    return now + std::min(timeOfImpactLine(c, w, front, paddle.half.y, ball.radius),
+                          timeOfImpactLine(c, w, back,  paddle.half.y, ball.radius));
+}
+
+/**
+ * @brief Stops a paddle at its limits.
+ * @param paddle Paddle.
+ * @param t Time when the paddle reaches the limits.
+ */
+void stop(SweptPaddle& paddle, const double t)
+{
+    paddle.position.y = paddle.speed > 0.0f ? paddle.maxY : paddle.minY;
+    paddle.speed      = 0.0f;
+    paddle.time       = t;
+}
+
+/**
+ * @brief Bounces the ball off a paddle.
+ * @param ball Ball.
+ * @param paddle Paddle.
+ * @param t Time of the collision.
+ * @return Position of the contact relative to the center of the paddle.
+ */
+float bounce(SweptBall& ball, const SweptPaddle& paddle, const double t)
+{
+    ball.position = positionAt(ball, t);
+
+    const float rDist = (ball.position.y - positionAt(paddle, t).y) / paddle.half.y;
+
+    ball.speed = physics::bounce(ball.speed, rDist);
+    ball.time  = t;
+
+    return rDist;
+}
+
+} // namespace
+
+SweepResult sweep(SweptBall& ball, SweptPaddle& paddleA, SweptPaddle& paddleB, const SweptTable& table, const double end)
+{
+    SweepResult result;
+
+    for (int events = 0; ; ++events)
+    {
+        // The state of all the bodies is known at the time of the last collision.
+        const double now = std::max({ball.time, paddleA.time, paddleB.time});
+        double       t   = Never;
+        Hit          hit = Hit::None;
+        // Keep the earliest collision, on ties the first one found.
+        const auto consider = [&t, &hit](const double time, const Hit what)
+        {
+            if (time < t)
+            {
+                t   = time;
+                hit = what;
+            }
+        };
+        // Walls.
+        if (ball.speed.y > 0.0f) { consider(ball.time + static_cast<double>((table.top    - ball.radius - ball.position.y) / ball.speed.y), Hit::Top);    }
+        if (ball.speed.y < 0.0f) { consider(ball.time + static_cast<double>((table.bottom + ball.radius - ball.position.y) / ball.speed.y), Hit::Bottom); }
+        // Goal lines.
+        if (ball.speed.x > 0.0f) { consider(ball.time + static_cast<double>((table.right  - ball.radius - ball.position.x) / ball.speed.x), Hit::GoalB);  }
+        if (ball.speed.x < 0.0f) { consider(ball.time + static_cast<double>((table.left   + ball.radius - ball.position.x) / ball.speed.x), Hit::GoalA);  }
+        // The paddles move linearly until they reach their limits.
+        consider(timeToStop(paddleA), Hit::StopA);
+        consider(timeToStop(paddleB), Hit::StopB);
+        // Paddles.
+        consider(timeOfImpact(ball, paddleA, now), Hit::PaddleA);
+        consider(timeOfImpact(ball, paddleB, now), Hit::PaddleB);
+        // Nothing else happens until the end of the sweep.
+        if (t > end)
+        {
+            break;
+        }
+        // Give up on a ball trapped between bodies that keep bouncing it.
+        if (events == MaxSweepEvents)
+        {
+            result.overflow = true;
+            break;
+        }
+        // A collision can not happen before the previous one.
+        t = std::max(t, now);
+        // Resolve the collision with the same rules of the discrete mode.
+        switch (hit)
+        {
+            case Hit::None:
+                break;
+
+            case Hit::Top:
+                ball.position   = positionAt(ball, t);
+                ball.position.y = table.top - ball.radius;
+                ball.speed.y   *= -1.0f;
+                ball.time       = t;
+                ++result.walls;
+                break;
+
+            case Hit::Bottom:
+                ball.position   = positionAt(ball, t);
+                ball.position.y = table.bottom + ball.radius;
+                ball.speed.y   *= -1.0f;
+                ball.time       = t;
+                ++result.walls;
+                break;
+
+            case Hit::GoalA:
+            case Hit::GoalB:
+                ball.position = positionAt(ball, t);
+                ball.time     = t;
+                result.pointA = hit == Hit::GoalA;
+                result.pointB = hit == Hit::GoalB;
+                result.time   = t;
+                return result;
+
+            case Hit::StopA:
+                stop(paddleA, t);
+                break;
+
+            case Hit::StopB:
+                stop(paddleB, t);
+                break;
+
+            case Hit::PaddleA:
+                result.offset = bounce(ball, paddleA, t);
+                result.paddle = 0;
+                ++result.paddles;
+                break;
+
+            case Hit::PaddleB:
+                result.offset = bounce(ball, paddleB, t);
+                result.paddle = 1;
+                ++result.paddles;
+                break;
+        }
+    }
+
+    return result;
+}
+
+void settle(SweptBall& ball, const SweptPaddle& paddleA, const SweptPaddle& paddleB, const SweptTable& table,
+            const SweepResult& result, const double end)
+{
+    glm::vec2 position = ball.position;
+    position.y = std::clamp(position.y, table.bottom + ball.radius, table.top - ball.radius);
+    position.x = std::clamp(position.x, table.left   + ball.radius, table.right - ball.radius);
+    // In front of the paddle, the front of paddle A faces left and the front of paddle B faces right.
+    if (result.paddles > 0 && result.paddle == 0)
+    {
+        position.x = std::min(position.x, paddleA.position.x - paddleA.half.x - ball.radius);
+    }
+    if (result.paddles > 0 && result.paddle == 1)
+    {
+        position.x = std::max(position.x, paddleB.position.x + paddleB.half.x + ball.radius);
+    }
+
+    ball.position = position;
+    ball.time     = end;
+}
+
+} // namespace pong::physics
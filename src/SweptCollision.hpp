@@ -0,0 +1,158 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace pong::physics {
+
+/**
+ * @brief Defines an enumeration with the collision detection modes.
+ */
+enum class CollisionMode
+{
+    Discrete, //!< Move the ball the whole time step and then resolve the overlaps (it can tunnel with large steps).
+    Swept     //!< Find the exact time of impact of every collision within the time step (continuous detection).
+};
+
+/**
+ * @brief Limits of the table for a sweep.
+ */
+struct SweptTable
+{
+    float top;    //!< Y-coordinate of the top wall.
+    float bottom; //!< Y-coordinate of the bottom wall.
+    float left;   //!< X-coordinate of the left goal line.
+    float right;  //!< X-coordinate of the right goal line.
+};
+
+/**
+ * @brief State of the ball for a sweep.
+ *
+ * The ball moves in a straight line from the position it had at a given time (its last collision).
+ */
+struct SweptBall
+{
+    glm::vec2 position; //!< Center position at `time`.
+    glm::vec2 speed;    //!< Speed.
+    float     radius;   //!< Radius.
+    double    time;     //!< Time of the position.
+};
+
+/**
+ * @brief State of a paddle for a sweep.
+ *
+ * The paddle moves vertically at a constant speed from the position it had at a given time, until it reaches its
+ * limits, where it stops.
+ */
+struct SweptPaddle
+{
+    glm::vec2 position; //!< Center position at `time`.
+    glm::vec2 half;     //!< Half of the size.
+    float     speed;    //!< Vertical speed.
+    float     minY;     //!< Minimum Y-coordinate of the center.
+    float     maxY;     //!< Maximum Y-coordinate of the center.
+    double    time;     //!< Time of the position.
+};
+
+/**
+ * @brief Summary of what happened during a sweep.
+ */
+struct SweepResult
+{
+    int    walls    = 0;     //!< Number of bounces off the walls.
+    int    paddles  = 0;     //!< Number of bounces off the paddles.
+    int    paddle   = 0;     //!< Paddle of the last bounce off a paddle (0 for A, 1 for B).
+    float  offset   = 0.0f;  //!< Contact of the last bounce off a paddle, relative to its center, in [-1, 1].
+    bool   pointA   = false; //!< The ball crossed the left goal line, player A scores.
+    bool   pointB   = false; //!< The ball crossed the right goal line, player B scores.
+    bool   overflow = false; //!< The sweep stopped after `MaxSweepEvents` collisions, before its end.
+    double time     = 0.0;   //!< Time of the point, if any.
+};
+
+/** @brief Maximum number of collisions resolved in a single sweep. */
+inline constexpr int MaxSweepEvents = 32;
+
+/**
+ * @brief Calculates the position of the ball at a given time.
+ * @param ball Ball.
+ * @param time Time, it must not be earlier than the time of the ball.
+ * @return Center position.
+ */
+inline glm::vec2 positionAt(const SweptBall& ball, const double time)
+{
+    return ball.position + ball.speed * static_cast<float>(time - ball.time);
+}
+
+/**
+ * @brief Calculates the position of a paddle at a given time.
+ * @param paddle Paddle.
+ * @param time Time, it must not be earlier than the time of the paddle.
+ * @return Center position.
+ */
+inline glm::vec2 positionAt(const SweptPaddle& paddle, const double time)
+{
+    const float y = paddle.position.y + paddle.speed * static_cast<float>(time - paddle.time);
+    return {paddle.position.x, glm::clamp(y, paddle.minY, paddle.maxY)};
+}
+
+/**
+ * @brief Sweeps the ball and the paddles up to a given time with continuous collision detection.
+ *
+ * The ball is swept against the walls, the goal lines and the front and back lines of both paddles (a capsule, the
+ * Minkowski sum of the line and the ball). The earliest collision is found in closed form, the bodies involved are
+ * moved to that time, the collision is resolved with the same rules of the discrete mode (reflection off the walls and
+ * `bounce` off the paddles) and the search continues, up to `MaxSweepEvents` collisions. The sweep stops as soon as
+ * the ball crosses a goal line, or at the last collision it resolved if there are more (see `SweepResult::overflow`
+ * and `settle`).
+ *
+ * The times of the collisions only depend on the state at the previous collision, never on the time the sweep starts
+ * or ends, so sweeping an interval at once or in several pieces gives exactly the same results. After the sweep the
+ * bodies keep the state of their last collision, use `positionAt` to get their positions at the end.
+ * @param ball Ball, it is updated.
+ * @param paddleA Paddle A (right), it is updated.
+ * @param paddleB Paddle B (left), it is updated.
+ * @param table Limits of the table.
+ * @param end Time where the sweep ends.
+ * @return Summary of the collisions.
+ */
+SweepResult sweep(SweptBall& ball, SweptPaddle& paddleA, SweptPaddle& paddleB, const SweptTable& table, double end);
+
+/**
+ * @brief Places the ball of a sweep that overflowed at its end.
+ *
+ * The collisions left are not resolved: the ball keeps its speed and stays where the sweep stopped, clamped inside the
+ * table and in front of the paddle it last hit in the sweep, if any, instead of moving through them.
+ * @param ball Ball of the sweep, it is updated.
+ * @param paddleA Paddle A (right) of the sweep.
+ * @param paddleB Paddle B (left) of the sweep.
+ * @param table Limits of the table.
+ * @param result Result of the sweep.
+ * @param end Time where the sweep ends.
+ */
+void settle(SweptBall& ball, const SweptPaddle& paddleA, const SweptPaddle& paddleB, const SweptTable& table,
+            const SweepResult& result, double end);
+
+} // namespace pong::physics
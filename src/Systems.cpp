@@ -0,0 +1,418 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Systems.hpp"
+#include "Game.hpp"
+#include "Paddle.hpp"
+#include "Physics.hpp"
+#include "PhysicsFixed.hpp"
+#include "Renderer.hpp"
+#include "Table.hpp"
+#include <cmath>
+#include <string>
+
+namespace pong::ecs {
+namespace {
+
+/**
+ * @brief Defines the limits of the bounds of a collider, calculated as `Table` does.
+ */
+struct Limits
+{
+    Scalar top;
+    Scalar bottom;
+    Scalar left;
+    Scalar right;
+};
+
+/**
+ * @brief Gets the limits of the bounds of an entity.
+ * @param world World.
+ * @param bounds Entity with the bounds.
+ * @return Limits.
+ */
+Limits limits(const World& world, const EntityId bounds) noexcept
+{
+    const Vector& position = world.get<Transform>(bounds).position;
+    const Vector& size     = world.get<Collider>(bounds).size;
+
+    return {position.y + size.y * Scalar(0.5f), position.y - size.y * Scalar(0.5f),
+            position.x - size.x * Scalar(0.5f), position.x + size.x * Scalar(0.5f)};
+}
+
+/**
+ * @brief Moves an entity to a position, without interpolation.
+ * @param world World.
+ * @param entity Entity.
+ * @param position Position.
+ */
+void place(World& world, const EntityId entity, const Vector& position) noexcept
+{
+    Transform& transform = world.get<Transform>(entity);
+    transform.position     = position;
+    transform.positionPrev = position;
+}
+
+/**
+ * @brief Changes the text of an entity.
+ * @param world World.
+ * @param entity Entity.
+ * @param score Score to display.
+ */
+void setScore(World& world, const EntityId entity, const int score)
+{
+    Text& text = world.get<Text>(entity);
+    text.text.assign(std::to_string(score));
+    text.dirty = true;
+}
+
+/**
+ * @brief Gets the interpolated position of an entity.
+ * @param transform Position of the entity.
+ * @param interp Interpolation value.
+ * @return Position.
+ */
+glm::vec2 interpolate(const Transform& transform, const float interp) noexcept
+{
+    return toVec2(transform.position) * interp + toVec2(transform.positionPrev) * (1.0f - interp);
+}
+
+} // namespace
+
+void ControlSystem<HumanControl>::update(World& world, [[maybe_unused]] const TimeDuration dt)
+{
+    auto&      controls = world.components<HumanControl>();
+    const auto entities = controls.entities();
+    const auto items    = controls.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        const int direction = items[i].direction;
+        Scalar&   speed     = world.get<Velocity>(entities[i]).speed.y;
+
+        if      (direction > 0) { speed =  Scalar(Paddle::MovementSpeed); }
+        else if (direction < 0) { speed = -Scalar(Paddle::MovementSpeed); }
+        else                    { speed =  Scalar(0); }
+    }
+}
+
+void ControlSystem<AIControl>::update(World& world, const TimeDuration dt)
+{
+    auto&      controls = world.components<AIControl>();
+    const auto entities = controls.entities();
+    const auto items    = controls.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        AIControl&       ai       = items[i];
+        const Transform& paddle   = world.get<Transform>(entities[i]);
+        const Collider&  collider = world.get<Collider>(entities[i]);
+        const Transform& table    = world.get<Transform>(collider.bounds);
+        // On the very first update, set the initial target to the table's center.
+        if (ai.first)
+        {
+            ai.target = toFloat(table.position.y);
+            ai.first  = false;
+        }
+        // Recalculate the target when enough time has elapsed since the last time.
+        ai.timeSinceTargetUpdate += dt;
+        if (ai.timeSinceTargetUpdate > ai.settings.targetUpdateInterval)
+        {
+            ai.timeSinceTargetUpdate = TimeDuration::zero();
+            ControllerAI::updateTarget(ai.target, ai.back,
+                                       toVec2(paddle.position), toFloat(collider.size.y),
+                                       toVec2(table.position),  toFloat(world.get<Collider>(collider.bounds).size.y),
+                                       toVec2(world.get<Transform>(ai.ball).position), toVec2(world.get<Velocity>(ai.ball).speed),
+                                       ai.settings,
+                                       [&ai](const float min, const float max) { return ai.random.uniform(min, max); });
+        }
+        // Move towards the target, but stop within the dead zone.
+        const float y     = toFloat(paddle.position.y);
+        Scalar&     speed = world.get<Velocity>(entities[i]).speed.y;
+        if (std::abs(y - ai.target) > ControllerAI::TargetDeadZone)
+        {
+            speed = y < ai.target ? Scalar(Paddle::MovementSpeed) : -Scalar(Paddle::MovementSpeed);
+        }
+        else
+        {
+            speed = Scalar(0);
+        }
+    }
+}
+
+void PaddleSystem::update(World& world, const TimeDuration dt)
+{
+    auto&      velocities = world.components<Velocity>();
+    const auto entities   = velocities.entities();
+    const auto items      = velocities.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        const Collider& collider = world.get<Collider>(entities[i]);
+        if (collider.shape != Collider::Shape::Box)
+        {
+            continue;
+        }
+
+        Transform&   transform = world.get<Transform>(entities[i]);
+        const Limits bounds    = limits(world, collider.bounds);
+        const Scalar half      = collider.size.y * Scalar(0.5f);
+
+        transform.positionPrev = transform.position;
+        transform.position.y   = transform.position.y + distance(items[i].speed.y, dt);
+
+        if (transform.position.y + half > bounds.top)    { transform.position.y = bounds.top    - half; }
+        if (transform.position.y - half < bounds.bottom) { transform.position.y = bounds.bottom + half; }
+    }
+}
+
+void BallSystem::update(World& world, const TimeDuration dt)
+{
+    auto&      velocities = world.components<Velocity>();
+    const auto entities   = velocities.entities();
+    const auto items      = velocities.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        Collider& collider = world.get<Collider>(entities[i]);
+        if (collider.shape != Collider::Shape::Circle)
+        {
+            continue;
+        }
+
+        Transform&   transform = world.get<Transform>(entities[i]);
+        Vector&      position  = transform.position;
+        Vector&      speed     = items[i].speed;
+        const Scalar radius    = collider.radius;
+        const Limits bounds    = limits(world, collider.bounds);
+
+        collider.hit           = false;
+        transform.positionPrev = position;
+        position               = position + speed * Scalar(dt.count());
+        // Walls.
+        if (position.y + radius > bounds.top)
+        {
+            position.y   = bounds.top - radius;
+            speed.y      = -speed.y;
+            collider.hit = true;
+        }
+
+        if (position.y - radius < bounds.bottom)
+        {
+            position.y   = bounds.bottom + radius;
+            speed.y      = -speed.y;
+            collider.hit = true;
+        }
+        // Sides, the left one has priority as in `Ball::checkScore()`.
+        if (position.x + radius > bounds.right) { collider.exit = Collider::Exit::Right; }
+        if (position.x - radius < bounds.left)  { collider.exit = Collider::Exit::Left;  }
+        // Paddles.
+        const Transform& paddleA = world.get<Transform>(collider.targets[0]);
+        const Transform& paddleB = world.get<Transform>(collider.targets[1]);
+        const Vector&    sizeA   = world.get<Collider>(collider.targets[0]).size;
+        const Vector&    sizeB   = world.get<Collider>(collider.targets[1]).size;
+
+        Vector     where;
+        const bool ca = physics::collisionBallPaddle(position, radius, paddleA.position, sizeA, where);
+        const bool cb = physics::collisionBallPaddle(position, radius, paddleB.position, sizeB, where);
+        if (!ca && !cb)
+        {
+            continue;
+        }
+
+        Scalar rDist = Scalar(0);
+        collider.hit = true;
+
+        if (ca)
+        {
+            position.x = paddleA.position.x - sizeA.x * Scalar(0.5f) - radius;
+            rDist      = (where.y - paddleA.position.y) / (sizeA.y * Scalar(0.5f));
+        }
+
+        if (cb)
+        {
+            position.x = paddleB.position.x + sizeB.x * Scalar(0.5f) + radius;
+            rDist      = (where.y - paddleB.position.y) / (sizeB.y * Scalar(0.5f));
+        }
+
+        speed = physics::bounce(speed, rDist);
+    }
+}
+
+void ScoreSystem::update(World& world, [[maybe_unused]] const TimeDuration dt)
+{
+    auto&      scores   = world.components<Score>();
+    const auto entities = scores.entities();
+    const auto items    = scores.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        Score& score = items[i];
+        if (score.finished)
+        {
+            continue;
+        }
+
+        ++score.ticks;
+
+        Collider& ball = world.get<Collider>(score.ball);
+        if (ball.exit == Collider::Exit::None)
+        {
+            continue;
+        }
+
+        const bool pointA = ball.exit == Collider::Exit::Left;
+        if (pointA) { ++score.scoreA; }
+        else        { ++score.scoreB; }
+        // The match stops moving when a player wins.
+        if (score.scoreA >= Game::MaxPoints || score.scoreB >= Game::MaxPoints)
+        {
+            score.finished = true;
+
+            for (const EntityId entity : {score.paddleA, score.paddleB, score.ball})
+            {
+                world.remove<Velocity>    (entity);
+                world.remove<HumanControl>(entity);
+                world.remove<AIControl>   (entity);
+            }
+            continue;
+        }
+        // Next round, as in `Game::scorePoints()`.
+        setScore(world, score.textA, score.scoreA);
+        setScore(world, score.textB, score.scoreB);
+
+        const Limits    bounds = limits(world, entities[i]);
+        const Vector&   center = world.get<Transform>(entities[i]).position;
+        const glm::vec2 table  = toVec2(center);
+
+        place(world, score.ball, toVector(table));
+        world.get<Velocity>(score.ball).speed = Vector(Scalar(pointA ? Game::InitialSpeed : -Game::InitialSpeed), Scalar(0));
+        ball.exit = Collider::Exit::None;
+
+        place(world, score.paddleA, toVector(glm::vec2{toFloat(bounds.right) - Game::PaddleMargin, table.y}));
+        place(world, score.paddleB, toVector(glm::vec2{toFloat(bounds.left)  + Game::PaddleMargin, table.y}));
+        world.get<Velocity>(score.paddleA).speed = Vector(Scalar(0), Scalar(0));
+        world.get<Velocity>(score.paddleB).speed = Vector(Scalar(0), Scalar(0));
+    }
+}
+
+void QuadSystem::draw(World& world, Renderer& renderer, const float interp)
+{
+    auto&      quads    = world.components<Quad>();
+    const auto entities = quads.entities();
+    const auto items    = quads.components();
+
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        const Transform& transform = world.get<Transform>(entities[i]);
+        const Collider&  collider  = world.get<Collider>(entities[i]);
+
+        switch (collider.shape)
+        {
+            case Collider::Shape::Bounds:
+            {
+                Table::drawLines(renderer, transform.position, collider.size);
+            }
+            break;
+
+            case Collider::Shape::Box:
+            {
+                renderer.queueQuad(interpolate(transform, interp), toVec2(collider.size), items[i].color);
+            }
+            break;
+
+            case Collider::Shape::Circle:
+            {
+                if (collider.exit == Collider::Exit::None)
+                {
+                    renderer.queueQuad(interpolate(transform, interp), glm::vec2(toFloat(collider.radius) * 2.0f), items[i].color);
+                }
+            }
+            break;
+        }
+    }
+}
+
+void TextSystem::draw(World& world, Renderer& renderer, [[maybe_unused]] const float interp)
+{
+    for (Text& text : world.components<Text>().components())
+    {
+        if (text.dirty)
+        {
+            text.dirty = false;
+            Label::layout(text.text, text.width, text.position, Label::HAlign::Center, Label::VAlign::Middle, text.quads);
+        }
+
+        for (const auto& [position, size] : text.quads)
+        {
+            renderer.queueQuad(position, size, text.color);
+        }
+    }
+}
+
+Match createMatch(World& world)
+{
+    // The layout is calculated by a table so it is bit-exact with the one of the entities.
+    const Table             table(Game::TablePosition, Game::TableSize);
+    const Game::MatchLayout layout = Game::matchLayout(table);
+
+    Match match;
+    match.table   = world.create();
+    match.textA   = world.create();
+    match.textB   = world.create();
+    match.paddleA = world.create();
+    match.paddleB = world.create();
+    match.ball    = world.create();
+    // Table.
+    world.add(match.table, Transform{table.position(), table.position()});
+    world.add(match.table, Collider{Collider::Shape::Bounds, table.size()});
+    world.add(match.table, Quad{});
+    world.add(match.table, Score{0, 0, 0, false, match.textA, match.textB, match.paddleA, match.paddleB, match.ball});
+    // Scores.
+    for (const auto& [entity, position] : {std::pair{match.textA, layout.scoreA}, std::pair{match.textB, layout.scoreB}})
+    {
+        Text text;
+        text.width    = Game::ScoreWidth;
+        text.position = position;
+        world.add(entity, std::move(text));
+        setScore(world, entity, 0);
+    }
+    // Paddles.
+    for (const auto& [entity, position] : {std::pair{match.paddleA, layout.paddleA}, std::pair{match.paddleB, layout.paddleB}})
+    {
+        world.add(entity, Transform{toVector(position), toVector(position)});
+        world.add(entity, Velocity{});
+        world.add(entity, Collider{Collider::Shape::Box, toVector(Game::PaddleSize), Scalar(0), match.table});
+        world.add(entity, Quad{});
+    }
+    // Ball, with the initial speed of `Ball`.
+    world.add(match.ball, Transform{toVector(layout.ball), toVector(layout.ball)});
+    world.add(match.ball, Velocity{Vector(Scalar(100), Scalar(0))});
+    world.add(match.ball, Collider{Collider::Shape::Circle, Vector(Scalar(0), Scalar(0)), Scalar(Game::BallRadius), match.table, {match.paddleA, match.paddleB}});
+    world.add(match.ball, Quad{});
+
+    return match;
+}
+
+} // namespace pong::ecs
@@ -0,0 +1,172 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "World.hpp"
+#include "Time.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace pong {
+class Renderer;
+}
+
+namespace pong::ecs {
+
+/**
+ * @brief Moves the paddles controlled by a type of control component.
+ *
+ * There is one specialization per control component, so every kind of control has its own loop over its own array.
+ * @tparam Control Type of the control component.
+ */
+template<typename Control>
+struct ControlSystem;
+
+/**
+ * @brief Moves the paddles controlled by players, as `ControllerHuman` does.
+ */
+template<>
+struct ControlSystem<HumanControl>
+{
+    static void update(World& world, TimeDuration dt);
+};
+
+/**
+ * @brief Moves the paddles controlled by the AI, as `ControllerAI` does.
+ */
+template<>
+struct ControlSystem<AIControl>
+{
+    static void update(World& world, TimeDuration dt);
+};
+
+/**
+ * @brief Moves the boxes (paddles) and keeps them inside their bounds, as `Paddle::update()` does.
+ */
+struct PaddleSystem
+{
+    static void update(World& world, TimeDuration dt);
+};
+
+/**
+ * @brief Moves the circles (balls) and bounces them off the walls and the paddles, as `Ball::update()` does with the
+ * discrete collision detection.
+ */
+struct BallSystem
+{
+    static void update(World& world, TimeDuration dt);
+};
+
+/**
+ * @brief Counts the points of the matches and starts the next round, as `Game::update()` does when the kickoff prompt
+ * is accepted at once. A match stops moving when a player wins.
+ */
+struct ScoreSystem
+{
+    static void update(World& world, TimeDuration dt);
+};
+
+/**
+ * @brief Draws the tables, the paddles and the balls.
+ */
+struct QuadSystem
+{
+    static void draw(World& world, Renderer& renderer, float interp);
+};
+
+/**
+ * @brief Draws the texts, calculating their quads when they change.
+ */
+struct TextSystem
+{
+    static void draw(World& world, Renderer& renderer, float interp);
+};
+
+/**
+ * @brief Defines the entities of a match.
+ */
+struct Match
+{
+    EntityId table   = NoEntity;
+    EntityId textA   = NoEntity;
+    EntityId textB   = NoEntity;
+    EntityId paddleA = NoEntity;
+    EntityId paddleB = NoEntity;
+    EntityId ball    = NoEntity;
+};
+
+/**
+ * @brief Adds a match to a world, with the same layout and initial state as `Game::setupMatch()`.
+ * @param world World.
+ * @param controlA Control of the paddle of player A (right).
+ * @param controlB Control of the paddle of player B (left).
+ * @return The entities of the match.
+ */
+template<typename ControlA, typename ControlB>
+Match addMatch(World& world, ControlA controlA, ControlB controlB);
+
+/**
+ * @brief Updates all the matches of a world by a tick.
+ * @param world World.
+ * @param dt The time elapsed since the last update (delta time).
+ */
+inline void update(World& world, const TimeDuration dt)
+{
+    world.update<ControlSystem<HumanControl>, ControlSystem<AIControl>, PaddleSystem, BallSystem, ScoreSystem>(dt);
+}
+
+/**
+ * @brief Draws all the matches of a world.
+ * @param world World.
+ * @param renderer Renderer.
+ * @param interp Interpolation value.
+ */
+inline void draw(World& world, Renderer& renderer, const float interp)
+{
+    world.draw<QuadSystem, TextSystem>(renderer, interp);
+}
+
+/**
+ * @brief Creates the entities of a match, without the controls of the paddles.
+ * @param world World.
+ * @return The entities of the match.
+ */
+Match createMatch(World& world);
+
+template<typename ControlA, typename ControlB>
+Match addMatch(World& world, ControlA controlA, ControlB controlB)
+{
+    const Match match = createMatch(world);
+    // The AI follows the ball of its match.
+    if constexpr (std::is_same_v<ControlA, AIControl>) { controlA.ball = match.ball; }
+    if constexpr (std::is_same_v<ControlB, AIControl>) { controlB.ball = match.ball; }
+
+    world.add(match.paddleA, std::move(controlA));
+    world.add(match.paddleB, std::move(controlB));
+
+    return match;
+}
+
+} // namespace pong::ecs
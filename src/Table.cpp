@@ -38,16 +38,28 @@ constexpr glm::vec4 LineColor = {1.0f, 1.0f, 1.0f, 1.0f};
 
 Table::Table(const glm::vec2& position, const glm::vec2& size) noexcept
     :
-    Entity(Type::Table), mPosition(position), mSize(size)
+    Entity(Type::Table), mPosition(toVector(position)), mSize(toVector(size))
 {}
 
 void Table::draw(Renderer& renderer, const float interp)
 {
-    renderer.queueQuad({mPosition.x, top()},       {mSize.x, LineWidth}, LineColor);
-    renderer.queueQuad({mPosition.x, bottom()},    {mSize.x, LineWidth}, LineColor);
-    renderer.queueQuad({left(),      mPosition.y}, {LineWidth, mSize.y}, LineColor);
-    renderer.queueQuad({right(),     mPosition.y}, {LineWidth, mSize.y}, LineColor);
-    renderer.queueQuad(mPosition,                  {LineWidth, mSize.y}, LineColor);
+    mMesh.draw(renderer, [this](Renderer& r) { drawLines(r, mPosition, mSize); });
+}
+
+void Table::drawLines(Renderer& renderer, const Vector& position, const Vector& size)
+{
+    const glm::vec2 center = toVec2(position);
+    const glm::vec2 extent = toVec2(size);
+    const float     top    = toFloat(position.y + size.y * Scalar(0.5f));
+    const float     bottom = toFloat(position.y - size.y * Scalar(0.5f));
+    const float     left   = toFloat(position.x - size.x * Scalar(0.5f));
+    const float     right  = toFloat(position.x + size.x * Scalar(0.5f));
+
+    renderer.queueQuad({center.x, top},    {extent.x, LineWidth}, LineColor);
+    renderer.queueQuad({center.x, bottom}, {extent.x, LineWidth}, LineColor);
+    renderer.queueQuad({left,     center.y}, {LineWidth, extent.y}, LineColor);
+    renderer.queueQuad({right,    center.y}, {LineWidth, extent.y}, LineColor);
+    renderer.queueQuad(center,               {LineWidth, extent.y}, LineColor);
 }
 
 } // namespace pong
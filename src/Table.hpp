@@ -25,6 +25,8 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "Scalar.hpp"
+#include "StaticMesh.hpp"
 #include <glm/glm.hpp>
 
 namespace pong {
@@ -33,7 +35,8 @@ namespace pong {
  * @brief Defines the game table, including its boundaries and visual representation.
  *
  * This entity is typically static and provides the limits for gameplay. It renders itself as a border and a center
- * line.
+ * line, recorded once as a static mesh of the renderer. The limits use the `Scalar` type of the gameplay state (fixed
+ * point when `PONG_FIXED_POINT` is defined).
  */
 class Table final : public Entity
 {
@@ -49,42 +52,53 @@ public:
     /**
      * @return Position.
      */
-    [[nodiscard]] const glm::vec2& position() const noexcept { return mPosition; }
+    [[nodiscard]] const Vector& position() const noexcept { return mPosition; }
 
     /**
      * @return Size.
      */
-    [[nodiscard]] const glm::vec2& size() const noexcept { return mSize; }
+    [[nodiscard]] const Vector& size() const noexcept { return mSize; }
 
     /**
      * @return Left limit.
      */
-    [[nodiscard]] float left() const noexcept { return mPosition.x - mSize.x * 0.5f; }
+    [[nodiscard]] Scalar left() const noexcept { return mPosition.x - mSize.x * Scalar(0.5f); }
 
     /**
      * @return Right limit.
      */
-    [[nodiscard]] float right() const noexcept { return mPosition.x + mSize.x * 0.5f; }
+    [[nodiscard]] Scalar right() const noexcept { return mPosition.x + mSize.x * Scalar(0.5f); }
 
     /**
      * @return Top limit.
      */
-    [[nodiscard]] float top() const noexcept { return mPosition.y + mSize.y * 0.5f; }
+    [[nodiscard]] Scalar top() const noexcept { return mPosition.y + mSize.y * Scalar(0.5f); }
 
     /**
      * @return Bottom limit.
      */
-    [[nodiscard]] float bottom() const noexcept { return mPosition.y - mSize.y * 0.5f; }
+    [[nodiscard]] Scalar bottom() const noexcept { return mPosition.y - mSize.y * Scalar(0.5f); }
 
     void draw(Renderer& renderer, float interp) override;
 
+    /**
+     * @brief Draws the lines of a table: its bounds and the center line.
+     * @param renderer Renderer.
+     * @param position The center position of the table.
+     * @param size The total width and height of the table.
+     */
+    static void drawLines(Renderer& renderer, const Vector& position, const Vector& size);
+
 private:
 
     /** @brief Position. */
-    glm::vec2 mPosition;
+    Vector mPosition;
 
     /** @brief Size. */
-    glm::vec2 mSize;
+    Vector mSize;
+
+    /** @brief Mesh of the lines. */
+    StaticMesh mMesh;
 };
 
 ////////////////////////////////////////////////////////////
@@ -0,0 +1,206 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "TimerWheel.hpp"
+#include <algorithm>
+
+namespace pong {
+
+TimerWheel::TimerWheel() noexcept
+{
+    mSlots.fill(None);
+}
+
+TimerWheel::Timer TimerWheel::schedule(std::uint64_t deadline, Callback callback, void* context)
+{
+    // Take a node from the free list, or grow the pool.
+    std::uint32_t index = mFree;
+    if (index != None)
+    {
+        mFree = mNodes[index].next;
+    }
+    else
+    {
+        if (mNodes.size() > Timer::MaxIndex)
+        {
+            return {};
+        }
+        index = static_cast<std::uint32_t>(mNodes.size());
+        mNodes.emplace_back();
+    }
+    // Fill the timer and push it to the slot of its deadline.
+    Node& node    = mNodes[index];
+    node.deadline = std::max(deadline, mNow + 1);
+    node.callback = callback;
+    node.context  = context;
+    link(index);
+    ++mSize;
+    return {index, node.generation};
+}
+
+bool TimerWheel::cancel(Timer timer) noexcept
+{
+    const std::uint32_t index = find(timer);
+    if (index == None)
+    {
+        return false;
+    }
+    // The node stays in its slot until the slot is reached, without its callback.
+    Node& node    = mNodes[index];
+    node.callback = nullptr;
+    invalidate(node);
+    --mSize;
+    return true;
+}
+
+std::uint64_t TimerWheel::deadline(Timer timer) const noexcept
+{
+    const std::uint32_t index = find(timer);
+    return index != None ? mNodes[index].deadline : 0;
+}
+
+std::size_t TimerWheel::advance()
+{
+    ++mNow;
+    // When a level completes a turn, move the timers of the next slot of the level above down.
+    if ((mNow & (Slots - 1)) == 0)
+    {
+        for (std::uint32_t level = 1; level < Levels; ++level)
+        {
+            if ((mNow & ((std::uint64_t(1) << (SlotBits * level)) - 1)) != 0)
+            {
+                break;
+            }
+            cascade(level * Slots + static_cast<std::uint32_t>((mNow >> (SlotBits * level)) & (Slots - 1)));
+        }
+    }
+    // Expire the timers of the current slot of the first level, one at a time since the callbacks can cancel the
+    // others.
+    std::uint32_t& slot = mSlots[mNow & (Slots - 1)];
+    std::size_t expired = 0;
+    while (slot != None)
+    {
+        const std::uint32_t index = slot;
+        Node& node                = mNodes[index];
+        const Callback callback   = node.callback;
+        void* const context       = node.context;
+        slot                      = node.next;
+        release(index);
+        if (callback)
+        {
+            invalidate(node);
+            --mSize;
+            callback(context);
+            ++expired;
+        }
+    }
+    return expired;
+}
+
+void TimerWheel::clear() noexcept
+{
+    for (std::uint32_t& slot : mSlots)
+    {
+        while (slot != None)
+        {
+            const std::uint32_t index = slot;
+            Node& node                = mNodes[index];
+            slot                      = node.next;
+            if (node.callback)
+            {
+                invalidate(node);
+            }
+            release(index);
+        }
+    }
+    mSize = 0;
+}
+
+std::uint32_t TimerWheel::find(Timer timer) const noexcept
+{
+    if (!timer || timer.index() >= mNodes.size())
+    {
+        return None;
+    }
+    const Node& node = mNodes[timer.index()];
+    return node.callback && node.generation == timer.generation() ? timer.index() : None;
+}
+
+void TimerWheel::link(std::uint32_t index) noexcept
+{
+    // Find the lowest level whose range holds the deadline, clamping the deadlines beyond the wheel.
+    Node& node                = mNodes[index];
+    const std::uint64_t delta = std::min(node.deadline - mNow, Range - 1);
+    const std::uint64_t tick  = mNow + delta;
+    std::uint32_t level       = 0;
+    while (level + 1 < Levels && delta >= (std::uint64_t(1) << (SlotBits * (level + 1))))
+    {
+        ++level;
+    }
+    // Push the node at the front of the slot.
+    std::uint32_t& slot = mSlots[level * Slots + static_cast<std::uint32_t>((tick >> (SlotBits * level)) & (Slots - 1))];
+    node.next           = slot;
+    slot                = index;
+}
+
+void TimerWheel::release(std::uint32_t index) noexcept
+{
+    Node& node    = mNodes[index];
+    node.callback = nullptr;
+    node.next     = mFree;
+    mFree         = index;
+}
+
+void TimerWheel::invalidate(Node& node) noexcept
+{
+    // Skip the null generation so that handles of the node are never null.
+    node.generation = (node.generation + 1) & Timer::GenerationMask;
+    if (node.generation == 0)
+    {
+        node.generation = 1;
+    }
+}
+
+void TimerWheel::cascade(std::uint32_t slot) noexcept
+{
+    // Detach the whole list first, the timers beyond the range of the wheel can land in the same slot again, and free
+    // the cancelled timers on the way.
+    std::uint32_t index = mSlots[slot];
+    mSlots[slot]        = None;
+    while (index != None)
+    {
+        const std::uint32_t next = mNodes[index].next;
+        if (mNodes[index].callback)
+        {
+            link(index);
+        }
+        else
+        {
+            release(index);
+        }
+        index = next;
+    }
+}
+
+} // namespace pong
@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Handle.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pong {
+
+/**
+ * @brief Defines a hierarchical timer wheel that calls functions at given ticks.
+ *
+ * The wheel has four levels of 64 slots. The first level holds the timers that expire within the next 64 ticks, one
+ * slot per tick, and every other level holds the timers 64 times farther away, with a slot per 64 ticks of the level
+ * below. When the first level completes a turn, the timers of the next slot of the level above are moved down, so
+ * scheduling, cancelling and expiring a timer cost a constant time, and the ticks without timers cost nothing but
+ * advancing the wheel. The timers farther away than the range of the wheel (2^24 ticks) wait in its last level until
+ * they get within range.
+ *
+ * The timers are stored in a pool and identified by generational handles, so cancelling a timer that already expired
+ * or was cancelled does nothing. The slots are singly linked lists: a cancelled timer only loses its callback and its
+ * node returns to the pool when its slot is reached, so scheduling and expiring a timer touch no other timer.
+ */
+class TimerWheel
+{
+public:
+
+    /** @brief Defines the function called when a timer expires. */
+    using Callback = void (*)(void* context);
+
+    /** @brief Defines the handle of a timer. */
+    using Timer = Handle<TimerWheel>;
+
+    /** @brief Number of bits of the slot of each level. */
+    static constexpr std::uint32_t SlotBits = 6;
+
+    /** @brief Number of slots of each level. */
+    static constexpr std::uint32_t Slots = 1u << SlotBits;
+
+    /** @brief Number of levels. */
+    static constexpr std::uint32_t Levels = 4;
+
+    /** @brief Number of ticks covered by the wheel. */
+    static constexpr std::uint64_t Range = std::uint64_t(1) << (SlotBits * Levels);
+
+    /**
+     * @brief Constructor.
+     */
+    TimerWheel() noexcept;
+
+    /**
+     * @brief Gets the current tick.
+     * @return Number of ticks advanced.
+     */
+    [[nodiscard]] std::uint64_t now() const noexcept { return mNow; }
+
+    /**
+     * @brief Gets the number of scheduled timers.
+     * @return Number of timers.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mSize; }
+
+    /**
+     * @brief Schedules a timer.
+     * @param deadline Tick at which the timer expires, the timers at or before the current tick expire in the next one.
+     * @param callback Function to call when the timer expires.
+     * @param context Argument of the function.
+     * @return The handle of the timer, null if the wheel already has `Timer::MaxIndex + 1` timers.
+     */
+    Timer schedule(std::uint64_t deadline, Callback callback, void* context);
+
+    /**
+     * @brief Cancels a timer.
+     * @param timer Handle of the timer.
+     * @return True if the timer was cancelled, false if it already expired or was cancelled.
+     */
+    bool cancel(Timer timer) noexcept;
+
+    /**
+     * @brief Gets the deadline of a timer.
+     * @param timer Handle of the timer.
+     * @return The tick at which the timer expires, or zero if it already expired or was cancelled.
+     */
+    [[nodiscard]] std::uint64_t deadline(Timer timer) const noexcept;
+
+    /**
+     * @brief Advances the wheel a tick and calls the functions of the timers that expire in it.
+     *
+     * The functions can schedule and cancel timers, the ones they schedule expire in later ticks.
+     * @return Number of timers that expired.
+     */
+    std::size_t advance();
+
+    /**
+     * @brief Cancels all the timers, keeping the current tick and the memory of the pool.
+     */
+    void clear() noexcept;
+
+private:
+
+    /** @brief Defines a timer of the pool. */
+    struct Node
+    {
+        /** @brief Tick at which the timer expires. */
+        std::uint64_t deadline = 0;
+
+        /** @brief Function to call when the timer expires, null if the timer was cancelled or the node is free. */
+        Callback callback = nullptr;
+
+        /** @brief Argument of the function. */
+        void* context = nullptr;
+
+        /** @brief Next timer of the slot, or of the free list. */
+        std::uint32_t next = None;
+
+        /** @brief Generation of the node, never zero. */
+        std::uint32_t generation = 1;
+    };
+
+    /** @brief Index of no node. */
+    static constexpr std::uint32_t None = UINT32_MAX;
+
+    /**
+     * @brief Gets the node of a timer.
+     * @param timer Handle of the timer.
+     * @return Index of the node, or `None` if the timer is not scheduled.
+     */
+    [[nodiscard]] std::uint32_t find(Timer timer) const noexcept;
+
+    /**
+     * @brief Links a node to the slot of its deadline.
+     * @param index Index of the node.
+     */
+    void link(std::uint32_t index) noexcept;
+
+    /**
+     * @brief Returns a node, already out of its slot, to the free list.
+     * @param index Index of the node.
+     */
+    void release(std::uint32_t index) noexcept;
+
+    /**
+     * @brief Invalidates the handles of a node.
+     * @param node Node.
+     */
+    static void invalidate(Node& node) noexcept;
+
+    /**
+     * @brief Moves the timers of a slot to the slots of their deadlines, in the lower levels, and frees the cancelled ones.
+     * @param slot Slot.
+     */
+    void cascade(std::uint32_t slot) noexcept;
+
+private:
+
+    /** @brief Pool of timers. */
+    std::vector<Node> mNodes;
+
+    /** @brief First timer of every slot, level by level. */
+    std::array<std::uint32_t, Slots * Levels> mSlots;
+
+    /** @brief First node of the free list. */
+    std::uint32_t mFree = None;
+
+    /** @brief Number of scheduled timers. */
+    std::size_t mSize = 0;
+
+    /** @brief Current tick. */
+    std::uint64_t mNow = 0;
+};
+
+} // namespace pong
@@ -0,0 +1,303 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Tournament.hpp"
+#include "Game.hpp"
+#include "Event.hpp"
+#include "RealTimeClock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace pong {
+namespace {
+
+/** @brief Size of a cache line, the data written by each thread is aligned to it to avoid false sharing. */
+constexpr std::size_t CacheLine = 64;
+
+/**
+ * @brief Range [begin, end) of pending matches of a thread, packed in a single atomic with `begin` in the high half.
+ *
+ * The ranges only hold indices, the matches themselves are immutable, so relaxed ordering is enough.
+ */
+struct alignas(CacheLine) WorkRange
+{
+    std::atomic<std::uint64_t> range{0};
+};
+
+/**
+ * @brief Packs a range.
+ * @param begin First match.
+ * @param end Last match plus one.
+ * @return Packed range.
+ */
+constexpr std::uint64_t pack(const std::uint64_t begin, const std::uint64_t end)
+{
+    return (begin << 32) | end;
+}
+
+/**
+ * @brief Takes the match at the front of a range, only called by the thread that owns the range.
+ * @param work Range.
+ * @param match Match taken.
+ * @return True if a match was taken, false if the range is empty.
+ */
+bool pop(WorkRange& work, long long& match)
+{
+    std::uint64_t range = work.range.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const std::uint64_t begin = range >> 32;
+        const std::uint64_t end   = range & 0xFFFFFFFFu;
+        if (begin >= end)
+        {
+            return false;
+        }
+        if (work.range.compare_exchange_weak(range, pack(begin + 1, end), std::memory_order_relaxed))
+        {
+            match = static_cast<long long>(begin);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Steals the back half of the range of another thread.
+ *
+ * It is only called when the range of the thief is empty, so nobody else can be changing it.
+ * @param victim Range to steal from.
+ * @param work Range of the thief.
+ * @return True if some matches were stolen, false if the range of the victim is empty.
+ */
+bool steal(WorkRange& victim, WorkRange& work)
+{
+    std::uint64_t range = victim.range.load(std::memory_order_relaxed);
+    while (true)
+    {
+        const std::uint64_t begin = range >> 32;
+        const std::uint64_t end   = range & 0xFFFFFFFFu;
+        if (begin >= end)
+        {
+            return false;
+        }
+        const std::uint64_t middle = begin + (end - begin) / 2;
+        if (victim.range.compare_exchange_weak(range, pack(begin, middle), std::memory_order_relaxed))
+        {
+            work.range.store(pack(middle, end), std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Mixes the bits of a value (SplitMix64), used to derive the seeds of every match.
+ * @param value Value.
+ * @return Mixed value.
+ */
+constexpr std::uint64_t mix(std::uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15u;
+    value  = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9u;
+    value  = (value ^ (value >> 27)) * 0x94D049BB133111EBu;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+struct alignas(CacheLine) Tournament::Counters
+{
+    /** @brief Results of every entrant (without names). */
+    std::vector<Standing> standings;
+
+    /** @brief Number of matches played. */
+    long long matches = 0;
+
+    /** @brief Number of matches that reached the tick limit without a winner. */
+    long long unfinished = 0;
+
+    /** @brief Number of ticks simulated. */
+    long long ticks = 0;
+
+    /** @brief Number of ranges stolen. */
+    long long steals = 0;
+};
+
+Tournament::Tournament(std::vector<Entrant> entrants, const int rounds, const std::uint64_t seed, const long long maxTicks)
+    :
+    mEntrants(std::move(entrants)),
+    mRounds  (rounds),
+    mSeed    (seed),
+    mMaxTicks(maxTicks)
+{}
+
+long long Tournament::matches() const noexcept
+{
+    const auto count = static_cast<long long>(mEntrants.size());
+    return count * (count - 1) * mRounds;
+}
+
+Tournament::Report Tournament::run(int threads) const
+{
+    const long long total = matches();
+
+    if (threads <= 0)
+    {
+        threads = defaultThreads();
+    }
+    threads = static_cast<int>(std::max<long long>(1, std::min<long long>(threads, total)));
+
+    std::vector<WorkRange> work    (static_cast<std::size_t>(threads));
+    std::vector<Counters>  counters(static_cast<std::size_t>(threads));
+    // Split the matches in one range per thread.
+    for (int t = 0; t < threads; ++t)
+    {
+        work[t].range.store(pack(static_cast<std::uint64_t>(total * t / threads), static_cast<std::uint64_t>(total * (t + 1) / threads)));
+        counters[t].standings.resize(mEntrants.size());
+    }
+
+    RealTimeClock clock;
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(static_cast<std::size_t>(threads));
+
+        for (int t = 0; t < threads; ++t)
+        {
+            pool.emplace_back([this, t, threads, &work, &counters]
+            {
+                // Every thread plays its matches in its own game.
+                Game      game;
+                long long match = 0;
+                while (true)
+                {
+                    while (pop(work[t], match))
+                    {
+                        play(match, game, counters[t]);
+                    }
+                    // Steal from the other threads, starting with the next one.
+                    bool stolen = false;
+                    for (int i = 1; i < threads && !stolen; ++i)
+                    {
+                        stolen = steal(work[(t + i) % threads], work[t]);
+                    }
+                    if (!stolen)
+                    {
+                        break;
+                    }
+                    ++counters[t].steals;
+                }
+            });
+        }
+    }
+
+    Report report;
+    report.threads = threads;
+    report.seconds = clock.elapsed().count();
+    report.standings.resize(mEntrants.size());
+    // Add up the results of every thread.
+    for (std::size_t i = 0; i < mEntrants.size(); ++i)
+    {
+        Standing& standing = report.standings[i];
+        standing.name = mEntrants[i].name;
+
+        for (const Counters& counter : counters)
+        {
+            standing.matches       += counter.standings[i].matches;
+            standing.wins          += counter.standings[i].wins;
+            standing.pointsFor     += counter.standings[i].pointsFor;
+            standing.pointsAgainst += counter.standings[i].pointsAgainst;
+        }
+    }
+
+    for (const Counters& counter : counters)
+    {
+        report.matches    += counter.matches;
+        report.unfinished += counter.unfinished;
+        report.ticks      += counter.ticks;
+        report.steals     += counter.steals;
+    }
+
+    return report;
+}
+
+int Tournament::defaultThreads() noexcept
+{
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+void Tournament::play(const long long match, Game& game, Counters& counters) const
+{
+    // Find the entrants of the match, every ordered pair plays a match per round.
+    const auto      count = static_cast<long long>(mEntrants.size());
+    const long long pair  = match % (count * (count - 1));
+    const auto      a     = static_cast<std::size_t>(pair / (count - 1));
+    auto            b     = static_cast<std::size_t>(pair % (count - 1));
+    if (b >= a)
+    {
+        ++b;
+    }
+    // The seeds only depend on the match, not on the thread that plays it.
+    const std::uint64_t seed = mix(mSeed ^ mix(static_cast<std::uint64_t>(match)));
+
+    game.startMatch(std::make_unique<ControllerAI>(mEntrants[a].settings, static_cast<std::uint32_t>(seed)),
+                    std::make_unique<ControllerAI>(mEntrants[b].settings, static_cast<std::uint32_t>(seed >> 32)));
+
+    long long tick = 0;
+    for (; tick < mMaxTicks && game.state() != Game::State::Win; ++tick)
+    {
+        // The kickoff prompt is accepted right away.
+        if (game.state() == Game::State::Kickoff)
+        {
+            game.handle(Event{Event::Type::Next});
+        }
+        game.update(Game::TickTime);
+    }
+
+    Standing& standingA = counters.standings[a];
+    Standing& standingB = counters.standings[b];
+    ++standingA.matches;
+    ++standingB.matches;
+    standingA.pointsFor     += game.scoreA();
+    standingA.pointsAgainst += game.scoreB();
+    standingB.pointsFor     += game.scoreB();
+    standingB.pointsAgainst += game.scoreA();
+
+    if (game.state() != Game::State::Win)
+    {
+        ++counters.unfinished;
+    }
+    else if (game.scoreA() > game.scoreB())
+    {
+        ++standingA.wins;
+    }
+    else
+    {
+        ++standingB.wins;
+    }
+
+    ++counters.matches;
+    counters.ticks += tick;
+}
+
+} // namespace pong
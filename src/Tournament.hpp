@@ -0,0 +1,171 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ControllerAI.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pong {
+
+class Game;
+
+/**
+ * @brief Plays a round-robin tournament between variants of the AI on a work-stealing thread pool.
+ *
+ * Every entrant plays every other entrant a number of rounds on each side of the table. The matches are independent:
+ * each one is played with its own seeds (derived from the seed of the tournament and the index of the match), and
+ * each thread plays its matches in its own `Game` and accumulates the results in its own counters, which are only
+ * added up when all the threads have finished. There is no shared mutable state but the ranges of pending matches, so
+ * the results do not depend on the number of threads or on the order the matches are played.
+ *
+ * The matches are split into one range per thread. A thread plays the matches of its range from the front, and when it
+ * runs out of them it steals the back half of the range of another thread. The ranges are single 64-bit atomics, so
+ * taking a match or stealing is a compare-and-swap.
+ */
+class Tournament
+{
+public:
+
+    /**
+     * @brief Defines an entrant of the tournament.
+     */
+    struct Entrant
+    {
+        /** @brief Name. */
+        std::string name;
+
+        /** @brief Parameters of the AI. */
+        ControllerAI::Settings settings;
+    };
+
+    /**
+     * @brief Defines the results of an entrant.
+     */
+    struct Standing
+    {
+        /** @brief Name of the entrant. */
+        std::string name;
+
+        /** @brief Number of matches played (finished or not). */
+        long long matches = 0;
+
+        /** @brief Number of matches won. */
+        long long wins = 0;
+
+        /** @brief Number of points scored. */
+        long long pointsFor = 0;
+
+        /** @brief Number of points conceded. */
+        long long pointsAgainst = 0;
+
+        bool operator==(const Standing&) const = default;
+    };
+
+    /**
+     * @brief Defines the report of a tournament.
+     */
+    struct Report
+    {
+        /** @brief Results of every entrant, in the order of the entrants. */
+        std::vector<Standing> standings;
+
+        /** @brief Number of threads used. */
+        int threads = 0;
+
+        /** @brief Number of matches played. */
+        long long matches = 0;
+
+        /** @brief Number of matches that reached the tick limit without a winner. */
+        long long unfinished = 0;
+
+        /** @brief Number of ticks simulated. */
+        long long ticks = 0;
+
+        /** @brief Number of ranges stolen by the threads. */
+        long long steals = 0;
+
+        /** @brief Wall time, in seconds. */
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Constructor.
+     * @param entrants Entrants (at least two).
+     * @param rounds Number of matches between every pair of entrants on each side of the table.
+     * @param seed Seed of the tournament.
+     * @param maxTicks Maximum number of ticks per match.
+     */
+    Tournament(std::vector<Entrant> entrants, int rounds, std::uint64_t seed, long long maxTicks);
+
+    /**
+     * @brief Gets the number of matches of the tournament.
+     * @return Number of matches.
+     */
+    [[nodiscard]] long long matches() const noexcept;
+
+    /**
+     * @brief Plays the whole tournament.
+     * @param threads Number of threads, zero to use one per hardware thread.
+     * @return Report.
+     */
+    [[nodiscard]] Report run(int threads) const;
+
+    /**
+     * @brief Gets the number of threads used by default, one per hardware thread.
+     * @return Number of threads.
+     */
+    [[nodiscard]] static int defaultThreads() noexcept;
+
+private:
+
+    /** @brief Results accumulated by a thread. */
+    struct Counters;
+
+    /**
+     * @brief Plays a match of the tournament.
+     * @param match Index of the match.
+     * @param game Game of the thread.
+     * @param counters Counters of the thread.
+     */
+    void play(long long match, Game& game, Counters& counters) const;
+
+private:
+
+    /** @brief Entrants. */
+    std::vector<Entrant> mEntrants;
+
+    /** @brief Number of matches between every pair of entrants on each side of the table. */
+    int mRounds;
+
+    /** @brief Seed of the tournament. */
+    std::uint64_t mSeed;
+
+    /** @brief Maximum number of ticks per match. */
+    long long mMaxTicks;
+};
+
+} // namespace pong
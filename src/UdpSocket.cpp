@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "UdpSocket.hpp"
+#include <charconv>
+
+#ifdef _WIN32
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <arpa/inet.h>
+#   include <fcntl.h>
+#   include <netinet/in.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+namespace pong {
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+using SocketLength = int;
+constexpr SocketHandle InvalidSocket = INVALID_SOCKET;
+#else
+using SocketHandle = int;
+using SocketLength = socklen_t;
+constexpr SocketHandle InvalidSocket = -1;
+#endif
+
+/**
+ * @brief Closes a socket.
+ * @param handle Handle.
+ */
+void closeSocket(const SocketHandle handle)
+{
+#ifdef _WIN32
+    closesocket(handle);
+    WSACleanup();
+#else
+    close(handle);
+#endif
+}
+
+/**
+ * @brief Converts an address into a socket address.
+ * @param address Address.
+ * @return Socket address.
+ */
+sockaddr_in toSocketAddress(const UdpAddress& address)
+{
+    sockaddr_in result{};
+    result.sin_family      = AF_INET;
+    result.sin_addr.s_addr = htonl(address.host);
+    result.sin_port        = htons(address.port);
+    return result;
+}
+
+} // namespace
+
+std::optional<UdpAddress> UdpAddress::parse(const std::string_view text)
+{
+    UdpAddress  address;
+    const char* current = text.data();
+    const char* end     = text.data() + text.size();
+    // Parse the four numbers of the address, separated by dots and followed by a colon.
+    for (int i = 0; i < 4; ++i)
+    {
+        unsigned int value = 0;
+        const auto [ptr, ec] = std::from_chars(current, end, value);
+        if (ec != std::errc{} || value > 255 || ptr == end || *ptr != (i < 3 ? '.' : ':'))
+        {
+            return std::nullopt;
+        }
+
+        address.host = address.host << 8 | value;
+        current      = ptr + 1;
+    }
+    // Parse the port.
+    unsigned int port = 0;
+    const auto [ptr, ec] = std::from_chars(current, end, port);
+    if (ec != std::errc{} || ptr != end || port == 0 || port > 65535)
+    {
+        return std::nullopt;
+    }
+
+    address.port = static_cast<std::uint16_t>(port);
+    return address;
+}
+
+std::string UdpAddress::toString() const
+{
+    return std::to_string(host >> 24 & 0xFF) + "." + std::to_string(host >> 16 & 0xFF) + "." +
+           std::to_string(host >>  8 & 0xFF) + "." + std::to_string(host       & 0xFF) + ":" + std::to_string(port);
+}
+
+std::unique_ptr<UdpSocket> UdpSocket::create(const std::uint16_t port)
+{
+#ifdef _WIN32
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+    {
+        return nullptr;
+    }
+#endif
+    // Try to open the socket.
+    const SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (handle == InvalidSocket)
+    {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return nullptr;
+    }
+    // Try to make it non-blocking and to bind it.
+#ifdef _WIN32
+    u_long     nonBlocking = 1;
+    const bool configured  = ioctlsocket(handle, FIONBIO, &nonBlocking) == 0;
+#else
+    const bool configured  = fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+    sockaddr_in address = toSocketAddress(UdpAddress{INADDR_ANY, port});
+    if (!configured || bind(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        closeSocket(handle);
+        return nullptr;
+    }
+    // Get the port chosen by the system.
+    SocketLength length = sizeof(address);
+    if (getsockname(handle, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+    {
+        closeSocket(handle);
+        return nullptr;
+    }
+
+    auto udpSocket = std::unique_ptr<UdpSocket>(new UdpSocket{});
+    udpSocket->mHandle = static_cast<std::intptr_t>(handle);
+    udpSocket->mPort   = ntohs(address.sin_port);
+    return udpSocket;
+}
+
+UdpSocket::~UdpSocket()
+{
+    closeSocket(static_cast<SocketHandle>(mHandle));
+}
+
+bool UdpSocket::send(const UdpAddress& to, const std::span<const std::uint8_t> data)
+{
+    const sockaddr_in address = toSocketAddress(to);
+    const auto        sent    = sendto(static_cast<SocketHandle>(mHandle), reinterpret_cast<const char*>(data.data()),
+                                       static_cast<int>(data.size()), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    return sent >= 0 && static_cast<std::size_t>(sent) == data.size();
+}
+
+std::size_t UdpSocket::receive(const std::span<std::uint8_t> buffer, UdpAddress& from)
+{
+    sockaddr_in  address{};
+    SocketLength length   = sizeof(address);
+    const auto   received = recvfrom(static_cast<SocketHandle>(mHandle), reinterpret_cast<char*>(buffer.data()),
+                                     static_cast<int>(buffer.size()), 0, reinterpret_cast<sockaddr*>(&address), &length);
+    // Nothing pending, or an error (e.g. a port unreachable notification on Windows).
+    if (received <= 0)
+    {
+        return 0;
+    }
+
+    from.host = ntohl(address.sin_addr.s_addr);
+    from.port = ntohs(address.sin_port);
+    return static_cast<std::size_t>(received);
+}
+
+} // namespace pong
@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace pong {
+
+/**
+ * @brief Defines an IPv4 address and port.
+ */
+struct UdpAddress
+{
+    /** @brief Address, in host byte order. */
+    std::uint32_t host = 0;
+
+    /** @brief Port. */
+    std::uint16_t port = 0;
+
+    /**
+     * @brief Parses an address in the form "a.b.c.d:port" (no name resolution).
+     * @param text Text to parse.
+     * @return Address, or nothing if the text is not a valid address.
+     */
+    [[nodiscard]] static std::optional<UdpAddress> parse(std::string_view text);
+
+    /**
+     * @brief Gets the address as text, in the form "a.b.c.d:port".
+     * @return Text.
+     */
+    [[nodiscard]] std::string toString() const;
+
+    bool operator==(const UdpAddress&) const = default;
+};
+
+/**
+ * @brief Defines a non-blocking UDP socket.
+ *
+ * It must be created via the static `create()` factory function, which returns a null pointer if the socket cannot be
+ * opened or bound.
+ */
+class UdpSocket
+{
+public:
+
+    /**
+     * @brief Opens a socket bound to a port of all the local interfaces.
+     * @param port Port, zero to let the system choose one.
+     * @return A unique pointer on success, null on failure.
+     */
+    [[nodiscard]] static std::unique_ptr<UdpSocket> create(std::uint16_t port);
+
+    UdpSocket(const UdpSocket&) = delete;
+
+    UdpSocket(UdpSocket&&) = delete;
+
+    UdpSocket& operator=(const UdpSocket&) = delete;
+
+    UdpSocket& operator=(UdpSocket&&) = delete;
+
+    /**
+     * @brief Destructor, it closes the socket.
+     */
+    ~UdpSocket();
+
+    /**
+     * @brief Gets the port the socket is bound to.
+     * @return Port.
+     */
+    [[nodiscard]] std::uint16_t port() const noexcept { return mPort; }
+
+    /**
+     * @brief Sends a datagram.
+     * @param to Destination.
+     * @param data Data.
+     * @return True if the datagram was sent (not necessarily received), false otherwise.
+     */
+    bool send(const UdpAddress& to, std::span<const std::uint8_t> data);
+
+    /**
+     * @brief Receives a datagram, without blocking.
+     * @param buffer Buffer, a longer datagram is truncated.
+     * @param from Variable where the source of the datagram is stored.
+     * @return Size of the datagram, zero if there are no datagrams pending.
+     */
+    std::size_t receive(std::span<std::uint8_t> buffer, UdpAddress& from);
+
+private:
+
+    UdpSocket() = default;
+
+private:
+
+    /** @brief Handle of the socket (a file descriptor or a `SOCKET`). */
+    std::intptr_t mHandle = -1;
+
+    /** @brief Port the socket is bound to. */
+    std::uint16_t mPort = 0;
+};
+
+} // namespace pong
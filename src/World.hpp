@@ -0,0 +1,455 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ControllerAI.hpp"
+#include "Label.hpp"
+#include "Random.hpp"
+#include "Scalar.hpp"
+#include "Time.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pong {
+class Renderer;
+}
+
+namespace pong::ecs {
+
+/** @brief Identifier of an entity of a world. */
+using EntityId = std::uint32_t;
+
+/** @brief Identifier used for no entity. */
+inline constexpr EntityId NoEntity = std::numeric_limits<EntityId>::max();
+
+/**
+ * @brief Position of an entity.
+ */
+struct Transform
+{
+    /** @brief Center position. */
+    Vector position = Vector(Scalar(0), Scalar(0));
+
+    /** @brief Center position before the last update, used for interpolation. */
+    Vector positionPrev = Vector(Scalar(0), Scalar(0));
+};
+
+/**
+ * @brief Speed of an entity that moves.
+ */
+struct Velocity
+{
+    /** @brief Speed. */
+    Vector speed = Vector(Scalar(0), Scalar(0));
+};
+
+/**
+ * @brief Shape of an entity and the entities it collides with.
+ */
+struct Collider
+{
+    /** @brief Defines the shapes. */
+    enum class Shape : std::uint8_t
+    {
+        Bounds, //!< The inside of a rectangle (a table), it holds the other colliders.
+        Box,    //!< A rectangle (a paddle), it is kept inside its bounds.
+        Circle  //!< A circle (a ball), it bounces off its bounds and its targets and leaves through the sides.
+    };
+
+    /** @brief Defines the sides a circle can leave its bounds through. */
+    enum class Exit : std::uint8_t
+    {
+        None,  //!< Inside the bounds.
+        Left,  //!< Through the left side, a point for player A.
+        Right  //!< Through the right side, a point for player B.
+    };
+
+    /** @brief Shape. */
+    Shape shape = Shape::Box;
+
+    /** @brief Width and height of the bounds and the boxes. */
+    Vector size = Vector(Scalar(0), Scalar(0));
+
+    /** @brief Radius of the circles. */
+    Scalar radius = Scalar(0);
+
+    /** @brief Entity with the bounds. */
+    EntityId bounds = NoEntity;
+
+    /** @brief Boxes a circle bounces off: the paddle of player A and the one of player B. */
+    EntityId targets[2] = {NoEntity, NoEntity};
+
+    /** @brief Side a circle left its bounds through in the last update. */
+    Exit exit = Exit::None;
+
+    /** @brief Flag indicating whether a circle bounced in the last update or not. */
+    bool hit = false;
+};
+
+/**
+ * @brief Quad drawn at the position of an entity with the size of its collider.
+ */
+struct Quad
+{
+    /** @brief Color. */
+    glm::vec4 color = glm::vec4(1.0f);
+};
+
+/**
+ * @brief Text drawn at a fixed position, as a `Label` does.
+ */
+struct Text
+{
+    /** @brief Width scale of the text. */
+    float width = 1.0f;
+
+    /** @brief Base position. */
+    glm::vec2 position = glm::vec2(0.0f);
+
+    /** @brief Color. */
+    glm::vec4 color = glm::vec4(1.0f);
+
+    /** @brief Text. */
+    std::pmr::string text;
+
+    /** @brief Quads of the characters, calculated when the text changes. */
+    std::pmr::vector<Label::CharQuad> quads;
+
+    /** @brief Flag indicating whether the quads need to be calculated or not. */
+    bool dirty = true;
+};
+
+/**
+ * @brief Control of a paddle by a player, as `ControllerHuman` does.
+ */
+struct HumanControl
+{
+    /** @brief Movement direction: positive to move up, negative to move down and zero to stop. */
+    int direction = 0;
+};
+
+/**
+ * @brief Control of a paddle by the AI, with the same state and decisions as `ControllerAI`.
+ */
+struct AIControl
+{
+    /** @brief Settings. */
+    ControllerAI::Settings settings;
+
+    /** @brief Random generator. */
+    Random random;
+
+    /** @brief Entity of the ball followed by the AI. */
+    EntityId ball = NoEntity;
+
+    /** @brief Vertical position the paddle moves towards. */
+    float target = 0.0f;
+
+    /** @brief Time since the target was calculated. */
+    TimeDuration timeSinceTargetUpdate = TimeDuration::zero();
+
+    /** @brief Flag indicating whether the paddle returns to the center or not. */
+    bool back = false;
+
+    /** @brief Flag indicating whether the AI was updated or not. */
+    bool first = true;
+};
+
+/**
+ * @brief Scores of a match, stored in the entity of its table.
+ */
+struct Score
+{
+    /** @brief Score of player A. */
+    int scoreA = 0;
+
+    /** @brief Score of player B. */
+    int scoreB = 0;
+
+    /** @brief Number of ticks played. */
+    std::uint32_t ticks = 0;
+
+    /** @brief Flag indicating whether a player won or not. */
+    bool finished = false;
+
+    /** @brief Entity with the text of the score of player A. */
+    EntityId textA = NoEntity;
+
+    /** @brief Entity with the text of the score of player B. */
+    EntityId textB = NoEntity;
+
+    /** @brief Entity of the paddle of player A. */
+    EntityId paddleA = NoEntity;
+
+    /** @brief Entity of the paddle of player B. */
+    EntityId paddleB = NoEntity;
+
+    /** @brief Entity of the ball. */
+    EntityId ball = NoEntity;
+};
+
+/**
+ * @brief Dense array with the components of a type, indexed by entity through a sparse array.
+ *
+ * The components are contiguous and in no particular order; removing one moves the last component to its place.
+ * @tparam T Type of the components.
+ */
+template<typename T>
+class ComponentArray
+{
+public:
+
+    /**
+     * @brief Gets the number of components.
+     * @return Number of components.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mComponents.size(); }
+
+    /**
+     * @brief Checks if an entity has a component.
+     * @param entity Entity.
+     * @return True if the entity has a component, false otherwise.
+     */
+    [[nodiscard]] bool contains(const EntityId entity) const noexcept
+    {
+        return entity < mIndices.size() && mIndices[entity] != NoEntity;
+    }
+
+    /**
+     * @brief Gets the component of an entity, it must have one.
+     * @param entity Entity.
+     * @return Component.
+     */
+    [[nodiscard]] T& get(const EntityId entity) noexcept { return mComponents[mIndices[entity]]; }
+
+    [[nodiscard]] const T& get(const EntityId entity) const noexcept { return mComponents[mIndices[entity]]; }
+
+    /**
+     * @brief Adds a component to an entity, replacing the current one.
+     * @param entity Entity.
+     * @param component Component.
+     * @return The component in the array.
+     */
+    T& add(const EntityId entity, T component)
+    {
+        if (contains(entity))
+        {
+            return get(entity) = std::move(component);
+        }
+
+        if (entity >= mIndices.size())
+        {
+            mIndices.resize(entity + 1, NoEntity);
+        }
+
+        mIndices[entity] = static_cast<EntityId>(mComponents.size());
+        mEntities.push_back(entity);
+        return mComponents.emplace_back(std::move(component));
+    }
+
+    /**
+     * @brief Removes the component of an entity, if it has one.
+     * @param entity Entity.
+     */
+    void remove(const EntityId entity)
+    {
+        if (!contains(entity))
+        {
+            return;
+        }
+        // Move the last component to the place of the removed one.
+        const EntityId index = mIndices[entity];
+        const EntityId last  = mEntities.back();
+        mComponents[index] = std::move(mComponents.back());
+        mEntities  [index] = last;
+        mIndices   [last]  = index;
+        mIndices   [entity] = NoEntity;
+        mComponents.pop_back();
+        mEntities.pop_back();
+    }
+
+    /**
+     * @brief Removes all the components.
+     */
+    void clear() noexcept
+    {
+        mComponents.clear();
+        mEntities.clear();
+        mIndices.clear();
+    }
+
+    /**
+     * @brief Gets the components.
+     * @return Components, in the same order as `entities()`.
+     */
+    [[nodiscard]] std::span<T> components() noexcept { return mComponents; }
+
+    /**
+     * @brief Gets the entities that have a component.
+     * @return Entities, in the same order as `components()`.
+     */
+    [[nodiscard]] std::span<const EntityId> entities() const noexcept { return mEntities; }
+
+private:
+
+    /** @brief Components. */
+    std::vector<T> mComponents;
+
+    /** @brief Entity of every component. */
+    std::vector<EntityId> mEntities;
+
+    /** @brief Index of the component of every entity, `NoEntity` for the entities without one. */
+    std::vector<EntityId> mIndices;
+};
+
+/**
+ * @brief Stores the components of many entities, one dense array per type of component.
+ *
+ * An entity is just an identifier; its data are the components added to it, and the behavior lives in systems,
+ * classes with static `update()` or `draw()` functions that process the arrays of components they need. The systems
+ * are given as template arguments, so they are called directly and in order, without virtual calls (see `Systems.hpp`).
+ */
+class World
+{
+public:
+
+    /**
+     * @brief Gets the number of entities created.
+     * @return Number of entities.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return mNext; }
+
+    /**
+     * @brief Creates a new entity, without components.
+     * @return Entity.
+     */
+    EntityId create() noexcept { return mNext++; }
+
+    /**
+     * @brief Removes all the entities and their components.
+     */
+    void clear() noexcept
+    {
+        std::apply([](auto&... arrays) { (arrays.clear(), ...); }, mComponents);
+        mNext = 0;
+    }
+
+    /**
+     * @brief Gets the array with the components of a type.
+     * @tparam T Type of the components.
+     * @return Array.
+     */
+    template<typename T>
+    [[nodiscard]] ComponentArray<T>& components() noexcept { return std::get<ComponentArray<T>>(mComponents); }
+
+    template<typename T>
+    [[nodiscard]] const ComponentArray<T>& components() const noexcept { return std::get<ComponentArray<T>>(mComponents); }
+
+    /**
+     * @brief Adds a component to an entity, replacing the current one.
+     * @tparam T Type of the component.
+     * @param entity Entity.
+     * @param component Component.
+     * @return The component in the world.
+     */
+    template<typename T>
+    T& add(const EntityId entity, T component) { return components<T>().add(entity, std::move(component)); }
+
+    /**
+     * @brief Gets the component of an entity, it must have one.
+     * @tparam T Type of the component.
+     * @param entity Entity.
+     * @return Component.
+     */
+    template<typename T>
+    [[nodiscard]] T& get(const EntityId entity) noexcept { return components<T>().get(entity); }
+
+    template<typename T>
+    [[nodiscard]] const T& get(const EntityId entity) const noexcept { return components<T>().get(entity); }
+
+    /**
+     * @brief Checks if an entity has a component.
+     * @tparam T Type of the component.
+     * @param entity Entity.
+     * @return True if the entity has the component, false otherwise.
+     */
+    template<typename T>
+    [[nodiscard]] bool has(const EntityId entity) const noexcept { return components<T>().contains(entity); }
+
+    /**
+     * @brief Removes the component of an entity, if it has one.
+     * @tparam T Type of the component.
+     * @param entity Entity.
+     */
+    template<typename T>
+    void remove(const EntityId entity) { components<T>().remove(entity); }
+
+    /**
+     * @brief Updates the world with a sequence of systems.
+     * @tparam Systems The systems, called in order.
+     * @param dt The time elapsed since the last update (delta time).
+     */
+    template<typename... Systems>
+    void update(const TimeDuration dt)
+    {
+        (Systems::update(*this, dt), ...);
+    }
+
+    /**
+     * @brief Draws the world with a sequence of systems.
+     * @tparam Systems The systems, called in order.
+     * @param renderer Renderer.
+     * @param interp Interpolation value.
+     */
+    template<typename... Systems>
+    void draw(Renderer& renderer, const float interp)
+    {
+        (Systems::draw(*this, renderer, interp), ...);
+    }
+
+private:
+
+    /** @brief Arrays of components. */
+    std::tuple<ComponentArray<Transform>,
+               ComponentArray<Velocity>,
+               ComponentArray<Collider>,
+               ComponentArray<Quad>,
+               ComponentArray<Text>,
+               ComponentArray<HumanControl>,
+               ComponentArray<AIControl>,
+               ComponentArray<Score>> mComponents;
+
+    /** @brief Next entity. */
+    EntityId mNext = 0;
+};
+
+} // namespace pong::ecs
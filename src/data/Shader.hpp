@@ -43,6 +43,22 @@ inline constexpr std::array QuadVertices =
      0.5f, -0.5f
 };
 
+/**
+ * @brief Corners of the 2D quad, the distinct vertices of `QuadVertices` in the order of `QuadIndices`.
+ */
+inline constexpr std::array QuadCorners =
+{
+    -0.5f,  0.5f,
+    -0.5f, -0.5f,
+     0.5f,  0.5f,
+     0.5f, -0.5f
+};
+
+/**
+ * @brief Indices of the corners of the two triangles of the 2D quad, the same ones as in `QuadVertices`.
+ */
+inline constexpr std::array<unsigned short, 6> QuadIndices = {0, 1, 2, 2, 1, 3};
+
 /**
  * @brief Vertex shader source code for OpenGL 3.3+ Core profile.
  */
@@ -63,6 +79,29 @@ void main()
 }
 )";
 
+/**
+ * @brief Vertex shader source code for OpenGL 3.3+ Core profile, for instances of the unit quad.
+ *
+ * Every instance has its center and size in `i_rect` and its color, normalized from 8 bits per component, in `i_color`.
+ */
+inline constexpr std::string_view GL3InstancedVS = R"(
+#version 330 core
+
+layout(location = 0) in vec2 v_corner;
+layout(location = 1) in vec4 i_rect;
+layout(location = 2) in vec4 i_color;
+
+uniform mat4 transform;
+
+out vec4 vss_color;
+
+void main()
+{
+    gl_Position = vec4(v_corner * i_rect.zw + i_rect.xy, 0.0, 1.0) * transform;
+    vss_color   = i_color;
+}
+)";
+
 /**
  * @brief Fragment shader source code for OpenGL 3.3+ Core profile.
  */
@@ -0,0 +1,203 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Fixtures.hpp"
+#include "MatchBatch.hpp"
+#include "Renderer.hpp"
+#include <iostream>
+
+namespace pong::sim {
+
+void startAiMatch(Game& game, const std::uint32_t seed)
+{
+    game.setSeed(seed);
+    game.update(TickTime);
+    game.handle(Event{Event::Type::Zero});
+}
+
+void stepMatch(Game& game)
+{
+    if (game.state() == Game::State::Kickoff)
+    {
+        game.handle(Event{Event::Type::Next});
+    }
+
+    game.update(TickTime);
+}
+
+void playMatch(const Options& options, Renderer& renderer, Results& results, const long long seed)
+{
+    Game game;
+    game.setCollisionMode(options.swept ? physics::CollisionMode::Swept : physics::CollisionMode::Discrete);
+    startAiMatch(game, static_cast<std::uint32_t>(seed));
+
+    const TimeDuration step = TickTime * static_cast<double>(options.step);
+
+    for (long long tick = 0; tick < options.ticks; tick += options.step)
+    {
+        if (game.state() == Game::State::Kickoff)
+        {
+            game.handle(Event{Event::Type::Next});
+        }
+
+        game.update(step);
+        results.ticks += options.step;
+        // Gather the statistics of the tick.
+        game.events().drain([&results](const GameplayEvent& event)
+        {
+            switch (event.type)
+            {
+                case GameplayEvent::Type::WallHit:   ++results.wallHits;   break;
+                case GameplayEvent::Type::PaddleHit: ++results.paddleHits; break;
+                case GameplayEvent::Type::Point:     ++results.points;     break;
+                case GameplayEvent::Type::State:                           break;
+            }
+        });
+
+        if (options.draw)
+        {
+            renderer.beginFrame();
+            game.draw(renderer, 1.0f);
+            renderer.endFrame();
+        }
+
+        if (game.state() == Game::State::Win)
+        {
+            break;
+        }
+    }
+
+    results.scores     += game.scoreA() + game.scoreB();
+    results.lostEvents += static_cast<long long>(game.events().lost());
+
+    if (game.state() != Game::State::Win)
+    {
+        ++results.unfinished;
+    }
+    else if (game.scoreA() > game.scoreB())
+    {
+        ++results.winsA;
+    }
+    else
+    {
+        ++results.winsB;
+    }
+}
+
+int scriptInput(const long long match, const long long tick, const int player)
+{
+    // SplitMix64 finalizer.
+    auto z = static_cast<std::uint64_t>(match) * 0x9E3779B97F4A7C15ull
+           + static_cast<std::uint64_t>(tick / ScriptHoldTicks) * 0xBF58476D1CE4E5B9ull
+           + static_cast<std::uint64_t>(player);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z =  z ^ (z >> 31);
+
+    return static_cast<int>(z % 3) - 1;
+}
+
+MatchResult playScriptedMatch(const Options& options, const long long match)
+{
+    Game game;
+    game.update(TickTime);
+    game.handle(Event{Event::Type::Two});
+
+    MatchResult result;
+    int inputA = 0;
+    int inputB = 0;
+
+    for (long long tick = 0; tick < options.ticks && game.state() != Game::State::Win; ++tick)
+    {
+        if (game.state() == Game::State::Kickoff)
+        {
+            game.handle(Event{Event::Type::Next});
+        }
+
+        const int nextA = scriptInput(match, tick, 0);
+        const int nextB = scriptInput(match, tick, 1);
+        sendInput(game, true,  inputA, nextA);
+        sendInput(game, false, inputB, nextB);
+        inputA = nextA;
+        inputB = nextB;
+
+        game.update(TickTime);
+        ++result.ticks;
+    }
+
+    result.scoreA = game.scoreA();
+    result.scoreB = game.scoreB();
+
+    return result;
+}
+
+void playScriptedBatch(const Options& options, MatchBatch& batch, const long long step)
+{
+    const TimeDuration dt = TickTime * static_cast<double>(step);
+
+    for (long long tick = 0; tick < options.ticks && !batch.done(); tick += step)
+    {
+        // The scripted inputs only change every `ScriptHoldTicks` ticks.
+        if (tick % ScriptHoldTicks < step)
+        {
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                const auto match = static_cast<long long>(i);
+                batch.setInput(i, scriptInput(match, tick, 0), scriptInput(match, tick, 1));
+            }
+        }
+
+        batch.step(dt);
+    }
+}
+
+MatchResult batchResult(const MatchBatch& batch, const std::size_t match, const long long step)
+{
+    return {batch.scoreA(match), batch.scoreB(match), batch.ticks(match) * step};
+}
+
+void accumulate(const MatchResult& result, Results& results)
+{
+    results.ticks += result.ticks;
+
+    if      (result.scoreA >= Game::MaxPoints) { ++results.winsA; }
+    else if (result.scoreB >= Game::MaxPoints) { ++results.winsB; }
+    else                                       { ++results.unfinished; }
+}
+
+void printResults(const std::string_view title, const long long matches, const Results& results, const double seconds)
+{
+    const double rate = seconds > 0.0 ? 1.0 / seconds : 0.0;
+
+    std::cout << "[" << title << "]" << std::endl
+              << "Matches:        " << matches << std::endl
+              << "Wins A/B:       " << results.winsA << "/" << results.winsB << std::endl
+              << "Unfinished:     " << results.unfinished << std::endl
+              << "Ticks:          " << results.ticks << std::endl
+              << "Elapsed (s):    " << seconds << std::endl
+              << "Matches/s:      " << static_cast<double>(matches) * rate << std::endl
+              << "Ticks/s:        " << static_cast<double>(results.ticks) * rate << std::endl;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,231 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Options.hpp"
+#include "Event.hpp"
+#include "Game.hpp"
+#include "Time.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace pong {
+
+class MatchBatch;
+class Renderer;
+
+} // namespace pong
+
+namespace pong::sim {
+
+/** @brief Fixed time step used by the simulation, the same one used by the application main loop. */
+inline constexpr TimeDuration TickTime = Game::TickTime;
+
+/** @brief Number of ticks a scripted input is held before it changes, a multiple of all the step sizes tested. */
+inline constexpr long long ScriptHoldTicks = 16;
+
+/** @brief Maximum number of ticks of a netplay match (two minutes). */
+inline constexpr long long NetplayTicks = 7200;
+
+/**
+ * @brief Defines the accumulated results of the simulation.
+ */
+struct Results
+{
+    /** @brief Number of ticks simulated. */
+    long long ticks = 0;
+
+    /** @brief Number of matches won by player A (right paddle). */
+    long long winsA = 0;
+
+    /** @brief Number of matches won by player B (left paddle). */
+    long long winsB = 0;
+
+    /** @brief Number of matches that reached the tick limit without a winner. */
+    long long unfinished = 0;
+
+    /** @brief Number of bounces off the walls reported by the gameplay events. */
+    long long wallHits = 0;
+
+    /** @brief Number of bounces off the paddles reported by the gameplay events. */
+    long long paddleHits = 0;
+
+    /** @brief Number of points reported by the gameplay events. */
+    long long points = 0;
+
+    /** @brief Sum of the final scores of the matches, the points reported must add up to it. */
+    long long scores = 0;
+
+    /** @brief Number of gameplay events lost because they were not drained in time. */
+    long long lostEvents = 0;
+};
+
+/**
+ * @brief Defines the final state of a match, used to compare the results of different simulation paths.
+ */
+struct MatchResult
+{
+    /** @brief Score of player A. */
+    int scoreA = 0;
+
+    /** @brief Score of player B. */
+    int scoreB = 0;
+
+    /** @brief Number of ticks simulated. */
+    long long ticks = 0;
+
+    bool operator==(const MatchResult&) const = default;
+};
+
+/**
+ * @brief Defines a transition of the state machine of the game, measured by the menus mode and drawn by the retained
+ * and frames modes.
+ */
+struct MenuTransition
+{
+    /** @brief Name of the transition. */
+    const char* name;
+
+    /** @brief Event that causes the transition. */
+    Event::Type event;
+
+    /** @brief State after the transition. */
+    Game::State state;
+};
+
+/** @brief Cycle of transitions of the menus mode, from the main menu back to it. */
+inline constexpr std::array<MenuTransition, 6> MenuCycle =
+{{
+    {"Main -> Help",   Event::Type::Help, Game::State::Help },
+    {"Help -> Main",   Event::Type::Quit, Game::State::Main },
+    {"Main -> Match",  Event::Type::Two,  Game::State::Match},
+    {"Match -> Abort", Event::Type::Quit, Game::State::Abort},
+    {"Abort -> Match", Event::Type::No,   Game::State::Match},
+    {"Abort -> Main",  Event::Type::Yes,  Game::State::Main },
+}};
+
+/**
+ * @brief Starts an AI vs AI match in a game.
+ *
+ * The first update moves the game to the main menu, then the AI vs AI mode is selected.
+ * @param game Game.
+ * @param seed Seed of the game.
+ */
+void startAiMatch(Game& game, std::uint32_t seed);
+
+/**
+ * @brief Advances an AI vs AI match one tick, accepting the kickoff prompt automatically.
+ * @param game Game.
+ */
+void stepMatch(Game& game);
+
+/**
+ * @brief Plays a complete AI vs AI match through the game state machine.
+ *
+ * The kickoff prompt is accepted automatically, so the match runs until a player wins or the tick limit is reached.
+ * @param options Options of the simulation.
+ * @param renderer Renderer.
+ * @param results Results where the outcome of the match is accumulated.
+ * @param seed Seed of the AI.
+ */
+void playMatch(const Options& options, Renderer& renderer, Results& results, long long seed);
+
+/**
+ * @brief Gets the scripted input of a paddle.
+ *
+ * The input is a pseudo-random direction that only depends on the match, the tick and the player, so every simulation
+ * path receives exactly the same inputs.
+ * @param match Index of the match.
+ * @param tick Index of the tick.
+ * @param player Index of the player (0 for A, 1 for B).
+ * @return Movement direction (-1, 0 or 1).
+ */
+[[nodiscard]] int scriptInput(long long match, long long tick, int player);
+
+/**
+ * @brief Plays a scripted match through the game state machine, in two players mode.
+ * @param options Options of the simulation.
+ * @param match Index of the match, used to generate the scripted inputs.
+ * @return The final state of the match.
+ */
+[[nodiscard]] MatchResult playScriptedMatch(const Options& options, long long match);
+
+/**
+ * @brief Plays scripted matches with a batch simulator.
+ * @param options Options of the simulation.
+ * @param batch Batch simulator, it must have one lane per match.
+ * @param step Number of ticks per step.
+ */
+void playScriptedBatch(const Options& options, MatchBatch& batch, long long step);
+
+/**
+ * @brief Gets the final state of a match of a batch simulator.
+ * @param batch Batch simulator.
+ * @param match Index of the match.
+ * @param step Number of ticks per step.
+ * @return The final state of the match.
+ */
+[[nodiscard]] MatchResult batchResult(const MatchBatch& batch, std::size_t match, long long step);
+
+/**
+ * @brief Accumulates the result of a match.
+ * @param result Final state of the match.
+ * @param results Results where the outcome of the match is accumulated.
+ */
+void accumulate(const MatchResult& result, Results& results);
+
+/**
+ * @brief Prints the results of a simulation.
+ * @param title Title of the simulation.
+ * @param matches Number of matches.
+ * @param results Results.
+ * @param seconds Time elapsed, in seconds.
+ */
+void printResults(std::string_view title, long long matches, const Results& results, double seconds);
+
+/**
+ * @brief Sends the events that change the movement direction of a human-controlled paddle.
+ * @tparam G Type of the receiver of the events, a game or anything with the same `handle()` function.
+ * @param game Game.
+ * @param playerA True for player A, false for player B.
+ * @param from Current direction.
+ * @param to New direction.
+ */
+template<typename G>
+void sendInput(G& game, const bool playerA, const int from, const int to)
+{
+    if (from == to)
+    {
+        return;
+    }
+
+    if (from > 0) { game.handle(Event{playerA ? Event::Type::PlayerAMoveUpReleased   : Event::Type::PlayerBMoveUpReleased});   }
+    if (from < 0) { game.handle(Event{playerA ? Event::Type::PlayerAMoveDownReleased : Event::Type::PlayerBMoveDownReleased}); }
+    if (to   > 0) { game.handle(Event{playerA ? Event::Type::PlayerAMoveUp           : Event::Type::PlayerBMoveUp});           }
+    if (to   < 0) { game.handle(Event{playerA ? Event::Type::PlayerAMoveDown         : Event::Type::PlayerBMoveDown});         }
+}
+
+} // namespace pong::sim
@@ -0,0 +1,223 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Project.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+namespace pong::sim {
+namespace           {
+
+/**
+ * @brief Prints the usage of the tool.
+ * @param name Name of the executable.
+ */
+void printUsage(std::string_view name)
+{
+    std::cerr << "Usage: " << name << " [options]" << std::endl
+              << "  --mode M     Simulation mode (default scene):" << std::endl;
+
+    for (const Mode& mode : modes())
+    {
+        std::cerr << "                 " << std::left << std::setw(8) << mode.name << std::right << " " << mode.description << std::endl;
+    }
+
+    std::cerr << "  --matches N  Number of matches to play (default 100)." << std::endl
+              << "  --ticks T    Maximum number of ticks per match (default 1000000)." << std::endl
+              << "  --pairs N    Number of circle/line pairs for the kernel mode (default 1048576)." << std::endl
+              << "  --balls N    Number of balls for the fixed mode (default 4096)." << std::endl
+              << "  --rounds R   Matches between every pair on each side, tournament mode, or round trips," << std::endl
+              << "               allocations mode (default 10)." << std::endl
+              << "  --threads N  Maximum number of threads, tournament and pipeline modes (default one per hardware thread)." << std::endl
+              << "  --entities N Number of entities for the entities mode (default 10000, at most 524288)." << std::endl
+              << "  --seed S     Seed for the random generators (default 1)." << std::endl
+              << "  --step K     Number of ticks per step, scene and batch modes (default 1)." << std::endl
+              << "  --swept      Use continuous collision detection, scene and batch modes." << std::endl
+              << "  --draw       Run the draw path against a null renderer (scene mode)." << std::endl
+              << "  --latency L  One-way latency of the link in ms, netplay mode (default 60)." << std::endl
+              << "  --jitter J   Maximum deviation of the latency in ms, netplay mode (default 10)." << std::endl
+              << "  --loss P     Percentage of packets lost, netplay mode (default 5)." << std::endl
+              << "  --delay D    Input delay in ticks, netplay mode (default 2)." << std::endl
+              << "  --rollback R Rollback window in ticks, netplay mode (default 8)." << std::endl
+              << "  --replay F   Replay file to play and verify, replay mode." << std::endl
+              << "  --seek T     Tick to seek to before playing the replay file, replay mode (default 0)." << std::endl;
+}
+
+/**
+ * @brief Parses a positive integer.
+ * @param text Text to parse.
+ * @param value Variable where the value is stored.
+ * @return True on success, false otherwise.
+ */
+bool parseCount(const std::string_view text, long long& value)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size() && value > 0;
+}
+
+/**
+ * @brief Parses a non-negative integer.
+ * @param text Text to parse.
+ * @param value Variable where the value is stored.
+ * @return True on success, false otherwise.
+ */
+bool parseAmount(const std::string_view text, long long& value)
+{
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size() && value >= 0;
+}
+
+/**
+ * @brief Parses the command line.
+ * @param argc Number of arguments.
+ * @param argv Arguments.
+ * @param options Options where the values are stored.
+ * @return True on success, false otherwise.
+ */
+bool parseOptions(const int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--draw")
+        {
+            options.draw = true;
+            continue;
+        }
+
+        if (arg == "--swept")
+        {
+            options.swept = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+
+        if (arg == "--mode")
+        {
+            options.mode = argv[++i];
+            if (!findMode(options.mode)) { return false; }
+        }
+        else if (arg == "--matches")
+        {
+            if (!parseCount(argv[++i], options.matches)) { return false; }
+        }
+        else if (arg == "--ticks")
+        {
+            if (!parseCount(argv[++i], options.ticks)) { return false; }
+        }
+        else if (arg == "--pairs")
+        {
+            if (!parseCount(argv[++i], options.pairs)) { return false; }
+        }
+        else if (arg == "--balls")
+        {
+            if (!parseCount(argv[++i], options.balls)) { return false; }
+        }
+        else if (arg == "--rounds")
+        {
+            if (!parseCount(argv[++i], options.rounds)) { return false; }
+        }
+        else if (arg == "--threads")
+        {
+            if (!parseCount(argv[++i], options.threads)) { return false; }
+        }
+        else if (arg == "--entities")
+        {
+            if (!parseCount(argv[++i], options.entities) || options.entities < 4 || options.entities > EntityLimit) { return false; }
+        }
+        else if (arg == "--seed")
+        {
+            if (!parseCount(argv[++i], options.seed)) { return false; }
+        }
+        else if (arg == "--step")
+        {
+            if (!parseCount(argv[++i], options.step)) { return false; }
+        }
+        else if (arg == "--latency")
+        {
+            if (!parseAmount(argv[++i], options.latency)) { return false; }
+        }
+        else if (arg == "--jitter")
+        {
+            if (!parseAmount(argv[++i], options.jitter)) { return false; }
+        }
+        else if (arg == "--loss")
+        {
+            if (!parseAmount(argv[++i], options.loss) || options.loss > 100) { return false; }
+        }
+        else if (arg == "--delay")
+        {
+            if (!parseAmount(argv[++i], options.inputDelay)) { return false; }
+        }
+        else if (arg == "--rollback")
+        {
+            if (!parseAmount(argv[++i], options.rollbackTicks)) { return false; }
+        }
+        else if (arg == "--replay")
+        {
+            options.replay = argv[++i];
+        }
+        else if (arg == "--seek")
+        {
+            if (!parseAmount(argv[++i], options.seek)) { return false; }
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+} // namespace pong::sim
+
+int main(const int argc, char* argv[])
+{
+    using namespace pong;
+    using namespace pong::sim;
+
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Proto Pong simulator " << PONG_VERSION << std::endl;
+
+    const bool success = findMode(options.mode)->run(options);
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
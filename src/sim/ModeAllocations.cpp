@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "AllocationCounter.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include <cstdint>
+#include <iostream>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of round trips between the menus and the matches before counting the allocations. */
+constexpr long long AllocationWarmupRounds = 2;
+
+/**
+ * @brief Plays a round trip through the menus and the matches: an AI vs AI match until a player wins, the help menu,
+ * and a two-player match that is paused and aborted, drawing every state.
+ * @param game Game, in the main menu.
+ * @param renderer Renderer.
+ * @return True if the game is back in the main menu, false otherwise.
+ */
+bool playRoundTrip(Game& game, Renderer& renderer)
+{
+    const auto draw = [&game, &renderer]()
+    {
+        renderer.beginFrame();
+        game.draw(renderer, 1.0f);
+        renderer.endFrame();
+    };
+    // AI vs AI match until a player wins, then back to the main menu.
+    game.handle(Event{Event::Type::Zero});
+    for (long long tick = 0; tick < NetplayTicks * 10 && game.state() != Game::State::Win; ++tick)
+    {
+        if (game.state() == Game::State::Kickoff)
+        {
+            game.handle(Event{Event::Type::Next});
+        }
+
+        game.update(TickTime);
+        draw();
+    }
+    game.handle(Event{Event::Type::Next});
+    draw();
+    // Help menu.
+    game.handle(Event{Event::Type::Help});
+    draw();
+    game.handle(Event{Event::Type::Quit});
+    draw();
+    // Two-player match, paused, resumed and aborted.
+    game.handle(Event{Event::Type::Two});
+    for (long long tick = 0; tick < 60; ++tick)
+    {
+        game.update(TickTime);
+        draw();
+    }
+    game.handle(Event{Event::Type::Quit});
+    draw();
+    game.handle(Event{Event::Type::No});
+    game.update(TickTime);
+    game.handle(Event{Event::Type::Quit});
+    game.handle(Event{Event::Type::Yes});
+    draw();
+
+    return game.state() == Game::State::Main;
+}
+
+} // namespace
+
+bool runAllocations(const Options& options)
+{
+    RendererNull renderer;
+    Game         game;
+    game.setSeed(static_cast<std::uint32_t>(options.seed));
+    // The first update moves the game to the main menu.
+    game.update(TickTime);
+
+    bool valid = true;
+    const long long start = allocationCount();
+    for (long long round = 0; round < AllocationWarmupRounds; ++round)
+    {
+        valid = playRoundTrip(game, renderer) && valid;
+    }
+    const long long warmup = allocationCount() - start;
+
+    RealTimeClock clock;
+    for (long long round = 0; round < options.rounds; ++round)
+    {
+        valid = playRoundTrip(game, renderer) && valid;
+    }
+    const double    seconds     = clock.elapsed().count();
+    const long long allocations = allocationCount() - start - warmup;
+
+    std::cout << "Rounds:         " << AllocationWarmupRounds << " warm-up, " << options.rounds << " measured" << std::endl
+              << "Round trip:     " << 1e3 * seconds / static_cast<double>(options.rounds) << " ms" << std::endl
+              << "Allocations:    " << warmup << " in the warm-up, " << allocations << " after it" << std::endl
+              << "Main menu:      " << (valid ? "yes" : "NO") << std::endl;
+
+    return valid && allocations == 0;
+}
+
+} // namespace pong::sim
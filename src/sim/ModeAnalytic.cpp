@@ -0,0 +1,110 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "AnalyticMatch.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace pong::sim {
+
+bool runAnalytic(const Options& options)
+{
+    RendererNull renderer;
+    Results      analyticResults;
+    Results      sceneResults;
+    // Duration of every match, in ticks.
+    std::vector<double> analyticTicks;
+    std::vector<double> sceneTicks;
+
+    std::uint64_t events = 0;
+
+    RealTimeClock analyticClock;
+    AnalyticMatch match(0);
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        match.reset(static_cast<std::uint64_t>(options.seed + i));
+        match.play(TickTime * static_cast<double>(options.ticks));
+        analyticTicks.push_back(static_cast<double>(match.ticks()));
+        events += match.events();
+        accumulate({match.scoreA(), match.scoreB(), static_cast<long long>(match.ticks())}, analyticResults);
+    }
+    const double analyticSeconds = analyticClock.elapsed().count();
+
+    RealTimeClock sceneClock;
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        const long long ticks = sceneResults.ticks;
+        playMatch(options, renderer, sceneResults, options.seed + i);
+        sceneTicks.push_back(static_cast<double>(sceneResults.ticks - ticks));
+    }
+    const double sceneSeconds = sceneClock.elapsed().count();
+
+    printResults("analytic", options.matches, analyticResults, analyticSeconds);
+    printResults("scene",    options.matches, sceneResults,    sceneSeconds);
+    // Mean and variance of the mean of a sample.
+    const auto statistics = [](const std::vector<double>& values, double& mean, double& variance)
+    {
+        const auto count = static_cast<double>(values.size());
+        mean     = 0.0;
+        variance = 0.0;
+        for (const double value : values) { mean += value; }
+        mean /= count;
+        for (const double value : values) { variance += (value - mean) * (value - mean); }
+        variance /= count * (count - 1.0);
+    };
+
+    const auto   count     = static_cast<double>(options.matches);
+    const double winsA     = static_cast<double>(analyticResults.winsA) / count;
+    const double winsB     = static_cast<double>(sceneResults.winsA)    / count;
+    const double winsP     = (winsA + winsB) * 0.5;
+    const double winsError = std::sqrt(winsP * (1.0 - winsP) * 2.0 / count);
+
+    double meanA = 0.0, varianceA = 0.0, meanB = 0.0, varianceB = 0.0;
+    statistics(analyticTicks, meanA, varianceA);
+    statistics(sceneTicks,    meanB, varianceB);
+    const double ticksError = std::sqrt(varianceA + varianceB);
+    // Both kinds of matches stop at the same time limit, so their durations only differ by chance.
+    const double longest = *std::max_element(analyticTicks.begin(), analyticTicks.end());
+
+    const bool winsOk  = std::abs(winsA - winsB) <= 4.0 * winsError + 1e-9;
+    const bool ticksOk = std::abs(meanA - meanB) <= 4.0 * ticksError + 1e-9 && longest <= static_cast<double>(options.ticks);
+
+    std::cout << "[analytic vs scene]" << std::endl
+              << "Speedup:        " << (analyticSeconds > 0.0 ? sceneSeconds / analyticSeconds : 0.0) << std::endl
+              << "Time/match (us):" << analyticSeconds * 1e6 / count << " / " << sceneSeconds * 1e6 / count << std::endl
+              << "Events/match:   " << static_cast<double>(events) / count << std::endl
+              << "Wins A ratio:   " << winsA << " / " << winsB << " (error " << winsError << ")" << (winsOk ? "" : " MISMATCH") << std::endl
+              << "Mean ticks:     " << meanA << " / " << meanB << " (error " << ticksError << ", longest " << longest << ")" << (ticksOk ? "" : " MISMATCH") << std::endl;
+
+    return winsOk && ticksOk;
+}
+
+} // namespace pong::sim
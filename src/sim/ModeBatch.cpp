@@ -0,0 +1,197 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "MatchBatch.hpp"
+#include "Physics.hpp"
+#include "RealTimeClock.hpp"
+#include "SweptCollision.hpp"
+#include <iostream>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Step sizes (in ticks) tested by the swept mode. */
+constexpr long long SweptSteps[] = {1, 2, 4, 8, 16};
+
+/**
+ * @brief Sweeps a fast ball trapped between two walls slightly further apart than its diameter for a tick.
+ *
+ * The ball bounces more times than a sweep resolves, so the sweep must overflow and the ball must be settled inside the
+ * table instead of being moved through the walls.
+ * @return True if the ball ends inside the table, false otherwise.
+ */
+bool checkTrappedBall()
+{
+    const float                radius  = Game::BallRadius;
+    const double               end     = TickTime.count();
+    const physics::SweptTable  table   = {radius * 1.5f, -radius * 1.5f, -50.0f, 50.0f};
+    physics::SweptBall         ball    = {{0.0f, 0.0f}, {1.0f, 10'000.0f}, radius, 0.0};
+    physics::SweptPaddle       paddleA = {{ 45.0f, 0.0f}, Game::PaddleSize * 0.5f, 0.0f, 0.0f, 0.0f, 0.0};
+    physics::SweptPaddle       paddleB = {{-45.0f, 0.0f}, Game::PaddleSize * 0.5f, 0.0f, 0.0f, 0.0f, 0.0};
+    const physics::SweepResult result  = physics::sweep(ball, paddleA, paddleB, table, end);
+    if (!result.overflow)
+    {
+        return false;
+    }
+
+    physics::settle(ball, paddleA, paddleB, table, result, end);
+    const glm::vec2 position = physics::positionAt(ball, end);
+
+    return position.y + radius <= table.top && position.y - radius >= table.bottom;
+}
+
+} // namespace
+
+bool runBatch(const Options& options)
+{
+    MatchBatch batch(static_cast<std::size_t>(options.matches), options.swept ? physics::CollisionMode::Swept : physics::CollisionMode::Discrete);
+    Results    results;
+
+    RealTimeClock clock;
+    playScriptedBatch(options, batch, options.step);
+    const double seconds = clock.elapsed().count();
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        accumulate(batchResult(batch, i, options.step), results);
+    }
+
+    printResults("batch", options.matches, results, seconds);
+    return true;
+}
+
+bool runCompare(const Options& options)
+{
+    std::vector<MatchResult> expected;
+    Results                  sceneResults;
+    Results                  batchResults;
+
+    expected.reserve(static_cast<std::size_t>(options.matches));
+
+    RealTimeClock sceneClock;
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        expected.push_back(playScriptedMatch(options, i));
+    }
+    const double sceneSeconds = sceneClock.elapsed().count();
+
+    MatchBatch batch(static_cast<std::size_t>(options.matches));
+    RealTimeClock batchClock;
+    playScriptedBatch(options, batch, 1);
+    const double batchSeconds = batchClock.elapsed().count();
+
+    long long mismatches = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const MatchResult result = batchResult(batch, i, 1);
+        if (result != expected[i])
+        {
+            if (mismatches++ < 10)
+            {
+                std::cerr << "Mismatch in match " << i << ": scene " << expected[i].scoreA << "-" << expected[i].scoreB
+                          << " in " << expected[i].ticks << " ticks, batch " << result.scoreA << "-" << result.scoreB
+                          << " in " << result.ticks << " ticks" << std::endl;
+            }
+        }
+
+        accumulate(expected[i], sceneResults);
+        accumulate(result,      batchResults);
+    }
+
+    printResults("scene", options.matches, sceneResults, sceneSeconds);
+    printResults("batch", options.matches, batchResults, batchSeconds);
+
+    std::cout << "[compare]" << std::endl
+              << "Speedup:        " << (batchSeconds > 0.0 ? sceneSeconds / batchSeconds : 0.0) << std::endl
+              << "Mismatches:     " << mismatches << std::endl;
+
+    return mismatches == 0;
+}
+
+bool runSwept(const Options& options)
+{
+    // Plays all the matches and returns their scores.
+    const auto play = [&options](const physics::CollisionMode mode, const long long step, double& seconds)
+    {
+        MatchBatch batch(static_cast<std::size_t>(options.matches), mode);
+
+        RealTimeClock clock;
+        playScriptedBatch(options, batch, step);
+        seconds = clock.elapsed().count();
+
+        std::vector<MatchResult> results;
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            // Only the scores are compared, the number of ticks depends on the step size.
+            results.push_back({batch.scoreA(i), batch.scoreB(i), 0});
+        }
+
+        return results;
+    };
+    // Counts the matches with different scores.
+    const auto mismatches = [](const std::vector<MatchResult>& a, const std::vector<MatchResult>& b)
+    {
+        long long count = 0;
+        for (std::size_t i = 0; i < a.size(); ++i)
+        {
+            count += a[i] != b[i] ? 1 : 0;
+        }
+
+        return count;
+    };
+
+    double seconds = 0.0;
+    const std::vector<MatchResult> discrete = play(physics::CollisionMode::Discrete, 1, seconds);
+    const std::vector<MatchResult> swept    = play(physics::CollisionMode::Swept,    1, seconds);
+
+    std::cout << "[swept]" << std::endl
+              << "Matches:        " << options.matches << std::endl
+              << "Differences against the tick rate of the game (discrete / swept):" << std::endl;
+
+    long long failures = 0;
+    for (const long long step : SweptSteps)
+    {
+        double discreteSeconds = 0.0;
+        double sweptSeconds    = 0.0;
+        const long long discreteMismatches = mismatches(discrete, play(physics::CollisionMode::Discrete, step, discreteSeconds));
+        const long long sweptMismatches    = mismatches(swept,    play(physics::CollisionMode::Swept,    step, sweptSeconds));
+
+        std::cout << "Step " << step << ": discrete " << discreteMismatches << " in " << discreteSeconds << " s"
+                  << ", swept " << sweptMismatches << " in " << sweptSeconds << " s" << std::endl;
+
+        failures += sweptMismatches;
+    }
+
+    const bool trapped = checkTrappedBall();
+
+    std::cout << "Swept vs discrete at the tick rate: " << mismatches(discrete, swept) << " different scores" << std::endl
+              << "Trapped ball:   " << (trapped ? "settled" : "ESCAPED") << std::endl;
+
+    return failures == 0 && trapped;
+}
+
+} // namespace pong::sim
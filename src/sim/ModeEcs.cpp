@@ -0,0 +1,193 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include "Systems.hpp"
+#include "World.hpp"
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Numbers of matches played at once by the ECS mode. */
+constexpr std::array<long long, 3> EcsMatchCounts = {1, 100, 10'000};
+
+/** @brief Number of ticks simulated by the ECS mode. */
+constexpr long long EcsTicks = 600;
+
+/**
+ * @brief Defines the time spent by a simulation path of the ECS mode.
+ */
+struct PathTimes
+{
+    /** @brief Seconds spent in the updates. */
+    double update = 0.0;
+
+    /** @brief Seconds spent in the draws. */
+    double draw = 0.0;
+};
+
+/**
+ * @brief Plays AI vs AI matches through the game scenes for a number of ticks.
+ * @param games Games, each one in its first match.
+ * @param renderer Renderer.
+ * @return The time spent.
+ */
+PathTimes runSceneMatches(std::vector<std::unique_ptr<Game>>& games, Renderer& renderer)
+{
+    PathTimes     times;
+    RealTimeClock clock;
+    for (long long tick = 0; tick < EcsTicks; ++tick)
+    {
+        clock.restart();
+        for (const auto& game : games)
+        {
+            // The kickoff prompt is accepted at once, the finished matches are not updated anymore.
+            if (game->state() == Game::State::Kickoff) { game->handle(Event{Event::Type::Next}); }
+            if (game->state() == Game::State::Match)   { game->update(TickTime); }
+        }
+        times.update += clock.elapsed().count();
+
+        clock.restart();
+        renderer.beginFrame();
+        for (const auto& game : games)
+        {
+            game->draw(renderer, 1.0f);
+        }
+        renderer.endFrame();
+        times.draw += clock.elapsed().count();
+    }
+
+    return times;
+}
+
+/**
+ * @brief Plays AI vs AI matches in a world for a number of ticks.
+ * @param world World with the matches.
+ * @param renderer Renderer.
+ * @return The time spent.
+ */
+PathTimes runWorldMatches(ecs::World& world, Renderer& renderer)
+{
+    PathTimes     times;
+    RealTimeClock clock;
+    for (long long tick = 0; tick < EcsTicks; ++tick)
+    {
+        clock.restart();
+        ecs::update(world, TickTime);
+        times.update += clock.elapsed().count();
+
+        clock.restart();
+        renderer.beginFrame();
+        ecs::draw(world, renderer, 1.0f);
+        renderer.endFrame();
+        times.draw += clock.elapsed().count();
+    }
+
+    return times;
+}
+
+/**
+ * @brief Checks that a match played in a world is in the same state as a match played through a game.
+ * @param game Game.
+ * @param world World.
+ * @param match Entities of the match in the world.
+ * @return True if the scores, the ball and the paddles are equal, false otherwise.
+ */
+bool sameMatch(const Game& game, const ecs::World& world, const ecs::Match& match)
+{
+    const GameSnapshot snapshot = game.snapshot();
+    const ecs::Score&  score    = world.get<ecs::Score>(match.table);
+
+    return score.scoreA == game.scoreA() && score.scoreB == game.scoreB()
+        && score.finished == (game.state() == Game::State::Win)
+        && world.get<ecs::Transform>(match.ball).position    == snapshot.ball.position
+        && world.get<ecs::Transform>(match.paddleA).position == snapshot.paddleA.position
+        && world.get<ecs::Transform>(match.paddleB).position == snapshot.paddleB.position;
+}
+
+} // namespace
+
+bool runEcs(const Options& options)
+{
+    RendererNull renderer;
+    bool         equal = true;
+
+    std::cout << "Ticks:          " << EcsTicks << std::endl
+              << "Matches     Update (ns/match)          Draw (ns/match)" << std::endl
+              << "            scene      ECS   speedup   scene      ECS   speedup" << std::endl;
+
+    for (const long long count : EcsMatchCounts)
+    {
+        std::vector<std::unique_ptr<Game>> games;
+        std::vector<ecs::Match>            matches;
+        ecs::World                         world;
+        for (long long i = 0; i < count; ++i)
+        {
+            // The same seeds as the AI of `Game::setupMatch()`.
+            const auto seed = static_cast<std::uint32_t>(options.seed + i);
+
+            auto game = std::make_unique<Game>();
+            startAiMatch(*game, seed);
+            games.push_back(std::move(game));
+
+            ecs::AIControl controlA;
+            ecs::AIControl controlB;
+            controlA.random = Random(seed * 2);
+            controlB.random = Random(seed * 2 + 1);
+            matches.push_back(ecs::addMatch(world, controlA, controlB));
+        }
+
+        const PathTimes scene = runSceneMatches(games, renderer);
+        const PathTimes ecs   = runWorldMatches(world, renderer);
+
+        for (std::size_t i = 0; i < games.size(); ++i)
+        {
+            equal = sameMatch(*games[i], world, matches[i]) && equal;
+        }
+        // Nanoseconds per match and tick.
+        const double scale = 1e9 / static_cast<double>(count * EcsTicks);
+
+        std::cout << std::left  << std::setw(8) << count << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(9) << scene.update * scale << std::setw(9) << ecs.update * scale << std::setw(9) << scene.update / ecs.update << "x"
+                  << std::setw(9) << scene.draw   * scale << std::setw(9) << ecs.draw   * scale << std::setw(9) << scene.draw   / ecs.draw   << "x" << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+
+    std::cout << "Equal:          " << (equal ? "yes" : "NO") << std::endl;
+
+    return equal;
+}
+
+} // namespace pong::sim
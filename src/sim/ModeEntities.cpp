@@ -0,0 +1,279 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Ball.hpp"
+#include "ControllerHuman.hpp"
+#include "Label.hpp"
+#include "Paddle.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include "Scalar.hpp"
+#include "Scene.hpp"
+#include "Table.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of ticks simulated by the entities mode. */
+constexpr long long EntityTicks = 1000;
+
+/**
+ * @brief Defines the storage of entities used by scenes before the pools: every entity in its own heap allocation,
+ * updated and drawn through the virtual functions of `Entity` in the order they were added.
+ */
+class HeapEntities
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param scene Scene that gives handles to the entities, for the ones that need the game or other entities.
+     */
+    explicit HeapEntities(Scene& scene) noexcept : mScene(scene) {}
+
+    /**
+     * @brief Adds a new entity.
+     * @tparam T Type of the entity.
+     * @param args The arguments for the constructor.
+     * @return A pointer to the entity.
+     */
+    template<typename T, typename... Args>
+    T* emplace(Args&&... args)
+    {
+        auto entity = std::make_unique<T>(std::forward<Args>(args)...);
+        T*   result = entity.get();
+        mScene.attach(*entity);
+        mEntities.push_back(std::move(entity));
+
+        return result;
+    }
+
+    /**
+     * @brief Updates all entities.
+     * @param dt Time step.
+     */
+    void update(const TimeDuration dt)
+    {
+        for (const auto& entity : mEntities)
+        {
+            entity->update(dt);
+        }
+    }
+
+    /**
+     * @brief Draws all entities.
+     * @param renderer Renderer.
+     * @param interp Interpolation value.
+     */
+    void draw(Renderer& renderer, const float interp)
+    {
+        for (const auto& entity : mEntities)
+        {
+            entity->draw(renderer, interp);
+        }
+    }
+
+private:
+
+    /** @brief Scene of the entities. */
+    Scene& mScene;
+
+    /** @brief Entities. */
+    std::vector<std::unique_ptr<Entity>> mEntities;
+};
+
+/**
+ * @brief Fills a storage with a table, two paddles and many balls and labels, interleaved as they are created.
+ *
+ * The balls start at random positions with random velocities, so the results only depend on the seed.
+ * @tparam S Type of the storage, a scene or anything with the same `emplace()` function.
+ * @param storage Storage.
+ * @param count Number of entities, at least four.
+ * @param seed Seed for the positions and the velocities of the balls.
+ * @param balls Vector where the balls are stored.
+ */
+template<typename S>
+void addEntities(S& storage, const long long count, const long long seed, std::vector<Ball*>& balls)
+{
+    std::mt19937_64                       random(static_cast<std::uint64_t>(seed));
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    const glm::vec2 half = Game::TableSize * 0.5f;
+    auto* table   = storage.template emplace<Table>(Game::TablePosition, Game::TableSize);
+    auto* paddleA = storage.template emplace<Paddle>(std::make_unique<ControllerHuman>(ControllerHuman::Player::A), Game::TablePosition + glm::vec2{ half.x - 5.0f, 0.0f}, Game::PaddleSize);
+    auto* paddleB = storage.template emplace<Paddle>(std::make_unique<ControllerHuman>(ControllerHuman::Player::B), Game::TablePosition + glm::vec2{-half.x + 5.0f, 0.0f}, Game::PaddleSize);
+    // One entity in ten is a label, the other ones are balls.
+    balls.clear();
+    for (long long i = 3; i < count; ++i)
+    {
+        if (i % 10 == 0)
+        {
+            storage.template emplace<Label>(5.0f, Game::TablePosition, glm::vec4(1.0f), std::to_string(i));
+            continue;
+        }
+
+        Ball* ball = storage.template emplace<Ball>(Game::TablePosition, Game::BallRadius);
+        ball->setup(*table, *paddleA, *paddleB);
+
+        BallSnapshot state;
+        state.position     = toVector(Game::TablePosition + glm::vec2{unit(random) * (half.x - 10.0f), unit(random) * (half.y - 5.0f)});
+        state.positionPrev = state.position;
+        state.speed        = toVector(glm::vec2{unit(random) * 60.0f, unit(random) * 60.0f});
+        ball->restore(state);
+        balls.push_back(ball);
+    }
+
+    paddleA->setup(*table, *balls.front());
+    paddleB->setup(*table, *balls.front());
+}
+
+/**
+ * @brief Updates and draws the entities of a storage.
+ * @tparam S Type of the storage.
+ * @param storage Storage.
+ * @param renderer Renderer.
+ * @param balls Balls of the storage.
+ * @param updateSeconds Variable where the time spent in the updates is stored.
+ * @param drawSeconds Variable where the time spent in the draws is stored.
+ * @return The final state of the balls.
+ */
+template<typename S>
+std::vector<BallSnapshot> runEntities(S& storage, Renderer& renderer, const std::vector<Ball*>& balls, double& updateSeconds, double& drawSeconds)
+{
+    RealTimeClock clock;
+    for (long long tick = 0; tick < EntityTicks; ++tick)
+    {
+        storage.update(TickTime);
+    }
+    updateSeconds = clock.elapsed().count();
+
+    clock.restart();
+    for (long long tick = 0; tick < EntityTicks; ++tick)
+    {
+        renderer.beginFrame();
+        storage.draw(renderer, 1.0f);
+        renderer.endFrame();
+    }
+    drawSeconds = clock.elapsed().count();
+
+    std::vector<BallSnapshot> states(balls.size());
+    for (std::size_t i = 0; i < balls.size(); ++i)
+    {
+        balls[i]->snapshot(states[i]);
+    }
+
+    return states;
+}
+
+/**
+ * @brief Looks up the balls of a scene from their handles `EntityTicks` times.
+ * @param scene Scene.
+ * @param handles Handles of the balls.
+ * @param balls Balls.
+ * @param seconds Variable where the time spent in the lookups is stored.
+ * @return True if every handle finds its ball, false otherwise.
+ */
+bool lookupHandles(const Scene& scene, const std::vector<Handle<Ball>>& handles, const std::vector<Ball*>& balls, double& seconds)
+{
+    bool found = true;
+
+    RealTimeClock clock;
+    for (long long tick = 0; tick < EntityTicks; ++tick)
+    {
+        for (std::size_t i = 0; i < handles.size(); ++i)
+        {
+            found = found && scene.get(handles[i]) == balls[i];
+        }
+    }
+    seconds = clock.elapsed().count();
+
+    return found;
+}
+
+} // namespace
+
+bool runEntities(const Options& options)
+{
+    RendererNull renderer;
+    Game         game;
+    // Entities in the pools of a scene.
+    std::vector<Ball*> balls;
+    Scene              scene(game);
+    addEntities(scene, options.entities, options.seed, balls);
+
+    double poolUpdate = 0.0;
+    double poolDraw   = 0.0;
+    const auto poolStates = runEntities(scene, renderer, balls, poolUpdate, poolDraw);
+    // Handles of the balls of the pools.
+    std::vector<Handle<Ball>> handles;
+    for (const Ball* ball : balls)
+    {
+        handles.push_back(scene.handle(*ball));
+    }
+
+    double     lookup = 0.0;
+    const bool found  = lookupHandles(scene, handles, balls, lookup);
+    // Entities in the heap.
+    HeapEntities heap(scene);
+    addEntities(heap, options.entities, options.seed, balls);
+
+    double heapUpdate = 0.0;
+    double heapDraw   = 0.0;
+    const auto heapStates = runEntities(heap, renderer, balls, heapUpdate, heapDraw);
+
+    const bool   equal = poolStates == heapStates;
+    // Nanoseconds per entity and tick.
+    const double scale = 1e9 / static_cast<double>(options.entities * EntityTicks);
+    // The handles of the cleared entities must not find the new entities in their slots.
+    scene.clear();
+    addEntities(scene, options.entities, options.seed, balls);
+
+    bool cleared = std::ranges::none_of(handles, [&scene](const Handle<Ball> handle) { return scene.get(handle) != nullptr; });
+    for (const Ball* ball : balls)
+    {
+        cleared = cleared && scene.get(scene.handle(*ball)) == ball;
+    }
+
+    std::cout << "Entities:       " << options.entities << " (" << balls.size() << " balls)" << std::endl
+              << "Ticks:          " << EntityTicks << std::endl
+              << "Update (ns):    pools " << poolUpdate * scale << ", heap " << heapUpdate * scale << " (" << heapUpdate / poolUpdate << "x)" << std::endl
+              << "Draw (ns):      pools " << poolDraw   * scale << ", heap " << heapDraw   * scale << " (" << heapDraw   / poolDraw   << "x)" << std::endl
+              << "Equal:          " << (equal ? "yes" : "NO") << std::endl
+              << "Lookup (ns):    " << lookup * 1e9 / static_cast<double>(handles.size() * EntityTicks) << " per handle" << std::endl
+              << "Handles:        " << (found && cleared ? "valid" : "INVALID") << std::endl;
+
+    return equal && found && cleared;
+}
+
+} // namespace pong::sim
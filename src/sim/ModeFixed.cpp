@@ -0,0 +1,199 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Physics.hpp"
+#include "PhysicsFixed.hpp"
+#include "RealTimeClock.hpp"
+#include "Scalar.hpp"
+#include "Snapshot.hpp"
+#include <bit>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of ticks simulated by the fixed mode. */
+constexpr long long FixedTicks = 3600;
+
+/** @brief Seed of the AI vs AI match of the fixed mode. */
+constexpr std::uint32_t GoldenSeed = 1;
+
+/** @brief Maximum number of ticks of the AI vs AI match of the fixed mode. */
+constexpr long long GoldenTicks = 100'000;
+
+/** @brief Checksum of the AI vs AI match of the fixed mode in a fixed-point build. */
+constexpr std::uint32_t GoldenChecksum = 0xc2030d1d;
+
+/**
+ * @brief Gets the bits of a scalar, for checksums.
+ * @param value Value.
+ * @return Bits.
+ */
+std::uint32_t scalarBits(const float value) { return std::bit_cast<std::uint32_t>(value); }
+
+std::uint32_t scalarBits(const Fixed value) { return static_cast<std::uint32_t>(value.raw()); }
+
+/**
+ * @brief Moves balls between the walls and two paddles with the physics functions of a scalar type.
+ *
+ * The paddles follow every ball with a different offset, so the balls hit every part of them (or miss them). The
+ * balls that leave the table are served again from the center.
+ * @param positions Positions of the balls.
+ * @param speeds Speeds of the balls.
+ * @param ticks Number of ticks.
+ * @return Checksum (FNV-1a) of the final state.
+ */
+template<typename S, typename V>
+std::uint32_t bounceBalls(std::vector<V>& positions, std::vector<V>& speeds, const long long ticks)
+{
+    const S dt      = S(TickTime.count());
+    const S radius  = S(Game::BallRadius);
+    const S top     = S(Game::TableSize.y * 0.5f);
+    const S right   = S(Game::TableSize.x * 0.5f);
+    const S paddleX = right - S(Game::PaddleMargin);
+    const V size    = V(S(Game::PaddleSize.x), S(Game::PaddleSize.y));
+    const S half    = size.x * S(0.5f);
+
+    for (long long tick = 0; tick < ticks; ++tick)
+    {
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            V& position = positions[i];
+            V& speed    = speeds   [i];
+            // Move and bounce off the walls.
+            position = position + speed * dt;
+            if (position.y + radius >  top) { position.y =  top - radius; speed.y = -speed.y; }
+            if (position.y - radius < -top) { position.y = -top + radius; speed.y = -speed.y; }
+            // Bounce off the paddles.
+            const S offset  = S(static_cast<int>(i % 37) - 18);
+            const V paddleA = V( paddleX, position.y + offset);
+            const V paddleB = V(-paddleX, position.y - offset);
+            V where;
+            if (physics::collisionBallPaddle(position, radius, paddleA, size, where))
+            {
+                position.x = paddleA.x - half - radius;
+                speed      = physics::bounce(speed, (where.y - paddleA.y) / (size.y * S(0.5f)));
+            }
+            else if (physics::collisionBallPaddle(position, radius, paddleB, size, where))
+            {
+                position.x = paddleB.x + half + radius;
+                speed      = physics::bounce(speed, (where.y - paddleB.y) / (size.y * S(0.5f)));
+            }
+            // Serve again.
+            if (position.x - radius > right || position.x + radius < -right)
+            {
+                position = V(S(0), S(0));
+            }
+        }
+    }
+
+    std::uint32_t checksum = 2166136261u;
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        for (const S value : {positions[i].x, positions[i].y, speeds[i].x, speeds[i].y})
+        {
+            checksum = (checksum ^ scalarBits(value)) * 16777619u;
+        }
+    }
+    return checksum;
+}
+
+/**
+ * @brief Plays an AI vs AI match from `GoldenSeed` until a player wins.
+ * @param ticks Variable where the number of ticks played is stored.
+ * @return Checksum (FNV-1a) of the number of ticks and the final state of the game.
+ */
+std::uint32_t playGoldenMatch(long long& ticks)
+{
+    Game game;
+    startAiMatch(game, GoldenSeed);
+    for (ticks = 0; ticks < GoldenTicks && game.state() != Game::State::Win; ++ticks)
+    {
+        stepMatch(game);
+    }
+
+    const GameSnapshot snapshot = game.snapshot();
+    const auto*        bytes    = reinterpret_cast<const std::uint8_t*>(&snapshot);
+
+    std::uint32_t checksum = 2166136261u;
+    checksum = (checksum ^ static_cast<std::uint32_t>(ticks)) * 16777619u;
+    for (std::size_t i = 0; i < sizeof(GameSnapshot); ++i)
+    {
+        checksum = (checksum ^ bytes[i]) * 16777619u;
+    }
+    return checksum;
+}
+
+} // namespace
+
+bool runFixed(const Options& options)
+{
+    const auto count = static_cast<std::size_t>(options.balls);
+    // Run both paths from the same initial state, built from integers so it is exact in both types.
+    const auto run = [count]<typename S, typename V>(std::uint32_t& checksum)
+    {
+        std::vector<V> positions(count);
+        std::vector<V> speeds   (count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            positions[i] = V(S(static_cast<int>(i * 37 % 160) - 80), S(static_cast<int>(i * 53 % 120) - 60));
+            speeds   [i] = V(S(i % 2 == 0 ? 100 : -100),             S(static_cast<int>(i *  7 % 100) - 50));
+        }
+
+        RealTimeClock clock;
+        checksum = bounceBalls<S, V>(positions, speeds, FixedTicks);
+        return clock.elapsed().count();
+    };
+
+    std::uint32_t floatChecksum = 0;
+    std::uint32_t fixedChecksum = 0;
+    const double floatSeconds = run.operator()<float, glm::vec2>(floatChecksum);
+    const double fixedSeconds = run.operator()<Fixed, FixedVec2>(fixedChecksum);
+    const double ballTicks    = static_cast<double>(count) * FixedTicks;
+    // The match is only pinned in the fixed-point builds, the floating-point ones may differ.
+    long long           matchTicks    = 0;
+    const std::uint32_t matchChecksum = playGoldenMatch(matchTicks);
+    const bool          pinned        = std::is_same_v<Scalar, Fixed>;
+    const bool          golden        = !pinned || matchChecksum == GoldenChecksum;
+
+    std::cout << "[fixed]" << std::endl
+              << "Game scalar:    " << (std::is_same_v<Scalar, Fixed> ? "fixed" : "float") << std::endl
+              << "Balls:          " << count << std::endl
+              << "Ticks:          " << FixedTicks << std::endl
+              << "Float:          " << (floatSeconds > 0.0 ? ballTicks / floatSeconds : 0.0) << " ball ticks/s, checksum 0x" << std::hex << floatChecksum << std::dec << std::endl
+              << "Fixed:          " << (fixedSeconds > 0.0 ? ballTicks / fixedSeconds : 0.0) << " ball ticks/s, checksum 0x" << std::hex << fixedChecksum << std::dec << std::endl
+              << "Fixed/float:    " << (floatSeconds > 0.0 ? fixedSeconds / floatSeconds : 0.0) << std::endl
+              << "Match:          " << matchTicks << " ticks, checksum 0x" << std::hex << matchChecksum << std::dec
+              << (pinned ? (golden ? " (golden)" : " (NOT GOLDEN)") : " (not pinned)") << std::endl;
+
+    return golden;
+}
+
+} // namespace pong::sim
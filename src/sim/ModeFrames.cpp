@@ -0,0 +1,202 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Renderer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of frames drawn in every state by the frames mode. */
+constexpr long long PresentFrames = 600;
+
+/** @brief Refresh rate of the display simulated by the frames mode, faster than the ticks so that it interpolates. */
+constexpr double PresentRate = 144.0;
+
+/**
+ * @brief A renderer that keeps the quads of the last frame drawn, with the quads of the static meshes, to compare the
+ * frames.
+ */
+class RendererFrames final : public Renderer
+{
+public:
+
+    /**
+     * @brief Defines a quad drawn.
+     */
+    struct Quad
+    {
+        /** @brief Center. */
+        glm::vec2 position;
+
+        /** @brief Size. */
+        glm::vec2 size;
+
+        /** @brief Color. */
+        glm::vec4 color;
+
+        bool operator==(const Quad&) const = default;
+    };
+
+    /**
+     * @brief Checks whether the last frame drawn is the same as the previous one.
+     * @return True if the frames are the same, false otherwise.
+     */
+    [[nodiscard]] bool same() const noexcept { return mSame; }
+
+    void beginFrame() override
+    {
+        mFrame.clear();
+    }
+
+    void endFrame() override
+    {
+        mSame = mFrame == mLast;
+        std::swap(mFrame, mLast);
+    }
+
+    void queueQuad(const glm::vec2& position, const glm::vec2& size) override
+    {
+        queueQuad(position, size, glm::vec4(1.0f));
+    }
+
+    void queueQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override
+    {
+        (mRecording ? mMeshes.back() : mFrame).push_back({position, size, color});
+    }
+
+    void beginMesh() override
+    {
+        mMeshes.emplace_back();
+        mRecording = true;
+    }
+
+    MeshId endMesh() override
+    {
+        mRecording = false;
+
+        return static_cast<MeshId>(mMeshes.size() - 1);
+    }
+
+    void drawMesh(const MeshId id) override
+    {
+        mFrame.insert(mFrame.end(), mMeshes[id].begin(), mMeshes[id].end());
+    }
+
+    void destroyMesh(const MeshId id) override
+    {
+        mMeshes[id].clear();
+    }
+
+private:
+
+    /** @brief Quads of the frame being drawn. */
+    std::vector<Quad> mFrame;
+
+    /** @brief Quads of the last frame drawn. */
+    std::vector<Quad> mLast;
+
+    /** @brief Quads of every mesh, indexed by their identifier, which is never reused. */
+    std::vector<std::vector<Quad>> mMeshes;
+
+    /** @brief Flag indicating whether a mesh is being recorded, the last one. */
+    bool mRecording = false;
+
+    /** @brief Flag indicating whether the last frame drawn is the same as the previous one. */
+    bool mSame = false;
+};
+
+} // namespace
+
+bool runFrames(const Options& options)
+{
+    RendererFrames renderer;
+    Game           game;
+    game.setSeed(static_cast<std::uint32_t>(options.seed));
+    // The first update moves the game to the main menu.
+    game.update(TickTime);
+
+    constexpr std::size_t transitions = MenuCycle.size() + 1;
+
+    const TimeDuration frameTime{1.0 / PresentRate};
+    TimeDuration       tickAccum{};
+
+    bool      valid   = true;
+    long long wrong   = 0;
+    long long skipped = 0;
+
+    std::cout << "Frames/state:   " << PresentFrames << " at " << PresentRate << " Hz" << std::endl
+              << "Transition      Presented  Skipped" << std::endl;
+
+    for (std::size_t i = 0; i < transitions; ++i)
+    {
+        // After the menu cycle, an AI vs AI match where the ball and the paddles move.
+        const MenuTransition transition = i < MenuCycle.size() ? MenuCycle[i] : MenuTransition{"Main -> AI match", Event::Type::Zero, Game::State::Match};
+        if (transition.event == Event::Type::Yes)
+        {
+            game.handle(Event{Event::Type::Quit});
+        }
+        game.handle(Event{transition.event});
+        valid = valid && game.state() == transition.state;
+
+        long long presented = 0;
+        for (long long frame = 0; frame < PresentFrames; ++frame)
+        {
+            for (tickAccum += frameTime; tickAccum >= TickTime; tickAccum -= TickTime)
+            {
+                game.update(TickTime);
+            }
+
+            const bool changed = game.changed();
+            renderer.beginFrame();
+            game.draw(renderer, static_cast<float>(tickAccum / TickTime));
+            renderer.endFrame();
+
+            presented += changed ? 1 : 0;
+            wrong     += changed || renderer.same() ? 0 : 1;
+        }
+        skipped += PresentFrames - presented;
+        // Nothing moves in the menus, the ball moves in the matches.
+        valid = valid && (transition.state == Game::State::Match ? presented > 1 : presented == 1);
+
+        std::cout << std::left << std::setw(16) << transition.name << std::right
+                  << std::setw(9) << presented << std::setw(9) << PresentFrames - presented << std::endl;
+    }
+
+    valid = valid && wrong == 0;
+
+    std::cout << "Frames skipped: " << skipped << " of " << PresentFrames * static_cast<long long>(transitions) << std::endl
+              << "Wrong skips:    " << wrong << std::endl
+              << "Result:         " << (valid ? "expected" : "UNEXPECTED") << std::endl;
+
+    return valid;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "CollisionKernel.hpp"
+#include "Physics.hpp"
+#include "RealTimeClock.hpp"
+#include <bit>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace pong::sim {
+
+bool runKernel(const Options& options)
+{
+    const auto count = static_cast<std::size_t>(options.pairs);
+
+    std::vector<float> cx(count), cy(count), r(count), ax(count), ay(count), bx(count), by(count);
+    std::mt19937_64 rng(static_cast<std::uint64_t>(options.seed));
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> sign(-1.0f, 1.0f);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const float length = 5.0f + 35.0f * unit(rng);
+        // One out of four lines has a random orientation.
+        const glm::vec2 dir = i % 4 == 0 ? glm::normalize(glm::vec2(sign(rng), sign(rng) + 2.0f)) : glm::vec2(0.0f, 1.0f);
+        const glm::vec2 a   = {100.0f * sign(rng), 70.0f * sign(rng)};
+        const glm::vec2 b   = a + dir * length;
+        const glm::vec2 c   = (a + b) * 0.5f + glm::vec2(10.0f * sign(rng), length * sign(rng));
+
+        cx[i] = c.x; cy[i] = c.y; r[i] = 0.5f + 4.5f * unit(rng);
+        ax[i] = a.x; ay[i] = a.y;
+        bx[i] = b.x; by[i] = b.y;
+    }
+
+    const physics::CircleLineInput input = {cx.data(), cy.data(), r.data(), ax.data(), ay.data(), bx.data(), by.data()};
+    // Reference results.
+    std::vector<std::uint8_t> expectedHit(count);
+    std::vector<glm::vec2>    expectedPoint(count);
+    long long hits = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        expectedHit[i] = physics::collisionCircleLine({cx[i], cy[i]}, r[i], {ax[i], ay[i]}, {bx[i], by[i]}, expectedPoint[i]);
+        hits += expectedHit[i];
+    }
+
+    std::cout << "[kernel]" << std::endl
+              << "Pairs:          " << count << std::endl
+              << "Hits:           " << hits << std::endl
+              << "Detected:       " << physics::simdLevelName(physics::detectSimdLevel()) << std::endl;
+
+    bool success = true;
+    std::vector<float>         px(count), py(count);
+    std::vector<std::uint32_t> masks((count + 31) / 32);
+
+    for (const auto level : {physics::SimdLevel::Scalar, physics::SimdLevel::SSE2, physics::SimdLevel::AVX2})
+    {
+        if (!physics::isSimdLevelSupported(level))
+        {
+            std::cout << physics::simdLevelName(level) << ": not supported" << std::endl;
+            continue;
+        }
+        // Run a few times to get a stable measurement.
+        constexpr int Runs = 10;
+        RealTimeClock clock;
+        for (int run = 0; run < Runs; ++run)
+        {
+            physics::collisionCircleLines(level, count, input, px.data(), py.data(), masks.data());
+        }
+        const double seconds = clock.elapsed().count();
+
+        long long mismatches = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const bool hit = (masks[i / 32] >> (i % 32) & 1u) != 0;
+            if (hit != (expectedHit[i] != 0) || (hit && (std::bit_cast<std::uint32_t>(px[i]) != std::bit_cast<std::uint32_t>(expectedPoint[i].x) ||
+                                                         std::bit_cast<std::uint32_t>(py[i]) != std::bit_cast<std::uint32_t>(expectedPoint[i].y))))
+            {
+                ++mismatches;
+            }
+        }
+
+        std::cout << physics::simdLevelName(level) << ": "
+                  << (seconds > 0.0 ? static_cast<double>(count) * Runs / seconds : 0.0) << " pairs/s, "
+                  << mismatches << " mismatches" << std::endl;
+
+        success = success && mismatches == 0;
+    }
+
+    return success;
+}
+
+} // namespace pong::sim
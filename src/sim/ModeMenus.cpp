@@ -0,0 +1,91 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of times the menus mode goes through its cycle of transitions. */
+constexpr long long MenuCycles = 10'000;
+
+} // namespace
+
+bool runMenus(const Options& options)
+{
+    RendererNull renderer;
+    Game         game;
+    game.setSeed(static_cast<std::uint32_t>(options.seed));
+    // The first update moves the game to the main menu.
+    game.update(TickTime);
+
+    bool                                 valid  = true;
+    std::array<double, MenuCycle.size()> events = {};
+    std::array<double, MenuCycle.size()> frames = {};
+    for (long long cycle = 0; cycle < MenuCycles; ++cycle)
+    {
+        for (std::size_t i = 0; i < MenuCycle.size(); ++i)
+        {
+            if (i + 1 == MenuCycle.size())
+            {
+                game.handle(Event{Event::Type::Quit});
+            }
+
+            RealTimeClock clock;
+            game.handle(Event{MenuCycle[i].event});
+            events[i] += clock.elapsed().count();
+
+            clock.restart();
+            renderer.beginFrame();
+            game.draw(renderer, 1.0f);
+            renderer.endFrame();
+            frames[i] += clock.elapsed().count();
+
+            valid = valid && game.state() == MenuCycle[i].state;
+        }
+    }
+
+    std::cout << "Cycles:         " << MenuCycles << std::endl
+              << "Transition      Event (ns)  First frame (ns)" << std::endl;
+    for (std::size_t i = 0; i < MenuCycle.size(); ++i)
+    {
+        std::cout << std::left << std::setw(16) << MenuCycle[i].name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << events[i] * 1e9 / static_cast<double>(MenuCycles)
+                  << std::setw(18) << frames[i] * 1e9 / static_cast<double>(MenuCycles) << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6)
+              << "States:         " << (valid ? "expected" : "UNEXPECTED") << std::endl;
+
+    return valid;
+}
+
+} // namespace pong::sim
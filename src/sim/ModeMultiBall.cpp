@@ -0,0 +1,350 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Ball.hpp"
+#include "BallGrid.hpp"
+#include "ControllerHuman.hpp"
+#include "Paddle.hpp"
+#include "RealTimeClock.hpp"
+#include "Scalar.hpp"
+#include "Scene.hpp"
+#include "Table.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Numbers of balls simulated by the multi-ball mode. */
+constexpr std::array<long long, 5> MultiBallCounts = {1, 10, 100, 1000, 10'000};
+
+/** @brief Number of ticks simulated for every number of balls by the multi-ball mode. */
+constexpr long long MultiBallTicks = 600;
+
+/** @brief Number of balls per area of the default table in the multi-ball mode, the table grows with the balls. */
+constexpr double MultiBallDensity = 100.0;
+
+/** @brief Maximum number of balls tested against each other (and checked against the grid) by the multi-ball mode. */
+constexpr long long MultiBallAllPairs = 2000;
+
+/** @brief Number of ticks between the checks of the pairs found by the grid in the multi-ball mode. */
+constexpr long long MultiBallCheckInterval = 60;
+
+/** @brief Number of balls of the multi-ball match played by the multi-ball mode. */
+constexpr int MultiBallMatchBalls = 200;
+
+/**
+ * @brief Defines a table with two static paddles and many balls that collide with each other.
+ *
+ * The table grows with the number of balls to keep the same number of balls per area, so the cost per ball of the
+ * broadphase does not depend on how crowded the table is.
+ */
+class BallField
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param game Game of the scene.
+     * @param count Number of balls.
+     * @param seed Seed for the positions and the velocities of the balls.
+     */
+    BallField(Game& game, const long long count, const long long seed)
+        : mScene(game)
+        , mRandom(static_cast<std::uint64_t>(seed))
+    {
+        const float     scale = static_cast<float>(std::sqrt(std::max(1.0, static_cast<double>(count) / MultiBallDensity)));
+        const glm::vec2 size  = Game::TableSize * scale;
+        const glm::vec2 half  = size * 0.5f;
+
+        mTable   = mScene.emplace<Table>(Game::TablePosition, size);
+        mPaddleA = mScene.emplace<Paddle>(std::make_unique<ControllerHuman>(ControllerHuman::Player::A), Game::TablePosition + glm::vec2{ half.x - 5.0f, 0.0f}, Game::PaddleSize);
+        mPaddleB = mScene.emplace<Paddle>(std::make_unique<ControllerHuman>(ControllerHuman::Player::B), Game::TablePosition + glm::vec2{-half.x + 5.0f, 0.0f}, Game::PaddleSize);
+        mGrid    = std::make_unique<BallGrid>(*mTable, *mPaddleA, *mPaddleB, 4.0f * Game::BallRadius);
+
+        for (long long i = 0; i < count; ++i)
+        {
+            Ball* ball = mScene.emplace<Ball>(Game::TablePosition, Game::BallRadius);
+            ball->setup(*mTable, *mPaddleA, *mPaddleB);
+            serve(*ball);
+            mBalls.push_back(ball);
+            mGrid->insert(*ball);
+        }
+
+        mPaddleA->setup(*mTable, *mBalls.front());
+        mPaddleB->setup(*mTable, *mBalls.front());
+    }
+
+    /** @brief Gets the balls. */
+    [[nodiscard]] const std::vector<Ball*>& balls() const noexcept { return mBalls; }
+
+    /** @brief Gets the grid. */
+    [[nodiscard]] const BallGrid& grid() const noexcept { return *mGrid; }
+
+    /**
+     * @brief Sets whether the balls find their candidate paddles in the grid or test both paddles.
+     * @param enabled True to use the grid, false otherwise.
+     */
+    void setGridEnabled(const bool enabled)
+    {
+        for (Ball* ball : mBalls)
+        {
+            ball->setGrid(enabled ? mGrid.get() : nullptr);
+        }
+    }
+
+    /**
+     * @brief Moves the balls and the paddles, and serves again the balls that scored.
+     */
+    void update()
+    {
+        mScene.update(TickTime);
+
+        for (Ball* ball : mBalls)
+        {
+            if (ball->point())
+            {
+                serve(*ball);
+            }
+        }
+
+        mGrid->update();
+    }
+
+    /**
+     * @brief Resolves the collisions between the balls found by the grid.
+     * @return Number of collisions.
+     */
+    std::size_t collideGrid() const { return mGrid->collide(); }
+
+    /**
+     * @brief Resolves the collisions between the balls testing every pair.
+     * @return Number of collisions.
+     */
+    std::size_t collideAllPairs() const
+    {
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < mBalls.size(); ++i)
+        {
+            for (std::size_t j = i + 1; j < mBalls.size(); ++j)
+            {
+                count += Ball::collide(*mBalls[i], *mBalls[j]) ? 1 : 0;
+            }
+        }
+
+        return count;
+    }
+
+private:
+
+    /**
+     * @brief Places a ball at a random position of the table with a random velocity.
+     * @param ball Ball.
+     */
+    void serve(Ball& ball)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> speed(100.0f, 180.0f);
+
+        const glm::vec2 half      = toVec2(mTable->size()) * 0.5f;
+        const glm::vec2 position  = Game::TablePosition + glm::vec2{unit(mRandom) * (half.x - 10.0f), unit(mRandom) * (half.y - 5.0f)};
+        const float     angle     = unit(mRandom) * 3.14159265f;
+        ball.reset(position, glm::vec2{std::cos(angle), std::sin(angle)} * speed(mRandom));
+    }
+
+    /** @brief Scene with the entities. */
+    Scene mScene;
+
+    /** @brief Random generator for the balls. */
+    std::mt19937_64 mRandom;
+
+    /** @brief Table. */
+    Table* mTable = nullptr;
+
+    /** @brief Paddle of player A. */
+    Paddle* mPaddleA = nullptr;
+
+    /** @brief Paddle of player B. */
+    Paddle* mPaddleB = nullptr;
+
+    /** @brief Grid with the balls. */
+    std::unique_ptr<BallGrid> mGrid;
+
+    /** @brief Balls. */
+    std::vector<Ball*> mBalls;
+};
+
+/**
+ * @brief Checks that the grid finds every pair of overlapping balls, comparing its pairs with all the pairs.
+ * @param field Field with the balls.
+ * @return True if the grid finds the same overlapping pairs as the all-pairs tests, false otherwise.
+ */
+bool checkPairs(const BallField& field)
+{
+    using Pair = std::pair<const Ball*, const Ball*>;
+
+    const auto overlap = [](const Ball& a, const Ball& b)
+    {
+        const glm::vec2 d = toVec2(a.position()) - toVec2(b.position());
+        const float     r = toFloat(a.radius() + b.radius());
+        return glm::dot(d, d) < r * r;
+    };
+
+    const auto makePair = [](const Ball& a, const Ball& b)
+    {
+        return std::less<const Ball*>()(&a, &b) ? Pair{&a, &b} : Pair{&b, &a};
+    };
+    // The overlapping pairs found by the grid.
+    std::vector<Pair> grid;
+    field.grid().forEachPair([&](const Ball& a, const Ball& b)
+    {
+        if (overlap(a, b)) { grid.push_back(makePair(a, b)); }
+    });
+    // The overlapping pairs of all the pairs.
+    std::vector<Pair> all;
+    const auto& balls = field.balls();
+    for (std::size_t i = 0; i < balls.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < balls.size(); ++j)
+        {
+            if (overlap(*balls[i], *balls[j])) { all.push_back(makePair(*balls[i], *balls[j])); }
+        }
+    }
+
+    std::sort(grid.begin(), grid.end());
+    std::sort(all.begin(),  all.end());
+
+    return grid == all;
+}
+
+/**
+ * @brief Simulates a field of balls.
+ * @param game Game for the scene.
+ * @param count Number of balls.
+ * @param seed Seed of the balls.
+ * @param useGrid True to use the grid, false to test all pairs.
+ * @param check True to check the pairs found by the grid against all the pairs.
+ * @param collisions Variable where the number of collisions is stored.
+ * @param valid Variable set to false if a check fails.
+ * @return Seconds spent in the simulation, without the checks.
+ */
+double runBallField(Game& game, const long long count, const long long seed, const bool useGrid, const bool check, std::size_t& collisions, bool& valid)
+{
+    BallField field(game, count, seed);
+    field.setGridEnabled(useGrid);
+
+    collisions = 0;
+    double seconds = 0.0;
+    for (long long tick = 0; tick < MultiBallTicks; ++tick)
+    {
+        RealTimeClock clock;
+        field.update();
+        collisions += useGrid ? field.collideGrid() : field.collideAllPairs();
+        seconds += clock.elapsed().count();
+        // Check the pairs of the grid before the next tick moves the balls again.
+        if (check && tick % MultiBallCheckInterval == 0 && !checkPairs(field))
+        {
+            valid = false;
+        }
+    }
+
+    return seconds;
+}
+
+/**
+ * @brief Plays an AI vs AI match with many balls through the game, until a player wins.
+ * @param seed Seed of the match.
+ * @param ticks Variable where the number of ticks is stored.
+ * @return True if the match ends with a winner, false otherwise.
+ */
+bool playMultiBallMatch(const long long seed, long long& ticks)
+{
+    Game game;
+    game.setBalls(MultiBallMatchBalls);
+    startAiMatch(game, static_cast<std::uint32_t>(seed));
+
+    for (ticks = 0; ticks < NetplayTicks && game.state() != Game::State::Win; ++ticks)
+    {
+        game.update(TickTime);
+    }
+
+    return game.state() == Game::State::Win;
+}
+
+} // namespace
+
+bool runMultiBall(const Options& options)
+{
+    Game game;
+    bool valid = true;
+
+    std::cout << "Ticks:          " << MultiBallTicks << std::endl
+              << "Balls       Grid (ns/ball)  All pairs (ns/ball)  Collisions" << std::endl;
+
+    for (const long long count : MultiBallCounts)
+    {
+        const bool  small = count <= MultiBallAllPairs;
+        std::size_t gridCollisions = 0;
+        std::size_t allCollisions  = 0;
+        const double gridSeconds = runBallField(game, count, options.seed, true,  small, gridCollisions, valid);
+        const double allSeconds  = small ? runBallField(game, count, options.seed, false, false, allCollisions, valid) : 0.0;
+        // Nanoseconds per ball and tick.
+        const double scale = 1e9 / static_cast<double>(count * MultiBallTicks);
+
+        std::cout << std::left  << std::setw(12) << count
+                  << std::right << std::setw(15) << std::fixed << std::setprecision(1) << gridSeconds * scale;
+        if (small)
+        {
+            std::cout << std::setw(21) << allSeconds * scale;
+        }
+        else
+        {
+            std::cout << std::setw(21) << "-";
+        }
+        std::cout << std::setw(12) << gridCollisions << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+
+    long long  ticks    = 0;
+    const bool finished = playMultiBallMatch(options.seed, ticks);
+
+    std::cout << "Match:          " << MultiBallMatchBalls << " balls, " << (finished ? "won" : "NOT FINISHED") << " in " << ticks << " ticks" << std::endl
+              << "Pairs:          " << (valid ? "complete" : "MISSING") << std::endl;
+
+    return valid && finished;
+}
+
+} // namespace pong::sim
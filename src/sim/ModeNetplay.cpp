@@ -0,0 +1,287 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "ControllerHuman.hpp"
+#include "RealTimeClock.hpp"
+#include "Rollback.hpp"
+#include "UdpSocket.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Address of the loopback interface, in host byte order. */
+constexpr std::uint32_t LoopbackAddress = 0x7F000001;
+
+/**
+ * @brief Simulated network link, it delays, reorders and drops the packets of a peer before sending them over UDP.
+ */
+class Link
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param options Options of the simulation, with the latency, the jitter and the loss.
+     * @param seed Seed of the random generator.
+     */
+    Link(const Options& options, const std::uint64_t seed)
+        :
+        mLatency(static_cast<double>(options.latency)),
+        mJitter (static_cast<double>(options.jitter)),
+        mLoss   (static_cast<double>(options.loss) / 100.0),
+        mRandom (seed)
+    {}
+
+    /**
+     * @brief Gets the number of packets lost.
+     * @return Number of packets.
+     */
+    [[nodiscard]] long long lost() const noexcept { return mLost; }
+
+    /**
+     * @brief Sends a packet, it is lost or queued until it arrives.
+     * @param now Current time, in milliseconds.
+     * @param packet Packet.
+     */
+    void send(const double now, const std::span<const std::uint8_t> packet)
+    {
+        if (std::uniform_real_distribution<double>(0.0, 1.0)(mRandom) < mLoss)
+        {
+            ++mLost;
+            return;
+        }
+
+        const double delay = mLatency + std::uniform_real_distribution<double>(-mJitter, mJitter)(mRandom);
+        mQueue.push_back({now + std::max(delay, 0.0), {packet.begin(), packet.end()}});
+    }
+
+    /**
+     * @brief Sends the packets that have arrived over UDP, in the order they arrive.
+     * @param now Current time, in milliseconds.
+     * @param socket Socket of the sender.
+     * @param to Address of the receiver.
+     */
+    void flush(const double now, UdpSocket& socket, const UdpAddress& to)
+    {
+        std::stable_sort(mQueue.begin(), mQueue.end(), [](const Packet& a, const Packet& b) { return a.time < b.time; });
+
+        std::size_t count = 0;
+        for (; count < mQueue.size() && mQueue[count].time <= now; ++count)
+        {
+            socket.send(to, mQueue[count].data);
+        }
+        mQueue.erase(mQueue.begin(), mQueue.begin() + static_cast<std::ptrdiff_t>(count));
+    }
+
+private:
+
+    /** @brief Packet in flight. */
+    struct Packet
+    {
+        /** @brief Arrival time, in milliseconds. */
+        double time = 0.0;
+
+        /** @brief Data. */
+        std::vector<std::uint8_t> data;
+    };
+
+    /** @brief Latency, in milliseconds. */
+    double mLatency;
+
+    /** @brief Maximum deviation of the latency, in milliseconds. */
+    double mJitter;
+
+    /** @brief Probability of losing a packet. */
+    double mLoss;
+
+    /** @brief Random generator. */
+    std::mt19937_64 mRandom;
+
+    /** @brief Packets in flight. */
+    std::vector<Packet> mQueue;
+
+    /** @brief Number of packets lost. */
+    long long mLost = 0;
+};
+
+/**
+ * @brief Gets the scripted input of a player in a netplay match: the movement of the scripted matches, and the next
+ * key held down for a while every few seconds (for the kickoffs).
+ * @param match Index of the match.
+ * @param tick Index of the tick.
+ * @param player Index of the player (0 for A, 1 for B).
+ * @return Input.
+ */
+Rollback::Input netplayInput(const long long match, const long long tick, const int player)
+{
+    const int direction = scriptInput(match, tick, player);
+    const bool next     = (tick / ScriptHoldTicks + player) % 8 == 0;
+
+    return static_cast<Rollback::Input>((direction > 0 ? Rollback::InputUp   : 0) |
+                                        (direction < 0 ? Rollback::InputDown : 0) |
+                                        (next          ? Rollback::InputNext : 0));
+}
+
+} // namespace
+
+bool runNetplay(const Options& options)
+{
+    const Rollback::Settings settings{static_cast<int>(options.inputDelay), static_cast<int>(options.rollbackTicks)};
+    const long long          ticks   = std::min(options.ticks, NetplayTicks);
+    const long long          delay   = std::clamp(options.inputDelay, 0LL, static_cast<long long>(Rollback::MaxInputDelay));
+    const double             frameMs = 1000.0 * TickTime.count();
+
+    Rollback::Stats total;
+    long long       frames     = 0;
+    long long       packets    = 0;
+    long long       lost       = 0;
+    long long       mismatches = 0;
+    RealTimeClock   clock;
+
+    for (long long match = 0; match < options.matches; ++match)
+    {
+        auto socketA = UdpSocket::create(0);
+        auto socketB = UdpSocket::create(0);
+        if (!socketA || !socketB)
+        {
+            std::cerr << "Unable to open the UDP sockets" << std::endl;
+            return false;
+        }
+
+        const UdpAddress addressA{LoopbackAddress, socketA->port()};
+        const UdpAddress addressB{LoopbackAddress, socketB->port()};
+
+        Game     gameA;
+        Game     gameB;
+        Rollback peerA(gameA, ControllerHuman::Player::A, settings);
+        Rollback peerB(gameB, ControllerHuman::Player::B, settings);
+        Link     linkA(options, static_cast<std::uint64_t>(options.seed + match) * 2);
+        Link     linkB(options, static_cast<std::uint64_t>(options.seed + match) * 2 + 1);
+        // Each frame delivers the packets that arrive, advances both peers and sends their new packets.
+        const auto frame = [&](const double now, Rollback& peer, UdpSocket& socket, Link& link, const int player)
+        {
+            std::array<std::uint8_t, Rollback::MaxPacketSize> buffer{};
+            UdpAddress from;
+            while (const std::size_t size = socket.receive(buffer, from))
+            {
+                peer.readPacket({buffer.data(), size});
+            }
+            // The input sampled now is the one of the tick after the input delay.
+            if (peer.tick() < ticks)
+            {
+                peer.advance(netplayInput(match, peer.tick() + delay, player));
+            }
+
+            link.send(now, {buffer.data(), peer.writePacket(buffer)});
+            ++packets;
+        };
+        // Play until both peers have simulated all the ticks with the actual inputs.
+        long long count = 0;
+        for (; peerA.tick() < ticks || peerB.tick() < ticks || peerA.confirmedTicks() < ticks || peerB.confirmedTicks() < ticks; ++count)
+        {
+            const double now = static_cast<double>(count) * frameMs;
+            linkA.flush(now, *socketA, addressB);
+            linkB.flush(now, *socketB, addressA);
+            frame(now, peerA, *socketA, linkA, 0);
+            frame(now, peerB, *socketB, linkB, 1);
+            // The sessions cannot get stuck, but a broken transport could.
+            if (count > ticks * 100)
+            {
+                std::cerr << "Match " << match << " stuck at ticks " << peerA.tick() << "/" << peerB.tick() << std::endl;
+                return false;
+            }
+        }
+
+        peerA.synchronize();
+        peerB.synchronize();
+        // Play the same inputs without a network.
+        Game reference;
+        reference.startMatch(std::make_unique<ControllerHuman>(ControllerHuman::Player::A),
+                             std::make_unique<ControllerHuman>(ControllerHuman::Player::B));
+        const auto input = [match, delay](const long long tick, const int player) -> Rollback::Input
+        {
+            return tick >= delay ? netplayInput(match, tick, player) : 0;
+        };
+        for (long long tick = 0; tick < ticks; ++tick)
+        {
+            Rollback::applyInputs(reference, input(tick - 1, 0), input(tick, 0), input(tick - 1, 1), input(tick, 1));
+            reference.update(TickTime);
+        }
+
+        const GameSnapshot expected = reference.snapshot();
+        if (!(gameA.snapshot() == expected) || !(gameB.snapshot() == expected))
+        {
+            std::cerr << "Match " << match << " differs from the reference" << std::endl;
+            ++mismatches;
+        }
+
+        for (const Rollback* peer : {&peerA, &peerB})
+        {
+            const Rollback::Stats& stats = peer->stats();
+            total.ticks               += stats.ticks;
+            total.stalls              += stats.stalls;
+            total.predictions         += stats.predictions;
+            total.rollbacks           += stats.rollbacks;
+            total.resimulatedTicks    += stats.resimulatedTicks;
+            total.maxRollback          = std::max(total.maxRollback, stats.maxRollback);
+            total.resimulationSeconds += stats.resimulationSeconds;
+            total.packets             += stats.packets;
+            total.invalidPackets      += stats.invalidPackets;
+            total.maxInputs            = std::max(total.maxInputs, stats.maxInputs);
+        }
+
+        frames += count * 2;
+        lost   += linkA.lost() + linkB.lost();
+    }
+
+    const double seconds = clock.elapsed().count();
+    const auto   ratio   = [](const double a, const long long b) { return b > 0 ? a / static_cast<double>(b) : 0.0; };
+
+    std::cout << "[netplay]" << std::endl
+              << "Link:           " << options.latency << " ms latency, " << options.jitter << " ms jitter, " << options.loss << "% loss" << std::endl
+              << "Session:        " << delay << " ticks input delay, " << std::clamp(options.rollbackTicks, 0LL, static_cast<long long>(Rollback::MaxRollbackTicks)) << " ticks rollback window" << std::endl
+              << "Matches:        " << options.matches << " of " << ticks << " ticks, " << mismatches << " mismatches" << std::endl
+              << "Packets:        " << packets << " sent, " << lost << " lost, " << total.packets << " received, " << total.invalidPackets << " invalid" << std::endl
+              << "Stalls:         " << total.stalls << " (" << 100.0 * ratio(static_cast<double>(total.stalls), frames) << "% of the frames)" << std::endl
+              << "Predictions:    " << total.predictions << " (" << 100.0 * ratio(static_cast<double>(total.predictions), total.ticks) << "% of the ticks)" << std::endl
+              << "Rollbacks:      " << total.rollbacks << " (" << 100.0 * ratio(static_cast<double>(total.rollbacks), total.ticks) << " per 100 ticks), longest " << total.maxRollback << " ticks" << std::endl
+              << "Resimulated:    " << total.resimulatedTicks << " ticks, " << ratio(static_cast<double>(total.resimulatedTicks), total.rollbacks) << " per rollback, " << ratio(static_cast<double>(total.resimulatedTicks), total.ticks) << " per frame" << std::endl
+              << "Inputs kept:    " << total.maxInputs << " ticks at most" << std::endl
+              << "Rollback cost:  " << 1e6 * ratio(total.resimulationSeconds, total.rollbacks) << " us per rollback, " << 1e6 * ratio(total.resimulationSeconds, total.ticks) << " us per frame" << std::endl
+              << "Elapsed (s):    " << seconds << std::endl;
+
+    return mismatches == 0;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,166 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "AllocationCounter.hpp"
+#include "MatchHost.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include "Tournament.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Numbers of matches hosted at once by the pipeline mode. */
+constexpr std::array<std::size_t, 3> PipelineMatchCounts = {1, 100, 10'000};
+
+/** @brief Number of ticks run by the pipeline mode. */
+constexpr long long PipelineTicks = 600;
+
+/** @brief Minimum number of threads of the pipeline mode, so that the graph is checked with concurrent threads. */
+constexpr int PipelineMinThreads = 4;
+
+/**
+ * @brief Checks that the matches of a host are in the same state as the same matches updated one after the other.
+ * @param host Host.
+ * @param games Games.
+ * @return True if every match has the same snapshot, false otherwise.
+ */
+bool sameMatches(MatchHost& host, const std::vector<std::unique_ptr<Game>>& games)
+{
+    for (std::size_t i = 0; i < games.size(); ++i)
+    {
+        if (!(host.game(i).snapshot() == games[i]->snapshot()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool runPipeline(const Options& options)
+{
+    const int maxThreads = options.threads > 0 ? static_cast<int>(options.threads)
+                                               : std::max(Tournament::defaultThreads(), PipelineMinThreads);
+
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    bool      equal = true;
+    bool      extra = false;
+    std::cout << "Ticks:          " << PipelineTicks << std::endl
+              << "Matches  Threads  Jobs/tick  Time (ns/match)  Speedup" << std::endl;
+
+    for (const std::size_t count : PipelineMatchCounts)
+    {
+        // Every match is drawn into its own renderer on both paths.
+        std::vector<RendererNull> renderers(count);
+
+        std::vector<std::unique_ptr<Game>> games;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            games.push_back(std::make_unique<Game>());
+            startAiMatch(*games.back(), static_cast<std::uint32_t>(options.seed) + static_cast<std::uint32_t>(i));
+        }
+
+        RealTimeClock   clock;
+        const long long first = allocationCount();
+        for (long long tick = 0; tick < PipelineTicks; ++tick)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                Game& game = *games[i];
+                if (game.state() == Game::State::Kickoff) { game.handle(Event{Event::Type::Next}); }
+                game.update(TickTime);
+                renderers[i].beginFrame();
+                game.draw(renderers[i], 1.0f);
+                renderers[i].endFrame();
+            }
+        }
+        const double    serial      = clock.elapsed().count();
+        const long long allocations = allocationCount() - first;
+        // Nanoseconds per match and tick.
+        const double scale = 1e9 / static_cast<double>(count * PipelineTicks);
+
+        std::cout << std::left << std::setw(9) << count << std::setw(9) << "serial" << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(9) << 0 << std::setw(17) << serial * scale << std::endl;
+
+        for (const int threads : counts)
+        {
+            MatchHost host(count, threads);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                startAiMatch(host.game(i), static_cast<std::uint32_t>(options.seed) + static_cast<std::uint32_t>(i));
+                host.setRenderer(i, &renderers[i]);
+            }
+
+            double          seconds = 0.0;
+            const long long before  = allocationCount();
+            for (long long tick = 0; tick < PipelineTicks; ++tick)
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (host.game(i).state() == Game::State::Kickoff) { host.post(i, Event{Event::Type::Next}); }
+                }
+
+                clock.restart();
+                host.tick(TickTime);
+                seconds += clock.elapsed().count();
+            }
+            const bool more = allocationCount() - before > allocations;
+            const bool same = sameMatches(host, games);
+            equal = equal && same;
+            extra = extra || more;
+
+            std::cout << std::left << std::setw(9) << count << std::setw(9) << threads << std::right
+                      << std::setw(9) << host.graph().jobs() << std::setw(17) << seconds * scale
+                      << std::setw(8) << serial / seconds << "x"
+                      << (same ? "" : " MISMATCH") << (more ? " ALLOCATES" : "") << std::endl;
+        }
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+
+    std::cout << "Equal:          " << (equal ? "yes" : "NO") << std::endl
+              << "Allocations:    " << (extra ? "MORE than the games" : "only the games") << std::endl;
+
+    return equal && !extra;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RealTimeClock.hpp"
+#include "QuadBatch.hpp"
+#include "data/Shader.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Numbers of quads of a frame queued by the quads mode. */
+constexpr std::array<std::size_t, 3> QuadCounts = {100, 10'000, 1'000'000};
+
+/** @brief Number of quads queued by the quads mode with every layout and number of quads of a frame. */
+constexpr std::size_t QuadWork = 20'000'000;
+
+/**
+ * @brief Defines a quad of the quads mode.
+ */
+struct Quad
+{
+    /** @brief Center. */
+    glm::vec2 position;
+
+    /** @brief Size. */
+    glm::vec2 size;
+
+    /** @brief Color. */
+    glm::vec4 color;
+};
+
+/**
+ * @brief Queues the frames of quads into a batch and copies their data, as a renderer uploads it.
+ * @param batch Batch, with the layout to measure.
+ * @param quads Quads of a frame.
+ * @param frames Number of frames.
+ * @param upload Buffer where the data of the frames is copied, large enough for a frame.
+ * @return Time spent, in seconds.
+ */
+double queueQuads(QuadBatch& batch, const std::vector<Quad>& quads, const std::size_t frames, std::vector<std::byte>& upload)
+{
+    RealTimeClock clock;
+    for (std::size_t frame = 0; frame < frames; ++frame)
+    {
+        for (const Quad& quad : quads)
+        {
+            batch.queue(quad.position, quad.size, quad.color);
+        }
+
+        std::memcpy(upload.data(), batch.data(), batch.bytes());
+        batch.clear();
+    }
+
+    return clock.elapsed().count();
+}
+
+/**
+ * @brief Checks that the instances of a batch draw the same quads as the vertices of another batch.
+ *
+ * Every instance is expanded as the shader does, the positions must be exactly the same and the colors of the vertices
+ * must pack into the color of the instance.
+ * @param vertices Batch in the vertices layout.
+ * @param instances Batch in the instances layout, with the same quads.
+ * @return True if the quads are the same, false otherwise.
+ */
+bool sameQuads(const QuadBatch& vertices, const QuadBatch& instances)
+{
+    if (vertices.size() != instances.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < instances.size(); ++i)
+    {
+        const QuadInstance& instance = instances.instances()[i];
+        for (std::size_t v = 0; v < QuadBatch::VerticesPerQuad; ++v)
+        {
+            const QuadVertex& vertex = vertices.vertices()[i * QuadBatch::VerticesPerQuad + v];
+            const float       px     = data::QuadVertices[v * 2]     * instance.sx + instance.cx;
+            const float       py     = data::QuadVertices[v * 2 + 1] * instance.sy + instance.cy;
+            if (px != vertex.px || py != vertex.py || packColor({vertex.cr, vertex.cg, vertex.cb, vertex.ca}) != instance.color)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Checks that the packed vertices of a batch draw the same quads as the vertices of another batch.
+ *
+ * Every vertex is packed as the batch does, through the index of its corner, so both must be exactly the same.
+ * @param vertices Batch in the vertices layout.
+ * @param packed Batch in the packed layout, with the same quads.
+ * @return True if the quads are the same, false otherwise.
+ */
+bool samePacked(const QuadBatch& vertices, const QuadBatch& packed)
+{
+    if (vertices.size() != packed.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < packed.size(); ++i)
+    {
+        for (std::size_t v = 0; v < QuadBatch::VerticesPerQuad; ++v)
+        {
+            const QuadVertex&   vertex = vertices.vertices()[i * QuadBatch::VerticesPerQuad + v];
+            const PackedVertex& corner = packed.packed()[i * QuadBatch::PackedVerticesPerQuad + data::QuadIndices[v]];
+            if (corner.position != packPosition({vertex.px, vertex.py}) ||
+                corner.color    != packColor({vertex.cr, vertex.cg, vertex.cb, vertex.ca}))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool runQuads(const Options& options)
+{
+    std::mt19937_64                       random(static_cast<std::uint64_t>(options.seed));
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 10.0f);
+    std::uniform_real_distribution<float> component(0.0f, 1.0f);
+
+    constexpr std::size_t vertexBytes   = QuadBatch::bytesPerQuad(QuadBatch::Layout::Vertices);
+    constexpr std::size_t packedBytes   = QuadBatch::bytesPerQuad(QuadBatch::Layout::Packed);
+    constexpr std::size_t instanceBytes = QuadBatch::bytesPerQuad(QuadBatch::Layout::Instances);
+
+    bool equal = true;
+
+    std::cout << "Quads queued:   " << QuadWork << " per layout" << std::endl
+              << "Bytes/quad:     " << vertexBytes << " vertices, " << packedBytes << " packed, " << instanceBytes
+              << " instances" << std::endl
+              << "Quads/frame  Vertices (Mquads/s)  Packed (Mquads/s)  Instances (Mquads/s)" << std::endl;
+
+    for (const std::size_t count : QuadCounts)
+    {
+        std::vector<Quad> quads(count);
+        for (Quad& quad : quads)
+        {
+            quad.position = {coordinate(random), coordinate(random)};
+            quad.size     = {extent(random), extent(random)};
+            quad.color    = {component(random), component(random), component(random), 1.0f};
+        }
+
+        const std::size_t      frames = std::max<std::size_t>(1, QuadWork / count);
+        std::vector<std::byte> upload(count * vertexBytes);
+        QuadBatch              vertices (QuadBatch::Layout::Vertices);
+        QuadBatch              packed   (QuadBatch::Layout::Packed);
+        QuadBatch              instances(QuadBatch::Layout::Instances);
+        // Warm up, so that the batches have their capacity.
+        static_cast<void>(queueQuads(vertices,  quads, 1, upload));
+        static_cast<void>(queueQuads(packed,    quads, 1, upload));
+        static_cast<void>(queueQuads(instances, quads, 1, upload));
+
+        const double vertexSeconds   = queueQuads(vertices,  quads, frames, upload);
+        const double packedSeconds   = queueQuads(packed,    quads, frames, upload);
+        const double instanceSeconds = queueQuads(instances, quads, frames, upload);
+        // Check a frame.
+        for (const Quad& quad : quads)
+        {
+            vertices .queue(quad.position, quad.size, quad.color);
+            packed   .queue(quad.position, quad.size, quad.color);
+            instances.queue(quad.position, quad.size, quad.color);
+        }
+        equal = sameQuads(vertices, instances) && samePacked(vertices, packed) && equal;
+        // Millions of quads per second.
+        const double scale = static_cast<double>(count * frames) * 1e-6;
+
+        std::cout << std::left  << std::setw(13) << count << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(19) << scale / vertexSeconds << std::setw(19) << scale / packedSeconds
+                  << std::setw(22) << scale / instanceSeconds << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+
+    std::cout << "Layouts:        " << (equal ? "equal" : "DIFFERENT") << std::endl;
+
+    return equal;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,570 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RealTimeClock.hpp"
+#include "Replay.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of seeks checked by the replay mode. */
+constexpr std::size_t ReplaySeeks = 1000;
+
+/**
+ * @brief Defines a game that records the events it handles into a replay.
+ */
+class RecordedGame
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param game Game.
+     * @param recorder Recorder.
+     */
+    RecordedGame(Game& game, ReplayRecorder& recorder) noexcept : mGame(game), mRecorder(recorder) {}
+
+    /**
+     * @brief Gets the number of updates of the game.
+     * @return The number of updates.
+     */
+    [[nodiscard]] std::uint64_t tick() const noexcept { return mTick; }
+
+    /**
+     * @brief Records an event and handles it.
+     * @param event Event.
+     */
+    void handle(const Event& event)
+    {
+        mRecorder.record(mTick, event.type());
+        mGame.handle(event);
+    }
+
+    /**
+     * @brief Updates the game one tick, and records a keyframe at the start of the next one if it is due.
+     */
+    void update()
+    {
+        mGame.update(TickTime);
+        ++mTick;
+        mRecorder.keyframe(mTick, mGame);
+    }
+
+private:
+
+    /** @brief Game. */
+    Game& mGame;
+
+    /** @brief Recorder. */
+    ReplayRecorder& mRecorder;
+
+    /** @brief Number of updates of the game. */
+    std::uint64_t mTick = 0;
+};
+
+/**
+ * @brief Defines a game that records the events it handles into a replay in the same order as the application.
+ *
+ * The events are queued until the next update, which records a keyframe if it is due, records and handles the queued
+ * events and updates the game; the session is finished as soon as the game is done, or when it is destroyed.
+ */
+class QueuedGame
+{
+public:
+
+    /**
+     * @brief Constructor.
+     * @param game Game.
+     * @param recorder Recorder.
+     */
+    QueuedGame(Game& game, ReplayRecorder& recorder) noexcept : mGame(game), mRecorder(recorder) {}
+
+    /**
+     * @brief Destructor, it finishes the session if the game is not done.
+     */
+    ~QueuedGame() { finish(); }
+
+    QueuedGame(const QueuedGame&) = delete;
+    QueuedGame& operator=(const QueuedGame&) = delete;
+
+    /**
+     * @brief Gets the number of updates of the game.
+     * @return The number of updates.
+     */
+    [[nodiscard]] std::uint64_t tick() const noexcept { return mTick; }
+
+    /**
+     * @brief Queues an event for the next update.
+     * @param event Event.
+     */
+    void handle(const Event& event) { mEvents.push_back(event); }
+
+    /**
+     * @brief Records a keyframe if it is due, records and handles the queued events and updates the game one tick.
+     */
+    void update()
+    {
+        if (mFinished)
+        {
+            return;
+        }
+
+        mRecorder.keyframe(mTick, mGame);
+        for (const Event& event : mEvents)
+        {
+            mRecorder.record(mTick, event.type());
+            mGame.handle(event);
+        }
+        mEvents.clear();
+
+        mGame.update(TickTime);
+        ++mTick;
+
+        if (mGame.done())
+        {
+            finish();
+        }
+    }
+
+    /**
+     * @brief Records the end of the session, only once.
+     */
+    void finish()
+    {
+        if (!mFinished)
+        {
+            mRecorder.finish(mTick, mGame.scoreA(), mGame.scoreB());
+            mFinished = true;
+        }
+    }
+
+private:
+
+    /** @brief Game. */
+    Game& mGame;
+
+    /** @brief Recorder. */
+    ReplayRecorder& mRecorder;
+
+    /** @brief Events queued for the next update. */
+    std::vector<Event> mEvents;
+
+    /** @brief Number of updates of the game. */
+    std::uint64_t mTick = 0;
+
+    /** @brief Flag indicating if the session has been finished. */
+    bool mFinished = false;
+};
+
+/**
+ * @brief Plays a session with scripted one-player matches against the AI.
+ *
+ * The human player follows the scripted inputs and accepts the kickoff prompts; a match that reaches the tick limit is
+ * aborted. After the last match the session is quit from the main menu.
+ * @param options Options of the simulation.
+ * @param game Game, it must be new.
+ * @param recorded Recorded game, it handles the events and updates the game.
+ */
+template <typename R>
+void playSession(const Options& options, const Game& game, R& recorded)
+{
+    recorded.update();
+
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        recorded.handle(Event{Event::Type::One});
+
+        int input = 0;
+        for (long long tick = 0; tick < options.ticks && game.state() != Game::State::Win; ++tick)
+        {
+            if (game.state() == Game::State::Kickoff)
+            {
+                recorded.handle(Event{Event::Type::Next});
+            }
+
+            const int next = scriptInput(i, tick, 0);
+            sendInput(recorded, true, input, next);
+            input = next;
+
+            recorded.update();
+        }
+        // Release the keys and go back to the main menu.
+        sendInput(recorded, true, input, 0);
+        if (game.state() == Game::State::Win)
+        {
+            recorded.handle(Event{Event::Type::Next});
+        }
+        else
+        {
+            recorded.handle(Event{Event::Type::Quit});
+            recorded.update();
+            recorded.handle(Event{Event::Type::Yes});
+        }
+        recorded.update();
+    }
+
+    recorded.handle(Event{Event::Type::Quit});
+    recorded.update();
+}
+
+/**
+ * @brief Records a session with scripted one-player matches against the AI into a replay file.
+ * @param options Options of the simulation.
+ * @param path Path of the replay file.
+ * @param game Game, it must be new.
+ * @return The number of ticks of the session, or a negative number if the file cannot be written.
+ */
+long long recordSession(const Options& options, const std::filesystem::path& path, Game& game)
+{
+    game.setSeed(static_cast<std::uint32_t>(options.seed));
+
+    auto recorder = ReplayRecorder::create(path, game.seed());
+    if (!recorder)
+    {
+        return -1;
+    }
+
+    RecordedGame recorded(game, *recorder);
+    playSession(options, game, recorded);
+    recorder->finish(recorded.tick(), game.scoreA(), game.scoreB());
+
+    return recorder->good() ? static_cast<long long>(recorded.tick()) : -1;
+}
+
+/**
+ * @brief Plays a replay into a new game as fast as possible.
+ * @param replay Replay.
+ * @param seek Tick to seek to before playing.
+ * @param snapshot Variable where the final state of the game is stored.
+ * @param ticks Variable where the number of ticks played is stored.
+ * @return True if the replay is verified, false otherwise.
+ */
+bool playReplay(const Replay& replay, const long long seek, GameSnapshot& snapshot, std::uint64_t& ticks)
+{
+    Game         game;
+    ReplayPlayer player(replay, game);
+    if (!player.seek(static_cast<std::uint64_t>(seek)))
+    {
+        return false;
+    }
+
+    while (!player.done())
+    {
+        player.step();
+    }
+
+    snapshot = game.snapshot();
+    ticks    = player.tick();
+    return player.verify();
+}
+
+/**
+ * @brief Checks and times the seeks in a replay.
+ *
+ * The replay is played from the start saving the state of the game at the start of `ReplaySeeks` random ticks, then
+ * a player seeks to those ticks in a random order; the state after every seek must be equal to the saved one.
+ * @param replay Replay, it must be finished.
+ * @param seed Seed for the random ticks.
+ * @param seconds Variable where the time spent in the seeks is stored.
+ * @return Number of seeks that do not reach the saved state.
+ */
+long long checkSeeks(const Replay& replay, const long long seed, double& seconds)
+{
+    std::mt19937_64                              random(static_cast<std::uint64_t>(seed));
+    std::uniform_int_distribution<std::uint64_t> distribution(0, replay.ticks);
+    std::vector<std::uint64_t>                   ticks(ReplaySeeks);
+    for (auto& tick : ticks)
+    {
+        tick = distribution(random);
+    }
+    std::sort(ticks.begin(), ticks.end());
+    // Save the states by playing the replay from the start.
+    std::vector<GameSnapshot> states;
+    {
+        Game         game;
+        ReplayPlayer player(replay, game);
+        for (const std::uint64_t tick : ticks)
+        {
+            while (player.tick() < tick)
+            {
+                player.step();
+            }
+            states.push_back(game.snapshot());
+        }
+    }
+    // Seek to the ticks in a random order.
+    std::vector<std::size_t> order(ticks.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::shuffle(order.begin(), order.end(), random);
+
+    Game          game;
+    ReplayPlayer  player(replay, game);
+    long long     mismatches = 0;
+    RealTimeClock clock;
+    for (const std::size_t i : order)
+    {
+        if (!player.seek(ticks[i]) || !(game.snapshot() == states[i]))
+        {
+            ++mismatches;
+        }
+    }
+    seconds = clock.elapsed().count();
+
+    return mismatches;
+}
+
+/**
+ * @brief Checks that a replay file with a damaged keyframe or a wrong number of events in its index is rejected, and
+ * that a file cut in the middle of a keyframe is loaded up to the cut.
+ *
+ * The file is overwritten with the damaged copies, with and without the index of the keyframes.
+ * @param path Path of the replay file.
+ * @param replay Replay loaded from the file.
+ * @return True if the damaged copies are handled as expected or the replay has no keyframes, false otherwise.
+ */
+bool checkDamage(const std::filesystem::path& path, const Replay& replay)
+{
+    if (replay.keyframes.empty())
+    {
+        return true;
+    }
+
+    std::error_code   error;
+    std::vector<char> data(static_cast<std::size_t>(std::filesystem::file_size(path, error)));
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+    // Find the snapshot of the first keyframe.
+    const auto* bytes    = reinterpret_cast<const char*>(&replay.keyframes.front().snapshot);
+    const auto  snapshot = std::search(data.begin(), data.end(), bytes, bytes + sizeof(GameSnapshot));
+    if (snapshot == data.end())
+    {
+        return false;
+    }
+
+    const auto save = [&path](const std::vector<char>& contents)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    };
+    // A keyframe with a wrong magic number, with the index and without it.
+    std::vector<char> damaged = data;
+    damaged[static_cast<std::size_t>(snapshot - data.begin())] ^= 0x01;
+    save(damaged);
+    bool valid = !Replay::load(path);
+
+    // The index has 24 bytes per keyframe and ends with 8 more bytes.
+    const std::size_t index = data.size() - replay.keyframes.size() * 24 - 8;
+    damaged.resize(index);
+    save(damaged);
+    valid = valid && !Replay::load(path);
+    // An index entry with another number of events, a seek from it would skip events or play them twice.
+    std::vector<char> skipped = data;
+    ++skipped[index + 8];
+    save(skipped);
+    valid = valid && !Replay::load(path);
+    // A file cut in the middle of the first keyframe, as if the recording was interrupted.
+    save({data.begin(), snapshot + sizeof(GameSnapshot) / 2});
+    const auto cut = Replay::load(path);
+
+    return valid && cut && !cut->finished && cut->keyframes.empty();
+}
+
+/**
+ * @brief Checks a replay file recorded in the same order as the application.
+ *
+ * The file must be finished, its playback and the seeks through its index must be verified, and the keyframes of its
+ * index must be the same as the ones rebuilt from the records of a copy without the index.
+ * @param options Options of the simulation.
+ * @param path Path of the replay file, it is overwritten.
+ * @return True if the file is valid, false otherwise.
+ */
+bool checkAppRecording(const Options& options, const std::filesystem::path& path)
+{
+    {
+        Game game;
+        game.setSeed(static_cast<std::uint32_t>(options.seed));
+
+        auto recorder = ReplayRecorder::create(path, game.seed());
+        if (!recorder)
+        {
+            return false;
+        }
+
+        QueuedGame recorded(game, *recorder);
+        playSession(options, game, recorded);
+        recorded.finish();
+        if (!recorder->good())
+        {
+            return false;
+        }
+    }
+
+    const auto replay = Replay::load(path);
+    if (!replay || !replay->finished)
+    {
+        return false;
+    }
+
+    GameSnapshot  played;
+    std::uint64_t ticks   = 0;
+    double        seconds = 0.0;
+    if (!playReplay(*replay, 0, played, ticks) || checkSeeks(*replay, options.seed, seconds) != 0)
+    {
+        return false;
+    }
+    // Remove the index (24 bytes per keyframe and 8 more bytes) so the keyframes are rebuilt from the records.
+    std::error_code   error;
+    std::vector<char> data(static_cast<std::size_t>(std::filesystem::file_size(path, error)));
+    {
+        std::ifstream file(path, std::ios::binary);
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    const std::size_t index = replay->keyframes.size() * 24 + 8;
+    if (data.size() < index)
+    {
+        return false;
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size() - index));
+    }
+
+    const auto rebuilt = Replay::load(path);
+    if (!rebuilt || !rebuilt->finished || rebuilt->events != replay->events ||
+        rebuilt->keyframes.size() != replay->keyframes.size())
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < replay->keyframes.size(); ++i)
+    {
+        const Replay::Keyframe& a = replay->keyframes[i];
+        const Replay::Keyframe& b = rebuilt->keyframes[i];
+        if (a.tick != b.tick || a.event != b.event || !(a.snapshot == b.snapshot))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool runReplay(const Options& options)
+{
+    GameSnapshot  played;
+    std::uint64_t playedTicks = 0;
+    // Play a replay file.
+    if (!options.replay.empty())
+    {
+        const auto replay = Replay::load(options.replay);
+        if (!replay)
+        {
+            std::cerr << "Unable to load the replay file " << options.replay << std::endl;
+            return false;
+        }
+
+        RealTimeClock clock;
+        const bool    verified = playReplay(*replay, options.seek, played, playedTicks);
+        const double  seconds  = clock.elapsed().count();
+
+        std::cout << "Replay:    " << options.replay << (replay->finished ? "" : " (unfinished)") << std::endl
+                  << "Events:    " << replay->events.size() << std::endl
+                  << "Keyframes: " << replay->keyframes.size() << std::endl
+                  << "Ticks:     " << playedTicks << std::endl
+                  << "Score:     " << played.scoreA << " - " << played.scoreB << std::endl
+                  << "Time:      " << seconds << " s (" << static_cast<double>(playedTicks) / seconds << " ticks/s)" << std::endl
+                  << "Verified:  " << (verified ? "yes" : "NO") << std::endl;
+
+        return verified;
+    }
+    // Record a session.
+    const auto path = std::filesystem::temp_directory_path() / ("pong-sim-" + std::to_string(options.seed) + ".replay");
+
+    Game          recorded;
+    RealTimeClock clock;
+    const long long ticks         = recordSession(options, path, recorded);
+    const double    recordSeconds = clock.elapsed().count();
+    if (ticks < 0)
+    {
+        std::cerr << "Unable to write the replay file " << path.string() << std::endl;
+        return false;
+    }
+    // Load it and play it back.
+    std::error_code error;
+    const auto      bytes  = std::filesystem::file_size(path, error);
+    const auto      replay = Replay::load(path);
+    const bool      damage = replay && checkDamage(path, *replay);
+    const bool      app    = checkAppRecording(options, path);
+    std::filesystem::remove(path, error);
+    if (!replay)
+    {
+        std::cerr << "Unable to load the replay file " << path.string() << std::endl;
+        return false;
+    }
+
+    clock.restart();
+    const bool   verified    = playReplay(*replay, 0, played, playedTicks);
+    const double playSeconds = clock.elapsed().count();
+    const bool   equal       = played == recorded.snapshot();
+    const auto   events      = static_cast<double>(replay->events.size());
+
+    double          seekSeconds = 0.0;
+    const long long mismatches  = checkSeeks(*replay, options.seed, seekSeconds);
+    const auto      seeks       = static_cast<double>(ReplaySeeks);
+
+    std::cout << "Matches:   " << options.matches << std::endl
+              << "Ticks:     " << ticks << std::endl
+              << "Events:    " << replay->events.size() << std::endl
+              << "Keyframes: " << replay->keyframes.size() << std::endl
+              << "Size:      " << bytes << " bytes (" << static_cast<double>(bytes) / events << " bytes/event)" << std::endl
+              << "Record:    " << recordSeconds << " s (" << static_cast<double>(ticks) / recordSeconds << " ticks/s)" << std::endl
+              << "Play:      " << playSeconds << " s (" << static_cast<double>(ticks) / playSeconds << " ticks/s)" << std::endl
+              << "Verified:  " << (verified ? "yes" : "NO") << std::endl
+              << "Equal:     " << (equal ? "yes" : "NO") << std::endl
+              << "Seek:      " << 1e6 * seekSeconds / seeks << " us per seek (" << 1e6 * playSeconds / 2.0 << " us to play half the replay)" << std::endl
+              << "Bad seeks: " << mismatches << "/" << ReplaySeeks << std::endl
+              << "Damaged:   " << (damage ? "rejected" : "ACCEPTED") << std::endl
+              << "App file:  " << (app ? "verified" : "NOT verified") << std::endl;
+
+    return verified && equal && mismatches == 0 && damage && app;
+}
+
+} // namespace pong::sim
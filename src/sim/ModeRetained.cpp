@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Renderer.hpp"
+#include "QuadBatch.hpp"
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of frames drawn in every state by the retained mode. */
+constexpr long long RetainedFrames = 600;
+
+/**
+ * @brief A renderer that counts the bytes that `RendererGL3` uploads in the instances layout, without drawing.
+ *
+ * With the static meshes retained, the meshes are uploaded again at the end of the frames in which one is recorded or
+ * destroyed, and only the quads queued are uploaded every frame, as `RendererGL3` does. Otherwise drawing a mesh
+ * queues its quads, as the entities did before the static meshes.
+ */
+class RendererCounter final : public Renderer
+{
+public:
+
+    /** @brief Number of bytes of a quad. */
+    static constexpr std::size_t QuadBytes = QuadBatch::bytesPerQuad(QuadBatch::Layout::Instances);
+
+    /**
+     * @brief Constructor.
+     * @param retained True to keep the static meshes, false to queue their quads every frame.
+     */
+    explicit RendererCounter(const bool retained) noexcept : mRetained(retained) {}
+
+    /**
+     * @brief Gets the number of bytes uploaded.
+     * @return Number of bytes.
+     */
+    [[nodiscard]] std::size_t bytes() const noexcept { return mBytes; }
+
+    /**
+     * @brief Gets the number of quads drawn, queued or from the meshes.
+     * @return Number of quads.
+     */
+    [[nodiscard]] std::size_t quads() const noexcept { return mQuads; }
+
+    void beginFrame() override {}
+
+    void endFrame() override
+    {
+        if (mRetained && mMeshesChanged)
+        {
+            for (const std::size_t quads : mMeshes)
+            {
+                mBytes += quads * QuadBytes;
+            }
+            mMeshesChanged = false;
+        }
+    }
+
+    void queueQuad(const glm::vec2& position, const glm::vec2& size) override
+    {
+        queueQuad(position, size, glm::vec4(1.0f));
+    }
+
+    void queueQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color) override
+    {
+        if (mRecording)
+        {
+            ++mMeshes.back();
+        }
+        else
+        {
+            mBytes += QuadBytes;
+            ++mQuads;
+        }
+    }
+
+    void beginMesh() override
+    {
+        mMeshes.push_back(0);
+        mRecording = true;
+    }
+
+    MeshId endMesh() override
+    {
+        mRecording     = false;
+        mMeshesChanged = true;
+
+        return static_cast<MeshId>(mMeshes.size() - 1);
+    }
+
+    void drawMesh(const MeshId id) override
+    {
+        mQuads += mMeshes[id];
+        mBytes += mRetained ? 0 : mMeshes[id] * QuadBytes;
+    }
+
+    void destroyMesh(const MeshId id) override
+    {
+        mMeshes[id]    = 0;
+        mMeshesChanged = true;
+    }
+
+private:
+
+    /** @brief Flag indicating whether the static meshes are kept or their quads are queued every frame. */
+    bool mRetained;
+
+    /** @brief Number of quads of every mesh, indexed by their identifier, which is never reused. */
+    std::vector<std::size_t> mMeshes;
+
+    /** @brief Flag indicating whether a mesh is being recorded, the last one. */
+    bool mRecording = false;
+
+    /** @brief Flag indicating whether the meshes changed since they were uploaded. */
+    bool mMeshesChanged = false;
+
+    /** @brief Number of bytes uploaded. */
+    std::size_t mBytes = 0;
+
+    /** @brief Number of quads drawn. */
+    std::size_t mQuads = 0;
+};
+
+} // namespace
+
+bool runRetained(const Options& options)
+{
+    RendererCounter immediate(false);
+    RendererCounter retained(true);
+    // A game for every renderer, the meshes of the entities belong to the renderer that recorded them.
+    Game gameImmediate;
+    Game gameRetained;
+    gameImmediate.setSeed(static_cast<std::uint32_t>(options.seed));
+    gameRetained .setSeed(static_cast<std::uint32_t>(options.seed));
+    // The first update moves the games to the main menu.
+    gameImmediate.update(TickTime);
+    gameRetained .update(TickTime);
+
+    bool valid = true;
+
+    std::cout << "Frames/state:   " << RetainedFrames << std::endl
+              << "Transition      Immediate (B/frame)  Retained (B/frame)  Reduction" << std::endl;
+
+    for (const MenuTransition& transition : MenuCycle)
+    {
+        const std::size_t immediateBytes = immediate.bytes();
+        const std::size_t retainedBytes  = retained .bytes();
+        const std::size_t immediateQuads = immediate.quads();
+        const std::size_t retainedQuads  = retained .quads();
+
+        for (Game* game : {&gameImmediate, &gameRetained})
+        {
+            if (transition.event == Event::Type::Yes)
+            {
+                game->handle(Event{Event::Type::Quit});
+            }
+            game->handle(Event{transition.event});
+        }
+
+        for (long long frame = 0; frame < RetainedFrames; ++frame)
+        {
+            for (auto [game, renderer] : {std::pair<Game*, Renderer*>{&gameImmediate, &immediate}, {&gameRetained, &retained}})
+            {
+                game->update(TickTime);
+                renderer->beginFrame();
+                game->draw(*renderer, 1.0f);
+                renderer->endFrame();
+            }
+        }
+
+        const double before = static_cast<double>(immediate.bytes() - immediateBytes) / static_cast<double>(RetainedFrames);
+        const double after  = static_cast<double>(retained .bytes() - retainedBytes)  / static_cast<double>(RetainedFrames);
+        valid = valid && immediate.quads() - immediateQuads == retained.quads() - retainedQuads && after < before &&
+                gameImmediate.state() == transition.state && gameRetained.state() == transition.state;
+
+        std::cout << std::left << std::setw(16) << transition.name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(19) << before << std::setw(20) << after << std::setw(10) << before / after << "x" << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6)
+              << "Quads drawn:    " << immediate.quads() << " immediate, " << retained.quads() << " retained" << std::endl
+              << "Result:         " << (valid ? "same quads, fewer bytes" : "UNEXPECTED") << std::endl;
+
+    return valid;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,55 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RendererNull.hpp"
+#include "RealTimeClock.hpp"
+#include <iostream>
+
+namespace pong::sim {
+
+bool runScene(const Options& options)
+{
+    RendererNull renderer;
+    Results      results;
+
+    RealTimeClock clock;
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        playMatch(options, renderer, results, options.seed + i);
+    }
+
+    printResults("scene", options.matches, results, clock.elapsed().count());
+
+    const bool valid = results.points == results.scores && results.lostEvents == 0;
+
+    std::cout << "Wall hits:      " << results.wallHits << std::endl
+              << "Paddle hits:    " << results.paddleHits << std::endl
+              << "Points:         " << results.points << (valid ? "" : " MISMATCH") << std::endl;
+
+    return valid;
+}
+
+} // namespace pong::sim
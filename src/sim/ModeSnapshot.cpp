@@ -0,0 +1,143 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "RealTimeClock.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Number of ticks between the snapshots replayed by the snapshot mode. */
+constexpr long long SnapshotInterval = 600;
+
+/** @brief Number of ticks replayed from every snapshot by the snapshot mode. */
+constexpr long long SnapshotReplayTicks = 600;
+
+/** @brief Number of times the snapshot mode saves and restores the state to time it. */
+constexpr long long SnapshotIterations = 1'000'000;
+
+} // namespace
+
+bool runSnapshot(const Options& options)
+{
+    std::vector<GameSnapshot> history;
+    long long                 ticks      = 0;
+    long long                 replays    = 0;
+    long long                 mismatches = 0;
+    // Replays a match from a snapshot, counting the ticks that differ from the original ones.
+    const auto replay = [&history, &mismatches](Game& game, const std::size_t from)
+    {
+        if (!game.restore(history[from]))
+        {
+            ++mismatches;
+            return;
+        }
+
+        const std::size_t to = std::min(history.size(), from + static_cast<std::size_t>(SnapshotReplayTicks) + 1);
+        for (std::size_t tick = from + 1; tick < to; ++tick)
+        {
+            stepMatch(game);
+            if (!(game.snapshot() == history[tick]))
+            {
+                ++mismatches;
+                return;
+            }
+        }
+    };
+
+    for (long long i = 0; i < options.matches; ++i)
+    {
+        // Play the match, saving the state after every tick.
+        Game game;
+        startAiMatch(game, static_cast<std::uint32_t>(options.seed + i));
+
+        history.clear();
+        history.push_back(game.snapshot());
+        for (long long tick = 0; tick < options.ticks && game.state() != Game::State::Win; ++tick)
+        {
+            stepMatch(game);
+            history.push_back(game.snapshot());
+        }
+        ticks += static_cast<long long>(history.size()) - 1;
+        // Replay it from some of the snapshots, in place and in a new game.
+        for (std::size_t from = 0; from < history.size(); from += SnapshotInterval)
+        {
+            Game resumed;
+            replay(game,    from);
+            replay(resumed, from);
+            replays += 2;
+        }
+    }
+    // Time the operations with the snapshots of the last match, the restores in place are the common case (e.g. a
+    // search that explores several continuations of the same match).
+    Game game;
+    if (!game.restore(history.back()))
+    {
+        ++mismatches;
+    }
+
+    const std::size_t count = history.size();
+    RealTimeClock     clock;
+    for (long long i = 0; i < SnapshotIterations; ++i)
+    {
+        history[static_cast<std::size_t>(i) % count] = game.snapshot();
+    }
+    const double saveSeconds = clock.elapsed().count();
+
+    long long failures = 0;
+    clock.restart();
+    for (long long i = 0; i < SnapshotIterations; ++i)
+    {
+        failures += game.restore(history[static_cast<std::size_t>(i) % count]) ? 0 : 1;
+    }
+    const double restoreSeconds = clock.elapsed().count();
+
+    clock.restart();
+    for (long long i = 0; i < SnapshotIterations / 100; ++i)
+    {
+        Game resumed;
+        failures += resumed.restore(history[static_cast<std::size_t>(i) % count]) ? 0 : 1;
+    }
+    const double rebuildSeconds = clock.elapsed().count();
+
+    const auto nanoseconds = [](const double seconds, const long long operations) { return 1e9 * seconds / static_cast<double>(operations); };
+
+    std::cout << "[snapshot]" << std::endl
+              << "Snapshot size:  " << sizeof(GameSnapshot) << " bytes" << std::endl
+              << "Matches:        " << options.matches << std::endl
+              << "Ticks:          " << ticks << std::endl
+              << "Replays:        " << replays << ", " << mismatches << " mismatches" << std::endl
+              << "Save:           " << nanoseconds(saveSeconds,    SnapshotIterations)       << " ns" << std::endl
+              << "Restore:        " << nanoseconds(restoreSeconds, SnapshotIterations)       << " ns (in place)" << std::endl
+              << "Restore (new):  " << nanoseconds(rebuildSeconds, SnapshotIterations / 100) << " ns (new game, scenes rebuilt)" << std::endl;
+
+    return mismatches == 0 && failures == 0;
+}
+
+} // namespace pong::sim
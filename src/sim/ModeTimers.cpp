@@ -0,0 +1,208 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "ControllerAI.hpp"
+#include "RealTimeClock.hpp"
+#include "TimerWheel.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Numbers of AI timers run at once by the timers mode. */
+constexpr std::array<long long, 4> TimerCounts = {1, 100, 10'000, 100'000};
+
+/** @brief Number of ticks run by the timers mode. */
+constexpr long long TimerTicks = 6'000;
+
+/** @brief Number of timers with random deadlines checked by the timers mode. */
+constexpr long long TimerChecks = 100'000;
+
+/**
+ * @brief Defines a periodic update of the AI for the timers mode.
+ */
+struct PeriodicUpdate
+{
+    /** @brief Interval between two updates. */
+    TimeDuration interval;
+
+    /** @brief Time elapsed since the last update, polling. */
+    TimeDuration elapsed;
+
+    /** @brief Number of ticks between two updates, timer wheel. */
+    std::uint64_t period = 0;
+
+    /** @brief Timers of the update, timer wheel. */
+    TimerWheel* timers = nullptr;
+
+    /** @brief Number of updates. */
+    long long updates = 0;
+};
+
+/**
+ * @brief Counts an update and schedules the next one, as `ControllerAI` does.
+ * @param context Periodic update.
+ */
+void expirePeriodicUpdate(void* context)
+{
+    auto& update = *static_cast<PeriodicUpdate*>(context);
+    ++update.updates;
+    update.timers->schedule(update.timers->now() + update.period, expirePeriodicUpdate, context);
+}
+
+/**
+ * @brief Schedules timers at random deadlines, cancels some of them, and checks that the others expire exactly at
+ * their deadlines, including the ones in the upper levels and beyond the range of the wheel.
+ * @param seed Seed of the random generator.
+ * @return True if every timer expired at its deadline and no cancelled timer expired, false otherwise.
+ */
+bool checkDeadlines(const long long seed)
+{
+    struct Expiry
+    {
+        TimerWheel*   timers   = nullptr;
+        std::uint64_t deadline = 0;
+        std::uint64_t expired  = 0;
+        bool          cancelled = false;
+    };
+
+    std::mt19937_64 random(static_cast<std::uint64_t>(seed));
+    std::uniform_int_distribution<std::uint64_t> near(1, 5'000);
+    std::uniform_int_distribution<std::uint64_t> far(1, TimerWheel::Range + 5'000);
+
+    TimerWheel          timers;
+    std::vector<Expiry> expiries(TimerChecks);
+    std::uint64_t       last = 0;
+    for (std::size_t i = 0; i < expiries.size(); ++i)
+    {
+        // Most deadlines are close, as the ones of the game, the others cover every level.
+        Expiry& expiry  = expiries[i];
+        expiry.timers   = &timers;
+        expiry.deadline = i % 8 == 0 ? far(random) : near(random);
+        last            = std::max(last, expiry.deadline);
+
+        const TimerWheel::Timer timer = timers.schedule(expiry.deadline, [](void* context)
+        {
+            auto& expired   = *static_cast<Expiry*>(context);
+            expired.expired = expired.timers->now();
+        }, &expiry);
+
+        if (i % 4 == 1)
+        {
+            expiry.cancelled = timers.cancel(timer);
+        }
+    }
+
+    while (timers.now() < last)
+    {
+        timers.advance();
+    }
+
+    return timers.size() == 0 && std::ranges::all_of(expiries, [](const Expiry& expiry)
+    {
+        return expiry.expired == (expiry.cancelled ? 0 : expiry.deadline);
+    });
+}
+
+} // namespace
+
+bool runTimers(const Options& options)
+{
+    std::mt19937_64 random(static_cast<std::uint64_t>(options.seed));
+    const std::uint64_t period = ControllerAI::targetUpdateTicks(ControllerAI::TargetUpdateInterval, TickTime);
+    std::uniform_int_distribution<std::uint64_t> phase(0, period - 1);
+    bool equal = true;
+
+    std::cout << "Ticks:          " << TimerTicks << std::endl
+              << "Period:         " << period << " ticks" << std::endl
+              << "AIs       Polling (ns)  Wheel (ns)  Speedup" << std::endl;
+
+    for (const long long count : TimerCounts)
+    {
+        TimerWheel                  timers;
+        std::vector<PeriodicUpdate> polled(static_cast<std::size_t>(count));
+        std::vector<PeriodicUpdate> scheduled(static_cast<std::size_t>(count));
+        for (std::size_t i = 0; i < polled.size(); ++i)
+        {
+            // The same phase on both ways.
+            const std::uint64_t ticks = phase(random);
+            polled[i].interval = ControllerAI::TargetUpdateInterval;
+            for (std::uint64_t tick = 0; tick < ticks; ++tick)
+            {
+                polled[i].elapsed += TickTime;
+            }
+            scheduled[i].period = period;
+            scheduled[i].timers = &timers;
+            timers.schedule(period - ticks, expirePeriodicUpdate, &scheduled[i]);
+        }
+
+        RealTimeClock clock;
+        for (long long tick = 0; tick < TimerTicks; ++tick)
+        {
+            for (PeriodicUpdate& update : polled)
+            {
+                update.elapsed += TickTime;
+                if (update.elapsed > update.interval)
+                {
+                    update.elapsed = TimeDuration::zero();
+                    ++update.updates;
+                }
+            }
+        }
+        const double polling = clock.elapsed().count();
+
+        clock.restart();
+        for (long long tick = 0; tick < TimerTicks; ++tick)
+        {
+            timers.advance();
+        }
+        const double wheel = clock.elapsed().count();
+
+        equal = std::ranges::equal(polled, scheduled, {}, &PeriodicUpdate::updates, &PeriodicUpdate::updates) && equal;
+        // Nanoseconds per AI and tick.
+        const double scale = 1e9 / static_cast<double>(count * TimerTicks);
+
+        std::cout << std::left  << std::setw(8) << count << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << polling * scale << std::setw(12) << wheel * scale
+                  << std::setw(8) << polling / wheel << "x" << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        std::cout << std::setprecision(6);
+    }
+
+    const bool exact = checkDeadlines(options.seed);
+    std::cout << "Updates:        " << (equal ? "equal" : "DIFFERENT") << std::endl
+              << "Deadlines:      " << (exact ? "exact" : "WRONG") << std::endl;
+
+    return equal && exact;
+}
+
+} // namespace pong::sim
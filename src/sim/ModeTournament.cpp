@@ -0,0 +1,106 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include "Fixtures.hpp"
+#include "Tournament.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace pong::sim {
+namespace           {
+
+/**
+ * @brief Gets the entrants of the tournament mode: the AI of the game and variants that react faster or slower, and
+ * aim better or worse.
+ * @return Entrants.
+ */
+std::vector<Tournament::Entrant> tournamentEntrants()
+{
+    using namespace std::chrono_literals;
+
+    return {
+        {"default", {}},
+        {"quick",   {.targetUpdateInterval = 150ms}},
+        {"slow",    {.targetUpdateInterval = 500ms}},
+        {"precise", {.hitPositionError = 0.05f}},
+        {"sloppy",  {.hitPositionError = 0.40f}}
+    };
+}
+
+} // namespace
+
+bool runTournament(const Options& options)
+{
+    const Tournament tournament(tournamentEntrants(), static_cast<int>(options.rounds), static_cast<std::uint64_t>(options.seed), options.ticks);
+    const int        maxThreads = options.threads > 0 ? static_cast<int>(options.threads) : Tournament::defaultThreads();
+
+    std::vector<int> counts;
+    for (int threads = 1; threads < maxThreads; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    std::cout << "[tournament]" << std::endl
+              << "Matches:        " << tournament.matches() << std::endl;
+
+    bool               success = true;
+    Tournament::Report first;
+    for (const int threads : counts)
+    {
+        const Tournament::Report report = tournament.run(threads);
+        if (threads == counts.front())
+        {
+            first = report;
+        }
+        // The results must not depend on the number of threads.
+        const bool   same       = report.standings == first.standings && report.ticks == first.ticks;
+        const double rate       = report.seconds > 0.0 ? static_cast<double>(report.matches) / report.seconds : 0.0;
+        const double firstRate  = first.seconds  > 0.0 ? static_cast<double>(first.matches)  / first.seconds  : 0.0;
+        const double speedup    = firstRate > 0.0 ? rate / firstRate : 0.0;
+
+        std::cout << "Threads " << report.threads << ": " << rate << " matches/s, speedup " << speedup
+                  << ", efficiency " << speedup / report.threads << ", steals " << report.steals
+                  << (same ? "" : " MISMATCH") << std::endl;
+
+        success = success && same;
+    }
+
+    std::cout << "Unfinished:     " << first.unfinished << std::endl
+              << "Entrant   Matches  Wins  Win %  Points for/against" << std::endl;
+    for (const Tournament::Standing& standing : first.standings)
+    {
+        std::cout << standing.name << std::string(standing.name.size() < 10 ? 10 - standing.name.size() : 1, ' ')
+                  << standing.matches << "  " << standing.wins << "  "
+                  << (standing.matches > 0 ? 100.0 * static_cast<double>(standing.wins) / static_cast<double>(standing.matches) : 0.0)
+                  << "  " << standing.pointsFor << "/" << standing.pointsAgainst << std::endl;
+    }
+
+    return success;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#include "Modes.hpp"
+#include <algorithm>
+#include <array>
+
+namespace pong::sim {
+namespace           {
+
+/** @brief Registry of the simulation modes. */
+constexpr std::array<Mode, 21> Modes =
+{{
+    {"scene",       "AI vs AI matches played through the game scenes.", runScene},
+    {"batch",       "Scripted matches played by the structure-of-arrays batch simulator.", runBatch},
+    {"compare",     "Scripted matches played by both, checking the results are equal.", runCompare},
+    {"kernel",      "Random circle/line pairs tested by every collision kernel.", runKernel},
+    {"swept",       "Scripted batch matches with larger steps and continuous collisions.", runSwept},
+    {"analytic",    "AI vs AI matches played event to event, checked against the game scenes.", runAnalytic},
+    {"fixed",       "Balls bouncing with the fixed-point and floating-point physics.", runFixed},
+    {"tournament",  "Round-robin tournament between AI variants on 1 to N threads.", runTournament},
+    {"snapshot",    "AI vs AI matches replayed from snapshots, checked against the originals.", runSnapshot},
+    {"netplay",     "Two-player matches between rollback peers over a simulated UDP link.", runNetplay},
+    {"replay",      "Matches against the AI recorded into a replay and played back.", runReplay},
+    {"entities",    "Entities updated from the pools of a scene and from the heap.", runEntities},
+    {"multiball",   "1 to 10000 colliding balls, with the grid broadphase and all-pairs.", runMultiBall},
+    {"allocations", "Menu/match round trips, counting the heap allocations.", runAllocations},
+    {"ecs",         "1 to 10000 AI vs AI matches through the game scenes and in an ECS world.", runEcs},
+    {"menus",       "Transitions between the menus and the matches, with their latency.", runMenus},
+    {"timers",      "1 to 100000 AI updates polled every tick and scheduled in a timer wheel.", runTimers},
+    {"pipeline",    "1 to 10000 AI vs AI matches updated serially and by a job graph on 1 to N threads.", runPipeline},
+    {"quads",       "Frames of quads queued as expanded vertices, packed vertices and instances.", runQuads},
+    {"retained",    "The menus and a match drawn with and without static meshes, with the bytes uploaded.", runRetained},
+    {"frames",      "The menus and the matches drawn at 144 Hz, counting the unchanged frames skipped.", runFrames},
+}};
+
+} // namespace
+
+std::span<const Mode> modes() noexcept
+{
+    return Modes;
+}
+
+const Mode* findMode(const std::string_view name) noexcept
+{
+    const auto mode = std::find_if(Modes.begin(), Modes.end(), [name](const Mode& m) { return m.name == name; });
+    return mode != Modes.end() ? &*mode : nullptr;
+}
+
+} // namespace pong::sim
@@ -0,0 +1,282 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Options.hpp"
+#include <span>
+#include <string_view>
+
+namespace pong::sim {
+
+/**
+ * @brief Defines a simulation mode, an entry of the registry used by the command line and the usage.
+ *
+ * Every mode lives in its own translation unit (`ModeScene.cpp`, `ModeBatch.cpp`, ...) and is added to the registry
+ * in `Modes.cpp`.
+ */
+struct Mode
+{
+    /** @brief Name used to select the mode with `--mode`. */
+    std::string_view name;
+
+    /** @brief Description printed by the usage. */
+    std::string_view description;
+
+    /** @brief Runs the mode, returning true if the results are the expected ones. */
+    bool (*run)(const Options& options);
+};
+
+/**
+ * @brief Gets the simulation modes, in the order they are listed by the usage.
+ * @return Modes.
+ */
+[[nodiscard]] std::span<const Mode> modes() noexcept;
+
+/**
+ * @brief Finds a simulation mode.
+ * @param name Name of the mode.
+ * @return Mode, null if there is no mode with that name.
+ */
+[[nodiscard]] const Mode* findMode(std::string_view name) noexcept;
+
+/**
+ * @brief Runs the AI vs AI matches through the game scenes.
+ *
+ * The statistics of the gameplay events are printed too, and the points they report must add up to the final scores.
+ * @param options Options of the simulation.
+ * @return True if the gameplay events agree with the scores, false otherwise.
+ */
+bool runScene(const Options& options);
+
+/**
+ * @brief Runs the scripted matches with a batch simulator.
+ * @param options Options of the simulation.
+ * @return True on success, false otherwise.
+ */
+bool runBatch(const Options& options);
+
+/**
+ * @brief Runs the scripted matches through the game scenes and with a batch simulator, and compares the results.
+ * @param options Options of the simulation.
+ * @return True if the results of both simulations are equal, false otherwise.
+ */
+bool runCompare(const Options& options);
+
+/**
+ * @brief Tests random circle/line pairs with every supported collision kernel and compares the results against the
+ * scalar `collisionCircleLine`.
+ *
+ * The pairs look like the ball against the sides of a paddle: mostly vertical lines with circles around them, so about
+ * half of them collide.
+ * @param options Options of the simulation.
+ * @return True if the results of all the kernels are equal to the scalar ones, false otherwise.
+ */
+bool runKernel(const Options& options);
+
+/**
+ * @brief Runs the scripted matches with a batch simulator at several step sizes, with discrete and continuous collision
+ * detection, and compares the scores against the ones of the tick rate of the game.
+ *
+ * The continuous collisions do not depend on the step size, so the swept simulations must get exactly the same scores
+ * with any step. The discrete simulation only works at the tick rate of the game: with larger steps the ball goes
+ * through the paddles and the scores diverge. A ball trapped between two walls must also stay inside the table when
+ * it bounces more times than a sweep resolves.
+ * @param options Options of the simulation.
+ * @return True if the swept simulations get the same scores with every step size and the trapped ball stays inside the
+ * table, false otherwise.
+ */
+bool runSwept(const Options& options);
+
+/**
+ * @brief Runs AI vs AI matches with the analytic simulation and through the game scenes, and compares them.
+ *
+ * The analytic simulation uses its own random generator and the swept collisions, so the matches are not the same ones
+ * and only their statistics can be compared: the ratio of matches won by player A must agree within four standard
+ * errors, and the mean duration of a match within MaxDurationError (collisions at exact times instead of at ticks make
+ * the rallies slightly longer, so the durations are close but not equal).
+ * @param options Options of the simulation.
+ * @return True if the statistics agree, false otherwise.
+ */
+bool runAnalytic(const Options& options);
+
+/**
+ * @brief Bounces balls with the fixed-point and the floating-point physics and compares their speed.
+ *
+ * The checksum of the fixed-point run only depends on integer arithmetic, so it must be the same for every compiler,
+ * optimization level and floating-point flag; the floating-point one may change. An AI vs AI match is also played from
+ * a fixed seed, and in a fixed-point build the checksum of its final state must be the pinned one.
+ * @param options Options of the simulation.
+ * @return True if the match ends with the pinned checksum or the build uses floating-point numbers, false otherwise.
+ */
+bool runFixed(const Options& options);
+
+/**
+ * @brief Plays a round-robin tournament between variants of the AI with 1, 2, 4... threads up to the maximum, and
+ * reports the matches per second of each run.
+ * @param options Options of the simulation.
+ * @return True if all the runs have the same results, false otherwise.
+ */
+bool runTournament(const Options& options);
+
+/**
+ * @brief Replays AI vs AI matches from snapshots and times the snapshots.
+ *
+ * Every match is played once saving the state after every tick. Then, every `SnapshotInterval` ticks, the state is
+ * restored into the same game (in place) and into a new one (rebuilding the scenes) and both are played for
+ * `SnapshotReplayTicks` ticks; the state after every tick must be equal to the one of the original match.
+ * @param options Options of the simulation.
+ * @return True if every replay matches the original match, false otherwise.
+ */
+bool runSnapshot(const Options& options);
+
+/**
+ * @brief Plays scripted two-player matches between two rollback peers on this machine.
+ *
+ * Each peer has its own game and its own UDP socket on the loopback interface, and its packets go through a simulated
+ * link with latency, jitter and loss. Both peers advance once per frame of 1/60 s of simulated time (as fast as
+ * possible). At the end of every match both games must be equal to a game that received the inputs without a network.
+ * @param options Options of the simulation.
+ * @return True if the peers and the reference game agree in every match, false otherwise.
+ */
+bool runNetplay(const Options& options);
+
+/**
+ * @brief Records scripted matches against the AI into a replay file and plays it back, or plays a replay file.
+ *
+ * The played game must end with the ticks and the scores stored in the replay and, when the session is recorded here,
+ * exactly in the same state as the recorded game; the seeks to random ticks must also reach the same states as playing
+ * the replay from the start. A copy of the file with a damaged keyframe must not load.
+ * @param options Options of the simulation.
+ * @return True if the replay is verified, false otherwise.
+ */
+bool runReplay(const Options& options);
+
+/**
+ * @brief Updates and draws the same entities from the pools of a scene and from individual heap allocations.
+ *
+ * The balls do not interact with each other and the paddles do not move, so the order of the updates does not change
+ * the results and both storages must end with the same balls. The handles of the balls of the pools must find them
+ * until the scene is cleared, and none of them must find an entity after that, even when the scene is filled again.
+ * @param options Options of the simulation.
+ * @return True if both storages end with the same balls and the handles pass the checks, false otherwise.
+ */
+bool runEntities(const Options& options);
+
+/**
+ * @brief Simulates from 1 to 10000 colliding balls with the grid broadphase, and with all-pairs tests for the smaller
+ * numbers, and reports the cost per ball of each tick.
+ *
+ * The grid must find every pair of overlapping balls that the all-pairs tests find; the mode also plays a match with
+ * many balls through the game, which must end with a winner.
+ * @param options Options of the simulation.
+ * @return True if the checks pass, false otherwise.
+ */
+bool runMultiBall(const Options& options);
+
+/**
+ * @brief Counts the calls to the global `operator new` during round trips between the menus and the matches.
+ *
+ * The scenes keep their entities in arenas that are reset by every state transition, so once the arenas are large
+ * enough (after the warm-up rounds) the round trips must not allocate anything from the heap.
+ * @param options Options of the simulation.
+ * @return True if the measured round trips do not allocate memory, false otherwise.
+ */
+bool runAllocations(const Options& options);
+
+/**
+ * @brief Plays the same AI vs AI matches through the game scenes and in an ECS world, with 1, 100 and 10000 matches,
+ * and reports the cost per match and tick of each one.
+ * @param options Options of the simulation.
+ * @return True if every match ends in the same state on both paths, false otherwise.
+ */
+bool runEcs(const Options& options);
+
+/**
+ * @brief Goes through the transitions between the menus and a two-player match, and reports the latency of each one.
+ *
+ * The latency of a transition is split into handling its event and drawing the first frame of the new state, which is
+ * when the labels that were not laid out yet lay out their text. The match is paused again between the last two
+ * transitions of the cycle, without measuring it.
+ * @param options Options of the simulation.
+ * @return True if every transition ends in the expected state, false otherwise.
+ */
+bool runMenus(const Options& options);
+
+/**
+ * @brief Runs the periodic updates of 1 to 100000 AIs polled every tick and scheduled in a timer wheel, and reports the
+ * cost per AI and tick of each one.
+ *
+ * The updates have the interval of the game, with random phases, and the polling accumulates the time of every tick as
+ * `ControllerAI` used to.
+ * @param options Options of the simulation.
+ * @return True if both ways update every AI the same number of times and the deadlines check passes, false otherwise.
+ */
+bool runTimers(const Options& options);
+
+/**
+ * @brief Updates and draws 1, 100 and 10000 AI vs AI matches one after the other and through the job graph of a
+ * `MatchHost` with 1, 2, 4... threads, and reports the cost per match and tick of each one.
+ *
+ * The kickoff prompts are accepted through the queues of events of the host. The games build their menus the first
+ * time they show them, so the ticks of the host must allocate as many times as the serial updates, no more.
+ * @param options Options of the simulation.
+ * @return True if every hosted match ends in the same state as updated on its own and the ticks of the host do not
+ * allocate more than the games, false otherwise.
+ */
+bool runPipeline(const Options& options);
+
+/**
+ * @brief Queues frames of 100 to 1000000 random quads expanded into vertices, into packed vertices and as instances of
+ * a unit quad, copying the data of every frame as a renderer uploads it, and reports the quads per second of each
+ * layout.
+ *
+ * Only the work of the CPU is measured, the draw calls need an OpenGL context.
+ * @param options Options of the simulation.
+ * @return True if all the layouts describe the same quads, false otherwise.
+ */
+bool runQuads(const Options& options);
+
+/**
+ * @brief Goes through the transitions between the menus and a two-player match, drawing the same frames of every
+ * state with the static meshes retained and with their quads queued every frame, and reports the bytes uploaded per
+ * frame.
+ * @param options Options of the simulation.
+ * @return True if both renderers draw the same quads and retaining the meshes uploads fewer bytes, false otherwise.
+ */
+bool runRetained(const Options& options);
+
+/**
+ * @brief Goes through the transitions between the menus and a two-player match, and then plays an AI vs AI match,
+ * drawing every state at the refresh rate of a display with the fixed ticks of `App::exec()` in between, and reports
+ * the frames that `Game::changed()` lets the application skip.
+ *
+ * Every frame is drawn anyway, so that the frames skipped can be checked against the previous ones.
+ * @param options Options of the simulation.
+ * @return True if no frame skipped differs from the previous one, the menus skip all their frames but the first and
+ * the matches present more, false otherwise.
+ */
+bool runFrames(const Options& options);
+
+} // namespace pong::sim
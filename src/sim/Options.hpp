@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////
+/// Proto Pong
+///
+/// Copyright (c) 2015 - 2025 Gonzalo González Romero (gonrogon)
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Entity.hpp"
+#include "Handle.hpp"
+#include <string>
+#include <string_view>
+
+namespace pong::sim {
+
+/** @brief Maximum number of entities of the entities mode, both storages take handles from the same scene. */
+constexpr long long EntityLimit = (Handle<Entity>::MaxIndex + 1) / 2;
+
+/**
+ * @brief Defines the command line options of the simulator.
+ */
+struct Options
+{
+    /** @brief Name of the simulation mode, see `modes()`. */
+    std::string_view mode = "scene";
+
+    /** @brief Number of matches to play. */
+    long long matches = 100;
+
+    /** @brief Maximum number of ticks per match. A match also ends as soon as a player wins. */
+    long long ticks = 1'000'000;
+
+    /** @brief Number of circle/line pairs for the kernel mode. */
+    long long pairs = 1 << 20;
+
+    /** @brief Number of balls for the fixed mode. */
+    long long balls = 4096;
+
+    /** @brief Matches between every pair of entrants on each side (tournament mode), or measured round trips (allocations mode). */
+    long long rounds = 10;
+
+    /** @brief Maximum number of threads for the tournament mode, zero for one per hardware thread. */
+    long long threads = 0;
+
+    /** @brief Number of entities for the entities mode. */
+    long long entities = 10'000;
+
+    /** @brief Seed for the random generators. */
+    long long seed = 1;
+
+    /** @brief Number of ticks per step (scene and batch modes). */
+    long long step = 1;
+
+    /** @brief One-way latency of the simulated link, in milliseconds (netplay mode). */
+    long long latency = 60;
+
+    /** @brief Maximum deviation of the latency of the simulated link, in milliseconds (netplay mode). */
+    long long jitter = 10;
+
+    /** @brief Percentage of packets lost by the simulated link (netplay mode). */
+    long long loss = 5;
+
+    /** @brief Input delay of the rollback sessions, in ticks (netplay mode). */
+    long long inputDelay = 2;
+
+    /** @brief Rollback window of the rollback sessions, in ticks (netplay mode). */
+    long long rollbackTicks = 8;
+
+    /** @brief Replay file to play (replay mode), empty to record and play scripted matches. */
+    std::string replay;
+
+    /** @brief Tick to seek to before playing the replay file (replay mode). */
+    long long seek = 0;
+
+    /** @brief Flag indicating whether the continuous collision detection is used or not (scene and batch modes). */
+    bool swept = false;
+
+    /** @brief Flag indicating whether the draw path is executed (against a null renderer) or not. */
+    bool draw = false;
+};
+
+} // namespace pong::sim